@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "mdv_debouncer.h"
+
+// Count of the stable samples used in the benchmarks
+#define BENCH_STABLE_SAMPLES 4u
+// Count of the sample sets cycled through in the benchmarks
+#define BENCH_SAMPLE_SETS 16u
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+
+namespace{
+
+uint32_t bench_input_get(void)
+{
+        return 0;
+}
+
+mdv_digital_input_t bench_input = {NULL, NULL, bench_input_get};
+
+std::vector<uint32_t> get_samples(uint32_t const count)
+{
+        std::mt19937 random(1u);
+        std::vector<uint32_t> samples(count);
+
+        for (uint32_t &sample : samples) {
+                sample = random() & random();
+        }
+
+        return samples;
+}
+
+/*
+ * A counter of its own for each line, as the applications do today
+ */
+struct per_line_debouncer{
+        uint32_t state;
+        uint8_t counters[32];
+};
+
+uint32_t per_line_sample(per_line_debouncer *const debouncer,
+                         uint32_t const sample)
+{
+        uint32_t changed = 0;
+
+        for (uint32_t n = 0; n < 32u; ++n) {
+                if (((sample ^ debouncer->state) >> n) & 1u) {
+                        if (++debouncer->counters[n] == BENCH_STABLE_SAMPLES) {
+                                changed |= 1u << n;
+                                debouncer->counters[n] = 0;
+                        }
+                } else {
+                        debouncer->counters[n] = 0;
+                }
+        }
+        debouncer->state ^= changed;
+
+        return changed;
+}
+
+void BM_per_line_counters(benchmark::State &state)
+{
+        uint32_t const port_count = (uint32_t)state.range(0);
+        std::vector<per_line_debouncer> debouncers(port_count,
+                                                   per_line_debouncer{});
+        std::vector<uint32_t> const samples =
+                get_samples(port_count * BENCH_SAMPLE_SETS);
+        uint32_t set = 0;
+
+        for (auto _ : state) {
+                uint32_t const *const sample =
+                        &samples[(set++ % BENCH_SAMPLE_SETS) * port_count];
+
+                for (uint32_t port = 0; port < port_count; ++port) {
+                        benchmark::DoNotOptimize(
+                                per_line_sample(&debouncers[port],
+                                                sample[port]));
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * port_count);
+}
+
+/*
+ * A vertical counter debouncer for each port
+ */
+void BM_vertical_counters(benchmark::State &state)
+{
+        uint32_t const port_count = (uint32_t)state.range(0);
+        std::vector<mdv_debouncer_t> debouncers(port_count);
+        std::vector<uint32_t> const samples =
+                get_samples(port_count * BENCH_SAMPLE_SETS);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint32_t set = 0;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        for (mdv_debouncer_t &debouncer : debouncers) {
+                mdv_debouncer_init(&debouncer, &bench_input, &sw_timer_base,
+                                   1u, BENCH_STABLE_SAMPLES);
+        }
+
+        for (auto _ : state) {
+                uint32_t const *const sample =
+                        &samples[(set++ % BENCH_SAMPLE_SETS) * port_count];
+
+                for (uint32_t port = 0; port < port_count; ++port) {
+                        benchmark::DoNotOptimize(
+                                mdv_debouncer_sample(&debouncers[port],
+                                                     sample[port]));
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * port_count);
+}
+
+/*
+ * All the ports in one bank
+ */
+void BM_bank(benchmark::State &state)
+{
+        uint32_t const port_count = (uint32_t)state.range(0);
+        std::vector<uint32_t> buffer(MDV_DEBOUNCER_BANK_WORDS(port_count));
+        std::vector<uint32_t> const samples =
+                get_samples(port_count * BENCH_SAMPLE_SETS);
+        mdv_debouncer_bank_t bank;
+        uint32_t set = 0;
+
+        mdv_debouncer_bank_init(&bank, buffer.data(), port_count,
+                                BENCH_STABLE_SAMPLES, NULL);
+
+        for (auto _ : state) {
+                mdv_debouncer_bank_sample(
+                        &bank,
+                        &samples[(set++ % BENCH_SAMPLE_SETS) * port_count]);
+                benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * port_count);
+}
+
+BENCHMARK(BM_per_line_counters)->Arg(1)->Arg(4096);
+BENCHMARK(BM_vertical_counters)->Arg(1)->Arg(4096);
+BENCHMARK(BM_bank)->Arg(1)->Arg(4096);
+
+} // namespace
\ No newline at end of file
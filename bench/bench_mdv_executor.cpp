@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "mdv_executor.h"
+#include "mdv_sw_timer.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+
+namespace{
+
+uint32_t get_period(uint32_t const index)
+{
+        return 1000u + (index * 2654435761u) % 1000u;
+}
+
+void bench_task_function(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task,
+                         void *const user_data)
+{
+        (void)executor;
+        (void)task;
+
+        ++*static_cast<uint64_t *>(user_data);
+}
+
+/*
+ * Superloop polling the software timer of each task
+ */
+void BM_superloop_polling(benchmark::State &state)
+{
+        uint32_t const task_count = (uint32_t)state.range(0);
+        std::vector<mdv_sw_timer_t> sw_timers(task_count);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint64_t run_count = 0;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+
+        for (uint32_t i = 0; i < task_count; i++) {
+                mdv_sw_timer_init(&sw_timers[i], &sw_timer_base);
+                mdv_sw_timer_start(&sw_timers[i]);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                for (uint32_t i = 0; i < task_count; i++) {
+                        mdv_sw_timer_get_time(&sw_timers[i],
+                                              MDV_SW_TIMER_TIMERTICK, &time);
+
+                        if (time >= get_period(i)) {
+                                mdv_sw_timer_start(&sw_timers[i]);
+                                ++run_count;
+                        }
+                }
+        }
+
+        benchmark::DoNotOptimize(run_count);
+        state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * Executor picking the due tasks from the heaps
+ */
+void BM_executor(benchmark::State &state)
+{
+        uint32_t const task_count = (uint32_t)state.range(0);
+        std::vector<mdv_executor_task_t> tasks(task_count);
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_executor_t executor;
+        uint64_t run_count = 0;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_executor_init(&executor, &sw_timer_base);
+
+        for (uint32_t i = 0; i < task_count; i++) {
+                uint32_t const period = get_period(i);
+
+                mdv_executor_task_init(&tasks[i], bench_task_function,
+                                       &run_count);
+                mdv_executor_submit(&executor, &tasks[i], period, period,
+                                    period);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                while (mdv_executor_run_once(&executor)) {
+                }
+        }
+
+        benchmark::DoNotOptimize(run_count);
+        state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_superloop_polling)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_executor)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
\ No newline at end of file
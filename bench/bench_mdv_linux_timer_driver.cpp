@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include "mdv_linux_timer_driver.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 1u
+
+namespace{
+
+/*
+ * Latency of reading the counter with each clock source
+ */
+void BM_get_count(benchmark::State &state)
+{
+        mdv_linux_timer_driver_config_t config;
+
+        config.clock_source = (mdv_linux_timer_clock_source_t)state.range(0);
+        config.tick_duration_us = BENCH_TICK_DURATION_US;
+        config.timer_width_bits = 32u;
+        config.event_period_ticks = 0;
+
+        if (!MDV_SUCCESSFUL(mdv_linux_timer_driver_configure(&config))) {
+                state.SkipWithError("Clock source not available");
+                return;
+        }
+
+        mdv_linux_timer_driver.init(0, 0);
+
+        for (auto _ : state) {
+                benchmark::DoNotOptimize(mdv_linux_timer_driver.get_count());
+        }
+
+        mdv_linux_timer_driver.uninit();
+}
+
+BENCHMARK(BM_get_count)
+        ->ArgName("clock_source")
+        ->Arg(MDV_LINUX_TIMER_CLOCK_MONOTONIC_RAW)
+        ->Arg(MDV_LINUX_TIMER_CLOCK_MONOTONIC)
+        ->Arg(MDV_LINUX_TIMER_CLOCK_TSC);
+
+} // namespace
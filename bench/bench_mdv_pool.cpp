@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "mdv_pool.h"
+#include "mdv_sw_timer.h"
+
+// Count of the objects in the benchmark pools
+#define BENCH_OBJECT_COUNT 4096u
+// Count of the live objects in the churn benchmarks
+#define BENCH_LIVE_COUNT 2048u
+
+namespace{
+
+MDV_POOL_STORAGE(bench_storage, sizeof(mdv_sw_timer_t), BENCH_OBJECT_COUNT);
+
+/*
+ * Allocation policies of the benchmarks
+ */
+class heap_allocator
+{
+        public:
+
+        void *alloc() {
+                return malloc(sizeof(mdv_sw_timer_t));
+        }
+
+        void free(void *const block) {
+                ::free(block);
+        }
+};
+
+class pool_allocator
+{
+        public:
+
+        pool_allocator() {
+                mdv_pool_init(&m_pool, bench_storage, sizeof(mdv_sw_timer_t),
+                              BENCH_OBJECT_COUNT);
+        }
+
+        void *alloc() {
+                return mdv_pool_alloc(&m_pool);
+        }
+
+        void free(void *const block) {
+                mdv_pool_free(&m_pool, block);
+        }
+
+        private:
+
+        mdv_pool_t m_pool;
+};
+
+class pool_cache_allocator
+{
+        public:
+
+        pool_cache_allocator() {
+                mdv_pool_init(&m_pool, bench_storage, sizeof(mdv_sw_timer_t),
+                              BENCH_OBJECT_COUNT);
+                mdv_pool_cache_init(&m_cache, &m_pool);
+        }
+
+        void *alloc() {
+                return mdv_pool_cache_alloc(&m_cache);
+        }
+
+        void free(void *const block) {
+                mdv_pool_cache_free(&m_cache, block);
+        }
+
+        private:
+
+        mdv_pool_t m_pool;
+        mdv_pool_cache_t m_cache;
+};
+
+/*
+ * One timer allocated and released, as for a short timeout
+ */
+template<typename allocator_t>
+void BM_alloc_free(benchmark::State &state)
+{
+        allocator_t allocator;
+
+        for (auto _ : state) {
+                void *const block = allocator.alloc();
+
+                benchmark::DoNotOptimize(block);
+                allocator.free(block);
+        }
+}
+
+/*
+ * A random one of the live timers replaced with a new one, as for timeouts of
+ * connections ending in a random order
+ */
+template<typename allocator_t>
+void BM_churn(benchmark::State &state)
+{
+        allocator_t allocator;
+        std::vector<void *> live;
+        std::vector<uint32_t> order(4096u);
+        std::mt19937 random(1u);
+        uint32_t i = 0;
+
+        for (uint32_t &index : order) {
+                index = random() % BENCH_LIVE_COUNT;
+        }
+        for (uint32_t j = 0; j < BENCH_LIVE_COUNT; ++j) {
+                live.push_back(allocator.alloc());
+        }
+
+        for (auto _ : state) {
+                void **const slot = &live[order[i++ & 4095u]];
+
+                allocator.free(*slot);
+                *slot = allocator.alloc();
+                benchmark::DoNotOptimize(*slot);
+        }
+
+        for (void *const block : live) {
+                allocator.free(block);
+        }
+}
+
+BENCHMARK_TEMPLATE(BM_alloc_free, heap_allocator);
+BENCHMARK_TEMPLATE(BM_alloc_free, pool_allocator);
+BENCHMARK_TEMPLATE(BM_alloc_free, pool_cache_allocator);
+BENCHMARK_TEMPLATE(BM_churn, heap_allocator);
+BENCHMARK_TEMPLATE(BM_churn, pool_allocator);
+BENCHMARK_TEMPLATE(BM_churn, pool_cache_allocator);
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include "mdv_profiler.h"
+#include "mdv_sw_timer.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 1u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+
+namespace{
+
+/*
+ * Section timed with a software timer, converting each sample
+ */
+void BM_sw_timer_sample(benchmark::State &state)
+{
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_sw_timer_t sw_timer;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_init(&sw_timer, &sw_timer_base);
+
+        for (auto _ : state) {
+                mdv_sw_timer_start(&sw_timer);
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+                mdv_sw_timer_get_time(&sw_timer, MDV_SW_TIMER_US, &time);
+                benchmark::DoNotOptimize(time);
+        }
+}
+
+/*
+ * Section timed with a profiler probe, accumulating the statistics
+ */
+void BM_profiler_probe(benchmark::State &state)
+{
+        static MDV_PROFILER_DEFINE_SITE(site, "bench");
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_profiler_t profiler;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_profiler_init(&profiler, &sw_timer_base);
+
+        for (auto _ : state) {
+                MDV_PROFILER_BEGIN(&profiler, start);
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+                MDV_PROFILER_END(&profiler, &site, start);
+        }
+
+        benchmark::DoNotOptimize(site.sum);
+}
+
+/*
+ * The timed section alone
+ */
+void BM_section_only(benchmark::State &state)
+{
+        mdv_sw_timer_base_t sw_timer_base;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+        }
+}
+
+BENCHMARK(BM_sw_timer_sample);
+BENCHMARK(BM_profiler_probe);
+BENCHMARK(BM_section_only);
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mdv_queue.h"
+
+// Capacity of the benchmark queues
+#define BENCH_CAPACITY 1024u
+// Count of the elements passed in one iteration of the throughput benchmarks
+#define BENCH_ELEMENT_COUNT 65536u
+// Count of the round trips in one iteration of the latency benchmarks
+#define BENCH_ROUND_TRIP_COUNT 1024u
+// Largest batch in the benchmarks
+#define BENCH_MAX_BATCH 64u
+
+namespace{
+
+/*
+ * Ring buffer protected by a mutex, the baseline of the benchmarks
+ */
+class mutex_queue
+{
+        public:
+
+        uint32_t enqueue(uint32_t const *const elements, uint32_t const count) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                uint32_t i;
+
+                for (i = 0; (i < count) && (m_tail - m_head < BENCH_CAPACITY);
+                     ++i) {
+                        m_elements[m_tail++ % BENCH_CAPACITY] = elements[i];
+                }
+
+                return i;
+        }
+
+        uint32_t dequeue(uint32_t *const elements, uint32_t const count) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                uint32_t i;
+
+                for (i = 0; (i < count) && (m_head != m_tail); ++i) {
+                        elements[i] = m_elements[m_head++ % BENCH_CAPACITY];
+                }
+
+                return i;
+        }
+
+        private:
+
+        std::mutex m_mutex;
+        uint32_t m_elements[BENCH_CAPACITY];
+        uint32_t m_head = 0;
+        uint32_t m_tail = 0;
+};
+
+class spsc_queue
+{
+        public:
+
+        spsc_queue() {
+                mdv_spsc_queue_init(&m_queue, m_buffer, sizeof(uint32_t),
+                                    BENCH_CAPACITY);
+        }
+
+        uint32_t enqueue(uint32_t const *const elements, uint32_t const count) {
+                return mdv_spsc_queue_enqueue(&m_queue, elements, count);
+        }
+
+        uint32_t dequeue(uint32_t *const elements, uint32_t const count) {
+                return mdv_spsc_queue_dequeue(&m_queue, elements, count);
+        }
+
+        private:
+
+        mdv_spsc_queue_t m_queue;
+        uint32_t m_buffer[BENCH_CAPACITY];
+};
+
+class mpsc_queue
+{
+        public:
+
+        mpsc_queue() {
+                mdv_mpsc_queue_init(&m_queue, m_buffer, sizeof(uint32_t),
+                                    BENCH_CAPACITY);
+        }
+
+        uint32_t enqueue(uint32_t const *const elements, uint32_t const count) {
+                return mdv_mpsc_queue_enqueue(&m_queue, elements, count);
+        }
+
+        uint32_t dequeue(uint32_t *const elements, uint32_t const count) {
+                return mdv_mpsc_queue_dequeue(&m_queue, elements, count);
+        }
+
+        private:
+
+        mdv_mpsc_queue_t m_queue;
+        uint32_t m_buffer[MDV_MPSC_QUEUE_BUFFER_SIZE(sizeof(uint32_t),
+                                                     BENCH_CAPACITY) /
+                          sizeof(uint32_t)];
+};
+
+template<typename queue_t>
+void produce(queue_t *const queue, uint32_t const count, uint32_t const batch)
+{
+        uint32_t elements[BENCH_MAX_BATCH] = {0};
+        uint32_t sent = 0;
+
+        while (sent < count) {
+                uint32_t const enqueued = queue->enqueue(
+                        elements, count - sent < batch ? count - sent : batch);
+
+                if (!enqueued) {
+                        std::this_thread::yield();
+                }
+                sent += enqueued;
+        }
+}
+
+template<typename queue_t>
+void consume(queue_t *const queue, uint32_t const count, uint32_t const batch)
+{
+        uint32_t elements[BENCH_MAX_BATCH];
+        uint32_t received = 0;
+
+        while (received < count) {
+                uint32_t const dequeued = queue->dequeue(elements, batch);
+
+                if (!dequeued) {
+                        std::this_thread::yield();
+                }
+                received += dequeued;
+        }
+}
+
+/*
+ * Elements passed from the producer threads to the consumer, in batches of
+ * range(1) elements
+ */
+template<typename queue_t>
+void BM_throughput(benchmark::State &state)
+{
+        uint32_t const producer_count = (uint32_t)state.range(0);
+        uint32_t const batch = (uint32_t)state.range(1);
+        uint32_t const count = BENCH_ELEMENT_COUNT / producer_count;
+
+        for (auto _ : state) {
+                queue_t queue;
+                std::vector<std::thread> producers;
+
+                for (uint32_t i = 0; i < producer_count; ++i) {
+                        producers.emplace_back(produce<queue_t>, &queue,
+                                               count, batch);
+                }
+                consume(&queue, count * producer_count, batch);
+                for (std::thread &producer : producers) {
+                        producer.join();
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_ELEMENT_COUNT);
+}
+
+/*
+ * Round trips of one element to an echo thread and back
+ */
+template<typename queue_t>
+void BM_round_trip(benchmark::State &state)
+{
+        for (auto _ : state) {
+                queue_t request;
+                queue_t response;
+                std::thread echo([&request, &response]() {
+                        uint32_t element;
+
+                        for (uint32_t i = 0; i < BENCH_ROUND_TRIP_COUNT; ++i) {
+                                while (!request.dequeue(&element, 1u)) {
+                                        std::this_thread::yield();
+                                }
+                                while (!response.enqueue(&element, 1u)) {
+                                        std::this_thread::yield();
+                                }
+                        }
+                });
+
+                for (uint32_t i = 0; i < BENCH_ROUND_TRIP_COUNT; ++i) {
+                        uint32_t element = i;
+
+                        while (!request.enqueue(&element, 1u)) {
+                                std::this_thread::yield();
+                        }
+                        while (!response.dequeue(&element, 1u)) {
+                                std::this_thread::yield();
+                        }
+                }
+                echo.join();
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_ROUND_TRIP_COUNT);
+}
+
+BENCHMARK_TEMPLATE(BM_throughput, mutex_queue)
+        ->Args({1, 1})->Args({1, BENCH_MAX_BATCH})
+        ->Args({3, 1})->Args({3, BENCH_MAX_BATCH})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput, spsc_queue)
+        ->Args({1, 1})->Args({1, BENCH_MAX_BATCH})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_throughput, mpsc_queue)
+        ->Args({1, 1})->Args({1, BENCH_MAX_BATCH})
+        ->Args({3, 1})->Args({3, BENCH_MAX_BATCH})->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, mutex_queue)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_round_trip, spsc_queue)->UseRealTime();
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "mdv_sw_timer.hpp"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+
+namespace{
+
+/*
+ * Timer driver counting one tick per read, for the polling mode
+ */
+uint32_t bench_driver_counter;
+
+mdv_result_t bench_driver_init(mdv_timer_event_handler_t const event_handler,
+                               void *const user_data)
+{
+        (void)event_handler;
+        (void)user_data;
+
+        bench_driver_counter = 0;
+
+        return MDV_RESULT_OK;
+}
+
+uint32_t bench_driver_get_count(void)
+{
+        return ++bench_driver_counter;
+}
+
+mdv_timer_driver_t bench_timer_driver = {
+        bench_driver_init, 0, 0, 0, 0, bench_driver_get_count, 0, 0
+};
+
+/*
+ * Cost of reading the time in one order of magnitude, with the timer width
+ * and the tick mode given as the arguments
+ */
+void BM_sw_timer_get_time(benchmark::State &state)
+{
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude =
+                (mdv_sw_timer_order_of_magnitude_t)state.range(0);
+        uint8_t const timer_width_bits = (uint8_t)state.range(1);
+        bool const is_polling = state.range(2) != 0;
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_sw_timer_t sw_timer;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               timer_width_bits,
+                               is_polling ? &bench_timer_driver : 0);
+        mdv_sw_timer_init(&sw_timer, &sw_timer_base);
+        mdv_sw_timer_start(&sw_timer);
+
+        for (auto _ : state) {
+                mdv_sw_timer_get_time(&sw_timer, order_of_magnitude, &time);
+                benchmark::DoNotOptimize(time);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * Cost of advancing the tick counter with the timer width given as the
+ * argument
+ */
+void BM_sw_timer_base_tick(benchmark::State &state)
+{
+        mdv_sw_timer_base_t sw_timer_base;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               (uint8_t)state.range(0), 0);
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+                benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * Cost of one superloop iteration querying many timers in the polling mode,
+ * with the snapshot mode disabled or enabled as the argument
+ */
+void BM_sw_timer_superloop(benchmark::State &state)
+{
+        uint32_t const timer_count = (uint32_t)state.range(0);
+        bool const is_snapshot_enabled = state.range(1) != 0;
+        std::vector<mdv_sw_timer_t> sw_timers(timer_count);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US, 32u,
+                               &bench_timer_driver);
+        mdv_sw_timer_base_set_snapshot_mode(&sw_timer_base,
+                                            is_snapshot_enabled);
+
+        for (auto &sw_timer : sw_timers) {
+                mdv_sw_timer_init(&sw_timer, &sw_timer_base);
+                mdv_sw_timer_start(&sw_timer);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_latch(&sw_timer_base);
+
+                for (auto &sw_timer : sw_timers) {
+                        mdv_sw_timer_get_time(&sw_timer, MDV_SW_TIMER_MS,
+                                              &time);
+                        benchmark::DoNotOptimize(time);
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * timer_count);
+}
+
+/*
+ * Tick source of the compile-time specialized timer, counting one tick per
+ * read like the polling mode driver
+ */
+struct bench_tick_source {
+        static uint32_t get_count()
+        {
+                return ++bench_driver_counter;
+        }
+};
+
+/*
+ * Cost of reading the time with the compile-time specialized timer
+ */
+template <mdv_sw_timer_order_of_magnitude_t Order>
+void BM_sw_timer_cpp_get_time(benchmark::State &state)
+{
+        mdv::sw_timer<BENCH_TICK_DURATION_US, 23u, bench_tick_source> sw_timer;
+
+        sw_timer.start();
+
+        for (auto _ : state) {
+                benchmark::DoNotOptimize(sw_timer.get_time<Order>());
+        }
+
+        state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_sw_timer_get_time)
+        ->ArgNames({"order", "width", "polling"})
+        ->ArgsProduct({{MDV_SW_TIMER_TIMERTICK, MDV_SW_TIMER_US,
+                        MDV_SW_TIMER_MS, MDV_SW_TIMER_S, MDV_SW_TIMER_NS},
+                       {8, 16, 23, 32},
+                       {0, 1}});
+BENCHMARK_TEMPLATE(BM_sw_timer_cpp_get_time, MDV_SW_TIMER_TIMERTICK);
+BENCHMARK_TEMPLATE(BM_sw_timer_cpp_get_time, MDV_SW_TIMER_US);
+BENCHMARK_TEMPLATE(BM_sw_timer_cpp_get_time, MDV_SW_TIMER_MS);
+BENCHMARK_TEMPLATE(BM_sw_timer_cpp_get_time, MDV_SW_TIMER_S);
+BENCHMARK_TEMPLATE(BM_sw_timer_cpp_get_time, MDV_SW_TIMER_NS);
+BENCHMARK(BM_sw_timer_superloop)
+        ->ArgNames({"timers", "snapshot"})
+        ->Args({200, 0})->Args({200, 1});
+BENCHMARK(BM_sw_timer_base_tick)
+        ->ArgName("width")->Arg(8)->Arg(16)->Arg(23)->Arg(32);
+
+} // namespace
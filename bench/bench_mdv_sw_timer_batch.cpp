@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "mdv_sw_timer.h"
+#include "mdv_sw_timer_batch.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+
+namespace{
+
+uint32_t get_timeout(uint32_t const index)
+{
+        return (index * 2654435761u) % 100000u;
+}
+
+/*
+ * Expiry evaluated one timer at a time with the software timer API
+ */
+void BM_expiry_per_timer(benchmark::State &state)
+{
+        uint32_t const timer_count = (uint32_t)state.range(0);
+        std::vector<mdv_sw_timer_t> sw_timers(timer_count);
+        std::vector<uint32_t> timeouts(timer_count);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint32_t expired_count;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+
+        for (uint32_t i = 0; i < timer_count; i++) {
+                mdv_sw_timer_init(&sw_timers[i], &sw_timer_base);
+                mdv_sw_timer_start(&sw_timers[i]);
+                timeouts[i] = get_timeout(i);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                expired_count = 0;
+
+                for (uint32_t i = 0; i < timer_count; i++) {
+                        mdv_sw_timer_get_time(&sw_timers[i],
+                                              MDV_SW_TIMER_TIMERTICK, &time);
+                        expired_count += (time >= timeouts[i]) ? 1u : 0u;
+                }
+
+                benchmark::DoNotOptimize(expired_count);
+        }
+
+        state.SetItemsProcessed(state.iterations() * timer_count);
+}
+
+/*
+ * Expiry evaluated for all timers with one tick count sample
+ */
+void BM_expiry_batch(benchmark::State &state)
+{
+        uint32_t const timer_count = (uint32_t)state.range(0);
+        std::vector<uint32_t> startup_samples(timer_count);
+        std::vector<uint32_t> timeouts(timer_count);
+        std::vector<uint32_t> expired(
+                MDV_SW_TIMER_BATCH_BITMAP_WORDS(timer_count));
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_sw_timer_batch_t sw_timer_batch;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_batch_init(&sw_timer_batch, &sw_timer_base,
+                                startup_samples.data(), timeouts.data(),
+                                timer_count);
+
+        for (uint32_t i = 0; i < timer_count; i++) {
+                mdv_sw_timer_batch_start(&sw_timer_batch, i, get_timeout(i));
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                benchmark::DoNotOptimize(mdv_sw_timer_batch_get_expired(
+                        &sw_timer_batch, expired.data()));
+                benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * timer_count);
+}
+
+BENCHMARK(BM_expiry_per_timer)->Arg(1024)->Arg(1 << 20);
+BENCHMARK(BM_expiry_batch)->Arg(1024)->Arg(1 << 20);
+
+} // namespace
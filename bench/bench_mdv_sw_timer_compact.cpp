@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "mdv_sw_timer.h"
+#include "mdv_sw_timer_compact.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+// Count of timers used in the benchmarks
+#define BENCH_TIMER_COUNT 4096u
+
+namespace{
+
+/*
+ * Time of each timer queried with the software timer API
+ */
+void BM_get_time_sw_timer(benchmark::State &state)
+{
+        std::vector<mdv_sw_timer_t> sw_timers(BENCH_TIMER_COUNT);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+
+        for (uint32_t i = 0; i < BENCH_TIMER_COUNT; i++) {
+                mdv_sw_timer_init(&sw_timers[i], &sw_timer_base);
+                mdv_sw_timer_start(&sw_timers[i]);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                for (uint32_t i = 0; i < BENCH_TIMER_COUNT; i++) {
+                        mdv_sw_timer_get_time(&sw_timers[i], MDV_SW_TIMER_MS,
+                                              &time);
+                        benchmark::DoNotOptimize(time);
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TIMER_COUNT);
+        state.counters["bytes_per_timer"] = sizeof(mdv_sw_timer_t);
+}
+
+/*
+ * Time of each timer queried with the compact timer API
+ */
+void BM_get_time_compact(benchmark::State &state)
+{
+        std::vector<mdv_sw_timer_compact_t> timers(BENCH_TIMER_COUNT);
+        mdv_sw_timer_base_t sw_timer_base;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+
+        for (uint32_t i = 0; i < BENCH_TIMER_COUNT; i++) {
+                mdv_sw_timer_compact_start(&sw_timer_base, &timers[i]);
+        }
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                for (uint32_t i = 0; i < BENCH_TIMER_COUNT; i++) {
+                        mdv_sw_timer_compact_get_time(&sw_timer_base,
+                                                      &timers[i],
+                                                      MDV_SW_TIMER_MS, &time);
+                        benchmark::DoNotOptimize(time);
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TIMER_COUNT);
+        state.counters["bytes_per_timer"] = sizeof(mdv_sw_timer_compact_t);
+}
+
+/*
+ * Time of each timer in an array queried one timer at a time
+ */
+void BM_get_time_compact_array(benchmark::State &state)
+{
+        std::vector<mdv_sw_timer_compact_t> timers(BENCH_TIMER_COUNT);
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_sw_timer_compact_array_t array;
+        uint32_t time;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_compact_array_init(&array, &sw_timer_base, timers.data(),
+                                        BENCH_TIMER_COUNT);
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                for (uint32_t i = 0; i < BENCH_TIMER_COUNT; i++) {
+                        mdv_sw_timer_compact_array_get_time(
+                                &array, i, MDV_SW_TIMER_MS, &time);
+                        benchmark::DoNotOptimize(time);
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TIMER_COUNT);
+        state.counters["bytes_per_timer"] = sizeof(mdv_sw_timer_compact_t);
+}
+
+/*
+ * Time of all timers in an array queried with one tick count sample
+ */
+void BM_get_times_compact_array(benchmark::State &state)
+{
+        std::vector<mdv_sw_timer_compact_t> timers(BENCH_TIMER_COUNT);
+        std::vector<uint32_t> times(BENCH_TIMER_COUNT);
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_sw_timer_compact_array_t array;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_compact_array_init(&array, &sw_timer_base, timers.data(),
+                                        BENCH_TIMER_COUNT);
+
+        for (auto _ : state) {
+                mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+
+                mdv_sw_timer_compact_array_get_times(&array, MDV_SW_TIMER_MS,
+                                                     times.data());
+                benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TIMER_COUNT);
+        state.counters["bytes_per_timer"] = sizeof(mdv_sw_timer_compact_t);
+}
+
+BENCHMARK(BM_get_time_sw_timer);
+BENCHMARK(BM_get_time_compact);
+BENCHMARK(BM_get_time_compact_array);
+BENCHMARK(BM_get_times_compact_array);
+
+} // namespace
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include "mdv_sw_timer_conversion.h"
+
+// Tick duration used in the benchmarks
+#define BENCH_TICK_DURATION_US 100u
+// Tick frequency of the fractional tick period used in the benchmarks
+#define BENCH_TICK_FREQUENCY_HZ 48000000u
+// Count of tick values converted per iteration
+#define BENCH_TICK_COUNTS 1024u
+
+namespace{
+
+/*
+ * Tick to time conversion using runtime divisions (the implementation before
+ * the precomputed conversion factors). The divisors are read through volatile
+ * variables, so that the compiler can't replace the division with
+ * a multiplication. This models a target without a hardware divider, where
+ * the division is done by a library call.
+ */
+volatile uint32_t us_in_one_ms = MDV_SW_TIMER_US_IN_ONE_MS;
+volatile uint32_t us_in_one_second = MDV_SW_TIMER_US_IN_ONE_SECOND;
+
+uint32_t get_time_with_division(uint32_t const tick_duration_us,
+        uint32_t const tick_count,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude)
+{
+        switch (order_of_magnitude) {
+        case MDV_SW_TIMER_US:
+                return tick_count * tick_duration_us;
+        case MDV_SW_TIMER_MS:
+                return (tick_count * tick_duration_us) / us_in_one_ms;
+        case MDV_SW_TIMER_S:
+                return (tick_count * tick_duration_us) / us_in_one_second;
+        default:
+                return tick_count;
+        }
+}
+
+void fill_tick_counts(uint32_t *const tick_counts)
+{
+        for (uint32_t i = 0; i < BENCH_TICK_COUNTS; i++) {
+                tick_counts[i] = (i * 2654435761u) % 40000000u;
+        }
+}
+
+void BM_conversion_division(benchmark::State &state)
+{
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude =
+                (mdv_sw_timer_order_of_magnitude_t)state.range(0);
+        uint32_t tick_counts[BENCH_TICK_COUNTS];
+
+        fill_tick_counts(tick_counts);
+
+        for (auto _ : state) {
+                for (uint32_t i = 0; i < BENCH_TICK_COUNTS; i++) {
+                        benchmark::DoNotOptimize(get_time_with_division(
+                                BENCH_TICK_DURATION_US, tick_counts[i],
+                                order_of_magnitude));
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TICK_COUNTS);
+}
+
+void BM_conversion_reciprocal(benchmark::State &state)
+{
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude =
+                (mdv_sw_timer_order_of_magnitude_t)state.range(0);
+        mdv_sw_timer_conversion_t conversion;
+        uint32_t tick_counts[BENCH_TICK_COUNTS];
+
+        fill_tick_counts(tick_counts);
+        mdv_sw_timer_conversion_init(&conversion, BENCH_TICK_DURATION_US);
+
+        for (auto _ : state) {
+                for (uint32_t i = 0; i < BENCH_TICK_COUNTS; i++) {
+                        benchmark::DoNotOptimize(
+                                mdv_sw_timer_conversion_get_time(
+                                        &conversion, tick_counts[i],
+                                        order_of_magnitude));
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TICK_COUNTS);
+}
+
+/*
+ * Conversion of a fractional tick period given in Q32.32 nanoseconds
+ */
+void BM_conversion_fractional(benchmark::State &state)
+{
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude =
+                (mdv_sw_timer_order_of_magnitude_t)state.range(0);
+        mdv_sw_timer_conversion_t conversion;
+        uint32_t tick_counts[BENCH_TICK_COUNTS];
+
+        fill_tick_counts(tick_counts);
+        mdv_sw_timer_conversion_init_period(
+                &conversion, MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(
+                        BENCH_TICK_FREQUENCY_HZ));
+
+        for (auto _ : state) {
+                for (uint32_t i = 0; i < BENCH_TICK_COUNTS; i++) {
+                        benchmark::DoNotOptimize(
+                                mdv_sw_timer_conversion_get_time(
+                                        &conversion, tick_counts[i],
+                                        order_of_magnitude));
+                }
+        }
+
+        state.SetItemsProcessed(state.iterations() * BENCH_TICK_COUNTS);
+}
+
+BENCHMARK(BM_conversion_division)
+        ->Arg(MDV_SW_TIMER_US)->Arg(MDV_SW_TIMER_MS)->Arg(MDV_SW_TIMER_S);
+BENCHMARK(BM_conversion_reciprocal)
+        ->Arg(MDV_SW_TIMER_US)->Arg(MDV_SW_TIMER_MS)->Arg(MDV_SW_TIMER_S)
+        ->Arg(MDV_SW_TIMER_NS);
+BENCHMARK(BM_conversion_fractional)
+        ->Arg(MDV_SW_TIMER_US)->Arg(MDV_SW_TIMER_MS)->Arg(MDV_SW_TIMER_S)
+        ->Arg(MDV_SW_TIMER_NS);
+
+} // namespace
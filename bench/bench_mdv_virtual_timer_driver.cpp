@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "mdv_sw_timer_base.h"
+#include "mdv_timer_wheel.h"
+#include "mdv_virtual_timer_driver.h"
+
+// Timer tick duration used in the benchmarks (1 ms)
+#define BENCH_TICK_DURATION_US 1000u
+// Timer width used in the benchmarks
+#define BENCH_TIMER_WIDTH_BITS 32u
+// Count of periodic timer wheel entries
+#define BENCH_ENTRY_COUNT 16u
+// Period of the first entry in ticks, the other entries use its multiples
+#define BENCH_ENTRY_PERIOD 1000u
+// Simulated ticks per benchmark iteration (one hour)
+#define BENCH_SIMULATED_TICKS 3600000u
+
+namespace{
+
+void bench_callback(mdv_timer_wheel_entry_t *const entry,
+                    void *const user_data)
+{
+        (void)entry;
+
+        ++*static_cast<uint64_t *>(user_data);
+}
+
+void arm_entries(mdv_timer_wheel_t *const timer_wheel,
+                 std::vector<mdv_timer_wheel_entry_t> &entries,
+                 uint64_t *const expiration_count)
+{
+        for (uint32_t i = 0; i < BENCH_ENTRY_COUNT; i++) {
+                uint32_t const period = BENCH_ENTRY_PERIOD * (i + 1u);
+
+                mdv_timer_wheel_entry_init(&entries[i], bench_callback,
+                                           expiration_count);
+                mdv_timer_wheel_arm(timer_wheel, &entries[i], period, period);
+        }
+}
+
+/*
+ * Timer wheel driven by a timer base ticked once per simulated tick
+ */
+void BM_simulate_ticks(benchmark::State &state)
+{
+        std::vector<mdv_timer_wheel_entry_t> entries(BENCH_ENTRY_COUNT);
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_timer_wheel_t timer_wheel;
+        uint64_t expiration_count = 0;
+
+        mdv_sw_timer_base_init(&sw_timer_base, BENCH_TICK_DURATION_US,
+                               BENCH_TIMER_WIDTH_BITS, 0);
+        mdv_timer_wheel_init(&timer_wheel, &sw_timer_base);
+        mdv_sw_timer_base_set_event_handler(&sw_timer_base,
+                                            mdv_timer_wheel_handle_event,
+                                            &timer_wheel);
+        arm_entries(&timer_wheel, entries, &expiration_count);
+
+        for (auto _ : state) {
+                for (uint32_t i = 0; i < BENCH_SIMULATED_TICKS; i++) {
+                        mdv_sw_timer_base_tick(&sw_timer_base, 1u);
+                }
+        }
+
+        benchmark::DoNotOptimize(expiration_count);
+        state.counters["simulated_ticks_per_second"] = benchmark::Counter(
+                (double)state.iterations() * BENCH_SIMULATED_TICKS,
+                benchmark::Counter::kIsRate);
+        state.counters["expirations"] = benchmark::Counter(
+                (double)expiration_count, benchmark::Counter::kAvgIterations);
+}
+
+/*
+ * Timer wheel driven by a tickless timer base on the virtual clock, which
+ * jumps from one deadline to the next
+ */
+void BM_simulate_virtual_time(benchmark::State &state)
+{
+        std::vector<mdv_timer_wheel_entry_t> entries(BENCH_ENTRY_COUNT);
+        mdv_virtual_timer_driver_config_t const config = {
+                BENCH_TIMER_WIDTH_BITS, 0
+        };
+        mdv_sw_timer_base_t sw_timer_base;
+        mdv_timer_wheel_t timer_wheel;
+        uint64_t expiration_count = 0;
+
+        mdv_virtual_timer_driver_configure(&config);
+        mdv_sw_timer_base_init_tickless(&sw_timer_base, BENCH_TICK_DURATION_US,
+                                        BENCH_TIMER_WIDTH_BITS,
+                                        &mdv_virtual_timer_driver);
+        mdv_timer_wheel_init(&timer_wheel, &sw_timer_base);
+        mdv_sw_timer_base_set_event_handler(&sw_timer_base,
+                                            mdv_timer_wheel_handle_event,
+                                            &timer_wheel);
+        mdv_sw_timer_base_set_deadline_provider(
+                &sw_timer_base, mdv_timer_wheel_provide_deadline,
+                &timer_wheel);
+        arm_entries(&timer_wheel, entries, &expiration_count);
+        mdv_sw_timer_base_update_deadline(&sw_timer_base);
+
+        for (auto _ : state) {
+                mdv_virtual_timer_driver_advance(BENCH_SIMULATED_TICKS);
+        }
+
+        benchmark::DoNotOptimize(expiration_count);
+        state.counters["simulated_ticks_per_second"] = benchmark::Counter(
+                (double)state.iterations() * BENCH_SIMULATED_TICKS,
+                benchmark::Counter::kIsRate);
+        state.counters["expirations"] = benchmark::Counter(
+                (double)expiration_count, benchmark::Counter::kAvgIterations);
+        state.counters["events"] = benchmark::Counter(
+                (double)mdv_virtual_timer_driver_get_event_count(),
+                benchmark::Counter::kAvgIterations);
+
+        mdv_sw_timer_base_uninit(&sw_timer_base);
+}
+
+BENCHMARK(BM_simulate_ticks);
+BENCHMARK(BM_simulate_virtual_time);
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,585 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "mdv_linux_timer_driver.h"
+#include "mdv_atomic.h"
+#include <assert.h>
+#include <poll.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MDV_LINUX_TIMER_DRIVER_TSC
+#endif
+
+/**
+ * \defgroup mdv-linux-timer-driver-internals Internals
+ * \ingroup  mdv-linux-timer-driver
+ * @{
+ */
+
+/// Nanoseconds in one microsecond
+#define NS_IN_ONE_US 1000u
+/// Nanoseconds in one second
+#define NS_IN_ONE_SECOND 1000000000u
+/// Duration of the time stamp counter calibration in nanoseconds
+#define TSC_CALIBRATION_NS 10000000u
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/**
+ * \brief Driver instance data
+ */
+typedef struct _linux_timer_driver_t{
+        /// Configuration
+        mdv_linux_timer_driver_config_t config;
+        /// Timer mask for the timer width
+        uint32_t timer_mask;
+        /// Ticks per one clock unit as a 0.64 fixed-point value
+        uint64_t multiplier;
+        /// Clock value at the counter value zero, while running
+        uint64_t clock_offset;
+        /// Elapsed clock units, while stopped
+        uint64_t clock_frozen;
+        /// Set while the counter runs
+        uint32_t is_running;
+        /// Set while the driver is initialized
+        bool is_initialized;
+        /// Event handler
+        mdv_timer_event_handler_t event_handler;
+        /// User data passed to the event handler
+        void *event_user_data;
+        /// Timer for the events, or -1
+        int timer_fd;
+        /// Event for stopping the event thread, or -1
+        int stop_fd;
+        /// Event thread
+        pthread_t event_thread;
+} linux_timer_driver_t;
+
+/// The driver instance, configured by default to 1 us ticks and 32 bits.
+/// The multiplier is the one computed for 1000 ns.
+static linux_timer_driver_t driver = {
+        {MDV_LINUX_TIMER_CLOCK_MONOTONIC_RAW, 1u, 32u, 0u},
+        0xffffffffu, 0x4189374bc6a7f0u, 0, 0, 0, false, 0, 0, -1, -1, 0
+};
+
+/**
+ * \brief Get the high 64 bits of a 64-bit multiplication
+ *
+ * \param[in] a First factor
+ * \param[in] b Second factor
+ *
+ * \return The high 64 bits of the 128-bit product
+ */
+static uint64_t multiply_high(uint64_t const a, uint64_t const b)
+{
+#ifdef __SIZEOF_INT128__
+        return (uint64_t)(((uint128_t)a * b) >> 64);
+#else
+        uint64_t const a_low = a & 0xffffffffu;
+        uint64_t const a_high = a >> 32;
+        uint64_t const b_low = b & 0xffffffffu;
+        uint64_t const b_high = b >> 32;
+        uint64_t const middle = ((a_low * b_low) >> 32) +
+                                (a_high * b_low & 0xffffffffu) +
+                                a_low * b_high;
+
+        return a_high * b_high + ((a_high * b_low) >> 32) + (middle >> 32);
+#endif
+}
+
+/**
+ * \brief Read a clock with clock_gettime
+ *
+ * \param[in] clock_id Clock to read
+ *
+ * \return The clock value in nanoseconds
+ */
+static uint64_t read_clock_ns(clockid_t const clock_id)
+{
+        struct timespec time;
+
+        clock_gettime(clock_id, &time);
+
+        return ((uint64_t)time.tv_sec * NS_IN_ONE_SECOND) +
+               (uint64_t)time.tv_nsec;
+}
+
+/**
+ * \brief Read the configured clock source
+ *
+ * \return The clock value in the units of the clock source
+ */
+static uint64_t read_clock(void)
+{
+        switch (driver.config.clock_source) {
+#ifdef MDV_LINUX_TIMER_DRIVER_TSC
+        case MDV_LINUX_TIMER_CLOCK_TSC:
+                return __rdtsc();
+#endif
+        case MDV_LINUX_TIMER_CLOCK_MONOTONIC:
+                return read_clock_ns(CLOCK_MONOTONIC);
+        default:
+                return read_clock_ns(CLOCK_MONOTONIC_RAW);
+        }
+}
+
+/**
+ * \brief Compute the multiplier which converts nanoseconds to ticks
+ *
+ * The multiplier is rounded up, so a whole count of ticks in nanoseconds
+ * gives exactly that count of ticks.
+ *
+ * \param[in] tick_duration_ns Duration of one tick in nanoseconds
+ *
+ * \return The multiplier as a 0.64 fixed-point value
+ */
+static uint64_t get_ns_multiplier(uint64_t const tick_duration_ns)
+{
+        return (UINT64_MAX / tick_duration_ns) + 1u;
+}
+
+/**
+ * \brief Compute the multiplier which converts time stamp counter cycles to
+ * ticks, by calibrating the counter against CLOCK_MONOTONIC_RAW
+ *
+ * \param[in] tick_duration_ns Duration of one tick in nanoseconds
+ *
+ * \return The multiplier as a 0.64 fixed-point value, or zero if the time
+ *      stamp counter is not available
+ */
+static uint64_t get_tsc_multiplier(uint64_t const tick_duration_ns)
+{
+#ifdef MDV_LINUX_TIMER_DRIVER_TSC
+        struct timespec const delay = {0, TSC_CALIBRATION_NS};
+        uint64_t ns;
+        uint64_t cycles;
+
+        ns = read_clock_ns(CLOCK_MONOTONIC_RAW);
+        cycles = __rdtsc();
+
+        nanosleep(&delay, 0);
+
+        cycles = __rdtsc() - cycles;
+        ns = read_clock_ns(CLOCK_MONOTONIC_RAW) - ns;
+
+        // Ticks per cycle: ns / (cycles * tick_duration_ns)
+        return (uint64_t)(((uint128_t)ns << 64) /
+                          ((uint128_t)cycles * tick_duration_ns));
+#else
+        (void)tick_duration_ns;
+
+        return 0;
+#endif
+}
+
+/**
+ * \brief Get the elapsed clock units of the counter
+ *
+ * \return The elapsed clock units
+ */
+static uint64_t get_elapsed(void)
+{
+        // The offset and the frozen value are stored before the running state
+        // is changed, so both give a valid value during the change
+        if (mdv_atomic_load_acquire_u32(&(driver.is_running))) {
+                return read_clock() -
+                       mdv_atomic_load_acquire_u64(&(driver.clock_offset));
+        }
+
+        return mdv_atomic_load_acquire_u64(&(driver.clock_frozen));
+}
+
+/**
+ * \brief Arm or disarm the event timer
+ *
+ * \param[in] is_armed Arm the timer if true, otherwise disarm it
+ *
+ * \return No return value
+ */
+static void arm_event_timer(bool const is_armed)
+{
+        uint64_t period_us;
+        struct itimerspec timer_spec;
+
+        if (driver.timer_fd < 0) {
+                return;
+        }
+
+        memset(&timer_spec, 0, sizeof(timer_spec));
+
+        if (is_armed) {
+                period_us = (uint64_t)driver.config.event_period_ticks *
+                            driver.config.tick_duration_us;
+                timer_spec.it_interval.tv_sec =
+                        (time_t)(period_us / (NS_IN_ONE_SECOND / NS_IN_ONE_US));
+                timer_spec.it_interval.tv_nsec =
+                        (long)((period_us %
+                                (NS_IN_ONE_SECOND / NS_IN_ONE_US)) *
+                               NS_IN_ONE_US);
+                timer_spec.it_value = timer_spec.it_interval;
+        }
+
+        timerfd_settime(driver.timer_fd, 0, &timer_spec, 0);
+}
+
+/**
+ * \brief Deliver the timer events to the event handler
+ *
+ * \param[in] argument Not used
+ *
+ * \return Always null
+ */
+static void *run_event_thread(void *argument)
+{
+        struct pollfd fds[2];
+        uint64_t expirations;
+
+        (void)argument;
+
+        fds[0].fd = driver.timer_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = driver.stop_fd;
+        fds[1].events = POLLIN;
+
+        for (;;) {
+                if (poll(fds, 2, -1) < 0) {
+                        continue;
+                }
+
+                if (fds[1].revents) {
+                        break;
+                }
+
+                // Overrun expirations are coalesced to one event, because the
+                // event carries the current counter value
+                if ((fds[0].revents & POLLIN) &&
+                    (read(driver.timer_fd, &expirations,
+                          sizeof(expirations)) == sizeof(expirations))) {
+                        driver.event_handler(driver.event_user_data,
+                                             mdv_linux_timer_driver.
+                                             get_count());
+                }
+        }
+
+        return 0;
+}
+
+/**
+ * \brief Close the event file descriptors
+ *
+ * \return No return value
+ */
+static void close_event_fds(void)
+{
+        if (driver.timer_fd >= 0) {
+                close(driver.timer_fd);
+                driver.timer_fd = -1;
+        }
+
+        if (driver.stop_fd >= 0) {
+                close(driver.stop_fd);
+                driver.stop_fd = -1;
+        }
+}
+
+/**
+ * \brief Start the event thread
+ *
+ * \retval MDV_RESULT_OK Started successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_SYSTEM A system call failed
+ */
+static mdv_result_t start_event_thread(void)
+{
+        driver.timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        driver.stop_fd = eventfd(0, EFD_CLOEXEC);
+
+        if ((driver.timer_fd < 0) || (driver.stop_fd < 0) ||
+            pthread_create(&(driver.event_thread), 0, run_event_thread, 0)) {
+                close_event_fds();
+                return MDV_LINUX_TIMER_DRIVER_ERROR_SYSTEM;
+        }
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Stop the event thread
+ *
+ * \return No return value
+ */
+static void stop_event_thread(void)
+{
+        uint64_t const stop = 1u;
+
+        if (driver.stop_fd < 0) {
+                return;
+        }
+
+        if (write(driver.stop_fd, &stop, sizeof(stop)) == sizeof(stop)) {
+                pthread_join(driver.event_thread, 0);
+        }
+
+        close_event_fds();
+}
+
+/**
+ * \brief Initialize the timer and start counting from zero
+ *
+ * \param[in] event_handler Timer event handler callback (optional)
+ * \param[in] user_data User data to be passed to the event handler
+ *
+ * \retval MDV_RESULT_OK Initialized successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is initialized
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_SYSTEM A system call failed
+ */
+static mdv_result_t init(mdv_timer_event_handler_t const event_handler,
+                         void *const user_data)
+{
+        mdv_result_t result;
+
+        if (driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.event_handler = event_handler;
+        driver.event_user_data = user_data;
+
+        if (event_handler && driver.config.event_period_ticks) {
+                result = start_event_thread();
+
+                if (!MDV_SUCCESSFUL(result)) {
+                        return result;
+                }
+        }
+
+        driver.is_initialized = true;
+
+        mdv_atomic_store_release_u64(&(driver.clock_frozen), 0);
+        mdv_linux_timer_driver.start();
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Uninitialize the timer
+ *
+ * \retval MDV_RESULT_OK Uninitialized successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t uninit(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        mdv_linux_timer_driver.stop();
+        stop_event_thread();
+
+        driver.event_handler = 0;
+        driver.event_user_data = 0;
+        driver.is_initialized = false;
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Start the timer
+ *
+ * \retval MDV_RESULT_OK Started successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t start(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        if (!mdv_atomic_load_relaxed_u32(&(driver.is_running))) {
+                mdv_atomic_store_release_u64(
+                        &(driver.clock_offset),
+                        read_clock() -
+                        mdv_atomic_load_acquire_u64(&(driver.clock_frozen)));
+                mdv_atomic_store_release_u32(&(driver.is_running), 1u);
+                arm_event_timer(true);
+        }
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Stop the timer
+ *
+ * \retval MDV_RESULT_OK Stopped successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t stop(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        if (mdv_atomic_load_relaxed_u32(&(driver.is_running))) {
+                arm_event_timer(false);
+                mdv_atomic_store_release_u64(&(driver.clock_frozen),
+                                             get_elapsed());
+                mdv_atomic_store_release_u32(&(driver.is_running), 0);
+        }
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Reset the timer counter to zero
+ *
+ * \retval MDV_RESULT_OK Reset successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t reset(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        mdv_atomic_store_release_u64(&(driver.clock_frozen), 0);
+        mdv_atomic_store_release_u64(&(driver.clock_offset), read_clock());
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Get the current timer counter value
+ *
+ * \return The current timer counter value in ticks
+ */
+static uint32_t get_count(void)
+{
+        return (uint32_t)multiply_high(get_elapsed(), driver.multiplier) &
+               driver.timer_mask;
+}
+
+/**
+ * \brief Get the current status of the timer
+ *
+ * \retval true Timer is running
+ * \retval false Timer is stopped
+ */
+static bool is_running(void)
+{
+        return mdv_atomic_load_acquire_u32(&(driver.is_running)) != 0;
+}
+
+/** @} mdv-linux-timer-driver-internals */
+
+mdv_timer_driver_t mdv_linux_timer_driver = {
+        init, uninit, start, stop, reset, get_count, is_running, 0
+};
+
+mdv_result_t mdv_linux_timer_driver_configure(
+        mdv_linux_timer_driver_config_t const *const config)
+{
+        uint64_t tick_duration_ns;
+        uint64_t multiplier;
+
+        assert(config);
+        assert(config->tick_duration_us > 0);
+        assert((config->timer_width_bits > 0) &&
+               (config->timer_width_bits <= 32));
+
+        if (driver.is_initialized) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        if (!mdv_linux_timer_driver_is_clock_source_available(
+                    config->clock_source)) {
+                return MDV_LINUX_TIMER_DRIVER_ERROR_CLOCK_SOURCE;
+        }
+
+        tick_duration_ns = (uint64_t)config->tick_duration_us * NS_IN_ONE_US;
+
+        if (config->clock_source == MDV_LINUX_TIMER_CLOCK_TSC) {
+                multiplier = get_tsc_multiplier(tick_duration_ns);
+        } else {
+                multiplier = get_ns_multiplier(tick_duration_ns);
+        }
+
+        driver.config = *config;
+        driver.timer_mask = (uint32_t)(0xffffffffu >>
+                                       (32u - config->timer_width_bits));
+        driver.multiplier = multiplier;
+
+        return MDV_RESULT_OK;
+}
+
+bool mdv_linux_timer_driver_is_clock_source_available(
+        mdv_linux_timer_clock_source_t const clock_source)
+{
+#ifdef MDV_LINUX_TIMER_DRIVER_TSC
+        unsigned int eax;
+        unsigned int ebx;
+        unsigned int ecx;
+        unsigned int edx;
+#endif
+        struct timespec time;
+
+        switch (clock_source) {
+        case MDV_LINUX_TIMER_CLOCK_MONOTONIC_RAW:
+                return clock_gettime(CLOCK_MONOTONIC_RAW, &time) == 0;
+        case MDV_LINUX_TIMER_CLOCK_MONOTONIC:
+                return clock_gettime(CLOCK_MONOTONIC, &time) == 0;
+#ifdef MDV_LINUX_TIMER_DRIVER_TSC
+        case MDV_LINUX_TIMER_CLOCK_TSC:
+                // The invariant time stamp counter runs at a constant rate in
+                // all power states
+                return __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) &&
+                       (edx & (1u << 8));
+#endif
+        default:
+                return false;
+        }
+}
+
+/* EOF */
@@ -0,0 +1,146 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_LINUX_TIMER_DRIVER_H
+#define MDV_LINUX_TIMER_DRIVER_H
+
+#include "mdv_timer_driver.h"
+
+/**
+ * \file       mdv_linux_timer_driver.h
+ * \defgroup   mdv-linux-timer-driver Linux host timer driver
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Implementation of the timer driver interface for Linux hosts. The counter
+ * is derived from a monotonic clock source, scaled to the configured tick
+ * duration and limited to the configured timer width.
+ *
+ * The clock sources are:
+ * - CLOCK_MONOTONIC_RAW, which is not affected by NTP adjustments.
+ * - CLOCK_MONOTONIC, which is slewed by NTP, and served from the vDSO on
+ *   all architectures.
+ * - The time stamp counter of x86 processors, read with the rdtsc
+ *   instruction. The counter frequency is calibrated against
+ *   CLOCK_MONOTONIC_RAW during the initialization. The time stamp counter is
+ *   available only on processors reporting an invariant counter.
+ *
+ * The clock values are scaled to ticks using a 64-bit multiplier and a 128-bit
+ * product, so reading the counter doesn't divide.
+ *
+ * If an event period is configured, a thread waits on a timerfd and calls the
+ * event handler given to the initialization function with the current counter
+ * value once per period. The event handler is called from that thread.
+ *
+ * There is one driver instance, \ref mdv_linux_timer_driver, configured with
+ * \ref mdv_linux_timer_driver_configure before the initialization.
+ *
+ * @{
+ */
+
+/// The clock source is not available on this host
+#define MDV_LINUX_TIMER_DRIVER_ERROR_CLOCK_SOURCE -1
+/// The operation is not valid in the current state of the driver
+#define MDV_LINUX_TIMER_DRIVER_ERROR_STATE -2
+/// A system call failed
+#define MDV_LINUX_TIMER_DRIVER_ERROR_SYSTEM -3
+
+/**
+ * \brief Clock source of the Linux timer driver
+ */
+typedef enum _mdv_linux_timer_clock_source_t{
+        /// CLOCK_MONOTONIC_RAW
+        MDV_LINUX_TIMER_CLOCK_MONOTONIC_RAW = 0,
+        /// CLOCK_MONOTONIC
+        MDV_LINUX_TIMER_CLOCK_MONOTONIC,
+        /// Time stamp counter of x86 processors
+        MDV_LINUX_TIMER_CLOCK_TSC
+} mdv_linux_timer_clock_source_t;
+
+/**
+ * \brief Configuration of the Linux timer driver
+ */
+typedef struct _mdv_linux_timer_driver_config_t{
+        /// Clock source
+        mdv_linux_timer_clock_source_t clock_source;
+        /// Duration of one tick in microseconds
+        uint32_t tick_duration_us;
+        /// Timer width in bits from 1 to 32
+        uint8_t timer_width_bits;
+        /// Period of the timer events in ticks (0 disables the events)
+        uint32_t event_period_ticks;
+} mdv_linux_timer_driver_config_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/// The Linux timer driver instance
+extern mdv_timer_driver_t mdv_linux_timer_driver;
+
+/**
+ * \brief Configure the Linux timer driver
+ *
+ * Must be called before initializing the driver. The time stamp counter is
+ * calibrated here, which takes about 10 milliseconds.
+ *
+ * \param[in] config Configuration to use
+ *
+ * \retval MDV_RESULT_OK Configured successfully
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_CLOCK_SOURCE The clock source is not
+ *      available
+ * \retval MDV_LINUX_TIMER_DRIVER_ERROR_STATE The driver is initialized
+ */
+mdv_result_t mdv_linux_timer_driver_configure(
+        mdv_linux_timer_driver_config_t const *const config);
+
+/**
+ * \brief Check if a clock source is available on this host
+ *
+ * \param[in] clock_source Clock source to check
+ *
+ * \retval true The clock source is available
+ * \retval false The clock source is not available
+ */
+bool mdv_linux_timer_driver_is_clock_source_available(
+        mdv_linux_timer_clock_source_t const clock_source);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-linux-timer-driver */
+
+#endif // ifndef MDV_LINUX_TIMER_DRIVER_H
+
+/* EOF */
@@ -0,0 +1,368 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_virtual_timer_driver.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-virtual-timer-driver-internals Internals
+ * \ingroup  mdv-virtual-timer-driver
+ * @{
+ */
+
+/**
+ * \brief Driver instance data
+ */
+typedef struct _virtual_timer_driver_t{
+        /// Configuration
+        mdv_virtual_timer_driver_config_t config;
+        /// Timer mask for the timer width
+        uint32_t timer_mask;
+        /// Ticks elapsed on the virtual clock
+        uint64_t time;
+        /// Ticks counted while the timer was running
+        uint64_t elapsed;
+        /// Counted ticks at the counter value zero
+        uint64_t counter_offset;
+        /// Counted ticks at the next periodic event
+        uint64_t next_periodic_event;
+        /// Counted ticks at the compare event
+        uint64_t compare_event;
+        /// Compare value
+        uint32_t compare;
+        /// Set while the compare event is pending
+        bool is_compare_armed;
+        /// Set while the counter runs
+        bool is_running;
+        /// Set while the driver is initialized
+        bool is_initialized;
+        /// Count of events raised
+        uint64_t event_count;
+        /// Event handler
+        mdv_timer_event_handler_t event_handler;
+        /// User data passed to the event handler
+        void *event_user_data;
+} virtual_timer_driver_t;
+
+/// The driver instance, configured by default to 32 bits without periodic
+/// events
+static virtual_timer_driver_t driver = {
+        {32u, 0u}, 0xffffffffu, 0, 0, 0, 0, 0, 0, false, false, false, 0, 0, 0
+};
+
+/**
+ * \brief Get the current timer counter value
+ *
+ * \return The current timer counter value in ticks
+ */
+static uint32_t get_count(void)
+{
+        return (uint32_t)(driver.elapsed - driver.counter_offset) &
+               driver.timer_mask;
+}
+
+/**
+ * \brief Schedule the compare event for the compare value
+ *
+ * \return No return value
+ */
+static void schedule_compare_event(void)
+{
+        uint64_t ticks = (driver.compare - get_count()) & driver.timer_mask;
+
+        // The counter reaches its current value again after a full period
+        if (!ticks) {
+                ticks = (uint64_t)driver.timer_mask + 1u;
+        }
+
+        driver.compare_event = driver.elapsed + ticks;
+}
+
+/**
+ * \brief Raise an event
+ *
+ * \return No return value
+ */
+static void raise_event(void)
+{
+        ++driver.event_count;
+
+        if (driver.event_handler) {
+                driver.event_handler(driver.event_user_data, get_count());
+        }
+}
+
+/**
+ * \brief Advance the virtual clock without raising events
+ *
+ * \param[in] tick_count Count of ticks to advance
+ *
+ * \return No return value
+ */
+static void advance_clock(uint64_t const tick_count)
+{
+        driver.time += tick_count;
+
+        if (driver.is_running) {
+                driver.elapsed += tick_count;
+        }
+}
+
+/**
+ * \brief Initialize the timer and start counting from zero
+ *
+ * \param[in] event_handler Timer event handler callback (optional)
+ * \param[in] user_data User data to be passed to the event handler
+ *
+ * \retval MDV_RESULT_OK Initialized successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is initialized
+ */
+static mdv_result_t init(mdv_timer_event_handler_t const event_handler,
+                         void *const user_data)
+{
+        if (driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.event_handler = event_handler;
+        driver.event_user_data = user_data;
+        driver.time = 0;
+        driver.elapsed = 0;
+        driver.counter_offset = 0;
+        driver.next_periodic_event = driver.config.event_period_ticks;
+        driver.is_compare_armed = false;
+        driver.event_count = 0;
+        driver.is_initialized = true;
+
+        mdv_virtual_timer_driver.start();
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Uninitialize the timer
+ *
+ * \retval MDV_RESULT_OK Uninitialized successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t uninit(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        mdv_virtual_timer_driver.stop();
+
+        driver.event_handler = 0;
+        driver.event_user_data = 0;
+        driver.is_compare_armed = false;
+        driver.is_initialized = false;
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Start the timer
+ *
+ * \retval MDV_RESULT_OK Started successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t start(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.is_running = true;
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Stop the timer
+ *
+ * \retval MDV_RESULT_OK Stopped successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t stop(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.is_running = false;
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Reset the timer counter to zero
+ *
+ * \retval MDV_RESULT_OK Reset successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t reset(void)
+{
+        if (!driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.counter_offset = driver.elapsed;
+
+        // The compare value is reached at a different tick from now on
+        if (driver.is_compare_armed) {
+                schedule_compare_event();
+        }
+
+        return MDV_RESULT_OK;
+}
+
+/**
+ * \brief Get the current status of the timer
+ *
+ * \retval true Timer is running
+ * \retval false Timer is stopped
+ */
+static bool is_running(void)
+{
+        return driver.is_running;
+}
+
+/**
+ * \brief Program the compare value of the timer
+ *
+ * \param[in] counter Counter value at which to raise the event
+ *
+ * \retval MDV_RESULT_OK Programmed successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is not initialized
+ */
+static mdv_result_t set_compare(uint32_t const counter)
+{
+        if (!driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.compare = counter & driver.timer_mask;
+        driver.is_compare_armed = true;
+        schedule_compare_event();
+
+        return MDV_RESULT_OK;
+}
+
+/** @} mdv-virtual-timer-driver-internals */
+
+mdv_timer_driver_t mdv_virtual_timer_driver = {
+        init, uninit, start, stop, reset, get_count, is_running, set_compare
+};
+
+mdv_result_t mdv_virtual_timer_driver_configure(
+        mdv_virtual_timer_driver_config_t const *const config)
+{
+        assert(config);
+        assert((config->timer_width_bits > 0) &&
+               (config->timer_width_bits <= 32));
+
+        if (driver.is_initialized) {
+                return MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE;
+        }
+
+        driver.config = *config;
+        driver.timer_mask = (uint32_t)(0xffffffffu >>
+                                       (32u - config->timer_width_bits));
+
+        return MDV_RESULT_OK;
+}
+
+uint64_t mdv_virtual_timer_driver_step(uint64_t const max_tick_count)
+{
+        uint64_t ticks = UINT64_MAX;
+
+        // The counter doesn't reach any event while the timer is stopped
+        if (driver.is_running) {
+                if (driver.config.event_period_ticks) {
+                        ticks = driver.next_periodic_event - driver.elapsed;
+                }
+                if (driver.is_compare_armed &&
+                    ((driver.compare_event - driver.elapsed) < ticks)) {
+                        ticks = driver.compare_event - driver.elapsed;
+                }
+        }
+
+        if (ticks > max_tick_count) {
+                advance_clock(max_tick_count);
+                return max_tick_count;
+        }
+
+        advance_clock(ticks);
+
+        // Raise all the events due at this tick in a fixed order. The event
+        // handler may program a new compare value, which replaces the one due
+        // now.
+        if (driver.config.event_period_ticks &&
+            (driver.next_periodic_event == driver.elapsed)) {
+                driver.next_periodic_event += driver.config.event_period_ticks;
+                raise_event();
+        }
+
+        if (driver.is_compare_armed &&
+            (driver.compare_event == driver.elapsed)) {
+                driver.is_compare_armed = false;
+                raise_event();
+        }
+
+        return ticks;
+}
+
+uint64_t mdv_virtual_timer_driver_advance(uint64_t const tick_count)
+{
+        uint64_t const event_count = driver.event_count;
+        uint64_t remaining = tick_count;
+
+        while (remaining) {
+                remaining -= mdv_virtual_timer_driver_step(remaining);
+        }
+
+        return driver.event_count - event_count;
+}
+
+uint64_t mdv_virtual_timer_driver_get_time(void)
+{
+        return driver.time;
+}
+
+uint64_t mdv_virtual_timer_driver_get_event_count(void)
+{
+        return driver.event_count;
+}
+
+/* EOF */
@@ -0,0 +1,160 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_VIRTUAL_TIMER_DRIVER_H
+#define MDV_VIRTUAL_TIMER_DRIVER_H
+
+#include "mdv_timer_driver.h"
+
+/**
+ * \file       mdv_virtual_timer_driver.h
+ * \defgroup   mdv-virtual-timer-driver Virtual time timer driver
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Implementation of the timer driver interface on a virtual clock, for
+ * running the firmware logic in a simulation. The counter doesn't follow any
+ * real clock. It advances only when the simulation calls
+ * \ref mdv_virtual_timer_driver_advance or
+ * \ref mdv_virtual_timer_driver_step.
+ *
+ * The virtual clock doesn't advance tick by tick. It jumps straight to the
+ * next pending event, raises all the events due at that tick, and continues
+ * to the next one. The cost of the simulation depends on the number of events
+ * only, not on the simulated time. Combined with the tickless mode of the
+ * software timer base, the events are raised only at the deadlines of the
+ * software timers, so days of operation can be simulated in a fraction of a
+ * second.
+ *
+ * The driver raises two kinds of events, both through the event handler given
+ * to the initialization function:
+ * - The compare event, programmed with the set_compare function of the driver
+ *   interface, once when the counter reaches the compare value.
+ * - The periodic event, configured with the event period, each time the given
+ *   count of ticks has elapsed. With the period equal to the counter period,
+ *   the periodic event is the counter overflow event.
+ *
+ * The simulation is deterministic: the events are raised in the order of
+ * their ticks, and at the same tick, the periodic event is raised before the
+ * compare event. The event handler is called from the context advancing the
+ * clock, and it may program a new compare value.
+ *
+ * There is one driver instance, \ref mdv_virtual_timer_driver, configured with
+ * \ref mdv_virtual_timer_driver_configure before the initialization. The
+ * driver is not thread-safe.
+ *
+ * @{
+ */
+
+/// The operation is not valid in the current state of the driver
+#define MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE -1
+
+/**
+ * \brief Configuration of the virtual timer driver
+ */
+typedef struct _mdv_virtual_timer_driver_config_t{
+        /// Timer width in bits from 1 to 32
+        uint8_t timer_width_bits;
+        /// Period of the periodic events in ticks (0 disables the events)
+        uint32_t event_period_ticks;
+} mdv_virtual_timer_driver_config_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/// The virtual timer driver instance
+extern mdv_timer_driver_t mdv_virtual_timer_driver;
+
+/**
+ * \brief Configure the virtual timer driver
+ *
+ * Must be called before initializing the driver.
+ *
+ * \param[in] config Configuration to use
+ *
+ * \retval MDV_RESULT_OK Configured successfully
+ * \retval MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE The driver is initialized
+ */
+mdv_result_t mdv_virtual_timer_driver_configure(
+        mdv_virtual_timer_driver_config_t const *const config);
+
+/**
+ * \brief Advance the virtual clock to the next event
+ *
+ * Jumps to the tick of the next pending event, and raises all the events due
+ * at that tick. If there is no event within the given count of ticks, the
+ * clock advances by the given count without raising events. While the timer
+ * is stopped, the clock advances, but the counter doesn't.
+ *
+ * \param[in] max_tick_count Maximum count of ticks to advance
+ *
+ * \return Count of ticks advanced
+ */
+uint64_t mdv_virtual_timer_driver_step(uint64_t const max_tick_count);
+
+/**
+ * \brief Advance the virtual clock by the given count of ticks
+ *
+ * Raises all the events due during the ticks, including the last tick, in
+ * order.
+ *
+ * \param[in] tick_count Count of ticks to advance
+ *
+ * \return Count of events raised
+ */
+uint64_t mdv_virtual_timer_driver_advance(uint64_t const tick_count);
+
+/**
+ * \brief Get the virtual time
+ *
+ * \return Ticks elapsed on the virtual clock since the initialization
+ */
+uint64_t mdv_virtual_timer_driver_get_time(void);
+
+/**
+ * \brief Get the count of events raised
+ *
+ * \return Count of events raised since the initialization
+ */
+uint64_t mdv_virtual_timer_driver_get_event_count(void);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-virtual-timer-driver */
+
+#endif // ifndef MDV_VIRTUAL_TIMER_DRIVER_H
+
+/* EOF */
@@ -0,0 +1,298 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_ATOMIC_H
+#define MDV_ATOMIC_H
+
+#include "mdv_common.h"
+
+/**
+ * \file      mdv_atomic.h
+ * \defgroup  mdv-atomic Atomic operations
+ * \ingroup   madivaru-lib-v2
+ *
+ * Minimal lock-free atomic operations on plain integer objects, shared by the
+ * C and C++ code of the library.
+ *
+ * With GCC and Clang, the operations use the __atomic builtins. They follow
+ * the C11 memory model, compile to plain loads and stores with barriers on
+ * ARMv7-M and x86, and to LDREX/STREX sequences for the read-modify-write
+ * operations. ThreadSanitizer understands them as well. Other compilers fall
+ * back to volatile accesses, which are only valid on single-core targets where
+ * the aligned 32-bit accesses are atomic. The volatile accesses are not
+ * reordered with each other, but the compiler may move the plain accesses
+ * across them. To order the plain accesses, for example the data published by
+ * a release store, define \ref MDV_ATOMIC_BARRIER as a compiler barrier of the
+ * target toolchain.
+ *
+ * 64-bit objects are accessed atomically only when the target has lock-free
+ * 64-bit atomics. Otherwise, such as on ARMv7-M, the 64-bit accesses may be
+ * torn, and the callers must protect them, for example by a sequence lock.
+ * The torn accesses are still ordered by fences like the acquire loads and
+ * the release stores, so the sequence lock works. Defining
+ * MDV_ATOMIC_NO_LOCK_FREE_U64 forces this path also on the targets with
+ * lock-free 64-bit atomics, for example for testing.
+ *
+ * @{
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#if !defined(MDV_ATOMIC_NO_LOCK_FREE_U64) && \
+    defined(__GCC_ATOMIC_LLONG_LOCK_FREE) && (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+/// The target has lock-free 64-bit atomics
+#define MDV_ATOMIC_LOCK_FREE_U64
+#endif
+
+/**
+ * \brief Load a 32-bit value with the acquire ordering
+ *
+ * \param[in] object Object to load
+ *
+ * \return The value of the object
+ */
+static inline uint32_t mdv_atomic_load_acquire_u32(uint32_t const *object)
+{
+        return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \brief Load a 32-bit value without ordering
+ *
+ * \param[in] object Object to load
+ *
+ * \return The value of the object
+ */
+static inline uint32_t mdv_atomic_load_relaxed_u32(uint32_t const *object)
+{
+        return __atomic_load_n(object, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Store a 32-bit value with the release ordering
+ *
+ * \param[in] object Object to store to
+ * \param[in] value Value to store
+ *
+ * \return No return value
+ */
+static inline void mdv_atomic_store_release_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        __atomic_store_n(object, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * \brief Store a 32-bit value without ordering
+ *
+ * \param[in] object Object to store to
+ * \param[in] value Value to store
+ *
+ * \return No return value
+ */
+static inline void mdv_atomic_store_relaxed_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        __atomic_store_n(object, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Add to a 32-bit value
+ *
+ * \param[in] object Object to modify
+ * \param[in] value Value to add
+ *
+ * \return The value of the object before the addition
+ */
+static inline uint32_t mdv_atomic_fetch_add_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        return __atomic_fetch_add(object, value, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * \brief Compare and exchange a 32-bit value
+ *
+ * \param[in] object Object to modify
+ * \param[in,out] expected Expected value of the object, updated with the
+ *      current value on failure
+ * \param[in] desired Value to store on success
+ *
+ * \retval true The value was exchanged
+ * \retval false The object didn't contain the expected value
+ */
+static inline bool mdv_atomic_compare_exchange_u32(uint32_t *object,
+                                                   uint32_t *expected,
+                                                   uint32_t desired)
+{
+        return __atomic_compare_exchange_n(object, expected, desired, false,
+                                           __ATOMIC_ACQ_REL,
+                                           __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \brief Load a 64-bit value with the acquire ordering
+ *
+ * \param[in] object Object to load
+ *
+ * \return The value of the object
+ */
+static inline uint64_t mdv_atomic_load_acquire_u64(uint64_t const *object)
+{
+#ifdef MDV_ATOMIC_LOCK_FREE_U64
+        return __atomic_load_n(object, __ATOMIC_ACQUIRE);
+#else
+        uint64_t const value = *(uint64_t const volatile *)object;
+
+        // The fence keeps the later accesses after the possibly torn load
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        return value;
+#endif
+}
+
+/**
+ * \brief Store a 64-bit value with the release ordering
+ *
+ * \param[in] object Object to store to
+ * \param[in] value Value to store
+ *
+ * \return No return value
+ */
+static inline void mdv_atomic_store_release_u64(uint64_t *object,
+                                                uint64_t value)
+{
+#ifdef MDV_ATOMIC_LOCK_FREE_U64
+        __atomic_store_n(object, value, __ATOMIC_RELEASE);
+#else
+        // The fence keeps the earlier accesses before the possibly torn store
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        *(uint64_t volatile *)object = value;
+#endif
+}
+
+#else // if defined(__GNUC__) || defined(__clang__)
+
+// The volatile fallback. The read-modify-write operations are atomic only if
+// no other writer can interrupt them.
+
+#ifndef MDV_ATOMIC_BARRIER
+/// Barrier ordering the plain memory accesses around the acquire loads and
+/// the release stores, for example __memory_changed() with IAR or
+/// __schedule_barrier() with the ARM compiler
+#define MDV_ATOMIC_BARRIER()
+#endif // ifndef MDV_ATOMIC_BARRIER
+
+static inline uint32_t mdv_atomic_load_acquire_u32(uint32_t const *object)
+{
+        uint32_t const value = *(uint32_t const volatile *)object;
+
+        MDV_ATOMIC_BARRIER();
+
+        return value;
+}
+
+static inline uint32_t mdv_atomic_load_relaxed_u32(uint32_t const *object)
+{
+        return *(uint32_t const volatile *)object;
+}
+
+static inline void mdv_atomic_store_release_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        MDV_ATOMIC_BARRIER();
+        *(uint32_t volatile *)object = value;
+}
+
+static inline void mdv_atomic_store_relaxed_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        *(uint32_t volatile *)object = value;
+}
+
+static inline uint32_t mdv_atomic_fetch_add_u32(uint32_t *object,
+                                                uint32_t value)
+{
+        uint32_t previous;
+
+        MDV_ATOMIC_BARRIER();
+        previous = *(uint32_t volatile *)object;
+        *(uint32_t volatile *)object = previous + value;
+        MDV_ATOMIC_BARRIER();
+
+        return previous;
+}
+
+static inline bool mdv_atomic_compare_exchange_u32(uint32_t *object,
+                                                   uint32_t *expected,
+                                                   uint32_t desired)
+{
+        uint32_t current;
+
+        MDV_ATOMIC_BARRIER();
+        current = *(uint32_t volatile *)object;
+        if (current != *expected) {
+                *expected = current;
+                MDV_ATOMIC_BARRIER();
+                return false;
+        }
+
+        *(uint32_t volatile *)object = desired;
+        MDV_ATOMIC_BARRIER();
+
+        return true;
+}
+
+static inline uint64_t mdv_atomic_load_acquire_u64(uint64_t const *object)
+{
+        uint64_t const value = *(uint64_t const volatile *)object;
+
+        MDV_ATOMIC_BARRIER();
+
+        return value;
+}
+
+static inline void mdv_atomic_store_release_u64(uint64_t *object,
+                                                uint64_t value)
+{
+        MDV_ATOMIC_BARRIER();
+        *(uint64_t volatile *)object = value;
+}
+
+#endif // if defined(__GNUC__) || defined(__clang__)
+
+/** @} mdv-atomic */
+
+#endif // ifndef MDV_ATOMIC_H
+
+/* EOF */
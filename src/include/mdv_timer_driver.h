@@ -108,6 +108,19 @@ typedef struct _mdv_timer_driver_t{
          * \retval false Timer is stopped
          */
         bool (*is_running)(void);
+        /**
+         * \brief Program the compare value of the timer (optional)
+         *
+         * When the counter reaches the compare value, the driver calls the
+         * event handler once with the current counter value. Programming a
+         * new compare value replaces the previous one. Set to null if the
+         * hardware has no compare or alarm capability.
+         *
+         * \param[in] counter Counter value at which to raise the event
+         *
+         * \return Implementation specific result of the operation
+         */
+        mdv_result_t (*set_compare)(uint32_t const counter);
 } const mdv_timer_driver_t;
 
 /** \} mdv-timer-driver */
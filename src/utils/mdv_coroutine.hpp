@@ -0,0 +1,718 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_COROUTINE_HPP
+#define MDV_COROUTINE_HPP
+
+#include "mdv_timer_wheel.h"
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \file       mdv_coroutine.hpp
+ * \defgroup   mdv-coroutine C++20 coroutines over the timer base
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Optional header-only C++20 layer for writing timed flows as coroutines
+ * instead of state machines polling the software timers.
+ *
+ * \ref mdv::coroutine_loop is a single-threaded run loop on one timer base.
+ * It keeps the suspended coroutines in a timer wheel (\ref mdv-timer-wheel),
+ * so a processed tick costs only as much as the coroutines resumed on it,
+ * regardless of the count of suspended coroutines. The timer wheel entry of a
+ * suspended coroutine lives in the awaiter inside the coroutine frame, so
+ * waiting doesn't allocate memory and each flow costs one frame.
+ *
+ * \ref mdv::task is a lazily started coroutine, which can be awaited by
+ * another task, or spawned as a detached flow on the loop with
+ * \ref mdv::coroutine_loop::spawn. A task waits with \ref mdv::sleep_for and
+ * \ref mdv::sleep_until, and \ref mdv::with_timeout runs a task with a
+ * deadline. When the deadline expires first, the task is destroyed, which
+ * cancels the waits in it and in the tasks it awaits.
+ *
+ * The times are timer ticks of the timer base. An unhandled exception in a
+ * coroutine terminates the program.
+ *
+ * @{
+ */
+
+namespace mdv {
+
+class coroutine_loop;
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+/**
+ * \brief Promise data common to all tasks
+ */
+struct task_promise_base {
+        /**
+         * \brief Awaiter of the final suspend point
+         *
+         * Continues the awaiting coroutine, or destroys a detached task.
+         */
+        struct final_awaiter {
+                bool await_ready() const noexcept
+                {
+                        return false;
+                }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(
+                        std::coroutine_handle<Promise> handle) noexcept;
+
+                void await_resume() const noexcept
+                {
+                }
+        };
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+                return {};
+        }
+
+        final_awaiter final_suspend() const noexcept
+        {
+                return {};
+        }
+
+        void unhandled_exception() const noexcept
+        {
+                std::terminate();
+        }
+
+        /// Coroutine awaiting this task (null if not awaited)
+        std::coroutine_handle<> m_continuation;
+        /// Loop owning this task when detached (null if not detached)
+        coroutine_loop *m_loop = nullptr;
+};
+
+/**
+ * \brief Promise of a task returning a value
+ *
+ * \tparam T Type of the value
+ */
+template <typename T>
+struct task_promise : task_promise_base {
+        task<T> get_return_object() noexcept;
+
+        template <typename U>
+        void return_value(U &&value)
+        {
+                m_value.emplace(std::forward<U>(value));
+        }
+
+        /// Returned value
+        std::optional<T> m_value;
+};
+
+/**
+ * \brief Promise of a task returning no value
+ */
+template <>
+struct task_promise<void> : task_promise_base {
+        task<void> get_return_object() noexcept;
+
+        void return_void() const noexcept
+        {
+        }
+};
+
+} // namespace detail
+
+/**
+ * \brief Lazily started coroutine
+ *
+ * The task starts when it is awaited or spawned, and owns its coroutine frame
+ * until then.
+ *
+ * \tparam T Type of the returned value
+ */
+template <typename T>
+class task {
+        public:
+
+        /// Promise type of the coroutine
+        using promise_type = detail::task_promise<T>;
+
+        /**
+         * \brief Awaiter starting the task and resuming with its value
+         */
+        struct awaiter {
+                bool await_ready() const noexcept
+                {
+                        return !m_handle || m_handle.done();
+                }
+
+                std::coroutine_handle<> await_suspend(
+                        std::coroutine_handle<> continuation) noexcept
+                {
+                        m_handle.promise().m_continuation = continuation;
+                        return m_handle;
+                }
+
+                T await_resume()
+                {
+                        if constexpr (!std::is_void_v<T>) {
+                                return std::move(
+                                        *(m_handle.promise().m_value));
+                        }
+                }
+
+                /// The awaited coroutine
+                std::coroutine_handle<promise_type> m_handle;
+        };
+
+        task() noexcept = default;
+
+        explicit task(std::coroutine_handle<promise_type> handle) noexcept
+                : m_handle(handle)
+        {
+        }
+
+        task(task &&other) noexcept
+                : m_handle(std::exchange(other.m_handle, nullptr))
+        {
+        }
+
+        task &operator=(task &&other) noexcept
+        {
+                if (this != &other) {
+                        reset();
+                        m_handle = std::exchange(other.m_handle, nullptr);
+                }
+
+                return *this;
+        }
+
+        task(task const &) = delete;
+        task &operator=(task const &) = delete;
+
+        ~task()
+        {
+                reset();
+        }
+
+        awaiter operator co_await() const noexcept
+        {
+                return awaiter{ m_handle };
+        }
+
+        /**
+         * \brief Check if the task owns a coroutine frame
+         *
+         * \retval true The task owns a coroutine
+         * \retval false The task is empty
+         */
+        bool is_valid() const noexcept
+        {
+                return !!m_handle;
+        }
+
+        /**
+         * \brief Check if the task has completed
+         *
+         * \retval true The task has returned
+         * \retval false The task has not returned, or the task is empty
+         */
+        bool is_done() const noexcept
+        {
+                return m_handle && m_handle.done();
+        }
+
+        /**
+         * \brief Destroy the coroutine frame
+         *
+         * Destroying a suspended task cancels the waits in it.
+         */
+        void reset() noexcept
+        {
+                if (m_handle) {
+                        std::exchange(m_handle, nullptr).destroy();
+                }
+        }
+
+        /**
+         * \brief Release the ownership of the coroutine frame
+         *
+         * \return The coroutine handle
+         */
+        std::coroutine_handle<promise_type> release() noexcept
+        {
+                return std::exchange(m_handle, nullptr);
+        }
+
+        private:
+
+        /// The coroutine
+        std::coroutine_handle<promise_type> m_handle;
+};
+
+/**
+ * \brief Single-threaded run loop on a timer base
+ *
+ * The loop must outlive the coroutines using it.
+ */
+class coroutine_loop {
+        public:
+
+        /**
+         * \brief Create a loop
+         *
+         * \param[in] sw_timer_base Timer base which the loop will use
+         */
+        explicit coroutine_loop(mdv_sw_timer_base_t *const sw_timer_base)
+                : m_sw_timer_base(sw_timer_base)
+        {
+                mdv_timer_wheel_init(&m_timer_wheel, sw_timer_base);
+        }
+
+        coroutine_loop(coroutine_loop const &) = delete;
+        coroutine_loop &operator=(coroutine_loop const &) = delete;
+
+        /**
+         * \brief Start a task as a detached flow
+         *
+         * The task runs until its first suspension before this function
+         * returns. The loop destroys the coroutine frame when the task
+         * returns.
+         *
+         * \param[in] flow Task to start
+         */
+        void spawn(task<void> &&flow)
+        {
+                std::coroutine_handle<detail::task_promise<void>> const
+                        handle = flow.release();
+
+                if (!handle) {
+                        return;
+                }
+
+                handle.promise().m_loop = this;
+                ++m_flow_count;
+                handle.resume();
+        }
+
+        /**
+         * \brief Resume the coroutines whose wait has expired
+         *
+         * Reads the tick count from the timer base, and resumes the
+         * coroutines in the order of their deadlines.
+         */
+        void run_once()
+        {
+                mdv_timer_wheel_process(&m_timer_wheel);
+        }
+
+        /**
+         * \brief Run until all detached flows have returned
+         *
+         * \tparam Idle Callable taking the ticks until the next deadline, or
+         *      \ref MDV_SW_TIMER_BASE_NO_DEADLINE
+         *
+         * \param[in] idle Called when nothing is due, to wait for the next
+         *      deadline without spinning
+         */
+        template <typename Idle>
+        void run(Idle &&idle)
+        {
+                while (m_flow_count) {
+                        run_once();
+
+                        if (m_flow_count) {
+                                idle(get_next_deadline());
+                        }
+                }
+        }
+
+        /**
+         * \brief Get the ticks until the next coroutine is resumed
+         *
+         * \return Ticks from the current tick count of the timer base, or
+         *      \ref MDV_SW_TIMER_BASE_NO_DEADLINE if no coroutines are waiting
+         */
+        uint32_t get_next_deadline()
+        {
+                return mdv_timer_wheel_provide_deadline(
+                        &m_timer_wheel,
+                        mdv_sw_timer_base_get_tick_count(m_sw_timer_base));
+        }
+
+        /**
+         * \brief Get the count of the running detached flows
+         *
+         * \return The count of the spawned tasks not returned yet
+         */
+        std::size_t get_flow_count() const noexcept
+        {
+                return m_flow_count;
+        }
+
+        /**
+         * \brief Get the timer base
+         *
+         * \return The timer base of the loop
+         */
+        mdv_sw_timer_base_t *get_sw_timer_base() const noexcept
+        {
+                return m_sw_timer_base;
+        }
+
+        /**
+         * \brief Arm a timer wheel entry relative to the timer base
+         *
+         * The wheel time lags behind the timer base by the ticks elapsed since
+         * the loop was last run, so the delay is extended by that lag to keep
+         * the deadline relative to the current tick count.
+         *
+         * \param[in] entry Entry to arm
+         * \param[in] delay_ticks Delay from the current tick count
+         */
+        void arm(mdv_timer_wheel_entry_t *const entry, uint32_t delay_ticks)
+        {
+                uint32_t const lag =
+                        (mdv_sw_timer_base_get_tick_count(m_sw_timer_base) -
+                         m_timer_wheel.last_tick_count) &
+                        m_timer_wheel.timer_mask;
+
+                if (delay_ticks > MDV_TIMER_WHEEL_MAX_DELAY - lag) {
+                        delay_ticks = MDV_TIMER_WHEEL_MAX_DELAY - lag;
+                }
+
+                mdv_timer_wheel_arm(&m_timer_wheel, entry, delay_ticks + lag,
+                                    0);
+        }
+
+        /**
+         * \brief Cancel a timer wheel entry
+         *
+         * \param[in] entry Entry to cancel
+         */
+        void cancel(mdv_timer_wheel_entry_t *const entry)
+        {
+                mdv_timer_wheel_cancel(&m_timer_wheel, entry);
+        }
+
+        private:
+
+        friend struct detail::task_promise_base;
+
+        /// Timer base on which this loop runs
+        mdv_sw_timer_base_t *m_sw_timer_base;
+        /// Timer wheel of the waiting coroutines
+        mdv_timer_wheel_t m_timer_wheel;
+        /// Count of the running detached flows
+        std::size_t m_flow_count = 0;
+};
+
+template <typename Promise>
+std::coroutine_handle<>
+detail::task_promise_base::final_awaiter::await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept
+{
+        task_promise_base &promise = handle.promise();
+
+        if (promise.m_continuation) {
+                return promise.m_continuation;
+        }
+
+        if (promise.m_loop) {
+                --(promise.m_loop->m_flow_count);
+                handle.destroy();
+        }
+
+        return std::noop_coroutine();
+}
+
+template <typename T>
+task<T> detail::task_promise<T>::get_return_object() noexcept
+{
+        return task<T>(
+                std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> detail::task_promise<void>::get_return_object() noexcept
+{
+        return task<void>(
+                std::coroutine_handle<task_promise<void>>::from_promise(
+                        *this));
+}
+
+/**
+ * \brief Awaiter suspending a coroutine for a number of ticks
+ */
+class sleep_awaiter {
+        public:
+
+        /**
+         * \brief Create an awaiter
+         *
+         * \param[in] loop Loop in use
+         * \param[in] delay_ticks Ticks to wait
+         */
+        sleep_awaiter(coroutine_loop &loop, uint32_t const delay_ticks)
+                : m_loop(loop), m_delay_ticks(delay_ticks)
+        {
+                mdv_timer_wheel_entry_init(&m_entry, resume, this);
+        }
+
+        sleep_awaiter(sleep_awaiter const &) = delete;
+        sleep_awaiter &operator=(sleep_awaiter const &) = delete;
+
+        /**
+         * \brief Cancel the wait when the awaiting coroutine is destroyed
+         */
+        ~sleep_awaiter()
+        {
+                m_loop.cancel(&m_entry);
+        }
+
+        bool await_ready() const noexcept
+        {
+                return !m_delay_ticks;
+        }
+
+        void await_suspend(std::coroutine_handle<> const handle)
+        {
+                m_handle = handle;
+                m_loop.arm(&m_entry, m_delay_ticks);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        private:
+
+        /**
+         * \brief Resume the waiting coroutine
+         *
+         * \param[in] entry The expired entry
+         * \param[in] user_data The awaiter
+         */
+        static void resume(mdv_timer_wheel_entry_t *const entry,
+                           void *const user_data)
+        {
+                (void)entry;
+
+                static_cast<sleep_awaiter *>(user_data)->m_handle.resume();
+        }
+
+        /// Loop in use
+        coroutine_loop &m_loop;
+        /// Ticks to wait
+        uint32_t m_delay_ticks;
+        /// Timer wheel entry of the wait
+        mdv_timer_wheel_entry_t m_entry;
+        /// The waiting coroutine
+        std::coroutine_handle<> m_handle;
+};
+
+/**
+ * \brief Wait for a number of ticks
+ *
+ * \param[in] loop Loop in use
+ * \param[in] delay_ticks Ticks to wait (zero doesn't suspend)
+ *
+ * \return Awaiter to be awaited
+ */
+inline sleep_awaiter sleep_for(coroutine_loop &loop,
+                               uint32_t const delay_ticks)
+{
+        return sleep_awaiter(loop, delay_ticks);
+}
+
+/**
+ * \brief Wait until an extended tick count of the timer base
+ *
+ * \param[in] loop Loop in use
+ * \param[in] tick_count64 Extended tick count to wait for (a past tick count
+ *      doesn't suspend)
+ *
+ * \return Awaiter to be awaited
+ */
+inline sleep_awaiter sleep_until(coroutine_loop &loop,
+                                 uint64_t const tick_count64)
+{
+        uint64_t const now =
+                mdv_sw_timer_base_get_tick_count64(loop.get_sw_timer_base());
+        uint64_t const delay = tick_count64 > now ? tick_count64 - now : 0;
+
+        return sleep_awaiter(loop, delay > MDV_TIMER_WHEEL_MAX_DELAY ?
+                             MDV_TIMER_WHEEL_MAX_DELAY : (uint32_t)delay);
+}
+
+/**
+ * \brief Awaiter running a task with a deadline
+ *
+ * \tparam T Type of the value returned by the task
+ */
+template <typename T>
+class timeout_awaiter {
+        public:
+
+        /// Result of the wait: the value, or empty if the deadline expired
+        using result_type = std::conditional_t<std::is_void_v<T>, bool,
+                                               std::optional<T>>;
+
+        /**
+         * \brief Create an awaiter
+         *
+         * \param[in] loop Loop in use
+         * \param[in] flow Task to run
+         * \param[in] timeout_ticks Ticks until the deadline
+         */
+        timeout_awaiter(coroutine_loop &loop, task<T> &&flow,
+                        uint32_t const timeout_ticks)
+                : m_loop(loop), m_flow(std::move(flow)),
+                  m_timeout_ticks(timeout_ticks)
+        {
+                assert(m_flow.is_valid());
+
+                mdv_timer_wheel_entry_init(&m_entry, expire, this);
+        }
+
+        timeout_awaiter(timeout_awaiter const &) = delete;
+        timeout_awaiter &operator=(timeout_awaiter const &) = delete;
+
+        /**
+         * \brief Cancel the deadline when the awaiting coroutine is destroyed
+         */
+        ~timeout_awaiter()
+        {
+                m_loop.cancel(&m_entry);
+        }
+
+        bool await_ready() const noexcept
+        {
+                return false;
+        }
+
+        std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<> const handle)
+        {
+                typename task<T>::awaiter flow_awaiter = m_flow.operator
+                                                         co_await();
+
+                m_handle = handle;
+                m_loop.arm(&m_entry, m_timeout_ticks);
+
+                // Start the task. It continues this coroutine when it returns.
+                return flow_awaiter.await_suspend(handle);
+        }
+
+        result_type await_resume()
+        {
+                m_loop.cancel(&m_entry);
+
+                if constexpr (std::is_void_v<T>) {
+                        return m_flow.is_done();
+                } else {
+                        if (!m_flow.is_done()) {
+                                return std::nullopt;
+                        }
+
+                        return m_flow.operator co_await().await_resume();
+                }
+        }
+
+        private:
+
+        /**
+         * \brief Destroy the task and resume the waiting coroutine
+         *
+         * \param[in] entry The expired entry
+         * \param[in] user_data The awaiter
+         */
+        static void expire(mdv_timer_wheel_entry_t *const entry,
+                           void *const user_data)
+        {
+                timeout_awaiter *const awaiter =
+                        static_cast<timeout_awaiter *>(user_data);
+
+                (void)entry;
+
+                awaiter->m_flow.reset();
+                awaiter->m_handle.resume();
+        }
+
+        /// Loop in use
+        coroutine_loop &m_loop;
+        /// Task to run
+        task<T> m_flow;
+        /// Ticks until the deadline
+        uint32_t m_timeout_ticks;
+        /// Timer wheel entry of the deadline
+        mdv_timer_wheel_entry_t m_entry;
+        /// The waiting coroutine
+        std::coroutine_handle<> m_handle;
+};
+
+/**
+ * \brief Run a task with a deadline
+ *
+ * If the task returns before the deadline, the result holds its value (or is
+ * true for a task returning no value). Otherwise, the task is destroyed at the
+ * deadline, and the result is empty (or false).
+ *
+ * \tparam T Type of the value returned by the task
+ *
+ * \param[in] loop Loop in use
+ * \param[in] flow Task to run
+ * \param[in] timeout_ticks Ticks until the deadline
+ *
+ * \return Awaiter to be awaited
+ */
+template <typename T>
+timeout_awaiter<T> with_timeout(coroutine_loop &loop, task<T> &&flow,
+                                uint32_t const timeout_ticks)
+{
+        return timeout_awaiter<T>(loop, std::move(flow), timeout_ticks);
+}
+
+} // namespace mdv
+
+/** @} mdv-coroutine */
+
+#endif // ifndef MDV_COROUTINE_HPP
+
+/* EOF */
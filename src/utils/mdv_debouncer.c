@@ -0,0 +1,384 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_debouncer.h"
+#include <assert.h>
+#include <string.h>
+
+/**
+ * \defgroup mdv-debouncer-internals Internals
+ * \ingroup  mdv-debouncer
+ * @{
+ */
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(MDV_DEBOUNCER_NO_VECTOR)
+/// Processes several ports per operation in the banks
+#define USE_VECTOR
+/// Count of the ports in a vector
+#define VECTOR_LANES 4u
+
+/**
+ * \brief Words of several ports
+ */
+typedef uint32_t vector_t __attribute__((vector_size(VECTOR_LANES * 4u)));
+#endif // if (defined(__GNUC__) || defined(__clang__)) && ...
+
+/**
+ * \brief Set the threshold of the counters
+ *
+ * \param[out] threshold Threshold to set
+ * \param[in] stable_samples Count of the stable samples
+ *
+ * \return No return value
+ */
+static void set_threshold(uint32_t *const threshold,
+                          uint32_t const stable_samples)
+{
+        uint32_t k;
+
+        assert(stable_samples > 0);
+        assert(stable_samples <= MDV_DEBOUNCER_MAX_STABLE_SAMPLES);
+
+        // A line changes when its counter is at the count minus one and the
+        // sample still differs
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                threshold[k] = ((stable_samples - 1u) >> k) & 1u ?
+                               UINT32_MAX : 0;
+        }
+}
+
+/**
+ * \brief Filter a sample of the lines
+ *
+ * \param[in] sample Sample of the lines
+ * \param[in,out] state Debounced state of the lines
+ * \param[in,out] counters Counters of the lines
+ * \param[in] threshold Threshold of the counters
+ *
+ * \return Mask of the lines which changed their state
+ */
+static uint32_t filter(uint32_t const sample,
+                       uint32_t *const state,
+                       uint32_t *const counters,
+                       uint32_t const *const threshold)
+{
+        uint32_t const delta = sample ^ *state;
+        uint32_t changed = delta;
+        uint32_t carry = delta;
+        uint32_t counter;
+        uint32_t k;
+
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                changed &= ~(counters[k] ^ threshold[k]);
+        }
+
+        // Count up the differing lines, and restart the others and the
+        // changed ones
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                counter = counters[k];
+                counters[k] = (counter ^ carry) & delta & ~changed;
+                carry &= counter;
+        }
+        *state ^= changed;
+
+        return changed;
+}
+
+#ifdef USE_VECTOR
+/**
+ * \brief Filter a sample of the lines of several ports
+ *
+ * The same as \ref filter for vectors.
+ *
+ * \param[in] sample Samples of the lines
+ * \param[in,out] state Debounced states of the lines
+ * \param[in,out] counters Counters of the lines
+ * \param[in] threshold Threshold of the counters
+ *
+ * \return Masks of the lines which changed their state
+ */
+static vector_t filter_vector(vector_t const sample,
+                              vector_t *const state,
+                              vector_t *const counters,
+                              vector_t const *const threshold)
+{
+        vector_t const delta = sample ^ *state;
+        vector_t changed = delta;
+        vector_t carry = delta;
+        vector_t counter;
+        uint32_t k;
+
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                changed &= ~(counters[k] ^ threshold[k]);
+        }
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                counter = counters[k];
+                counters[k] = (counter ^ carry) & delta & ~changed;
+                carry &= counter;
+        }
+        *state ^= changed;
+
+        return changed;
+}
+#endif // ifdef USE_VECTOR
+
+/**
+ * \brief Filter a sample of one port of a bank
+ *
+ * \param[in] bank Bank in use
+ * \param[in] port Index of the port
+ * \param[in] sample Sample of the port
+ *
+ * \return No return value
+ */
+static void filter_port(mdv_debouncer_bank_t *const bank,
+                        uint32_t const port,
+                        uint32_t const sample)
+{
+        uint32_t counters[MDV_DEBOUNCER_COUNTER_BITS];
+        uint32_t changed;
+        uint32_t k;
+
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                counters[k] = bank->counters[k * bank->port_count + port];
+        }
+        changed = filter(sample, &(bank->states[port]), counters,
+                         bank->threshold);
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                bank->counters[k * bank->port_count + port] = counters[k];
+        }
+        bank->rising[port] |= changed & bank->states[port];
+        bank->falling[port] |= changed & ~bank->states[port];
+}
+
+/** @} mdv-debouncer-internals */
+
+void mdv_debouncer_init(mdv_debouncer_t *const debouncer,
+                        mdv_digital_input_t *const input,
+                        mdv_sw_timer_base_t *const sw_timer_base,
+                        uint32_t const sample_period,
+                        uint32_t const stable_samples)
+{
+        uint32_t k;
+
+        assert(debouncer);
+        assert(input);
+        assert(input->get);
+        assert(sw_timer_base);
+        assert(sample_period > 0);
+
+        debouncer->input = input;
+        debouncer->sw_timer_base = sw_timer_base;
+        debouncer->sample_period = sample_period;
+        debouncer->timer_mask =
+                mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        debouncer->sample_tick_count =
+                mdv_sw_timer_base_get_tick_count(sw_timer_base);
+        debouncer->state = input->get();
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                debouncer->counters[k] = 0;
+        }
+        set_threshold(debouncer->threshold, stable_samples);
+        debouncer->rising = 0;
+        debouncer->falling = 0;
+}
+
+uint32_t mdv_debouncer_process(mdv_debouncer_t *const debouncer)
+{
+        uint32_t tick_count;
+        uint32_t elapsed;
+
+        assert(debouncer);
+
+        tick_count = mdv_sw_timer_base_get_tick_count(
+                debouncer->sw_timer_base);
+        elapsed = (tick_count - debouncer->sample_tick_count) &
+                  debouncer->timer_mask;
+        if (elapsed < debouncer->sample_period) {
+                return 0;
+        }
+
+        // Keep the sampling period exact, unless the calls have fallen
+        // behind by more than one period
+        if (elapsed - debouncer->sample_period < debouncer->sample_period) {
+                debouncer->sample_tick_count =
+                        (debouncer->sample_tick_count +
+                         debouncer->sample_period) & debouncer->timer_mask;
+        } else {
+                debouncer->sample_tick_count = tick_count;
+        }
+
+        return mdv_debouncer_sample(debouncer, debouncer->input->get());
+}
+
+uint32_t mdv_debouncer_sample(mdv_debouncer_t *const debouncer,
+                              uint32_t const sample)
+{
+        uint32_t changed;
+
+        assert(debouncer);
+
+        changed = filter(sample, &(debouncer->state), debouncer->counters,
+                         debouncer->threshold);
+        debouncer->rising |= changed & debouncer->state;
+        debouncer->falling |= changed & ~debouncer->state;
+
+        return changed;
+}
+
+uint32_t mdv_debouncer_get_state(mdv_debouncer_t *const debouncer)
+{
+        assert(debouncer);
+
+        return debouncer->state;
+}
+
+void mdv_debouncer_take_edges(mdv_debouncer_t *const debouncer,
+                              uint32_t *const rising,
+                              uint32_t *const falling)
+{
+        assert(debouncer);
+        assert(rising);
+        assert(falling);
+
+        *rising = debouncer->rising;
+        *falling = debouncer->falling;
+        debouncer->rising = 0;
+        debouncer->falling = 0;
+}
+
+void mdv_debouncer_bank_init(mdv_debouncer_bank_t *const bank,
+                             uint32_t *const buffer,
+                             uint32_t const port_count,
+                             uint32_t const stable_samples,
+                             uint32_t const *const states)
+{
+        assert(bank);
+        assert(buffer);
+        assert(port_count > 0);
+
+        bank->states = buffer;
+        bank->counters = buffer + port_count;
+        bank->rising = bank->counters +
+                       MDV_DEBOUNCER_COUNTER_BITS * port_count;
+        bank->falling = bank->rising + port_count;
+        bank->port_count = port_count;
+        set_threshold(bank->threshold, stable_samples);
+
+        memset(buffer, 0,
+               MDV_DEBOUNCER_BANK_WORDS(port_count) * sizeof(uint32_t));
+        if (states) {
+                memcpy(bank->states, states, port_count * sizeof(uint32_t));
+        }
+}
+
+void mdv_debouncer_bank_sample(mdv_debouncer_bank_t *const bank,
+                               uint32_t const *const samples)
+{
+        uint32_t port = 0;
+#ifdef USE_VECTOR
+        vector_t threshold[MDV_DEBOUNCER_COUNTER_BITS];
+        vector_t counters[MDV_DEBOUNCER_COUNTER_BITS];
+        vector_t sample;
+        vector_t state;
+        vector_t changed;
+        vector_t edges;
+        uint32_t k;
+#endif // ifdef USE_VECTOR
+
+        assert(bank);
+        assert(samples);
+
+#ifdef USE_VECTOR
+        for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                threshold[k] = (vector_t){0} + bank->threshold[k];
+        }
+
+        // The words are copied in and out of the vectors, so that the arrays
+        // need no alignment
+        for (; port + VECTOR_LANES <= bank->port_count;
+             port += VECTOR_LANES) {
+                memcpy(&sample, &(samples[port]), sizeof(sample));
+                memcpy(&state, &(bank->states[port]), sizeof(state));
+                for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                        memcpy(&(counters[k]),
+                               &(bank->counters[k * bank->port_count + port]),
+                               sizeof(counters[k]));
+                }
+                changed = filter_vector(sample, &state, counters, threshold);
+                memcpy(&(bank->states[port]), &state, sizeof(state));
+                for (k = 0; k < MDV_DEBOUNCER_COUNTER_BITS; ++k) {
+                        memcpy(&(bank->counters[k * bank->port_count + port]),
+                               &(counters[k]), sizeof(counters[k]));
+                }
+                memcpy(&edges, &(bank->rising[port]), sizeof(edges));
+                edges |= changed & state;
+                memcpy(&(bank->rising[port]), &edges, sizeof(edges));
+                memcpy(&edges, &(bank->falling[port]), sizeof(edges));
+                edges |= changed & ~state;
+                memcpy(&(bank->falling[port]), &edges, sizeof(edges));
+        }
+#endif // ifdef USE_VECTOR
+
+        for (; port < bank->port_count; ++port) {
+                filter_port(bank, port, samples[port]);
+        }
+}
+
+uint32_t mdv_debouncer_bank_get_state(mdv_debouncer_bank_t *const bank,
+                                      uint32_t const port)
+{
+        assert(bank);
+        assert(port < bank->port_count);
+
+        return bank->states[port];
+}
+
+void mdv_debouncer_bank_take_edges(mdv_debouncer_bank_t *const bank,
+                                   uint32_t const port,
+                                   uint32_t *const rising,
+                                   uint32_t *const falling)
+{
+        assert(bank);
+        assert(port < bank->port_count);
+        assert(rising);
+        assert(falling);
+
+        *rising = bank->rising[port];
+        *falling = bank->falling[port];
+        bank->rising[port] = 0;
+        bank->falling[port] = 0;
+}
+
+/* EOF */
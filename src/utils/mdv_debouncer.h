@@ -0,0 +1,260 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_DEBOUNCER_H
+#define MDV_DEBOUNCER_H
+
+#include "mdv_digital_input.h"
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_debouncer.h
+ * \defgroup   mdv-debouncer Digital input debouncer
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Debounces all the 32 lines of a digital input at once with vertical
+ * counters. Bit n of each counter word is one bit of the counter of line n,
+ * so a sample is processed with a few bitwise operations per counter bit,
+ * regardless of the count of lines changing.
+ *
+ * A line changes its debounced state after it has differed from the state in
+ * the given count of consecutive samples. A sample equal to the debounced
+ * state restarts the count. The changes are collected to the rising and
+ * falling edge masks until they are taken.
+ *
+ * \ref mdv_debouncer_t samples a \ref mdv_digital_input_t at a fixed period of
+ * the software timer base. \ref mdv_debouncer_bank_t runs the same filter on
+ * any number of 32-bit ports at once, for example virtual ports of a
+ * simulator. With GCC and Clang, the bank processes several ports per
+ * operation with the vector extensions, which compile to SSE2 or NEON
+ * instructions on hosts.
+ *
+ * @{
+ */
+
+#ifndef MDV_DEBOUNCER_COUNTER_BITS
+/// Count of the bits in a counter, 1 to 8. The counters count up to
+/// 2^MDV_DEBOUNCER_COUNTER_BITS consecutive samples.
+#define MDV_DEBOUNCER_COUNTER_BITS 3u
+#endif // ifndef MDV_DEBOUNCER_COUNTER_BITS
+
+#if (MDV_DEBOUNCER_COUNTER_BITS < 1) || (MDV_DEBOUNCER_COUNTER_BITS > 8)
+#error "MDV_DEBOUNCER_COUNTER_BITS must be from 1 to 8"
+#endif
+
+/// Largest count of the stable samples
+#define MDV_DEBOUNCER_MAX_STABLE_SAMPLES (1u << MDV_DEBOUNCER_COUNTER_BITS)
+
+/// Count of the 32-bit words in the buffer of a bank of ports
+#define MDV_DEBOUNCER_BANK_WORDS(port_count) \
+        ((MDV_DEBOUNCER_COUNTER_BITS + 3u) * (port_count))
+
+/**
+ * \brief Debouncer data
+ */
+typedef struct _mdv_debouncer_t{
+        /// Digital input to sample
+        mdv_digital_input_t *input;
+        /// Timer base in use
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Sampling period in ticks
+        uint32_t sample_period;
+        /// Mask of the timer counter
+        uint32_t timer_mask;
+        /// Tick count of the latest sample
+        uint32_t sample_tick_count;
+        /// Debounced state of the lines
+        uint32_t state;
+        /// Counters of the lines, one word per counter bit
+        uint32_t counters[MDV_DEBOUNCER_COUNTER_BITS];
+        /// Bits of the count of the stable samples minus one, as masks
+        uint32_t threshold[MDV_DEBOUNCER_COUNTER_BITS];
+        /// Lines changed from zero to one since the edges were taken
+        uint32_t rising;
+        /// Lines changed from one to zero since the edges were taken
+        uint32_t falling;
+} mdv_debouncer_t;
+
+/**
+ * \brief Data of a bank of ports
+ */
+typedef struct _mdv_debouncer_bank_t{
+        /// Debounced states of the ports
+        uint32_t *states;
+        /// Counters of the ports, one array per counter bit
+        uint32_t *counters;
+        /// Rising edges of the ports since the edges were taken
+        uint32_t *rising;
+        /// Falling edges of the ports since the edges were taken
+        uint32_t *falling;
+        /// Count of the ports
+        uint32_t port_count;
+        /// Bits of the count of the stable samples minus one, as masks
+        uint32_t threshold[MDV_DEBOUNCER_COUNTER_BITS];
+} mdv_debouncer_bank_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a debouncer
+ *
+ * The debounced state is initialized from the input, so the input must be
+ * initialized first.
+ *
+ * \param[in] debouncer Debouncer to initialize
+ * \param[in] input Digital input to sample
+ * \param[in] sw_timer_base Timer base in use
+ * \param[in] sample_period Sampling period in ticks
+ * \param[in] stable_samples Count of the consecutive samples needed to change
+ *      the state of a line, from 1 to \ref MDV_DEBOUNCER_MAX_STABLE_SAMPLES
+ *
+ * \return No return value
+ */
+void mdv_debouncer_init(mdv_debouncer_t *const debouncer,
+                        mdv_digital_input_t *const input,
+                        mdv_sw_timer_base_t *const sw_timer_base,
+                        uint32_t const sample_period,
+                        uint32_t const stable_samples);
+
+/**
+ * \brief Sample the input if the sampling period has elapsed
+ *
+ * Takes one sample per call. If the calls have been late by more than one
+ * period, the missed samples are skipped.
+ *
+ * \param[in] debouncer Debouncer in use
+ *
+ * \return Mask of the lines which changed their state
+ */
+uint32_t mdv_debouncer_process(mdv_debouncer_t *const debouncer);
+
+/**
+ * \brief Filter a sample
+ *
+ * \param[in] debouncer Debouncer in use
+ * \param[in] sample Sample of the lines
+ *
+ * \return Mask of the lines which changed their state
+ */
+uint32_t mdv_debouncer_sample(mdv_debouncer_t *const debouncer,
+                              uint32_t const sample);
+
+/**
+ * \brief Get the debounced state of the lines
+ *
+ * \param[in] debouncer Debouncer in use
+ *
+ * \return The debounced state
+ */
+uint32_t mdv_debouncer_get_state(mdv_debouncer_t *const debouncer);
+
+/**
+ * \brief Take the edges collected since the previous call
+ *
+ * \param[in] debouncer Debouncer in use
+ * \param[out] rising Lines changed from zero to one
+ * \param[out] falling Lines changed from one to zero
+ *
+ * \return No return value
+ */
+void mdv_debouncer_take_edges(mdv_debouncer_t *const debouncer,
+                              uint32_t *const rising,
+                              uint32_t *const falling);
+
+/**
+ * \brief Initialize a bank of ports
+ *
+ * \param[in] bank Bank to initialize
+ * \param[in] buffer Buffer of \ref MDV_DEBOUNCER_BANK_WORDS words
+ * \param[in] port_count Count of the ports
+ * \param[in] stable_samples Count of the consecutive samples needed to change
+ *      the state of a line, from 1 to \ref MDV_DEBOUNCER_MAX_STABLE_SAMPLES
+ * \param[in] states Initial debounced states of the ports, or NULL for zeros
+ *
+ * \return No return value
+ */
+void mdv_debouncer_bank_init(mdv_debouncer_bank_t *const bank,
+                             uint32_t *const buffer,
+                             uint32_t const port_count,
+                             uint32_t const stable_samples,
+                             uint32_t const *const states);
+
+/**
+ * \brief Filter a sample of each port
+ *
+ * \param[in] bank Bank in use
+ * \param[in] samples Samples of the ports
+ *
+ * \return No return value
+ */
+void mdv_debouncer_bank_sample(mdv_debouncer_bank_t *const bank,
+                               uint32_t const *const samples);
+
+/**
+ * \brief Get the debounced state of a port
+ *
+ * \param[in] bank Bank in use
+ * \param[in] port Index of the port
+ *
+ * \return The debounced state
+ */
+uint32_t mdv_debouncer_bank_get_state(mdv_debouncer_bank_t *const bank,
+                                      uint32_t const port);
+
+/**
+ * \brief Take the edges of a port collected since the previous call
+ *
+ * \param[in] bank Bank in use
+ * \param[in] port Index of the port
+ * \param[out] rising Lines changed from zero to one
+ * \param[out] falling Lines changed from one to zero
+ *
+ * \return No return value
+ */
+void mdv_debouncer_bank_take_edges(mdv_debouncer_bank_t *const bank,
+                                   uint32_t const port,
+                                   uint32_t *const rising,
+                                   uint32_t *const falling);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-debouncer */
+
+#endif // ifndef MDV_DEBOUNCER_H
+
+/* EOF */
@@ -0,0 +1,459 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_executor.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-executor-internals Internals
+ * \ingroup  mdv-executor
+ * @{
+ */
+
+/**
+ * \brief Check if a task precedes another one in a heap
+ *
+ * \param[in] a First task
+ * \param[in] b Second task
+ *
+ * \retval true The first task precedes the second one
+ * \retval false The second task precedes the first one
+ */
+static bool is_before(mdv_executor_task_t const *const a,
+                      mdv_executor_task_t const *const b)
+{
+        if (a->key != b->key) {
+                return a->key < b->key;
+        }
+
+        // The sequence numbers of the tasks in a heap are close to each
+        // other, so the difference is valid across the wrap-around
+        return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+/**
+ * \brief Meld two heaps
+ *
+ * \param[in] a Root of the first heap
+ * \param[in] b Root of the second heap
+ *
+ * \return Root of the melded heap
+ */
+static mdv_executor_task_t *meld(mdv_executor_task_t *a,
+                                 mdv_executor_task_t *b)
+{
+        mdv_executor_task_t *swap;
+
+        if (is_before(b, a)) {
+                swap = a;
+                a = b;
+                b = swap;
+        }
+
+        // Link the second root as the leftmost child of the first one
+        b->prev = a;
+        b->sibling = a->child;
+
+        if (a->child) {
+                a->child->prev = b;
+        }
+
+        a->child = b;
+
+        return a;
+}
+
+/**
+ * \brief Meld a list of sibling heaps into one heap
+ *
+ * The siblings are melded in pairs from left to right, and the pairs are
+ * melded into one heap from right to left.
+ *
+ * \param[in] first The leftmost sibling
+ *
+ * \return Root of the melded heap, or null if the list is empty
+ */
+static mdv_executor_task_t *merge_pairs(mdv_executor_task_t *first)
+{
+        mdv_executor_task_t *pairs = 0;
+        mdv_executor_task_t *next;
+
+        // First pass, collecting the pairs into a list in reverse order
+        while (first) {
+                next = first->sibling;
+                first->sibling = 0;
+
+                if (next) {
+                        mdv_executor_task_t *const second = next;
+
+                        next = second->sibling;
+                        second->sibling = 0;
+                        first = meld(first, second);
+                }
+
+                first->sibling = pairs;
+                pairs = first;
+                first = next;
+        }
+
+        if (!pairs) {
+                return 0;
+        }
+
+        // Second pass
+        first = pairs;
+        pairs = pairs->sibling;
+        first->sibling = 0;
+
+        while (pairs) {
+                next = pairs->sibling;
+                pairs->sibling = 0;
+                first = meld(first, pairs);
+                pairs = next;
+        }
+
+        first->prev = 0;
+
+        return first;
+}
+
+/**
+ * \brief Insert a task into a heap
+ *
+ * \param[in] executor Executor in use
+ * \param[in] root Root of the heap
+ * \param[in] task Task to insert, the key set
+ *
+ * \return No return value
+ */
+static void insert_task(mdv_executor_t *const executor,
+                        mdv_executor_task_t **const root,
+                        mdv_executor_task_t *const task)
+{
+        task->child = 0;
+        task->sibling = 0;
+        task->prev = 0;
+        task->sequence = executor->sequence++;
+
+        *root = *root ? meld(*root, task) : task;
+}
+
+/**
+ * \brief Remove the root task of a heap
+ *
+ * \param[in] root Root of a non-empty heap
+ *
+ * \return The removed task
+ */
+static mdv_executor_task_t *pop_task(mdv_executor_task_t **const root)
+{
+        mdv_executor_task_t *const task = *root;
+
+        *root = merge_pairs(task->child);
+        task->child = 0;
+
+        return task;
+}
+
+/**
+ * \brief Remove any task from a heap
+ *
+ * \param[in] root Root of the heap
+ * \param[in] task Task to remove
+ *
+ * \return No return value
+ */
+static void remove_task(mdv_executor_task_t **const root,
+                        mdv_executor_task_t *const task)
+{
+        mdv_executor_task_t *subheap;
+
+        if (task == *root) {
+                pop_task(root);
+                return;
+        }
+
+        // Cut the subtree of the task, and meld its children back
+        if (task->prev->child == task) {
+                task->prev->child = task->sibling;
+        } else {
+                task->prev->sibling = task->sibling;
+        }
+
+        if (task->sibling) {
+                task->sibling->prev = task->prev;
+        }
+
+        task->sibling = 0;
+        task->prev = 0;
+        subheap = merge_pairs(task->child);
+        task->child = 0;
+
+        if (subheap) {
+                *root = meld(*root, subheap);
+        }
+}
+
+/**
+ * \brief Unlink a task from the heap holding it
+ *
+ * \param[in] executor Executor in use
+ * \param[in] task Task to unlink
+ *
+ * \return No return value
+ */
+static void unlink_task(mdv_executor_t *const executor,
+                        mdv_executor_task_t *const task)
+{
+        if (task->state == MDV_EXECUTOR_TASK_PENDING) {
+                remove_task(&(executor->pending), task);
+        } else if (task->state == MDV_EXECUTOR_TASK_READY) {
+                remove_task(&(executor->ready), task);
+        }
+}
+
+/**
+ * \brief Make a task pending until its release time
+ *
+ * \param[in] executor Executor in use
+ * \param[in] task Task in use
+ *
+ * \return No return value
+ */
+static void make_pending(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task)
+{
+        task->key = task->release;
+        task->state = MDV_EXECUTOR_TASK_PENDING;
+        insert_task(executor, &(executor->pending), task);
+}
+
+/**
+ * \brief Release the pending tasks whose release time has been reached
+ *
+ * \param[in] executor Executor in use
+ * \param[in] tick_count Current extended tick count
+ *
+ * \return No return value
+ */
+static void release_tasks(mdv_executor_t *const executor,
+                          uint64_t const tick_count)
+{
+        mdv_executor_task_t *task;
+
+        while (executor->pending && executor->pending->key <= tick_count) {
+                task = pop_task(&(executor->pending));
+                task->key = task->deadline;
+                task->state = MDV_EXECUTOR_TASK_READY;
+                insert_task(executor, &(executor->ready), task);
+        }
+}
+
+/**
+ * \brief Update the execution statistics of a task
+ *
+ * \param[in] task Task in use
+ * \param[in] start Tick count when the task started
+ * \param[in] end Tick count when the task completed
+ * \param[in] deadline Deadline of the run
+ *
+ * \return No return value
+ */
+static void update_stats(mdv_executor_task_t *const task,
+                         uint64_t const start,
+                         uint64_t const end,
+                         uint64_t const deadline)
+{
+        mdv_executor_task_stats_t *const stats = &(task->stats);
+        uint64_t const elapsed = end - start;
+        uint32_t const execution_ticks = elapsed > UINT32_MAX ?
+                                         UINT32_MAX : (uint32_t)elapsed;
+
+        ++stats->run_count;
+        stats->last_execution_ticks = execution_ticks;
+        stats->total_execution_ticks += elapsed;
+
+        if (execution_ticks > stats->max_execution_ticks) {
+                stats->max_execution_ticks = execution_ticks;
+        }
+
+        if (end > deadline) {
+                ++stats->deadline_miss_count;
+        }
+}
+
+/** @} mdv-executor-internals */
+
+void mdv_executor_init(mdv_executor_t *const executor,
+                       mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(executor);
+        assert(sw_timer_base);
+
+        executor->sw_timer_base = sw_timer_base;
+        executor->pending = 0;
+        executor->ready = 0;
+        executor->sequence = 0;
+        executor->idle_hook = 0;
+        executor->idle_user_data = 0;
+}
+
+void mdv_executor_set_idle_hook(mdv_executor_t *const executor,
+                                mdv_executor_idle_hook_t const idle_hook,
+                                void *const user_data)
+{
+        assert(executor);
+
+        executor->idle_hook = idle_hook;
+        executor->idle_user_data = user_data;
+}
+
+void mdv_executor_task_init(mdv_executor_task_t *const task,
+                            mdv_executor_task_function_t const function,
+                            void *const user_data)
+{
+        assert(task);
+        assert(function);
+
+        task->child = 0;
+        task->sibling = 0;
+        task->prev = 0;
+        task->key = 0;
+        task->sequence = 0;
+        task->release = 0;
+        task->deadline = 0;
+        task->relative_deadline = 0;
+        task->period = 0;
+        task->function = function;
+        task->user_data = user_data;
+        task->state = MDV_EXECUTOR_TASK_IDLE;
+        task->stats.run_count = 0;
+        task->stats.deadline_miss_count = 0;
+        task->stats.last_execution_ticks = 0;
+        task->stats.max_execution_ticks = 0;
+        task->stats.total_execution_ticks = 0;
+}
+
+void mdv_executor_submit(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task,
+                         uint32_t const release_delay_ticks,
+                         uint32_t const relative_deadline_ticks,
+                         uint32_t const period_ticks)
+{
+        assert(executor);
+        assert(task);
+
+        unlink_task(executor, task);
+
+        task->release = mdv_sw_timer_base_get_tick_count64(
+                executor->sw_timer_base) + release_delay_ticks;
+        task->deadline = task->release + relative_deadline_ticks;
+        task->relative_deadline = relative_deadline_ticks;
+        task->period = period_ticks;
+        make_pending(executor, task);
+}
+
+void mdv_executor_cancel(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task)
+{
+        assert(executor);
+        assert(task);
+
+        unlink_task(executor, task);
+        task->state = MDV_EXECUTOR_TASK_IDLE;
+}
+
+mdv_executor_task_state_t mdv_executor_task_get_state(
+        mdv_executor_task_t *const task)
+{
+        assert(task);
+
+        return task->state;
+}
+
+mdv_executor_task_stats_t const *mdv_executor_task_get_stats(
+        mdv_executor_task_t *const task)
+{
+        assert(task);
+
+        return &(task->stats);
+}
+
+bool mdv_executor_run_once(mdv_executor_t *const executor)
+{
+        mdv_executor_task_t *task;
+        uint64_t start;
+        uint64_t end;
+        uint64_t deadline;
+
+        assert(executor);
+
+        start = mdv_sw_timer_base_get_tick_count64(executor->sw_timer_base);
+        release_tasks(executor, start);
+
+        if (!executor->ready) {
+                if (executor->idle_hook) {
+                        executor->idle_hook(executor->idle_user_data,
+                                            executor->pending ?
+                                            executor->pending->key - start :
+                                            MDV_EXECUTOR_NO_RELEASE);
+                }
+
+                return false;
+        }
+
+        task = pop_task(&(executor->ready));
+        task->state = MDV_EXECUTOR_TASK_RUNNING;
+        // The task function may submit the task again with a new deadline
+        deadline = task->deadline;
+        task->function(executor, task, task->user_data);
+
+        end = mdv_sw_timer_base_get_tick_count64(executor->sw_timer_base);
+        update_stats(task, start, end, deadline);
+
+        // The task function didn't submit or cancel the task
+        if (task->state == MDV_EXECUTOR_TASK_RUNNING) {
+                if (task->period) {
+                        task->release += task->period;
+                        task->deadline = task->release +
+                                         task->relative_deadline;
+                        make_pending(executor, task);
+                } else {
+                        task->state = MDV_EXECUTOR_TASK_IDLE;
+                }
+        }
+
+        return true;
+}
+
+/* EOF */
@@ -0,0 +1,313 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_EXECUTOR_H
+#define MDV_EXECUTOR_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_executor.h
+ * \defgroup   mdv-executor Earliest deadline first executor
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * The executor runs cooperative run-to-completion tasks on one software timer
+ * base, earliest deadline first. Each task is submitted with a release time
+ * and a relative deadline, and optionally with a period. A task becomes ready
+ * when the release time is reached, and of the ready tasks, the one with the
+ * earliest absolute deadline runs next. Tasks with equal deadlines run in the
+ * order they became ready.
+ *
+ * The tasks are owned by the caller, and the executor links them into two
+ * intrusive pairing heaps: one ordered by the release time for the pending
+ * tasks, and one ordered by the deadline for the ready tasks. Submitting a
+ * task is a constant time operation, and picking the next task takes
+ * amortized O(log n) time, so the cost per iteration doesn't grow with the
+ * number of tasks like polling each task does. No memory is allocated.
+ *
+ * The time is the extended tick count of the timer base, so the release times
+ * and the deadlines don't wrap around. For each task, the executor records the
+ * execution time and the count of deadline misses. A deadline is missed when
+ * the task completes after its deadline.
+ *
+ * The application calls \ref mdv_executor_run_once from the main loop. When
+ * no task is ready, the executor calls the idle hook with the ticks until the
+ * next release, so the hook can put the processor to sleep through the idle
+ * gap instead of spinning, for example by waiting for the interrupt of a
+ * tickless timer base.
+ *
+ * @{
+ */
+
+/// Idle time reported to the idle hook when no tasks are pending
+#define MDV_EXECUTOR_NO_RELEASE UINT64_MAX
+
+struct _mdv_executor_t;
+struct _mdv_executor_task_t;
+
+/**
+ * \brief Task function type
+ *
+ * The function runs to completion. It may submit or cancel any task,
+ * including itself.
+ *
+ * \param[in] executor Executor running the task
+ * \param[in] task The running task
+ * \param[in] user_data User data given when the task was initialized
+ *
+ * \return No return value
+ */
+typedef void (*mdv_executor_task_function_t)(
+        struct _mdv_executor_t *const executor,
+        struct _mdv_executor_task_t *const task,
+        void *const user_data);
+
+/**
+ * \brief Idle hook function type
+ *
+ * \param[in] user_data User data given when the hook was set
+ * \param[in] idle_ticks Ticks until the next task is released, or
+ *      \ref MDV_EXECUTOR_NO_RELEASE if no tasks are pending
+ *
+ * \return No return value
+ */
+typedef void (*mdv_executor_idle_hook_t)(void *const user_data,
+                                         uint64_t const idle_ticks);
+
+/**
+ * \brief Task state
+ */
+typedef enum _mdv_executor_task_state_t{
+        /// The task is not submitted
+        MDV_EXECUTOR_TASK_IDLE = 0,
+        /// The task waits for its release time
+        MDV_EXECUTOR_TASK_PENDING,
+        /// The task is released and waits to run
+        MDV_EXECUTOR_TASK_READY,
+        /// The task is running
+        MDV_EXECUTOR_TASK_RUNNING
+} mdv_executor_task_state_t;
+
+/**
+ * \brief Execution statistics of a task
+ */
+typedef struct _mdv_executor_task_stats_t{
+        /// Count of completed runs
+        uint32_t run_count;
+        /// Count of runs completed after the deadline
+        uint32_t deadline_miss_count;
+        /// Execution time of the latest run in ticks
+        uint32_t last_execution_ticks;
+        /// Longest execution time in ticks
+        uint32_t max_execution_ticks;
+        /// Total execution time in ticks
+        uint64_t total_execution_ticks;
+} mdv_executor_task_stats_t;
+
+/**
+ * \brief Executor task
+ *
+ * The task is owned by the caller and linked into the executor while
+ * submitted. The fields are internal to the executor.
+ */
+typedef struct _mdv_executor_task_t{
+        /// Leftmost child in the heap
+        struct _mdv_executor_task_t *child;
+        /// Next sibling in the heap
+        struct _mdv_executor_task_t *sibling;
+        /// Parent if this is the leftmost child, otherwise the previous
+        /// sibling (null for the root)
+        struct _mdv_executor_task_t *prev;
+        /// Heap key: the release time when pending, the deadline when ready
+        uint64_t key;
+        /// Order of insertion, breaks the ties of equal keys
+        uint32_t sequence;
+        /// Release time as an extended tick count
+        uint64_t release;
+        /// Absolute deadline as an extended tick count
+        uint64_t deadline;
+        /// Relative deadline in ticks
+        uint32_t relative_deadline;
+        /// Period in ticks (zero for a one-shot task)
+        uint32_t period;
+        /// Task function
+        mdv_executor_task_function_t function;
+        /// User data passed to the task function
+        void *user_data;
+        /// Task state
+        mdv_executor_task_state_t state;
+        /// Execution statistics
+        mdv_executor_task_stats_t stats;
+} mdv_executor_task_t;
+
+/**
+ * \brief Executor instance data
+ */
+typedef struct _mdv_executor_t{
+        /// Timer base on which this executor runs
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Root of the heap of the pending tasks
+        mdv_executor_task_t *pending;
+        /// Root of the heap of the ready tasks
+        mdv_executor_task_t *ready;
+        /// Sequence number of the next heap insertion
+        uint32_t sequence;
+        /// Idle hook (null if not used)
+        mdv_executor_idle_hook_t idle_hook;
+        /// User data passed to the idle hook
+        void *idle_user_data;
+} mdv_executor_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize an executor
+ *
+ * \param[in] executor Executor to initialize
+ * \param[in] sw_timer_base Timer base which this executor will use
+ *
+ * \return No return value
+ */
+void mdv_executor_init(mdv_executor_t *const executor,
+                       mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Set the idle hook
+ *
+ * \param[in] executor Executor in use
+ * \param[in] idle_hook Hook to call when no task is ready, or null
+ * \param[in] user_data User data passed to the hook
+ *
+ * \return No return value
+ */
+void mdv_executor_set_idle_hook(mdv_executor_t *const executor,
+                                mdv_executor_idle_hook_t const idle_hook,
+                                void *const user_data);
+
+/**
+ * \brief Initialize a task
+ *
+ * \param[in] task Task to initialize
+ * \param[in] function Task function
+ * \param[in] user_data User data passed to the task function
+ *
+ * \return No return value
+ */
+void mdv_executor_task_init(mdv_executor_task_t *const task,
+                            mdv_executor_task_function_t const function,
+                            void *const user_data);
+
+/**
+ * \brief Submit a task
+ *
+ * If the task is already submitted, it is submitted again with the new
+ * parameters. A periodic task is released again one period after each
+ * release, so the releases don't drift by the execution latency. If a
+ * periodic task overruns its period, the next release is already due when
+ * the task completes.
+ *
+ * \param[in] executor Executor in use
+ * \param[in] task Task to submit
+ * \param[in] release_delay_ticks Delay from the current tick count to the
+ *      release time
+ * \param[in] relative_deadline_ticks Deadline relative to the release time
+ * \param[in] period_ticks Period in ticks for a periodic task, or zero for a
+ *      one-shot task
+ *
+ * \return No return value
+ */
+void mdv_executor_submit(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task,
+                         uint32_t const release_delay_ticks,
+                         uint32_t const relative_deadline_ticks,
+                         uint32_t const period_ticks);
+
+/**
+ * \brief Cancel a task
+ *
+ * Cancelling a task which is not submitted has no effect. A periodic task
+ * cancelled from its own task function is not released again.
+ *
+ * \param[in] executor Executor in use
+ * \param[in] task Task to cancel
+ *
+ * \return No return value
+ */
+void mdv_executor_cancel(mdv_executor_t *const executor,
+                         mdv_executor_task_t *const task);
+
+/**
+ * \brief Get the state of a task
+ *
+ * \param[in] task Task in use
+ *
+ * \return The task state
+ */
+mdv_executor_task_state_t mdv_executor_task_get_state(
+        mdv_executor_task_t *const task);
+
+/**
+ * \brief Get the execution statistics of a task
+ *
+ * \param[in] task Task in use
+ *
+ * \return The statistics
+ */
+mdv_executor_task_stats_t const *mdv_executor_task_get_stats(
+        mdv_executor_task_t *const task);
+
+/**
+ * \brief Run the next task
+ *
+ * Releases the tasks whose release time has been reached, and runs the ready
+ * task with the earliest deadline. If no task is ready, calls the idle hook.
+ *
+ * \param[in] executor Executor in use
+ *
+ * \retval true A task was run
+ * \retval false No task was ready
+ */
+bool mdv_executor_run_once(mdv_executor_t *const executor);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-executor */
+
+#endif // ifndef MDV_EXECUTOR_H
+
+/* EOF */
@@ -0,0 +1,332 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_histogram.h"
+#include "mdv_atomic.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-histogram-internals Internals
+ * \ingroup  mdv-histogram
+ * @{
+ */
+
+/// Number of buckets of the linear range, and sub-buckets of each power of two
+#define SUB_BUCKETS (1u << MDV_HISTOGRAM_SUB_BUCKET_BITS)
+
+/**
+ * \brief Lower the minimum of a histogram
+ *
+ * \param[in] histogram Histogram in use
+ * \param[in] ticks Value in ticks
+ *
+ * \return No return value
+ */
+static void update_min(mdv_histogram_t *const histogram, uint32_t const ticks)
+{
+        uint32_t current = mdv_atomic_load_relaxed_u32(&(histogram->min));
+
+        while ((ticks < current) &&
+               !mdv_atomic_compare_exchange_u32(&(histogram->min), &current,
+                                                ticks)) {
+        }
+}
+
+/**
+ * \brief Raise the maximum of a histogram
+ *
+ * \param[in] histogram Histogram in use
+ * \param[in] ticks Value in ticks
+ *
+ * \return No return value
+ */
+static void update_max(mdv_histogram_t *const histogram, uint32_t const ticks)
+{
+        uint32_t current = mdv_atomic_load_relaxed_u32(&(histogram->max));
+
+        while ((ticks > current) &&
+               !mdv_atomic_compare_exchange_u32(&(histogram->max), &current,
+                                                ticks)) {
+        }
+}
+
+/**
+ * \brief Get the index of the most significant set bit
+ *
+ * \param[in] value Value, not zero
+ *
+ * \return Index of the bit
+ */
+static uint32_t get_msb(uint32_t const value)
+{
+#if defined(__GNUC__)
+        return 31u - (uint32_t)__builtin_clz(value);
+#else
+        uint32_t shifted = value;
+        uint32_t msb = 0;
+
+        while (shifted >>= 1u) {
+                ++msb;
+        }
+
+        return msb;
+#endif // if defined(__GNUC__)
+}
+
+/** @} mdv-histogram-internals */
+
+void mdv_histogram_init(mdv_histogram_t *const histogram)
+{
+        uint32_t i;
+
+        assert(histogram);
+
+        histogram->min = UINT32_MAX;
+        histogram->max = 0;
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                histogram->counts[i] = 0;
+        }
+}
+
+void mdv_histogram_record(mdv_histogram_t *const histogram,
+                          uint32_t const ticks)
+{
+        assert(histogram);
+
+        // The limits are updated before the count, so that a reader acquiring
+        // the count sees the value within the limits
+        update_min(histogram, ticks);
+        update_max(histogram, ticks);
+        mdv_atomic_fetch_add_u32(
+                &(histogram->counts[mdv_histogram_get_bucket(ticks)]), 1u);
+}
+
+uint32_t mdv_histogram_record_elapsed(mdv_histogram_t *const histogram,
+                                      mdv_sw_timer_base_t *const sw_timer_base,
+                                      uint32_t const start)
+{
+        uint32_t ticks;
+
+        assert(histogram);
+        assert(sw_timer_base);
+
+        ticks = (mdv_sw_timer_base_get_tick_count(sw_timer_base) - start) &
+                mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        mdv_histogram_record(histogram, ticks);
+
+        return ticks;
+}
+
+void mdv_histogram_snapshot(mdv_histogram_t *const source,
+                            mdv_histogram_t *const snapshot)
+{
+        uint32_t i;
+
+        assert(source);
+        assert(snapshot);
+        assert(source != snapshot);
+
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                snapshot->counts[i] =
+                        mdv_atomic_load_acquire_u32(&(source->counts[i]));
+        }
+        snapshot->min = mdv_atomic_load_relaxed_u32(&(source->min));
+        snapshot->max = mdv_atomic_load_relaxed_u32(&(source->max));
+}
+
+void mdv_histogram_merge(mdv_histogram_t *const destination,
+                         mdv_histogram_t *const source)
+{
+        uint32_t i;
+        uint32_t count;
+
+        assert(destination);
+        assert(source);
+        assert(destination != source);
+
+        update_min(destination, mdv_atomic_load_relaxed_u32(&(source->min)));
+        update_max(destination, mdv_atomic_load_relaxed_u32(&(source->max)));
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                count = mdv_atomic_load_acquire_u32(&(source->counts[i]));
+                if (count) {
+                        mdv_atomic_fetch_add_u32(&(destination->counts[i]),
+                                                 count);
+                }
+        }
+}
+
+void mdv_histogram_drain(mdv_histogram_t *const destination,
+                         mdv_histogram_t *const source)
+{
+        uint32_t i;
+        uint32_t count;
+
+        assert(destination);
+        assert(source);
+        assert(destination != source);
+
+        update_min(destination, mdv_atomic_load_relaxed_u32(&(source->min)));
+        update_max(destination, mdv_atomic_load_relaxed_u32(&(source->max)));
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                count = mdv_atomic_load_relaxed_u32(&(source->counts[i]));
+                while (count &&
+                       !mdv_atomic_compare_exchange_u32(&(source->counts[i]),
+                                                        &count, 0)) {
+                }
+                if (count) {
+                        mdv_atomic_fetch_add_u32(&(destination->counts[i]),
+                                                 count);
+                }
+        }
+}
+
+uint64_t mdv_histogram_get_count(mdv_histogram_t *const histogram)
+{
+        uint64_t total = 0;
+        uint32_t i;
+
+        assert(histogram);
+
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                total += mdv_atomic_load_relaxed_u32(&(histogram->counts[i]));
+        }
+
+        return total;
+}
+
+uint32_t mdv_histogram_get_value_at_quantile(mdv_histogram_t *const histogram,
+                                             uint32_t const quantile_ppm)
+{
+        uint32_t counts[MDV_HISTOGRAM_BUCKETS];
+        uint64_t total = 0;
+        uint64_t rank;
+        uint64_t cumulative = 0;
+        uint32_t min;
+        uint32_t max;
+        uint32_t value;
+        uint32_t i;
+
+        assert(histogram);
+        assert(quantile_ppm <= MDV_HISTOGRAM_PPM);
+
+        // Take the counts once, so that the rank and the search agree also
+        // while the histogram is recorded
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                counts[i] = mdv_atomic_load_acquire_u32(
+                        &(histogram->counts[i]));
+                total += counts[i];
+        }
+        if (!total) {
+                return 0;
+        }
+        min = mdv_atomic_load_relaxed_u32(&(histogram->min));
+        max = mdv_atomic_load_relaxed_u32(&(histogram->max));
+
+        rank = (total * quantile_ppm + MDV_HISTOGRAM_PPM - 1u) /
+               MDV_HISTOGRAM_PPM;
+        if (!rank) {
+                rank = 1u;
+        }
+        for (i = 0; i < MDV_HISTOGRAM_BUCKETS - 1u; ++i) {
+                cumulative += counts[i];
+                if (cumulative >= rank) {
+                        break;
+                }
+        }
+
+        value = mdv_histogram_get_bucket_highest(i);
+        if (value > max) {
+                value = max;
+        }
+        if (value < min) {
+                value = min;
+        }
+
+        return value;
+}
+
+uint32_t mdv_histogram_get_bucket(uint32_t const ticks)
+{
+        uint32_t msb;
+
+#if MDV_HISTOGRAM_VALUE_BITS < 32
+        if (ticks >> MDV_HISTOGRAM_VALUE_BITS) {
+                return MDV_HISTOGRAM_BUCKETS - 1u;
+        }
+#endif // if MDV_HISTOGRAM_VALUE_BITS < 32
+        if (ticks < SUB_BUCKETS) {
+                return ticks;
+        }
+
+        // The power of two selects the group of sub-buckets, and the bits
+        // below the most significant one select the sub-bucket in it
+        msb = get_msb(ticks);
+
+        return ((msb - MDV_HISTOGRAM_SUB_BUCKET_BITS + 1u) <<
+                MDV_HISTOGRAM_SUB_BUCKET_BITS) +
+               (ticks >> (msb - MDV_HISTOGRAM_SUB_BUCKET_BITS)) - SUB_BUCKETS;
+}
+
+uint32_t mdv_histogram_get_bucket_lowest(uint32_t const index)
+{
+        uint32_t group;
+
+        assert(index < MDV_HISTOGRAM_BUCKETS);
+
+        if (index < SUB_BUCKETS) {
+                return index;
+        }
+        group = index >> MDV_HISTOGRAM_SUB_BUCKET_BITS;
+
+        return (SUB_BUCKETS + (index & (SUB_BUCKETS - 1u))) << (group - 1u);
+}
+
+uint32_t mdv_histogram_get_bucket_highest(uint32_t const index)
+{
+        uint32_t group;
+
+        assert(index < MDV_HISTOGRAM_BUCKETS);
+
+        if (index < SUB_BUCKETS) {
+                return index;
+        }
+        if (index == MDV_HISTOGRAM_BUCKETS - 1u) {
+                return UINT32_MAX;
+        }
+        group = index >> MDV_HISTOGRAM_SUB_BUCKET_BITS;
+
+        return mdv_histogram_get_bucket_lowest(index) +
+               ((1u << (group - 1u)) - 1u);
+}
+
+/* EOF */
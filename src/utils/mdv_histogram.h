@@ -0,0 +1,253 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_HISTOGRAM_H
+#define MDV_HISTOGRAM_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_histogram.h
+ * \defgroup   mdv-histogram Latency histogram
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * A fixed-size log-linear histogram of tick counts, in the style of the HDR
+ * histogram. The values below 2^MDV_HISTOGRAM_SUB_BUCKET_BITS ticks have a
+ * bucket each. Above that, each power of two range is divided into
+ * 2^MDV_HISTOGRAM_SUB_BUCKET_BITS linear sub-buckets, so the relative error
+ * of a value is at most 2^-MDV_HISTOGRAM_SUB_BUCKET_BITS over the whole
+ * range. The histogram keeps the exact minimum and maximum as well.
+ *
+ * Recording a value is a constant time operation: a leading zero count, a
+ * shift and an atomic increment of the bucket. The values are recorded in
+ * ticks, and converted to time only when reported, for example with
+ * \ref mdv_sw_timer_conversion_get_time.
+ *
+ * Any number of contexts can record to the same histogram concurrently
+ * without locks. \ref mdv_histogram_snapshot copies a live histogram,
+ * \ref mdv_histogram_merge adds one histogram to another, and
+ * \ref mdv_histogram_drain moves the counts of a live histogram to another,
+ * so that no concurrently recorded value is lost. This way, per-thread or
+ * per-interrupt histograms can be aggregated without stopping the recording.
+ * The totals and the quantiles are computed from the bucket counts, so they
+ * are consistent with each other also for a copy taken during recording.
+ *
+ * The bucket counts are 32 bits and wrap around after 2^32 values per
+ * bucket.
+ *
+ * @{
+ */
+
+#ifndef MDV_HISTOGRAM_SUB_BUCKET_BITS
+/// Number of bits in the linear part of a bucket index (1 to 8)
+#define MDV_HISTOGRAM_SUB_BUCKET_BITS 4u
+#endif // ifndef MDV_HISTOGRAM_SUB_BUCKET_BITS
+
+#ifndef MDV_HISTOGRAM_VALUE_BITS
+/// Number of bits in the largest value with a bucket of its own. Larger
+/// values are counted in the last bucket.
+#define MDV_HISTOGRAM_VALUE_BITS 32u
+#endif // ifndef MDV_HISTOGRAM_VALUE_BITS
+
+#if (MDV_HISTOGRAM_SUB_BUCKET_BITS < 1) || (MDV_HISTOGRAM_SUB_BUCKET_BITS > 8)
+#error "MDV_HISTOGRAM_SUB_BUCKET_BITS must be from 1 to 8"
+#endif
+
+#if (MDV_HISTOGRAM_VALUE_BITS < MDV_HISTOGRAM_SUB_BUCKET_BITS) || \
+    (MDV_HISTOGRAM_VALUE_BITS > 32)
+#error "MDV_HISTOGRAM_VALUE_BITS must be from MDV_HISTOGRAM_SUB_BUCKET_BITS to 32"
+#endif
+
+/// Number of buckets in a histogram
+#define MDV_HISTOGRAM_BUCKETS \
+        ((MDV_HISTOGRAM_VALUE_BITS + 1u - MDV_HISTOGRAM_SUB_BUCKET_BITS) << \
+         MDV_HISTOGRAM_SUB_BUCKET_BITS)
+
+/// One million, the scale of the quantiles
+#define MDV_HISTOGRAM_PPM 1000000u
+
+/**
+ * \brief Histogram data
+ */
+typedef struct _mdv_histogram_t{
+        /// Smallest recorded value (UINT32_MAX when empty)
+        uint32_t min;
+        /// Largest recorded value
+        uint32_t max;
+        /// Counts of the recorded values per bucket
+        uint32_t counts[MDV_HISTOGRAM_BUCKETS];
+} mdv_histogram_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize an empty histogram
+ *
+ * \param[in] histogram Histogram to initialize
+ *
+ * \return No return value
+ */
+void mdv_histogram_init(mdv_histogram_t *const histogram);
+
+/**
+ * \brief Record a value
+ *
+ * \param[in] histogram Histogram in use
+ * \param[in] ticks Value in ticks
+ *
+ * \return No return value
+ */
+void mdv_histogram_record(mdv_histogram_t *const histogram,
+                          uint32_t const ticks);
+
+/**
+ * \brief Record the ticks elapsed from a tick count
+ *
+ * \param[in] histogram Histogram in use
+ * \param[in] sw_timer_base Timer base in use
+ * \param[in] start Tick count of the timer base at the start
+ *
+ * \return The recorded value in ticks
+ */
+uint32_t mdv_histogram_record_elapsed(mdv_histogram_t *const histogram,
+                                      mdv_sw_timer_base_t *const sw_timer_base,
+                                      uint32_t const start);
+
+/**
+ * \brief Copy a histogram
+ *
+ * The source can be recorded concurrently. The destination must not be
+ * accessed concurrently.
+ *
+ * \param[in] source Histogram to copy
+ * \param[out] snapshot Copy of the histogram
+ *
+ * \return No return value
+ */
+void mdv_histogram_snapshot(mdv_histogram_t *const source,
+                            mdv_histogram_t *const snapshot);
+
+/**
+ * \brief Add a histogram to another one
+ *
+ * Both histograms can be recorded concurrently.
+ *
+ * \param[in] destination Histogram to add to
+ * \param[in] source Histogram to add
+ *
+ * \return No return value
+ */
+void mdv_histogram_merge(mdv_histogram_t *const destination,
+                         mdv_histogram_t *const source);
+
+/**
+ * \brief Move the counts of a histogram to another one
+ *
+ * Each bucket of the source is emptied atomically, and its count is added to
+ * the destination, so a value recorded concurrently to the source ends up in
+ * exactly one of them. The minimum and the maximum of the source are merged
+ * to the destination, but they are not reset, because they can't be reset
+ * atomically with the buckets.
+ *
+ * \param[in] destination Histogram to add to
+ * \param[in] source Histogram to empty
+ *
+ * \return No return value
+ */
+void mdv_histogram_drain(mdv_histogram_t *const destination,
+                         mdv_histogram_t *const source);
+
+/**
+ * \brief Get the count of the recorded values
+ *
+ * \param[in] histogram Histogram in use
+ *
+ * \return The sum of the bucket counts
+ */
+uint64_t mdv_histogram_get_count(mdv_histogram_t *const histogram);
+
+/**
+ * \brief Get the value at a quantile
+ *
+ * The result is the largest value of the bucket holding the quantile, limited
+ * to the recorded minimum and maximum, so it is at most the relative error of
+ * the buckets above the exact value.
+ *
+ * \param[in] histogram Histogram in use
+ * \param[in] quantile_ppm Quantile in parts per million, for example 990000
+ *      for the 99th percentile, and \ref MDV_HISTOGRAM_PPM for the maximum
+ *
+ * \return Value in ticks, or zero if the histogram is empty
+ */
+uint32_t mdv_histogram_get_value_at_quantile(mdv_histogram_t *const histogram,
+                                             uint32_t const quantile_ppm);
+
+/**
+ * \brief Get the bucket of a value
+ *
+ * \param[in] ticks Value in ticks
+ *
+ * \return Index of the bucket
+ */
+uint32_t mdv_histogram_get_bucket(uint32_t const ticks);
+
+/**
+ * \brief Get the smallest value of a bucket
+ *
+ * \param[in] index Index of the bucket
+ *
+ * \return The smallest value in ticks counted in the bucket
+ */
+uint32_t mdv_histogram_get_bucket_lowest(uint32_t const index);
+
+/**
+ * \brief Get the largest value of a bucket
+ *
+ * \param[in] index Index of the bucket
+ *
+ * \return The largest value in ticks counted in the bucket
+ */
+uint32_t mdv_histogram_get_bucket_highest(uint32_t const index);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-histogram */
+
+#endif // ifndef MDV_HISTOGRAM_H
+
+/* EOF */
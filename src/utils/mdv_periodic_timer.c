@@ -0,0 +1,254 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_periodic_timer.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-periodic-timer-internals Internals
+ * \ingroup  mdv-periodic-timer
+ * @{
+ */
+
+/**
+ * \brief Move the deadline forward by the given count of periods
+ *
+ * \param[in] timer Timer in use
+ * \param[in] period_count Count of periods
+ *
+ * \return No return value
+ */
+static void advance_deadline(mdv_periodic_timer_t *const timer,
+                             uint32_t const period_count)
+{
+        // Neither product nor the sum can exceed 64 bits, because the
+        // remainders are less than the 32-bit denominator
+        uint64_t const remainder = (uint64_t)timer->deadline_remainder +
+                                   (uint64_t)period_count *
+                                   timer->period_remainder;
+
+        timer->deadline += (uint64_t)period_count * timer->period_ticks +
+                           remainder / timer->period_denominator;
+        timer->deadline_remainder =
+                (uint32_t)(remainder % timer->period_denominator);
+}
+
+/**
+ * \brief Skip over all due periods
+ *
+ * \param[in] timer Timer in use
+ * \param[in] tick_count Current extended tick count
+ *
+ * \return Count of the due periods
+ */
+static uint64_t skip_due_periods(mdv_periodic_timer_t *const timer,
+                                 uint64_t const tick_count)
+{
+        uint64_t period_count = 0;
+        uint64_t step;
+
+        while (timer->deadline <= tick_count) {
+                // A period is shorter than period_ticks + 1, so at least this
+                // many periods are due. Each round leaves less than one
+                // period_ticks + 1:th of the remaining ticks, so the loop
+                // takes a few rounds even after a long overrun.
+                step = (tick_count - timer->deadline) /
+                       ((uint64_t)timer->period_ticks + 1u);
+
+                if (step > UINT32_MAX) {
+                        step = UINT32_MAX;
+                } else if (!step) {
+                        step = 1u;
+                }
+
+                advance_deadline(timer, (uint32_t)step);
+                period_count += step;
+        }
+
+        return period_count;
+}
+
+/**
+ * \brief Add missed periods to the missed count
+ *
+ * \param[in] timer Timer in use
+ * \param[in] missed_count Count of the missed periods
+ *
+ * \return Count of the missed periods saturated to 32 bits
+ */
+static uint32_t add_missed_count(mdv_periodic_timer_t *const timer,
+                                 uint64_t const missed_count)
+{
+        uint32_t const count = missed_count > UINT32_MAX ?
+                               UINT32_MAX : (uint32_t)missed_count;
+
+        timer->missed_count = count > UINT32_MAX - timer->missed_count ?
+                              UINT32_MAX : timer->missed_count + count;
+
+        return count;
+}
+
+/** @} mdv-periodic-timer-internals */
+
+void mdv_periodic_timer_init(mdv_periodic_timer_t *const timer,
+                             mdv_sw_timer_base_t *const sw_timer_base,
+                             uint32_t const period_ticks,
+                             mdv_periodic_timer_policy_t const policy,
+                             mdv_periodic_timer_callback_t const callback,
+                             void *const user_data)
+{
+        mdv_periodic_timer_init_fraction(timer, sw_timer_base, period_ticks,
+                                         1u, policy, callback, user_data);
+}
+
+void mdv_periodic_timer_init_fraction(
+        mdv_periodic_timer_t *const timer,
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const numerator,
+        uint32_t const denominator,
+        mdv_periodic_timer_policy_t const policy,
+        mdv_periodic_timer_callback_t const callback,
+        void *const user_data)
+{
+        assert(timer);
+        assert(sw_timer_base);
+        assert(denominator > 0);
+        assert(numerator >= denominator);
+        assert(policy == MDV_PERIODIC_TIMER_SKIP ||
+               policy == MDV_PERIODIC_TIMER_BURST ||
+               policy == MDV_PERIODIC_TIMER_COALESCE);
+        assert(callback);
+
+        timer->sw_timer_base = sw_timer_base;
+        timer->deadline = 0;
+        timer->deadline_remainder = 0;
+        timer->period_ticks = numerator / denominator;
+        timer->period_remainder = numerator % denominator;
+        timer->period_denominator = denominator;
+        timer->missed_count = 0;
+        timer->policy = policy;
+        timer->callback = callback;
+        timer->user_data = user_data;
+        timer->is_running = false;
+}
+
+void mdv_periodic_timer_start(mdv_periodic_timer_t *const timer)
+{
+        assert(timer);
+
+        timer->deadline =
+                mdv_sw_timer_base_get_tick_count64(timer->sw_timer_base);
+        timer->deadline_remainder = 0;
+        advance_deadline(timer, 1u);
+        timer->missed_count = 0;
+        timer->is_running = true;
+}
+
+void mdv_periodic_timer_stop(mdv_periodic_timer_t *const timer)
+{
+        assert(timer);
+
+        timer->is_running = false;
+}
+
+bool mdv_periodic_timer_is_running(mdv_periodic_timer_t *const timer)
+{
+        assert(timer);
+
+        return timer->is_running;
+}
+
+uint32_t mdv_periodic_timer_process(mdv_periodic_timer_t *const timer)
+{
+        uint64_t tick_count;
+        uint64_t period_count;
+        uint32_t missed_count;
+        uint32_t call_count = 0;
+
+        assert(timer);
+
+        if (!timer->is_running) {
+                return 0;
+        }
+
+        tick_count = mdv_sw_timer_base_get_tick_count64(timer->sw_timer_base);
+
+        if (timer->deadline > tick_count) {
+                return 0;
+        }
+
+        if (timer->policy == MDV_PERIODIC_TIMER_BURST) {
+                // Call once per due period. The periods after the first one
+                // are late. The callback may stop or restart the timer, which
+                // ends the burst.
+                while (timer->is_running && timer->deadline <= tick_count) {
+                        advance_deadline(timer, 1u);
+
+                        if (call_count) {
+                                add_missed_count(timer, 1u);
+                        }
+
+                        timer->callback(timer, 0, timer->user_data);
+                        ++call_count;
+                }
+
+                return call_count;
+        }
+
+        period_count = skip_due_periods(timer, tick_count);
+        missed_count = add_missed_count(timer, period_count - 1u);
+
+        timer->callback(timer,
+                        timer->policy == MDV_PERIODIC_TIMER_COALESCE ?
+                        missed_count : 0,
+                        timer->user_data);
+
+        return 1u;
+}
+
+uint32_t mdv_periodic_timer_get_missed_count(
+        mdv_periodic_timer_t *const timer)
+{
+        assert(timer);
+
+        return timer->missed_count;
+}
+
+uint64_t mdv_periodic_timer_get_deadline64(mdv_periodic_timer_t *const timer)
+{
+        assert(timer);
+
+        return timer->deadline;
+}
+
+/* EOF */
@@ -0,0 +1,261 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_PERIODIC_TIMER_H
+#define MDV_PERIODIC_TIMER_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_periodic_timer.h
+ * \defgroup   mdv-periodic-timer Periodic timer
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * A periodic timer calls its callback once per period. The deadlines are
+ * absolute extended tick counts of the timer base: each deadline is the
+ * previous deadline plus one period, not the time of the callback plus one
+ * period, so the latency of polling the timer doesn't accumulate as drift.
+ *
+ * The period is given in whole ticks, or with
+ * \ref mdv_periodic_timer_init_fraction as a fraction of ticks. The fraction
+ * is accumulated exactly, so for example a 1 kHz loop on a 32.768 kHz counter
+ * (32768/1000 ticks per period) runs exactly 1000 periods per 32768 ticks in
+ * the long term. A deadline with a fractional part is due on the tick where
+ * its whole part is reached.
+ *
+ * The timer is processed by calling \ref mdv_periodic_timer_process from the
+ * main loop. If more than one period has become due since the previous call,
+ * the timer has overrun, and the overrun policy selects what happens to the
+ * missed periods:
+ *
+ * - \ref MDV_PERIODIC_TIMER_SKIP calls the callback once. The missed periods
+ *   are dropped and the next deadline stays in phase with the original ones.
+ * - \ref MDV_PERIODIC_TIMER_BURST calls the callback once for each due period
+ *   to catch up with the schedule.
+ * - \ref MDV_PERIODIC_TIMER_COALESCE calls the callback once, and gives it the
+ *   count of the missed periods, so the callback can account for them at
+ *   once. The next deadline stays in phase.
+ *
+ * With all policies, the missed periods are counted, see
+ * \ref mdv_periodic_timer_get_missed_count.
+ *
+ * @{
+ */
+
+/**
+ * \brief Overrun policy of a periodic timer
+ */
+typedef enum _mdv_periodic_timer_policy_t{
+        /// Call the callback once, drop the missed periods
+        MDV_PERIODIC_TIMER_SKIP = 0,
+        /// Call the callback once for each due period
+        MDV_PERIODIC_TIMER_BURST,
+        /// Call the callback once with the count of the missed periods
+        MDV_PERIODIC_TIMER_COALESCE
+} mdv_periodic_timer_policy_t;
+
+struct _mdv_periodic_timer_t;
+
+/**
+ * \brief Periodic timer callback function type
+ *
+ * The callback is called after the timer has been scheduled for the next
+ * period, so the callback is free to stop or restart the timer.
+ *
+ * \param[in] timer The expired timer
+ * \param[in] missed_count Count of the missed periods covered by this call
+ *      with \ref MDV_PERIODIC_TIMER_COALESCE, otherwise zero
+ * \param[in] user_data User data given when the timer was initialized
+ *
+ * \return No return value
+ */
+typedef void (*mdv_periodic_timer_callback_t)(
+        struct _mdv_periodic_timer_t *const timer,
+        uint32_t const missed_count,
+        void *const user_data);
+
+/**
+ * \brief Periodic timer data
+ */
+typedef struct _mdv_periodic_timer_t{
+        /// Timer base on which this timer runs
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Whole part of the next deadline as an extended tick count
+        uint64_t deadline;
+        /// Fractional part of the next deadline in units of the denominator
+        uint32_t deadline_remainder;
+        /// Whole ticks in one period
+        uint32_t period_ticks;
+        /// Fractional part of the period in units of the denominator
+        uint32_t period_remainder;
+        /// Denominator of the fractional parts
+        uint32_t period_denominator;
+        /// Count of the missed periods since the timer was started
+        uint32_t missed_count;
+        /// Overrun policy
+        mdv_periodic_timer_policy_t policy;
+        /// Callback to call when a period expires
+        mdv_periodic_timer_callback_t callback;
+        /// User data passed to the callback
+        void *user_data;
+        /// Running state
+        bool is_running;
+} mdv_periodic_timer_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a periodic timer
+ *
+ * The timer is stopped after the initialization.
+ *
+ * \param[in] timer Timer to initialize
+ * \param[in] sw_timer_base Timer base which this timer will use
+ * \param[in] period_ticks Period in ticks (at least one)
+ * \param[in] policy Overrun policy
+ * \param[in] callback Callback to call when a period expires
+ * \param[in] user_data User data passed to the callback
+ *
+ * \return No return value
+ */
+void mdv_periodic_timer_init(mdv_periodic_timer_t *const timer,
+                             mdv_sw_timer_base_t *const sw_timer_base,
+                             uint32_t const period_ticks,
+                             mdv_periodic_timer_policy_t const policy,
+                             mdv_periodic_timer_callback_t const callback,
+                             void *const user_data);
+
+/**
+ * \brief Initialize a periodic timer with a fractional period
+ *
+ * Works like \ref mdv_periodic_timer_init, but the period is
+ * numerator / denominator ticks.
+ *
+ * \param[in] timer Timer to initialize
+ * \param[in] sw_timer_base Timer base which this timer will use
+ * \param[in] numerator Numerator of the period in ticks
+ * \param[in] denominator Denominator of the period (not greater than the
+ *      numerator, so that the period is at least one tick)
+ * \param[in] policy Overrun policy
+ * \param[in] callback Callback to call when a period expires
+ * \param[in] user_data User data passed to the callback
+ *
+ * \return No return value
+ */
+void mdv_periodic_timer_init_fraction(
+        mdv_periodic_timer_t *const timer,
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const numerator,
+        uint32_t const denominator,
+        mdv_periodic_timer_policy_t const policy,
+        mdv_periodic_timer_callback_t const callback,
+        void *const user_data);
+
+/**
+ * \brief Start a periodic timer
+ *
+ * The first period expires one period after the current tick count. Starting
+ * a running timer restarts it, and clears the missed count.
+ *
+ * \param[in] timer Timer to start
+ *
+ * \return No return value
+ */
+void mdv_periodic_timer_start(mdv_periodic_timer_t *const timer);
+
+/**
+ * \brief Stop a periodic timer
+ *
+ * \param[in] timer Timer to stop
+ *
+ * \return No return value
+ */
+void mdv_periodic_timer_stop(mdv_periodic_timer_t *const timer);
+
+/**
+ * \brief Check if a periodic timer is running
+ *
+ * \param[in] timer Timer to check
+ *
+ * \retval true The timer is running
+ * \retval false The timer is stopped
+ */
+bool mdv_periodic_timer_is_running(mdv_periodic_timer_t *const timer);
+
+/**
+ * \brief Process a periodic timer
+ *
+ * Reads the extended tick count from the timer base, and calls the callback
+ * for the due periods according to the overrun policy.
+ *
+ * \param[in] timer Timer in use
+ *
+ * \return Count of the callback calls
+ */
+uint32_t mdv_periodic_timer_process(mdv_periodic_timer_t *const timer);
+
+/**
+ * \brief Get the count of the missed periods
+ *
+ * A period is missed when it becomes due while an earlier period of the same
+ * timer is still waiting to be processed. The count saturates at UINT32_MAX.
+ *
+ * \param[in] timer Timer in use
+ *
+ * \return Count of the missed periods since the timer was started
+ */
+uint32_t mdv_periodic_timer_get_missed_count(
+        mdv_periodic_timer_t *const timer);
+
+/**
+ * \brief Get the next deadline
+ *
+ * \param[in] timer Timer in use
+ *
+ * \return Extended tick count of the timer base at which the next period
+ *      expires
+ */
+uint64_t mdv_periodic_timer_get_deadline64(mdv_periodic_timer_t *const timer);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-periodic-timer */
+
+#endif // ifndef MDV_PERIODIC_TIMER_H
+
+/* EOF */
@@ -0,0 +1,280 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_pool.h"
+#include "mdv_atomic.h"
+#include <assert.h>
+#include <string.h>
+
+/**
+ * \defgroup mdv-pool-internals Internals
+ * \ingroup  mdv-pool
+ * @{
+ */
+
+/// Count of the blocks moved between a cache and the pool at once
+#define CACHE_TRANSFER_COUNT (MDV_POOL_CACHE_SIZE / 2u)
+
+/**
+ * \brief Check that a block belongs to a pool
+ *
+ * \param[in] pool Pool in use
+ * \param[in] block Block to check
+ *
+ * \return No return value
+ */
+static void check_block(mdv_pool_t const *const pool, void const *const block)
+{
+        uintptr_t const offset = (uintptr_t)block - (uintptr_t)pool->blocks;
+
+        (void)offset;
+
+        assert(block);
+        assert((uintptr_t)block >= (uintptr_t)pool->blocks);
+        assert(offset < (uintptr_t)pool->block_size * pool->block_count);
+        assert(!(offset % pool->block_size));
+}
+
+/**
+ * \brief Take a block from the free list
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return The block, or NULL if the free list is empty
+ */
+static void *pop(mdv_pool_t *const pool)
+{
+        mdv_pool_align_t *const block = pool->free_list;
+        uint32_t free_count;
+
+        if (!block) {
+                return NULL;
+        }
+
+        pool->free_list = (mdv_pool_align_t *)block->pointer;
+        free_count = pool->free_count - 1u;
+        mdv_atomic_store_relaxed_u32(&(pool->free_count), free_count);
+        if (free_count < pool->min_free_count) {
+                mdv_atomic_store_relaxed_u32(&(pool->min_free_count),
+                                             free_count);
+        }
+
+        return block;
+}
+
+/**
+ * \brief Put a block to the free list
+ *
+ * \param[in] pool Pool in use
+ * \param[in] block Block to put
+ *
+ * \return No return value
+ */
+static void push(mdv_pool_t *const pool, void *const block)
+{
+        check_block(pool, block);
+        assert(pool->free_count < pool->block_count);
+
+        ((mdv_pool_align_t *)block)->pointer = pool->free_list;
+        pool->free_list = (mdv_pool_align_t *)block;
+        mdv_atomic_store_relaxed_u32(&(pool->free_count),
+                                     pool->free_count + 1u);
+}
+
+/**
+ * \brief Take the lock of a pool
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return No return value
+ */
+static void lock(mdv_pool_t *const pool)
+{
+        uint32_t expected;
+
+        do {
+                expected = 0;
+        } while (!mdv_atomic_compare_exchange_u32(&(pool->lock), &expected,
+                                                  1u));
+}
+
+/**
+ * \brief Release the lock of a pool
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return No return value
+ */
+static void unlock(mdv_pool_t *const pool)
+{
+        mdv_atomic_store_release_u32(&(pool->lock), 0);
+}
+
+/** @} mdv-pool-internals */
+
+void mdv_pool_init(mdv_pool_t *const pool,
+                   void *const buffer,
+                   uint32_t const object_size,
+                   uint32_t const count)
+{
+        uint32_t i;
+
+        assert(pool);
+        assert(buffer);
+        assert(!((uintptr_t)buffer % sizeof(mdv_pool_align_t)));
+        assert(object_size > 0);
+        assert(count > 0);
+
+        pool->blocks = (uint8_t *)buffer;
+        pool->block_size = (uint32_t)MDV_POOL_BLOCK_SIZE(object_size);
+        pool->block_count = count;
+        pool->free_count = count;
+        pool->min_free_count = count;
+        pool->lock = 0;
+
+        // Link the blocks in the order of their addresses
+        pool->free_list = NULL;
+        for (i = count; i > 0; --i) {
+                mdv_pool_align_t *const block = (mdv_pool_align_t *)
+                        (pool->blocks + (size_t)(i - 1u) * pool->block_size);
+
+                block->pointer = pool->free_list;
+                pool->free_list = block;
+        }
+}
+
+void *mdv_pool_alloc(mdv_pool_t *const pool)
+{
+        assert(pool);
+
+        return pop(pool);
+}
+
+void mdv_pool_free(mdv_pool_t *const pool,
+                   void *const block)
+{
+        assert(pool);
+
+        push(pool, block);
+}
+
+uint32_t mdv_pool_get_free_count(mdv_pool_t *const pool)
+{
+        assert(pool);
+
+        return mdv_atomic_load_relaxed_u32(&(pool->free_count));
+}
+
+uint32_t mdv_pool_get_min_free_count(mdv_pool_t *const pool)
+{
+        assert(pool);
+
+        return mdv_atomic_load_relaxed_u32(&(pool->min_free_count));
+}
+
+void mdv_pool_cache_init(mdv_pool_cache_t *const cache,
+                         mdv_pool_t *const pool)
+{
+        assert(cache);
+        assert(pool);
+
+        cache->pool = pool;
+        cache->count = 0;
+}
+
+void *mdv_pool_cache_alloc(mdv_pool_cache_t *const cache)
+{
+        void *block;
+
+        assert(cache);
+
+        if (!cache->count) {
+                lock(cache->pool);
+                while (cache->count < CACHE_TRANSFER_COUNT) {
+                        block = pop(cache->pool);
+                        if (!block) {
+                                break;
+                        }
+                        cache->blocks[cache->count++] = block;
+                }
+                unlock(cache->pool);
+                if (!cache->count) {
+                        return NULL;
+                }
+        }
+
+        return cache->blocks[--cache->count];
+}
+
+void mdv_pool_cache_free(mdv_pool_cache_t *const cache,
+                         void *const block)
+{
+        uint32_t i;
+
+        assert(cache);
+        check_block(cache->pool, block);
+
+        if (cache->count == MDV_POOL_CACHE_SIZE) {
+                // Return the least recently released blocks, and keep the
+                // ones most likely still in the data cache of the processor
+                lock(cache->pool);
+                for (i = 0; i < CACHE_TRANSFER_COUNT; ++i) {
+                        push(cache->pool, cache->blocks[i]);
+                }
+                unlock(cache->pool);
+                memmove(&(cache->blocks[0]),
+                        &(cache->blocks[CACHE_TRANSFER_COUNT]),
+                        (MDV_POOL_CACHE_SIZE - CACHE_TRANSFER_COUNT) *
+                        sizeof(cache->blocks[0]));
+                cache->count -= CACHE_TRANSFER_COUNT;
+        }
+
+        cache->blocks[cache->count++] = block;
+}
+
+void mdv_pool_cache_flush(mdv_pool_cache_t *const cache)
+{
+        assert(cache);
+
+        if (!cache->count) {
+                return;
+        }
+
+        lock(cache->pool);
+        while (cache->count) {
+                push(cache->pool, cache->blocks[--cache->count]);
+        }
+        unlock(cache->pool);
+}
+
+/* EOF */
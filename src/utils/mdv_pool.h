@@ -0,0 +1,251 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_POOL_H
+#define MDV_POOL_H
+
+#include "mdv_common.h"
+
+/**
+ * \file       mdv_pool.h
+ * \defgroup   mdv-pool Fixed-block pool
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Allocates blocks of one size from a buffer sized at compile time, for
+ * example timers, executor tasks or other objects with a dynamic lifetime,
+ * without using the heap. The free blocks are linked through their first
+ * bytes, so the pool has no memory overhead per block, and both the
+ * allocation and the release take a constant time. All the blocks have the
+ * same size, so the pool never fragments: an allocation fails only when every
+ * block is in use.
+ *
+ * A pool is used from one context at a time. On hosts with several threads,
+ * each thread can use a \ref mdv_pool_cache_t of its own. A cache holds up to
+ * \ref MDV_POOL_CACHE_SIZE blocks, and moves half of them from or to the pool
+ * under a spinlock when it runs empty or full, so most of the allocations
+ * don't touch the shared pool at all. While caches are used concurrently,
+ * \ref mdv_pool_alloc and \ref mdv_pool_free must not be called.
+ *
+ * A buffer for a pool of objects of a type is declared with
+ * \ref MDV_POOL_STORAGE:
+ * \code
+ * static MDV_POOL_STORAGE(timer_storage, sizeof(mdv_sw_timer_t), 32);
+ * static mdv_pool_t timer_pool;
+ *
+ * mdv_pool_init(&timer_pool, timer_storage, sizeof(mdv_sw_timer_t), 32);
+ * \endcode
+ *
+ * @{
+ */
+
+#ifndef MDV_POOL_CACHE_SIZE
+/// Largest count of the blocks in a cache, an even number
+#define MDV_POOL_CACHE_SIZE 32u
+#endif // ifndef MDV_POOL_CACHE_SIZE
+
+#if (MDV_POOL_CACHE_SIZE < 2) || (MDV_POOL_CACHE_SIZE % 2)
+#error "MDV_POOL_CACHE_SIZE must be an even number of at least 2"
+#endif
+
+/**
+ * \brief Unit of the alignment of the blocks
+ */
+typedef union _mdv_pool_align_t{
+        /// Link of a free block
+        void *pointer;
+        /// Alignment of 64-bit integers
+        uint64_t integer;
+        /// Alignment of floating point values
+        double floating;
+} mdv_pool_align_t;
+
+/// Size of a block holding an object of the given size
+#define MDV_POOL_BLOCK_SIZE(object_size) \
+        ((((object_size) + sizeof(mdv_pool_align_t) - 1u) / \
+          sizeof(mdv_pool_align_t)) * sizeof(mdv_pool_align_t))
+
+/// Size of a buffer for the given count of objects of the given size
+#define MDV_POOL_BUFFER_SIZE(object_size, count) \
+        (MDV_POOL_BLOCK_SIZE(object_size) * (count))
+
+/// Declares an aligned buffer for the given count of objects of the given size
+#define MDV_POOL_STORAGE(name, object_size, count) \
+        mdv_pool_align_t name[MDV_POOL_BUFFER_SIZE(object_size, count) / \
+                              sizeof(mdv_pool_align_t)]
+
+/**
+ * \brief Pool data
+ */
+typedef struct _mdv_pool_t{
+        /// First free block
+        mdv_pool_align_t *free_list;
+        /// Storage of the blocks
+        uint8_t *blocks;
+        /// Size of a block in bytes
+        uint32_t block_size;
+        /// Count of the blocks
+        uint32_t block_count;
+        /// Count of the free blocks
+        uint32_t free_count;
+        /// Smallest count of the free blocks since the initialization
+        uint32_t min_free_count;
+        /// Lock of the pool, taken by the caches
+        uint32_t lock;
+} mdv_pool_t;
+
+/**
+ * \brief Cache of a pool for one thread
+ */
+typedef struct _mdv_pool_cache_t{
+        /// Pool in use
+        mdv_pool_t *pool;
+        /// Count of the blocks in the cache
+        uint32_t count;
+        /// Blocks in the cache
+        void *blocks[MDV_POOL_CACHE_SIZE];
+} mdv_pool_cache_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a pool with all the blocks free
+ *
+ * \param[in] pool Pool to initialize
+ * \param[in] buffer Buffer of \ref MDV_POOL_BUFFER_SIZE bytes, aligned to
+ *      \ref mdv_pool_align_t, for example one declared with
+ *      \ref MDV_POOL_STORAGE
+ * \param[in] object_size Size of an object in bytes
+ * \param[in] count Count of the objects
+ *
+ * \return No return value
+ */
+void mdv_pool_init(mdv_pool_t *const pool,
+                   void *const buffer,
+                   uint32_t const object_size,
+                   uint32_t const count);
+
+/**
+ * \brief Allocate a block
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return The allocated block, or NULL if all the blocks are in use
+ */
+void *mdv_pool_alloc(mdv_pool_t *const pool);
+
+/**
+ * \brief Release a block
+ *
+ * \param[in] pool Pool in use
+ * \param[in] block Block allocated from the pool
+ *
+ * \return No return value
+ */
+void mdv_pool_free(mdv_pool_t *const pool,
+                   void *const block);
+
+/**
+ * \brief Get the count of the free blocks
+ *
+ * The blocks held by caches are not counted as free.
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return Count of the free blocks
+ */
+uint32_t mdv_pool_get_free_count(mdv_pool_t *const pool);
+
+/**
+ * \brief Get the smallest count of the free blocks since the initialization
+ *
+ * \param[in] pool Pool in use
+ *
+ * \return The smallest count of the free blocks
+ */
+uint32_t mdv_pool_get_min_free_count(mdv_pool_t *const pool);
+
+/**
+ * \brief Initialize an empty cache
+ *
+ * \param[in] cache Cache to initialize
+ * \param[in] pool Pool to cache
+ *
+ * \return No return value
+ */
+void mdv_pool_cache_init(mdv_pool_cache_t *const cache,
+                         mdv_pool_t *const pool);
+
+/**
+ * \brief Allocate a block through a cache
+ *
+ * \param[in] cache Cache in use
+ *
+ * \return The allocated block, or NULL if all the blocks of the pool are in
+ *      use or held by other caches
+ */
+void *mdv_pool_cache_alloc(mdv_pool_cache_t *const cache);
+
+/**
+ * \brief Release a block through a cache
+ *
+ * The block may have been allocated through any cache of the pool.
+ *
+ * \param[in] cache Cache in use
+ * \param[in] block Block allocated from the pool
+ *
+ * \return No return value
+ */
+void mdv_pool_cache_free(mdv_pool_cache_t *const cache,
+                         void *const block);
+
+/**
+ * \brief Return all the blocks of a cache to the pool
+ *
+ * \param[in] cache Cache in use
+ *
+ * \return No return value
+ */
+void mdv_pool_cache_flush(mdv_pool_cache_t *const cache);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-pool */
+
+#endif // ifndef MDV_POOL_H
+
+/* EOF */
@@ -0,0 +1,227 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_profiler.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-profiler-internals Internals
+ * \ingroup  mdv-profiler
+ * @{
+ */
+
+/**
+ * \brief Get the histogram bucket of a sample
+ *
+ * \param[in] ticks Sample in ticks
+ *
+ * \return Index of the bucket
+ */
+static uint32_t get_bucket(uint32_t const ticks)
+{
+        uint32_t bucket = 0;
+
+        if (ticks) {
+#if defined(__GNUC__)
+                bucket = 32u - (uint32_t)__builtin_clz(ticks);
+#else
+                uint32_t value = ticks;
+
+                while (value) {
+                        value >>= 1u;
+                        ++bucket;
+                }
+#endif // if defined(__GNUC__)
+        }
+
+        return bucket < MDV_PROFILER_HISTOGRAM_BUCKETS ?
+               bucket : MDV_PROFILER_HISTOGRAM_BUCKETS - 1u;
+}
+
+/**
+ * \brief Clear the statistics of a site
+ *
+ * \param[in] site Site in use
+ *
+ * \return No return value
+ */
+static void clear_site(mdv_profiler_site_t *const site)
+{
+        uint32_t i;
+
+        site->count = 0;
+        site->min = UINT32_MAX;
+        site->max = 0;
+        site->sum = 0;
+
+        for (i = 0; i < MDV_PROFILER_HISTOGRAM_BUCKETS; i++) {
+                site->histogram[i] = 0;
+        }
+}
+
+/** @} mdv-profiler-internals */
+
+void mdv_profiler_init(mdv_profiler_t *const profiler,
+                       mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(profiler);
+        assert(sw_timer_base);
+
+        profiler->sw_timer_base = sw_timer_base;
+        profiler->timer_mask = mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        profiler->sites = 0;
+}
+
+void mdv_profiler_add_site(mdv_profiler_t *const profiler,
+                           mdv_profiler_site_t *const site)
+{
+        assert(profiler);
+        assert(site);
+
+        if (site->is_added) {
+                return;
+        }
+
+        site->next = profiler->sites;
+        site->is_added = true;
+        profiler->sites = site;
+}
+
+uint32_t mdv_profiler_begin(mdv_profiler_t *const profiler)
+{
+        assert(profiler);
+
+        return mdv_sw_timer_base_get_tick_count(profiler->sw_timer_base);
+}
+
+uint32_t mdv_profiler_end(mdv_profiler_t *const profiler,
+                          mdv_profiler_site_t *const site,
+                          uint32_t const start)
+{
+        uint32_t ticks;
+
+        assert(profiler);
+
+        ticks = (mdv_sw_timer_base_get_tick_count(profiler->sw_timer_base) -
+                 start) & profiler->timer_mask;
+        mdv_profiler_record(profiler, site, ticks);
+
+        return ticks;
+}
+
+void mdv_profiler_record(mdv_profiler_t *const profiler,
+                         mdv_profiler_site_t *const site,
+                         uint32_t const ticks)
+{
+        assert(profiler);
+        assert(site);
+
+        if (!site->is_added) {
+                mdv_profiler_add_site(profiler, site);
+        }
+
+        ++site->count;
+        site->sum += ticks;
+        ++site->histogram[get_bucket(ticks)];
+
+        if (ticks < site->min) {
+                site->min = ticks;
+        }
+
+        if (ticks > site->max) {
+                site->max = ticks;
+        }
+}
+
+uint32_t mdv_profiler_get_bucket_limit(uint32_t const index)
+{
+        assert(index < MDV_PROFILER_HISTOGRAM_BUCKETS);
+
+        if (index >= 32u || index == MDV_PROFILER_HISTOGRAM_BUCKETS - 1u) {
+                return UINT32_MAX;
+        }
+
+        return (1u << index) - 1u;
+}
+
+void mdv_profiler_report(
+        mdv_profiler_t *const profiler,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        mdv_profiler_report_function_t const function,
+        void *const user_data)
+{
+        mdv_sw_timer_conversion_t const *conversion;
+        mdv_profiler_site_t *site;
+        mdv_profiler_report_t report;
+
+        assert(profiler);
+        assert(function);
+
+        conversion = mdv_sw_timer_base_get_conversion(profiler->sw_timer_base);
+
+        for (site = profiler->sites; site; site = site->next) {
+                report.name = site->name;
+                report.count = site->count;
+                report.histogram = site->histogram;
+
+                if (!site->count) {
+                        report.min = 0;
+                        report.max = 0;
+                        report.mean = 0;
+                } else {
+                        report.min = mdv_sw_timer_conversion_get_time(
+                                conversion, site->min, order_of_magnitude);
+                        report.max = mdv_sw_timer_conversion_get_time(
+                                conversion, site->max, order_of_magnitude);
+                        report.mean = mdv_sw_timer_conversion_get_time(
+                                conversion,
+                                (uint32_t)(site->sum / site->count),
+                                order_of_magnitude);
+                }
+
+                function(user_data, &report);
+        }
+}
+
+void mdv_profiler_reset(mdv_profiler_t *const profiler)
+{
+        mdv_profiler_site_t *site;
+
+        assert(profiler);
+
+        for (site = profiler->sites; site; site = site->next) {
+                clear_site(site);
+        }
+}
+
+/* EOF */
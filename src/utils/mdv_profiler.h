@@ -0,0 +1,302 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_PROFILER_H
+#define MDV_PROFILER_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_profiler.h
+ * \defgroup   mdv-profiler Code section profiler
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * The profiler measures the execution time of code sections at named probe
+ * sites. A probe reads the tick count of the timer base once when the section
+ * begins and once when it ends, and records the raw tick count only. Each
+ * site accumulates the sample count, the minimum, the maximum, the sum for
+ * the mean, and a histogram with logarithmic buckets in fixed memory. The
+ * ticks are converted to time only when the results are reported with
+ * \ref mdv_profiler_report.
+ *
+ * The probes are placed with the macros:
+ *
+ * \code
+ * MDV_PROFILER_DEFINE_SITE(control_site, "control");
+ *
+ * void control_loop(void)
+ * {
+ *         MDV_PROFILER_BEGIN(&profiler, start);
+ *         ...
+ *         MDV_PROFILER_END(&profiler, &control_site, start);
+ * }
+ * \endcode
+ *
+ * Defining MDV_DISABLE_PROFILER turns the macros into nothing, so disabled
+ * probes cost neither code nor memory. The cost of an enabled probe is two
+ * tick count reads and a few additions, so the probes can be left enabled in
+ * production builds to catch latency regressions in the field.
+ *
+ * A site is linked to the profiler on its first sample. The statistics of a
+ * site are updated without locks, so each site must be sampled from one
+ * context only, and a site sampled from an interrupt handler must be added
+ * with \ref mdv_profiler_add_site before the interrupt is enabled. Reading
+ * the statistics concurrently with the sampling may give a mix of two
+ * consecutive samples.
+ *
+ * The timer base used by the profiler determines the resolution, so a timer
+ * base on a fast free running counter is preferred. In the snapshot mode of
+ * the timer base, the tick count doesn't advance between the latches, so the
+ * profiler should use a timer base without the snapshot mode.
+ *
+ * @{
+ */
+
+#ifndef MDV_PROFILER_HISTOGRAM_BUCKETS
+/// Number of histogram buckets per site (2 to 33). The bucket i > 0 counts
+/// the samples from 2^(i-1) to 2^i - 1 ticks, and the last bucket counts also
+/// all longer samples.
+#define MDV_PROFILER_HISTOGRAM_BUCKETS 33u
+#endif // ifndef MDV_PROFILER_HISTOGRAM_BUCKETS
+
+#if (MDV_PROFILER_HISTOGRAM_BUCKETS < 2) || \
+    (MDV_PROFILER_HISTOGRAM_BUCKETS > 33)
+#error "MDV_PROFILER_HISTOGRAM_BUCKETS must be from 2 to 33"
+#endif
+
+/**
+ * \brief Probe site
+ *
+ * The fields are internal to the profiler.
+ */
+typedef struct _mdv_profiler_site_t{
+        /// Next site linked to the same profiler
+        struct _mdv_profiler_site_t *next;
+        /// Name of the site
+        char const *name;
+        /// Set when the site is linked to a profiler
+        bool is_added;
+        /// Count of samples
+        uint32_t count;
+        /// Shortest sample in ticks
+        uint32_t min;
+        /// Longest sample in ticks
+        uint32_t max;
+        /// Sum of the samples in ticks
+        uint64_t sum;
+        /// Sample counts of the histogram buckets
+        uint32_t histogram[MDV_PROFILER_HISTOGRAM_BUCKETS];
+} mdv_profiler_site_t;
+
+/// Initializer of a probe site with the given name
+#define MDV_PROFILER_SITE_INITIALIZER(name) \
+        { 0, (name), false, 0, UINT32_MAX, 0, 0, { 0 } }
+
+/**
+ * \brief Profiler instance data
+ */
+typedef struct _mdv_profiler_t{
+        /// Timer base used for the measurements
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Timer counter mask, inherited from the timer base
+        uint32_t timer_mask;
+        /// First linked site
+        mdv_profiler_site_t *sites;
+} mdv_profiler_t;
+
+/**
+ * \brief Statistics of a probe site, converted to time
+ */
+typedef struct _mdv_profiler_report_t{
+        /// Name of the site
+        char const *name;
+        /// Count of samples
+        uint32_t count;
+        /// Shortest sample (zero without samples)
+        uint32_t min;
+        /// Longest sample
+        uint32_t max;
+        /// Mean of the samples, rounded down
+        uint32_t mean;
+        /// Sample counts of the histogram buckets, see
+        /// \ref mdv_profiler_get_bucket_limit for the bucket limits
+        uint32_t const *histogram;
+} mdv_profiler_report_t;
+
+/**
+ * \brief Report function type
+ *
+ * \param[in] user_data User data given to \ref mdv_profiler_report
+ * \param[in] report Statistics of one site
+ *
+ * \return No return value
+ */
+typedef void (*mdv_profiler_report_function_t)(
+        void *const user_data, mdv_profiler_report_t const *const report);
+
+#ifndef MDV_DISABLE_PROFILER
+
+/// Define a probe site with a name
+#define MDV_PROFILER_DEFINE_SITE(site, name) \
+        mdv_profiler_site_t site = MDV_PROFILER_SITE_INITIALIZER(name)
+
+/// Begin a measured section, storing the start tick count to a new variable
+#define MDV_PROFILER_BEGIN(profiler, start) \
+        uint32_t const start = mdv_profiler_begin(profiler)
+
+/// End a measured section begun with \ref MDV_PROFILER_BEGIN
+#define MDV_PROFILER_END(profiler, site, start) \
+        mdv_profiler_end((profiler), (site), (start))
+
+#else
+
+#define MDV_PROFILER_DEFINE_SITE(site, name) \
+        struct mdv_profiler_disabled_##site
+#define MDV_PROFILER_BEGIN(profiler, start) \
+        do { } while (0)
+#define MDV_PROFILER_END(profiler, site, start) \
+        do { } while (0)
+
+#endif // ifndef MDV_DISABLE_PROFILER
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a profiler
+ *
+ * \param[in] profiler Profiler to initialize
+ * \param[in] sw_timer_base Timer base which the profiler will use
+ *
+ * \return No return value
+ */
+void mdv_profiler_init(mdv_profiler_t *const profiler,
+                       mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Link a site to a profiler
+ *
+ * Adding a site which has already been added has no effect.
+ *
+ * \param[in] profiler Profiler in use
+ * \param[in] site Site to add
+ *
+ * \return No return value
+ */
+void mdv_profiler_add_site(mdv_profiler_t *const profiler,
+                           mdv_profiler_site_t *const site);
+
+/**
+ * \brief Begin a measured section
+ *
+ * \param[in] profiler Profiler in use
+ *
+ * \return The tick count at the beginning of the section
+ */
+uint32_t mdv_profiler_begin(mdv_profiler_t *const profiler);
+
+/**
+ * \brief End a measured section and record the sample
+ *
+ * \param[in] profiler Profiler in use
+ * \param[in] site Site of the section
+ * \param[in] start Tick count returned by \ref mdv_profiler_begin
+ *
+ * \return The sample in ticks
+ */
+uint32_t mdv_profiler_end(mdv_profiler_t *const profiler,
+                          mdv_profiler_site_t *const site,
+                          uint32_t const start);
+
+/**
+ * \brief Record a sample measured by other means
+ *
+ * \param[in] profiler Profiler in use
+ * \param[in] site Site of the sample
+ * \param[in] ticks Sample in ticks
+ *
+ * \return No return value
+ */
+void mdv_profiler_record(mdv_profiler_t *const profiler,
+                         mdv_profiler_site_t *const site,
+                         uint32_t const ticks);
+
+/**
+ * \brief Get the upper limit of a histogram bucket
+ *
+ * \param[in] index Index of the bucket
+ *
+ * \return The longest sample in ticks counted in the bucket
+ */
+uint32_t mdv_profiler_get_bucket_limit(uint32_t const index);
+
+/**
+ * \brief Report the statistics of all linked sites
+ *
+ * The minimum, the maximum and the mean are converted from ticks to the
+ * given order of magnitude with the conversion of the timer base. The
+ * histogram is reported in ticks.
+ *
+ * \param[in] profiler Profiler in use
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[in] function Function called once per site
+ * \param[in] user_data User data passed to the function
+ *
+ * \return No return value
+ */
+void mdv_profiler_report(
+        mdv_profiler_t *const profiler,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        mdv_profiler_report_function_t const function,
+        void *const user_data);
+
+/**
+ * \brief Clear the statistics of all linked sites
+ *
+ * \param[in] profiler Profiler in use
+ *
+ * \return No return value
+ */
+void mdv_profiler_reset(mdv_profiler_t *const profiler);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-profiler */
+
+#endif // ifndef MDV_PROFILER_H
+
+/* EOF */
@@ -0,0 +1,357 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_queue.h"
+#include "mdv_atomic.h"
+#include <assert.h>
+#include <string.h>
+
+/**
+ * \defgroup mdv-queue-internals Internals
+ * \ingroup  mdv-queue
+ * @{
+ */
+
+/**
+ * \brief Check the parameters of a queue
+ *
+ * \param[in] buffer Buffer of the queue
+ * \param[in] element_size Size of an element in bytes
+ * \param[in] capacity Capacity in elements
+ *
+ * \return No return value
+ */
+static void check_parameters(void const *const buffer,
+                             uint32_t const element_size,
+                             uint32_t const capacity)
+{
+        (void)buffer;
+        (void)element_size;
+        (void)capacity;
+
+        assert(buffer);
+        assert(element_size > 0);
+        assert(capacity > 0);
+        assert(capacity <= MDV_QUEUE_MAX_CAPACITY);
+        assert(!(capacity & (capacity - 1u)));
+}
+
+/**
+ * \brief Copy elements into a ring buffer
+ *
+ * \param[in] storage Storage of the ring buffer
+ * \param[in] element_size Size of an element in bytes
+ * \param[in] mask Capacity minus one
+ * \param[in] index Index of the first element in the ring buffer
+ * \param[in] elements Elements to copy
+ * \param[in] count Count of the elements, at most the capacity
+ *
+ * \return No return value
+ */
+static void copy_in(uint8_t *const storage,
+                    uint32_t const element_size,
+                    uint32_t const mask,
+                    uint32_t const index,
+                    void const *const elements,
+                    uint32_t const count)
+{
+        uint32_t const slot = index & mask;
+        uint32_t first = mask + 1u - slot;
+
+        if (first > count) {
+                first = count;
+        }
+
+        // The elements wrap around the end of the storage at most once
+        memcpy(storage + (size_t)slot * element_size, elements,
+               (size_t)first * element_size);
+        if (first < count) {
+                memcpy(storage,
+                       (uint8_t const *)elements + (size_t)first * element_size,
+                       (size_t)(count - first) * element_size);
+        }
+}
+
+/**
+ * \brief Copy elements out of a ring buffer
+ *
+ * \param[in] storage Storage of the ring buffer
+ * \param[in] element_size Size of an element in bytes
+ * \param[in] mask Capacity minus one
+ * \param[in] index Index of the first element in the ring buffer
+ * \param[out] elements Storage for the copied elements
+ * \param[in] count Count of the elements, at most the capacity
+ *
+ * \return No return value
+ */
+static void copy_out(uint8_t const *const storage,
+                     uint32_t const element_size,
+                     uint32_t const mask,
+                     uint32_t const index,
+                     void *const elements,
+                     uint32_t const count)
+{
+        uint32_t const slot = index & mask;
+        uint32_t first = mask + 1u - slot;
+
+        if (first > count) {
+                first = count;
+        }
+
+        memcpy(elements, storage + (size_t)slot * element_size,
+               (size_t)first * element_size);
+        if (first < count) {
+                memcpy((uint8_t *)elements + (size_t)first * element_size,
+                       storage, (size_t)(count - first) * element_size);
+        }
+}
+
+/**
+ * \brief Get the count of the elements between two indexes
+ *
+ * \param[in] head_index Consumer index, loaded before the producer index
+ * \param[in] tail_index Producer index
+ * \param[in] mask Capacity minus one
+ *
+ * \return Count of the elements, limited to the capacity
+ */
+static uint32_t get_count(uint32_t const head_index,
+                          uint32_t const tail_index,
+                          uint32_t const mask)
+{
+        uint32_t const count = tail_index - head_index;
+
+        // The consumer may have dequeued and the producers refilled the queue
+        // between the loads of the indexes
+        return count <= mask ? count : mask + 1u;
+}
+
+/** @} mdv-queue-internals */
+
+void mdv_spsc_queue_init(mdv_spsc_queue_t *const queue,
+                         void *const buffer,
+                         uint32_t const element_size,
+                         uint32_t const capacity)
+{
+        assert(queue);
+        check_parameters(buffer, element_size, capacity);
+
+        queue->tail = 0;
+        queue->cached_head = 0;
+        queue->head = 0;
+        queue->cached_tail = 0;
+        queue->elements = (uint8_t *)buffer;
+        queue->element_size = element_size;
+        queue->mask = capacity - 1u;
+}
+
+uint32_t mdv_spsc_queue_enqueue(mdv_spsc_queue_t *const queue,
+                                void const *const elements,
+                                uint32_t const count)
+{
+        uint32_t tail;
+        uint32_t free_count;
+
+        assert(queue);
+        assert(elements || !count);
+
+        tail = mdv_atomic_load_relaxed_u32(&(queue->tail));
+        free_count = queue->mask + 1u - (tail - queue->cached_head);
+        if (free_count < count) {
+                // Read the index of the consumer only when the copy of it
+                // doesn't leave room for all the elements
+                queue->cached_head =
+                        mdv_atomic_load_acquire_u32(&(queue->head));
+                free_count = queue->mask + 1u - (tail - queue->cached_head);
+        }
+        if (free_count > count) {
+                free_count = count;
+        }
+        if (free_count) {
+                copy_in(queue->elements, queue->element_size, queue->mask,
+                        tail, elements, free_count);
+                mdv_atomic_store_release_u32(&(queue->tail),
+                                             tail + free_count);
+        }
+
+        return free_count;
+}
+
+uint32_t mdv_spsc_queue_dequeue(mdv_spsc_queue_t *const queue,
+                                void *const elements,
+                                uint32_t const count)
+{
+        uint32_t head;
+        uint32_t available;
+
+        assert(queue);
+        assert(elements || !count);
+
+        head = mdv_atomic_load_relaxed_u32(&(queue->head));
+        available = queue->cached_tail - head;
+        if (available < count) {
+                queue->cached_tail =
+                        mdv_atomic_load_acquire_u32(&(queue->tail));
+                available = queue->cached_tail - head;
+        }
+        if (available > count) {
+                available = count;
+        }
+        if (available) {
+                copy_out(queue->elements, queue->element_size, queue->mask,
+                         head, elements, available);
+                mdv_atomic_store_release_u32(&(queue->head),
+                                             head + available);
+        }
+
+        return available;
+}
+
+uint32_t mdv_spsc_queue_get_count(mdv_spsc_queue_t *const queue)
+{
+        uint32_t head;
+
+        assert(queue);
+
+        head = mdv_atomic_load_acquire_u32(&(queue->head));
+
+        return get_count(head, mdv_atomic_load_acquire_u32(&(queue->tail)),
+                         queue->mask);
+}
+
+void mdv_mpsc_queue_init(mdv_mpsc_queue_t *const queue,
+                         void *const buffer,
+                         uint32_t const element_size,
+                         uint32_t const capacity)
+{
+        uint32_t i;
+
+        assert(queue);
+        check_parameters(buffer, element_size, capacity);
+        assert(!((uintptr_t)buffer & (sizeof(uint32_t) - 1u)));
+
+        queue->tail = 0;
+        queue->head = 0;
+        queue->sequences = (uint32_t *)buffer;
+        queue->elements = (uint8_t *)buffer +
+                          (size_t)capacity * sizeof(uint32_t);
+        queue->element_size = element_size;
+        queue->mask = capacity - 1u;
+
+        // A slot holding the element of index i is published with the
+        // sequence i + 1, so no slot is published initially
+        for (i = 0; i < capacity; ++i) {
+                queue->sequences[i] = 0;
+        }
+}
+
+uint32_t mdv_mpsc_queue_enqueue(mdv_mpsc_queue_t *const queue,
+                                void const *const elements,
+                                uint32_t const count)
+{
+        uint32_t head;
+        uint32_t tail;
+        uint32_t reserved;
+        uint32_t i;
+
+        assert(queue);
+        assert(elements || !count);
+
+        // Reserve the slots. The consumer index is loaded first, so that it
+        // is never ahead of the producer index.
+        do {
+                head = mdv_atomic_load_acquire_u32(&(queue->head));
+                tail = mdv_atomic_load_relaxed_u32(&(queue->tail));
+                reserved = queue->mask + 1u - (tail - head);
+                if (reserved > count) {
+                        reserved = count;
+                }
+                if (!reserved) {
+                        return 0;
+                }
+        } while (!mdv_atomic_compare_exchange_u32(&(queue->tail), &tail,
+                                                  tail + reserved));
+
+        // Fill and publish the slots
+        copy_in(queue->elements, queue->element_size, queue->mask, tail,
+                elements, reserved);
+        for (i = 0; i < reserved; ++i) {
+                mdv_atomic_store_release_u32(
+                        &(queue->sequences[(tail + i) & queue->mask]),
+                        tail + i + 1u);
+        }
+
+        return reserved;
+}
+
+uint32_t mdv_mpsc_queue_dequeue(mdv_mpsc_queue_t *const queue,
+                                void *const elements,
+                                uint32_t const count)
+{
+        uint32_t head;
+        uint32_t available = 0;
+
+        assert(queue);
+        assert(elements || !count);
+
+        head = mdv_atomic_load_relaxed_u32(&(queue->head));
+        while ((available < count) &&
+               (mdv_atomic_load_acquire_u32(
+                        &(queue->sequences[(head + available) &
+                                           queue->mask])) ==
+                head + available + 1u)) {
+                ++available;
+        }
+        if (available) {
+                copy_out(queue->elements, queue->element_size, queue->mask,
+                         head, elements, available);
+                mdv_atomic_store_release_u32(&(queue->head),
+                                             head + available);
+        }
+
+        return available;
+}
+
+uint32_t mdv_mpsc_queue_get_count(mdv_mpsc_queue_t *const queue)
+{
+        uint32_t head;
+
+        assert(queue);
+
+        head = mdv_atomic_load_acquire_u32(&(queue->head));
+
+        return get_count(head, mdv_atomic_load_acquire_u32(&(queue->tail)),
+                         queue->mask);
+}
+
+/* EOF */
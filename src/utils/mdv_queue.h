@@ -0,0 +1,282 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_QUEUE_H
+#define MDV_QUEUE_H
+
+#include "mdv_common.h"
+
+/**
+ * \file       mdv_queue.h
+ * \defgroup   mdv-queue Lock-free queues
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Bounded ring buffers for passing fixed-size elements from interrupt or
+ * thread context to another thread without locks or interrupt-disable
+ * windows. The elements are copied in and out of a buffer given by the
+ * caller, and any number of elements can be moved by one call.
+ *
+ * \ref mdv_spsc_queue_t has one producer and one consumer. Both sides are
+ * wait-free: each call completes in a bounded number of steps, moving as many
+ * elements as there is room or data for. Each side keeps a copy of the index
+ * of the other side, and reads the shared index only when the copy shows the
+ * queue full or empty.
+ *
+ * \ref mdv_mpsc_queue_t has any number of producers and one consumer. The
+ * producers reserve a range of slots with a compare-and-exchange, copy the
+ * elements and mark each slot published, so they are lock-free. The consumer
+ * stops at the first slot not published yet, so a producer interrupted
+ * between the reservation and the publication delays the elements behind its
+ * own until it continues.
+ *
+ * The indexes written by different sides are kept \ref
+ * MDV_QUEUE_CACHE_LINE_SIZE bytes apart, so the sides don't invalidate the
+ * cache lines of each other. The memory ordering is given by \ref mdv-atomic.
+ * With compilers other than GCC and Clang, the queues are valid only on
+ * single-core targets, \ref MDV_ATOMIC_BARRIER must be defined, and the
+ * producers of a \ref mdv_mpsc_queue_t must not interrupt each other.
+ *
+ * @{
+ */
+
+#ifndef MDV_QUEUE_CACHE_LINE_SIZE
+/// Size of a cache line in bytes, at least 16. Targets without a data cache
+/// can use the minimum to save memory.
+#define MDV_QUEUE_CACHE_LINE_SIZE 64u
+#endif // ifndef MDV_QUEUE_CACHE_LINE_SIZE
+
+#if MDV_QUEUE_CACHE_LINE_SIZE < 16
+#error "MDV_QUEUE_CACHE_LINE_SIZE must be at least 16"
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+/// Alignment of the queues to the cache line
+#define MDV_QUEUE_ALIGNED __attribute__((aligned(MDV_QUEUE_CACHE_LINE_SIZE)))
+#else
+#define MDV_QUEUE_ALIGNED
+#endif // if defined(__GNUC__) || defined(__clang__)
+
+/// Largest capacity of a queue
+#define MDV_QUEUE_MAX_CAPACITY 0x80000000u
+
+/// Size of the buffer of a \ref mdv_spsc_queue_t in bytes
+#define MDV_SPSC_QUEUE_BUFFER_SIZE(element_size, capacity) \
+        ((element_size) * (capacity))
+
+/// Size of the buffer of a \ref mdv_mpsc_queue_t in bytes. The buffer must be
+/// aligned to 32 bits.
+#define MDV_MPSC_QUEUE_BUFFER_SIZE(element_size, capacity) \
+        ((sizeof(uint32_t) + (element_size)) * (capacity))
+
+/**
+ * \brief Single-producer single-consumer queue
+ */
+typedef struct MDV_QUEUE_ALIGNED _mdv_spsc_queue_t{
+        /// Index of the next element to enqueue, written by the producer
+        uint32_t tail;
+        /// Copy of the consumer index, used by the producer
+        uint32_t cached_head;
+        /// Keeps the producer indexes on a cache line of their own
+        uint8_t padding_0[MDV_QUEUE_CACHE_LINE_SIZE - 8u];
+        /// Index of the next element to dequeue, written by the consumer
+        uint32_t head;
+        /// Copy of the producer index, used by the consumer
+        uint32_t cached_tail;
+        /// Keeps the consumer indexes on a cache line of their own
+        uint8_t padding_1[MDV_QUEUE_CACHE_LINE_SIZE - 8u];
+        /// Storage of the elements
+        uint8_t *elements;
+        /// Size of an element in bytes
+        uint32_t element_size;
+        /// Capacity minus one
+        uint32_t mask;
+} mdv_spsc_queue_t;
+
+/**
+ * \brief Multi-producer single-consumer queue
+ */
+typedef struct MDV_QUEUE_ALIGNED _mdv_mpsc_queue_t{
+        /// Index of the next slot to reserve, shared by the producers
+        uint32_t tail;
+        /// Keeps the producer index on a cache line of its own
+        uint8_t padding_0[MDV_QUEUE_CACHE_LINE_SIZE - 4u];
+        /// Index of the next element to dequeue, written by the consumer
+        uint32_t head;
+        /// Keeps the consumer index on a cache line of its own
+        uint8_t padding_1[MDV_QUEUE_CACHE_LINE_SIZE - 4u];
+        /// Publication sequence of each slot
+        uint32_t *sequences;
+        /// Storage of the elements
+        uint8_t *elements;
+        /// Size of an element in bytes
+        uint32_t element_size;
+        /// Capacity minus one
+        uint32_t mask;
+} mdv_mpsc_queue_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a single-producer single-consumer queue
+ *
+ * \param[in] queue Queue to initialize
+ * \param[in] buffer Buffer of \ref MDV_SPSC_QUEUE_BUFFER_SIZE bytes
+ * \param[in] element_size Size of an element in bytes
+ * \param[in] capacity Capacity in elements, a power of two up to
+ *      \ref MDV_QUEUE_MAX_CAPACITY
+ *
+ * \return No return value
+ */
+void mdv_spsc_queue_init(mdv_spsc_queue_t *const queue,
+                         void *const buffer,
+                         uint32_t const element_size,
+                         uint32_t const capacity);
+
+/**
+ * \brief Enqueue elements
+ *
+ * May be called by the producer only.
+ *
+ * \param[in] queue Queue in use
+ * \param[in] elements Elements to enqueue
+ * \param[in] count Count of the elements
+ *
+ * \return Count of the elements enqueued, less than the count if the queue
+ *      became full
+ */
+uint32_t mdv_spsc_queue_enqueue(mdv_spsc_queue_t *const queue,
+                                void const *const elements,
+                                uint32_t const count);
+
+/**
+ * \brief Dequeue elements
+ *
+ * May be called by the consumer only.
+ *
+ * \param[in] queue Queue in use
+ * \param[out] elements Storage for the dequeued elements
+ * \param[in] count Largest count of the elements to dequeue
+ *
+ * \return Count of the elements dequeued
+ */
+uint32_t mdv_spsc_queue_dequeue(mdv_spsc_queue_t *const queue,
+                                void *const elements,
+                                uint32_t const count);
+
+/**
+ * \brief Get the count of the queued elements
+ *
+ * The count may be out of date already when returned, if the queue is used
+ * concurrently.
+ *
+ * \param[in] queue Queue in use
+ *
+ * \return Count of the elements in the queue
+ */
+uint32_t mdv_spsc_queue_get_count(mdv_spsc_queue_t *const queue);
+
+/**
+ * \brief Initialize a multi-producer single-consumer queue
+ *
+ * \param[in] queue Queue to initialize
+ * \param[in] buffer Buffer of \ref MDV_MPSC_QUEUE_BUFFER_SIZE bytes, aligned
+ *      to 32 bits
+ * \param[in] element_size Size of an element in bytes
+ * \param[in] capacity Capacity in elements, a power of two up to
+ *      \ref MDV_QUEUE_MAX_CAPACITY
+ *
+ * \return No return value
+ */
+void mdv_mpsc_queue_init(mdv_mpsc_queue_t *const queue,
+                         void *const buffer,
+                         uint32_t const element_size,
+                         uint32_t const capacity);
+
+/**
+ * \brief Enqueue elements
+ *
+ * May be called by any number of producers concurrently. The elements of one
+ * call are dequeued in order and without elements of other producers between
+ * them.
+ *
+ * \param[in] queue Queue in use
+ * \param[in] elements Elements to enqueue
+ * \param[in] count Count of the elements
+ *
+ * \return Count of the elements enqueued, less than the count if the queue
+ *      became full
+ */
+uint32_t mdv_mpsc_queue_enqueue(mdv_mpsc_queue_t *const queue,
+                                void const *const elements,
+                                uint32_t const count);
+
+/**
+ * \brief Dequeue elements
+ *
+ * May be called by the consumer only.
+ *
+ * \param[in] queue Queue in use
+ * \param[out] elements Storage for the dequeued elements
+ * \param[in] count Largest count of the elements to dequeue
+ *
+ * \return Count of the elements dequeued
+ */
+uint32_t mdv_mpsc_queue_dequeue(mdv_mpsc_queue_t *const queue,
+                                void *const elements,
+                                uint32_t const count);
+
+/**
+ * \brief Get the count of the reserved and queued elements
+ *
+ * The count may be out of date already when returned, if the queue is used
+ * concurrently.
+ *
+ * \param[in] queue Queue in use
+ *
+ * \return Count of the elements in the queue, including the ones still being
+ *      enqueued
+ */
+uint32_t mdv_mpsc_queue_get_count(mdv_mpsc_queue_t *const queue);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-queue */
+
+#endif // ifndef MDV_QUEUE_H
+
+/* EOF */
@@ -0,0 +1,193 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_shadow_output.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-shadow-output-internals Internals
+ * \ingroup  mdv-shadow-output
+ * @{
+ */
+
+/**
+ * \brief Write the shadow register to the output if it has changed
+ *
+ * \param[in] shadow_output Shadow register output in use
+ *
+ * \return The result of the write, or \ref MDV_RESULT_OK if nothing was
+ *      written
+ */
+static mdv_result_t flush(mdv_shadow_output_t *const shadow_output)
+{
+        uint32_t const shadow = shadow_output->shadow;
+        mdv_result_t result;
+
+        if (shadow == shadow_output->written) {
+                return MDV_RESULT_OK;
+        }
+
+        result = shadow_output->output->set(shadow);
+        if (MDV_SUCCESSFUL(result)) {
+                shadow_output->written = shadow;
+                ++shadow_output->stats.write_count;
+        } else {
+                ++shadow_output->stats.error_count;
+        }
+
+        return result;
+}
+
+/** @} mdv-shadow-output-internals */
+
+void mdv_shadow_output_init(mdv_shadow_output_t *const shadow_output,
+                            mdv_digital_output_t *const output,
+                            mdv_sw_timer_base_t *const sw_timer_base,
+                            uint32_t const initial_value)
+{
+        assert(shadow_output);
+        assert(output);
+        assert(output->set);
+
+        shadow_output->output = output;
+        shadow_output->sw_timer_base = sw_timer_base;
+        shadow_output->shadow = initial_value;
+        shadow_output->written = initial_value;
+        shadow_output->write_tick_count = 0;
+        shadow_output->stats.operation_count = 0;
+        shadow_output->stats.write_count = 0;
+        shadow_output->stats.saved_write_count = 0;
+        shadow_output->stats.error_count = 0;
+
+        // Allow a write during the current tick
+        if (sw_timer_base) {
+                shadow_output->write_tick_count =
+                        (mdv_sw_timer_base_get_tick_count(sw_timer_base) -
+                         1u) & mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        }
+}
+
+void mdv_shadow_output_set(mdv_shadow_output_t *const shadow_output,
+                           uint32_t const mask)
+{
+        assert(shadow_output);
+
+        shadow_output->shadow |= mask;
+        ++shadow_output->stats.operation_count;
+}
+
+void mdv_shadow_output_clear(mdv_shadow_output_t *const shadow_output,
+                             uint32_t const mask)
+{
+        assert(shadow_output);
+
+        shadow_output->shadow &= ~mask;
+        ++shadow_output->stats.operation_count;
+}
+
+void mdv_shadow_output_toggle(mdv_shadow_output_t *const shadow_output,
+                              uint32_t const mask)
+{
+        assert(shadow_output);
+
+        shadow_output->shadow ^= mask;
+        ++shadow_output->stats.operation_count;
+}
+
+void mdv_shadow_output_modify(mdv_shadow_output_t *const shadow_output,
+                              uint32_t const mask,
+                              uint32_t const value)
+{
+        assert(shadow_output);
+
+        shadow_output->shadow = (shadow_output->shadow & ~mask) |
+                                (value & mask);
+        ++shadow_output->stats.operation_count;
+}
+
+uint32_t mdv_shadow_output_get(mdv_shadow_output_t *const shadow_output)
+{
+        assert(shadow_output);
+
+        return shadow_output->shadow;
+}
+
+bool mdv_shadow_output_is_pending(mdv_shadow_output_t *const shadow_output)
+{
+        assert(shadow_output);
+
+        return shadow_output->shadow != shadow_output->written;
+}
+
+mdv_result_t mdv_shadow_output_commit(mdv_shadow_output_t *const shadow_output)
+{
+        assert(shadow_output);
+
+        return flush(shadow_output);
+}
+
+mdv_result_t mdv_shadow_output_process(
+        mdv_shadow_output_t *const shadow_output)
+{
+        uint32_t tick_count;
+
+        assert(shadow_output);
+        assert(shadow_output->sw_timer_base);
+
+        if (shadow_output->shadow == shadow_output->written) {
+                return MDV_RESULT_OK;
+        }
+
+        tick_count = mdv_sw_timer_base_get_tick_count(
+                shadow_output->sw_timer_base);
+        if (tick_count == shadow_output->write_tick_count) {
+                return MDV_RESULT_OK;
+        }
+        shadow_output->write_tick_count = tick_count;
+
+        return flush(shadow_output);
+}
+
+void mdv_shadow_output_get_stats(mdv_shadow_output_t *const shadow_output,
+                                 mdv_shadow_output_stats_t *const stats)
+{
+        assert(shadow_output);
+        assert(stats);
+
+        *stats = shadow_output->stats;
+        stats->saved_write_count =
+                stats->operation_count > stats->write_count ?
+                stats->operation_count - stats->write_count : 0;
+}
+
+/* EOF */
@@ -0,0 +1,227 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_SHADOW_OUTPUT_H
+#define MDV_SHADOW_OUTPUT_H
+
+#include "mdv_digital_output.h"
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_shadow_output.h
+ * \defgroup   mdv-shadow-output Shadow register output
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Batches the writes to a \ref mdv_digital_output_t. The lines are changed
+ * with masks in a shadow register in memory, and the shadow register is
+ * written to the output only when it is committed, or at most once per tick
+ * of the software timer base when processed. A commit is skipped when the
+ * shadow register equals to the value written last, so lines set and cleared
+ * again before the commit cause no write at all.
+ *
+ * The output is counted as written with the initial value. The operations and
+ * the writes are counted, so the writes saved by the batching can be
+ * monitored.
+ *
+ * @{
+ */
+
+/**
+ * \brief Statistics of a shadow register output
+ */
+typedef struct _mdv_shadow_output_stats_t{
+        /// Count of the operations on the shadow register, each of which would
+        /// be a write without the shadow register
+        uint32_t operation_count;
+        /// Count of the writes to the output
+        uint32_t write_count;
+        /// Count of the writes saved, the operations minus the writes
+        uint32_t saved_write_count;
+        /// Count of the failed writes to the output
+        uint32_t error_count;
+} mdv_shadow_output_stats_t;
+
+/**
+ * \brief Shadow register output data
+ */
+typedef struct _mdv_shadow_output_t{
+        /// Output to write
+        mdv_digital_output_t *output;
+        /// Timer base in use, or NULL if the output is only committed
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Value of the shadow register
+        uint32_t shadow;
+        /// Value written to the output last
+        uint32_t written;
+        /// Tick count of the latest write by \ref mdv_shadow_output_process
+        uint32_t write_tick_count;
+        /// Statistics of the output
+        mdv_shadow_output_stats_t stats;
+} mdv_shadow_output_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a shadow register output
+ *
+ * Nothing is written to the output. The output is expected to hold the
+ * initial value already.
+ *
+ * \param[in] shadow_output Shadow register output to initialize
+ * \param[in] output Output to write
+ * \param[in] sw_timer_base Timer base for \ref mdv_shadow_output_process, or
+ *      NULL if the output is only committed
+ * \param[in] initial_value Value of the output
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_init(mdv_shadow_output_t *const shadow_output,
+                            mdv_digital_output_t *const output,
+                            mdv_sw_timer_base_t *const sw_timer_base,
+                            uint32_t const initial_value);
+
+/**
+ * \brief Set lines to one
+ *
+ * \param[in] shadow_output Shadow register output in use
+ * \param[in] mask Lines to set
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_set(mdv_shadow_output_t *const shadow_output,
+                           uint32_t const mask);
+
+/**
+ * \brief Clear lines to zero
+ *
+ * \param[in] shadow_output Shadow register output in use
+ * \param[in] mask Lines to clear
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_clear(mdv_shadow_output_t *const shadow_output,
+                             uint32_t const mask);
+
+/**
+ * \brief Invert lines
+ *
+ * \param[in] shadow_output Shadow register output in use
+ * \param[in] mask Lines to invert
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_toggle(mdv_shadow_output_t *const shadow_output,
+                              uint32_t const mask);
+
+/**
+ * \brief Change lines to a value
+ *
+ * \param[in] shadow_output Shadow register output in use
+ * \param[in] mask Lines to change
+ * \param[in] value Value of the lines
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_modify(mdv_shadow_output_t *const shadow_output,
+                              uint32_t const mask,
+                              uint32_t const value);
+
+/**
+ * \brief Get the value of the shadow register
+ *
+ * \param[in] shadow_output Shadow register output in use
+ *
+ * \return Value of the shadow register, including the changes not written
+ *      yet
+ */
+uint32_t mdv_shadow_output_get(mdv_shadow_output_t *const shadow_output);
+
+/**
+ * \brief Check if the shadow register has changes not written yet
+ *
+ * \param[in] shadow_output Shadow register output in use
+ *
+ * \retval true The shadow register differs from the output
+ * \retval false The output is up to date
+ */
+bool mdv_shadow_output_is_pending(mdv_shadow_output_t *const shadow_output);
+
+/**
+ * \brief Write the shadow register to the output if it has changed
+ *
+ * If the write fails, the changes stay pending.
+ *
+ * \param[in] shadow_output Shadow register output in use
+ *
+ * \return The result of the write, or \ref MDV_RESULT_OK if nothing was
+ *      written
+ */
+mdv_result_t mdv_shadow_output_commit(mdv_shadow_output_t *const shadow_output);
+
+/**
+ * \brief Commit the shadow register if not written during the current tick
+ *
+ * Only the writes by this function are limited to one per tick. A failed
+ * write is retried on the next tick.
+ *
+ * \param[in] shadow_output Shadow register output in use
+ *
+ * \return The result of the write, or \ref MDV_RESULT_OK if nothing was
+ *      written
+ */
+mdv_result_t mdv_shadow_output_process(
+        mdv_shadow_output_t *const shadow_output);
+
+/**
+ * \brief Get the statistics of the output
+ *
+ * \param[in] shadow_output Shadow register output in use
+ * \param[out] stats Statistics of the output
+ *
+ * \return No return value
+ */
+void mdv_shadow_output_get_stats(mdv_shadow_output_t *const shadow_output,
+                                 mdv_shadow_output_stats_t *const stats);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-shadow-output */
+
+#endif // ifndef MDV_SHADOW_OUTPUT_H
+
+/* EOF */
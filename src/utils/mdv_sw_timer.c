@@ -41,101 +41,6 @@
  * @{
  */
 
-/// Microseconds in one millisecond
-#define US_IN_ONE_MS 1000u
-/// Microseconds in one second
-#define US_IN_ONE_SECOND 1000000u
-
- #ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-
-/**
- * \brief Initialize the timer starvation detection
- *
- * \param[in] starvation_avereness Starvation avereness data
- * \param[in] initial_tick_count Initial tick count
- *
- * \return No return value
- */
-static void init_starvation_detection(
-        mdv_sw_timer_starvation_avereness_t *const starvation_avereness,
-        uint32_t const initial_tick_count)
-{
-        starvation_avereness->last_tick_count = initial_tick_count;
-}
-
-/**
- * \brief Check if starvation detection is enabled
- *
- * \param[in] starvation_avereness Starvation avereness data
- *
- * \retval true Starvation detection is enabled
- * \retval false Starvation detection is disabled
- */
-static bool is_starvation_detection_enabled(
-        mdv_sw_timer_starvation_avereness_t *const starvation_avereness)
-{
-        // Starvation detection is enabled, if the invocation limit has been set
-        // to a non-zero value.
-        return !!(starvation_avereness->invocation_limit);
-}
-
-/**
- * \brief Manage invocation count for starvation detection
- *
- * \param[in] starvation_avereness Starvation avereness data
- * \param[in] tick_count Current tick count
- *
- * \return No return value
- */
-static void manage_invocation_count(
-        mdv_sw_timer_starvation_avereness_t *const starvation_avereness,
-        uint32_t const tick_count)
-{
-        // If the timer tick count increases between the invocations, the
-        // timer base is alive and there is no starvation. Otherwise, the
-        // starvation avereness system counts the time how long the timer base
-        // is not responding.
-        if ((starvation_avereness->last_tick_count == tick_count)) {
-                // Stop invocation counter to the maximum value
-                if (starvation_avereness->invocation_count < UINT32_MAX) {
-                        ++starvation_avereness->invocation_count;
-                }
-        }else{
-                starvation_avereness->invocation_count = 0;
-        }
-
-        // Keep the last tick count on track.
-        starvation_avereness->last_tick_count = tick_count;
-}
-
-/**
- * \brief Check if timer is starving
- *
- * \param[in] starvation_avereness Starvation avereness data
- * \param[in] tick_count Tick count from the timer base
- *
- * \retval true Timer is starving
- * \retval false Timer is not starving
- */
-static bool is_timer_starving(
-        mdv_sw_timer_starvation_avereness_t *const starvation_avereness,
-        uint32_t const tick_count)
-{
-        // If the starvation detection is disabled, the timer can't be starving.
-        if (!is_starvation_detection_enabled(starvation_avereness)) {
-                return false;
-        }
-
-        manage_invocation_count(starvation_avereness, tick_count);
-
-        // Check if the invocation count exceeds or equals to the invocation
-        // limit, and return the result as a boolean value
-        return (starvation_avereness->invocation_count >=
-                starvation_avereness->invocation_limit);
-}
-
-#endif // MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-
 /**
  * \brief Get time in ticks and manage timer wrap-around situations
  *
@@ -153,50 +58,6 @@ static uint32_t get_time_in_ticks(uint32_t const timer_mask,
                 ((timer_mask - tick_count_startup_sample) + tick_count + 1);
 }
 
-/**
- * \brief Get time for the tick count
- *
- * \param[in] tick_duration_us Duration of one tick in microseconds
- * \param[in] tick_count Tick count
- * \param[in] order_of_magnitude
- *
- * \return Time in the given order of magnitude
- */
-static uint32_t get_time_for_tick_count(uint32_t const tick_duration_us,
-        uint32_t const tick_count,
-        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude)
-{
-        uint32_t time;
-
-        // Calculate the time lapse based on the time base and the requested
-        // order of magnitude.
-        switch (order_of_magnitude) {
-        case MDV_SW_TIMER_US:
-                // Calculate time in microseconds
-                time = (tick_count * tick_duration_us);
-                break;
-
-        case MDV_SW_TIMER_MS:
-                // Calculate time in milliseconds
-                time = (tick_count * tick_duration_us) / US_IN_ONE_MS;
-                break;
-
-        case MDV_SW_TIMER_S:
-                // Calculate time in seconds
-                time = (tick_count * tick_duration_us) / US_IN_ONE_SECOND;
-                break;
-
-        case MDV_SW_TIMER_TIMERTICK:
-        default:
-                // The time value is in correct order of magnitude, or the order
-                // of magnitude is unknown
-                time = tick_count;
-                break;
-        }
-
-        return time;
-}
-
 /** @} mdv-sw-timer-internals */
 
 void mdv_sw_timer_init(mdv_sw_timer_t *const sw_timer,
@@ -205,8 +66,7 @@ void mdv_sw_timer_init(mdv_sw_timer_t *const sw_timer,
         assert(sw_timer);
         assert(sw_timer_base);
 
-        // Reset all timer data (this resets also the starvation averness if
-        // that feature is enabled)
+        // Reset all timer data
         memset(sw_timer, 0, sizeof(mdv_sw_timer_t));
         // Link the timer with the timer base
         sw_timer->sw_timer_base = sw_timer_base;
@@ -216,6 +76,9 @@ void mdv_sw_timer_init(mdv_sw_timer_t *const sw_timer,
         // Get the timer mask from the timer base
         sw_timer->timer_mask =
                 mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        // Get the precomputed conversion factors from the timer base
+        sw_timer->conversion =
+                mdv_sw_timer_base_get_conversion(sw_timer_base);
 }
 
 #ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
@@ -224,21 +87,23 @@ void mdv_sw_timer_set_invocation_limit(
 {
         assert(sw_timer);
 
-        sw_timer->starvation_avereness.invocation_limit = invocation_limit;
+        // The timer base monitors the starvation for all of its timers
+        mdv_sw_timer_base_set_starvation_monitor(sw_timer->sw_timer_base,
+                                                 invocation_limit, 0, 0);
 }
-#endif // MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
+#endif // ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
 
 void mdv_sw_timer_start(mdv_sw_timer_t *const sw_timer)
 {
         assert(sw_timer);
 
+        // Read the timer base once, so that both start values belong to the
+        // same sample
+        sw_timer->tick_count_startup_sample64 =
+                mdv_sw_timer_base_get_tick_count64(sw_timer->sw_timer_base);
         sw_timer->tick_count_startup_sample =
-                mdv_sw_timer_base_get_tick_count(sw_timer->sw_timer_base);
-
-#ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-        init_starvation_detection(&(sw_timer->starvation_avereness),
-                sw_timer->tick_count_startup_sample);
-#endif // MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
+                (uint32_t)sw_timer->tick_count_startup_sample64 &
+                sw_timer->timer_mask;
 }
 
 void mdv_sw_timer_get_time(
@@ -257,13 +122,29 @@ void mdv_sw_timer_get_time(
         tick_count = get_time_in_ticks(sw_timer->timer_mask,
                 sw_timer->tick_count_startup_sample, tick_count);
 
-#ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-        assert(!is_timer_starving(&(sw_timer->starvation_avereness),
-                                  tick_count));
-#endif // MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
+        *time = mdv_sw_timer_conversion_get_time(sw_timer->conversion,
+                                                 tick_count,
+                                                 order_of_magnitude);
+}
+
+void mdv_sw_timer_get_time64(
+        mdv_sw_timer_t *const sw_timer,
+        mdv_sw_timer_order_of_magnitude_t order_of_magnitude,
+        uint64_t *const time)
+{
+        assert(sw_timer);
+        assert(time);
+
+        uint64_t tick_count;
+
+        // Get the current extended tick count, which doesn't wrap around
+        tick_count = mdv_sw_timer_base_get_tick_count64(
+                sw_timer->sw_timer_base) -
+                sw_timer->tick_count_startup_sample64;
 
-        *time = get_time_for_tick_count(sw_timer->tick_duration_us,
-                                        tick_count, order_of_magnitude);
+        *time = mdv_sw_timer_conversion_get_time64(sw_timer->conversion,
+                                                   tick_count,
+                                                   order_of_magnitude);
 }
 
 /* EOF */
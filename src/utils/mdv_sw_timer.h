@@ -42,48 +42,19 @@
  * \ingroup    madivaru-lib-v2
  * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
  *
- * This timer is equipped with a starvation avereness functionality. That
- * feature is used to detect situations where the underlying hardware or
- * software timer stops running, but the software is still waiting the timer.
- * The starvation detection recognizes the situation and raises an error.
+ * The starvation of the timers is detected once for all timers by the
+ * starvation monitor of the timer base, see
+ * \ref mdv_sw_timer_base_set_starvation_monitor. The monitor is updated by
+ * \ref mdv_sw_timer_base_latch, not by the time queries of the timers.
  *
- * If the starvation avareness is not needed, the functionality can be disabled
- * by adding the define MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS to the project
- * options. Disabling the feature saves some memory for each timer instance, and
- * has a small impact to the overall timer perfomance.
+ * The deprecated \ref mdv_sw_timer_set_invocation_limit configures the
+ * starvation monitor of the timer base. Defining
+ * MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS removes it, but no longer changes
+ * the size or the performance of the timers.
  *
  * @{
  */
 
-/**
- * \brief Order of magnitude of time
- */
-typedef enum _mdv_sw_timer_order_of_magnitude_t{
-        /// The order of magnitude equals to timer ticks
-        MDV_SW_TIMER_TIMERTICK = 0,
-        /// The order of magnitude is microseconds
-        MDV_SW_TIMER_US,
-        /// The order of magnitude is milliseconds
-        MDV_SW_TIMER_MS,
-        /// The order of magnitude is seconds
-        MDV_SW_TIMER_S
-} mdv_sw_timer_order_of_magnitude_t;
-
-#ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-/**
- * \brief Timer starvation avereness data
- */
-typedef struct _mdv_sw_timer_starvation_avereness_t{
-        /// Limit for \ref mdv_sw_timer_get_time invocations to detect timer
-        /// starvation when the timer system is not running
-        uint32_t invocation_limit;
-        /// Invocation count for \ref mdv_sw_timer_get_time invocations
-        uint32_t invocation_count;
-        /// Last tick count value for detecting starvation
-        uint32_t last_tick_count;
-} mdv_sw_timer_starvation_avereness_t;
-#endif // ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-
 /**
  * \brief Timer data
  */
@@ -92,14 +63,17 @@ typedef struct _mdv_sw_timer_t{
         mdv_sw_timer_base_t *sw_timer_base;
         /// \brief Sample from the tick counter when the timer is started
         uint32_t tick_count_startup_sample;
-        /// Time tick duration (in nanoseconds), inherited from the timer base
+        /// \brief Sample from the extended tick counter when the timer is
+        /// started
+        uint64_t tick_count_startup_sample64;
+        /// Time tick duration (in microseconds), inherited from the timer base
+        /// (deprecated, zero for the tick periods shorter than one
+        /// microsecond)
         uint32_t tick_duration_us;
         /// Timer counter mask, inherited from the timer base
         uint32_t timer_mask;
-#ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
-        /// Timer starvation avereness support
-        mdv_sw_timer_starvation_avereness_t starvation_avereness;
-#endif // ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
+        /// Conversion factors, inherited from the timer base
+        mdv_sw_timer_conversion_t const *conversion;
 } mdv_sw_timer_t;
 
 #ifdef __cplusplus
@@ -119,9 +93,15 @@ void mdv_sw_timer_init(mdv_sw_timer_t *const sw_timer,
 
 #ifndef MDV_DISABLE_SW_TIMER_STARVATION_AVERENESS
 /**
- * \brief Set invocation limit for \ref timer_get_time function
+ * \brief Set invocation limit for the starvation detection
+ *
+ * \deprecated The starvation is detected by the timer base for all timers
+ *      using it. This function configures the starvation monitor of the timer
+ *      base without a handler, and the limit counts the calls of
+ *      \ref mdv_sw_timer_base_latch instead of the time queries. Use
+ *      \ref mdv_sw_timer_base_set_starvation_monitor instead.
  *
- * \param[in] timer Timer to configure
+ * \param[in] timer Timer whose timer base to configure
  * \param[in] invocation_limit Invocation limit (set to 0 to disable the
  *      starvation check)
  *
@@ -152,6 +132,22 @@ void mdv_sw_timer_get_time(
         mdv_sw_timer_order_of_magnitude_t order_of_magnitude,
         uint32_t *const time);
 
+/**
+ * \brief Get the time elapsed from the timer start using 64-bit arithmetic
+ *
+ * The time is calculated from the extended tick count of the timer base, so
+ * it is not limited by the timer width or by the 32-bit range of the time
+ * value.
+ *
+ * \param[in] timer Timer in use
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[out] time Elapsed time in the given order of magnitude
+ */
+void mdv_sw_timer_get_time64(
+        mdv_sw_timer_t *const sw_timer,
+        mdv_sw_timer_order_of_magnitude_t order_of_magnitude,
+        uint64_t *const time);
+
 #ifdef __cplusplus
 }
 #endif // ifdef __cplusplus
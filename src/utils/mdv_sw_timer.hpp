@@ -0,0 +1,264 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_SW_TIMER_HPP
+#define MDV_SW_TIMER_HPP
+
+#include "mdv_sw_timer.h"
+#include <cassert>
+
+/**
+ * \file       mdv_sw_timer.hpp
+ * \defgroup   mdv-sw-timer-cpp Compile-time specialized software timer
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Optional header-only C++ layer over the software timer. The tick duration,
+ * the timer width, the timer mask and the conversion factors are template
+ * parameters and constants, and the tick source is bound statically, so the
+ * compiler can inline the counter read and fold the constants. The elapsed
+ * time is then a counter read, a subtraction, an AND and a multiplication
+ * followed by a constant division, which the compiler replaces with
+ * a multiplication.
+ *
+ * The tick source is a type with a static get_count() function returning the
+ * counter value. It can read a hardware register directly, or the tick
+ * counter of a C timer base with \ref mdv::sw_timer_base_tick_source.
+ *
+ * \ref mdv::sw_timer holds exactly one \ref mdv_sw_timer_t, so it can be
+ * passed to the C functions, and it can share a timer base with the C code.
+ * Starting the timer in C++ sets the 32-bit startup sample only, so the
+ * 64-bit time of the C interface requires starting the timer with
+ * \ref mdv_sw_timer_start.
+ *
+ * @{
+ */
+
+namespace mdv {
+
+/**
+ * \brief Compile-time constants of a software timer configuration
+ *
+ * \tparam TickUs Duration of one tick in microseconds
+ * \tparam WidthBits Timer width in bits from 1 to 32
+ */
+template <uint32_t TickUs, uint8_t WidthBits>
+struct sw_timer_traits {
+        static_assert(TickUs > 0u, "Tick duration must be greater than zero");
+        static_assert(TickUs <= MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US,
+                      "Tick duration must fit the tick period");
+        static_assert((WidthBits > 0u) && (WidthBits <= 32u),
+                      "Timer width must be from 1 to 32 bits");
+
+        /// Duration of one tick in microseconds
+        static constexpr uint32_t tick_duration_us = TickUs;
+        /// Timer width in bits
+        static constexpr uint8_t timer_width_bits = WidthBits;
+        /// Timer mask for the timer width
+        static constexpr uint32_t timer_mask =
+                0xffffffffu >> (32u - WidthBits);
+        /// Period of one tick in Q32.32 nanoseconds
+        static constexpr uint64_t tick_period_ns_q32 =
+                ((uint64_t)TickUs * MDV_SW_TIMER_NS_IN_ONE_US) << 32;
+
+        /**
+         * \brief Get the greatest common divisor
+         *
+         * \param[in] a First value
+         * \param[in] b Second value
+         *
+         * \return The greatest common divisor of the values
+         */
+        static constexpr uint32_t gcd(uint32_t a, uint32_t b)
+        {
+                return b ? gcd(b, a % b) : a;
+        }
+
+        /**
+         * \brief Get the microseconds in one unit of an order of magnitude
+         *
+         * \tparam Order The order of magnitude
+         *
+         * \return The microseconds in one unit, or zero for the timer ticks
+         *      and the nanoseconds
+         */
+        template <mdv_sw_timer_order_of_magnitude_t Order>
+        static constexpr uint32_t us_in_unit()
+        {
+                return (Order == MDV_SW_TIMER_US) ? 1u :
+                       (Order == MDV_SW_TIMER_MS) ?
+                               MDV_SW_TIMER_US_IN_ONE_MS :
+                       (Order == MDV_SW_TIMER_S) ?
+                               MDV_SW_TIMER_US_IN_ONE_SECOND : 0u;
+        }
+
+        /**
+         * \brief Convert a tick count to time
+         *
+         * The tick duration and the unit are reduced by their greatest common
+         * divisor, so the result is exact whenever the reduced product fits
+         * in 32 bits, like in \ref mdv_sw_timer_conversion_get_time. The time
+         * in nanoseconds wraps around like the product.
+         *
+         * \tparam Order The order of magnitude of time to use
+         *
+         * \param[in] tick_count Tick count to convert
+         *
+         * \return Time in the given order of magnitude
+         */
+        template <mdv_sw_timer_order_of_magnitude_t Order>
+        static constexpr uint32_t get_time(uint32_t const tick_count)
+        {
+                return (Order == MDV_SW_TIMER_NS) ?
+                       tick_count * (TickUs * MDV_SW_TIMER_NS_IN_ONE_US) :
+                       us_in_unit<Order>() ?
+                       (tick_count *
+                        (TickUs / gcd(TickUs, us_in_unit<Order>()))) /
+                       (us_in_unit<Order>() /
+                        gcd(TickUs, us_in_unit<Order>())) :
+                       tick_count;
+        }
+};
+
+/**
+ * \brief Tick source reading the tick counter of a C timer base
+ *
+ * The counter is read directly from the timer base, so the timer base must
+ * be in the tick mode or in the event driven mode, and the snapshot mode of
+ * the timer base is not used.
+ *
+ * \tparam Base The timer base
+ */
+template <mdv_sw_timer_base_t *Base>
+struct sw_timer_base_tick_source {
+        /**
+         * \brief Get the current tick count
+         *
+         * \return The tick count of the timer base
+         */
+        static uint32_t get_count()
+        {
+                return mdv_atomic_load_acquire_u32(&(Base->tick_counter));
+        }
+};
+
+/**
+ * \brief Software timer specialized at compile time
+ *
+ * \tparam TickUs Duration of one tick in microseconds
+ * \tparam WidthBits Timer width in bits from 1 to 32
+ * \tparam TickSource Type with a static get_count() function
+ */
+template <uint32_t TickUs, uint8_t WidthBits, typename TickSource>
+class sw_timer {
+        public:
+
+        /// Compile-time constants of the timer
+        using traits = sw_timer_traits<TickUs, WidthBits>;
+
+        /**
+         * \brief Create a timer without a timer base
+         *
+         * The timer can be used only through this class.
+         */
+        sw_timer() : m_sw_timer()
+        {
+                m_sw_timer.tick_duration_us = TickUs;
+                m_sw_timer.timer_mask = traits::timer_mask;
+        }
+
+        /**
+         * \brief Create a timer sharing a timer base with the C code
+         *
+         * \param[in] sw_timer_base Timer base, configured with the same tick
+         *      duration and the same timer width
+         */
+        explicit sw_timer(mdv_sw_timer_base_t *const sw_timer_base)
+                : m_sw_timer()
+        {
+                mdv_sw_timer_init(&m_sw_timer, sw_timer_base);
+
+                // The tick duration in microseconds is rounded down, so the
+                // exact tick period is checked instead
+                assert(mdv_sw_timer_base_get_tick_period_ns_q32(
+                               sw_timer_base) == traits::tick_period_ns_q32);
+                assert(m_sw_timer.timer_mask == traits::timer_mask);
+        }
+
+        /**
+         * \brief Start the timer
+         */
+        void start()
+        {
+                m_sw_timer.tick_count_startup_sample = TickSource::get_count();
+        }
+
+        /**
+         * \brief Get the time elapsed from the timer start
+         *
+         * \tparam Order The order of magnitude of time to use
+         *
+         * \return Elapsed time in the given order of magnitude
+         */
+        template <mdv_sw_timer_order_of_magnitude_t Order>
+        uint32_t get_time() const
+        {
+                return traits::template get_time<Order>(
+                        (TickSource::get_count() -
+                         m_sw_timer.tick_count_startup_sample) &
+                        traits::timer_mask);
+        }
+
+        /**
+         * \brief Get the C timer
+         *
+         * \return The timer to be used with the C functions
+         */
+        mdv_sw_timer_t *c_timer()
+        {
+                return &m_sw_timer;
+        }
+
+        private:
+
+        /// The C timer
+        mdv_sw_timer_t m_sw_timer;
+};
+
+} // namespace mdv
+
+/** @} mdv-sw-timer-cpp */
+
+#endif // ifndef MDV_SW_TIMER_HPP
+
+/* EOF */
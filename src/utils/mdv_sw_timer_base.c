@@ -59,6 +59,506 @@ uint32_t create_mask(uint8_t bits)
         return mask;
 }
 
+/**
+ * \brief Initialize the common instance data of the software timer base
+ *
+ * The tick duration and the conversion factors are set by the caller.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver (optional)
+ * \param[in] mode Operating mode
+ *
+ * \return No return value
+ */
+static void init_instance(mdv_sw_timer_base_t *const sw_timer_base,
+                          uint8_t const timer_width_bits,
+                          mdv_timer_driver_t *const timer_driver,
+                          mdv_sw_timer_base_mode_t const mode)
+{
+        assert(sw_timer_base);
+        assert((timer_width_bits > 0) && (timer_width_bits <= 32));
+
+        sw_timer_base->timer_mask = create_mask(timer_width_bits);
+        sw_timer_base->counter_mask = sw_timer_base->timer_mask;
+        sw_timer_base->guard_tick_count = 0;
+        sw_timer_base->tick_counter = 0;
+        sw_timer_base->tick_counter64 = 0;
+        sw_timer_base->tick_counter64_latch[0] = 0;
+        sw_timer_base->tick_counter64_latch[1] = 0;
+        sw_timer_base->sequence = 0;
+        sw_timer_base->update_lock = 0;
+        sw_timer_base->timer_driver = timer_driver;
+        sw_timer_base->mode = mode;
+        sw_timer_base->event_handler = 0;
+        sw_timer_base->event_user_data = 0;
+        sw_timer_base->deadline_provider = 0;
+        sw_timer_base->deadline_user_data = 0;
+        sw_timer_base->is_snapshot_enabled = false;
+        sw_timer_base->snapshot_tick_count = 0;
+        sw_timer_base->snapshot_tick_count64 = 0;
+        sw_timer_base->starvation_monitor.stall_limit = 0;
+        sw_timer_base->starvation_monitor.stall_count = 0;
+        sw_timer_base->starvation_monitor.last_tick_count64 = 0;
+        sw_timer_base->starvation_monitor.latch_period_ticks = 0;
+        sw_timer_base->starvation_monitor.handler = 0;
+        sw_timer_base->starvation_monitor.user_data = 0;
+}
+
+/**
+ * \brief Get the tick period for a tick duration in microseconds
+ *
+ * \param[in] tick_duration_us Duration of one timer tick in microseconds
+ *
+ * \return Tick period in Q32.32 nanoseconds
+ */
+static uint64_t get_tick_period(uint32_t const tick_duration_us)
+{
+        assert(tick_duration_us > 0);
+        // The Q32.32 format holds the periods shorter than 2^32 nanoseconds
+        assert(tick_duration_us <= MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US);
+
+        return ((uint64_t)tick_duration_us * MDV_SW_TIMER_NS_IN_ONE_US) << 32;
+}
+
+/**
+ * \brief Set the tick period in Q32.32 nanoseconds
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_period_ns_q32 Period of one timer tick in Q32.32
+ *      nanoseconds
+ *
+ * \return No return value
+ */
+static void set_tick_period(mdv_sw_timer_base_t *const sw_timer_base,
+                            uint64_t const tick_period_ns_q32)
+{
+        uint32_t const tick_period_ns = (uint32_t)(tick_period_ns_q32 >> 32);
+
+        assert(sw_timer_base);
+        assert(tick_period_ns_q32 > 0);
+
+        // The tick duration in microseconds is only kept for compatibility
+        sw_timer_base->tick_duration_us =
+                tick_period_ns / MDV_SW_TIMER_NS_IN_ONE_US;
+        sw_timer_base->tick_period_ns_q32 = tick_period_ns_q32;
+
+        // Precompute the conversion factors once for all software timers. A
+        // period of whole microseconds uses the exact integer factors.
+        if (!(uint32_t)tick_period_ns_q32 &&
+            !(tick_period_ns % MDV_SW_TIMER_NS_IN_ONE_US)) {
+                mdv_sw_timer_conversion_init(&(sw_timer_base->conversion),
+                                             sw_timer_base->tick_duration_us);
+        } else {
+                mdv_sw_timer_conversion_init_period(
+                        &(sw_timer_base->conversion), tick_period_ns_q32);
+        }
+}
+
+/**
+ * \brief Publish the extended tick count to the readers
+ *
+ * Both copies of the extended tick count are updated in turn. The sequence
+ * counter directs the readers to the copy not being updated.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return No return value
+ */
+static void publish_tick_count64(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        uint32_t const sequence =
+                mdv_atomic_load_relaxed_u32(&(sw_timer_base->sequence));
+
+        // Each release store keeps the preceding store before it, so a copy
+        // never changes before the sequence counter has moved away from it
+        mdv_atomic_store_relaxed_u32(&(sw_timer_base->sequence), sequence + 1u);
+        mdv_atomic_store_release_u64(&(sw_timer_base->tick_counter64_latch[0]),
+                                     sw_timer_base->tick_counter64);
+        mdv_atomic_store_release_u32(&(sw_timer_base->sequence), sequence + 2u);
+        mdv_atomic_store_release_u64(&(sw_timer_base->tick_counter64_latch[1]),
+                                     sw_timer_base->tick_counter64);
+}
+
+/**
+ * \brief Read the published extended tick count
+ *
+ * The reader never waits for the writer. It retries only if the writer
+ * updated the tick count during the read.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The extended tick count
+ */
+static uint64_t read_tick_count64(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        uint32_t sequence;
+        uint64_t tick_count;
+
+        do {
+                sequence = mdv_atomic_load_acquire_u32(
+                        &(sw_timer_base->sequence));
+                // The acquire load keeps the second sequence counter load
+                // after it
+                tick_count = mdv_atomic_load_acquire_u64(
+                        &(sw_timer_base->tick_counter64_latch[sequence & 1u]));
+        } while (sequence !=
+                 mdv_atomic_load_relaxed_u32(&(sw_timer_base->sequence)));
+
+        return tick_count;
+}
+
+/**
+ * \brief Update the extended tick count with a new tick count sample
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[in] tick_count Current tick count
+ *
+ * \return No return value
+ */
+static void extend_tick_count(mdv_sw_timer_base_t *const sw_timer_base,
+                              uint32_t const tick_count)
+{
+        uint32_t const masked_tick_count =
+                tick_count & sw_timer_base->timer_mask;
+
+        // The tick counter holds the previous sample. The timer mask handles
+        // the wrap-around between the samples.
+        sw_timer_base->tick_counter64 +=
+                (masked_tick_count - sw_timer_base->tick_counter) &
+                sw_timer_base->timer_mask;
+        mdv_atomic_store_release_u32(&(sw_timer_base->tick_counter),
+                                     masked_tick_count);
+        publish_tick_count64(sw_timer_base);
+}
+
+/**
+ * \brief Dispatch the due work after the tick counter has advanced
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return No return value
+ */
+static void dispatch_event(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        if (sw_timer_base->event_handler) {
+                sw_timer_base->event_handler(sw_timer_base->event_user_data,
+                                             sw_timer_base->tick_counter);
+        }
+}
+
+/**
+ * \brief Handle a timer driver event in the event driven mode
+ *
+ * \param[in] user_data The software timer base
+ * \param[in] counter The current timer counter value
+ *
+ * \return No return value
+ */
+static void handle_timer_event(void *const user_data, uint32_t const counter)
+{
+        mdv_sw_timer_base_t *const sw_timer_base =
+                (mdv_sw_timer_base_t *)user_data;
+
+        assert(sw_timer_base);
+
+        // Store the counter value so that reading the tick count doesn't need
+        // to access the timer hardware
+        extend_tick_count(sw_timer_base, counter);
+
+        dispatch_event(sw_timer_base);
+}
+
+/**
+ * \brief Program the compare value for the earliest pending deadline
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return Count of ticks from the current tick count to the programmed
+ *      compare value
+ */
+static uint32_t program_deadline(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        // Wake up at least twice per counter period, so that the elapsed
+        // ticks are always shorter than one period
+        uint32_t const max_delay = (sw_timer_base->timer_mask >> 1u) + 1u;
+        uint32_t delay = max_delay;
+
+        if (sw_timer_base->deadline_provider) {
+                delay = sw_timer_base->deadline_provider(
+                        sw_timer_base->deadline_user_data,
+                        sw_timer_base->tick_counter);
+        }
+
+        // A deadline already due is handled on the next tick
+        if (!delay) {
+                delay = 1u;
+        } else if (delay > max_delay) {
+                delay = max_delay;
+        }
+
+        sw_timer_base->timer_driver->set_compare(
+                (sw_timer_base->tick_counter + delay) &
+                sw_timer_base->timer_mask);
+
+        return delay;
+}
+
+/**
+ * \brief Handle a timer driver event in the tickless mode
+ *
+ * \param[in] user_data The software timer base
+ * \param[in] counter The current timer counter value
+ *
+ * \return No return value
+ */
+static void handle_tickless_event(void *const user_data, uint32_t counter)
+{
+        mdv_sw_timer_base_t *const sw_timer_base =
+                (mdv_sw_timer_base_t *)user_data;
+        uint32_t delay;
+
+        assert(sw_timer_base);
+
+        do {
+                // Credit all the ticks elapsed since the previous event at
+                // once
+                extend_tick_count(sw_timer_base, counter);
+
+                dispatch_event(sw_timer_base);
+
+                delay = program_deadline(sw_timer_base);
+
+                // If the counter passed the compare value while it was being
+                // programmed, the event may have been missed. Handle the
+                // deadline right away.
+                counter = sw_timer_base->timer_driver->get_count();
+        } while (((counter - sw_timer_base->tick_counter) &
+                  sw_timer_base->timer_mask) >= delay);
+}
+
+/**
+ * \brief Read the extended tick count in the tickless mode
+ *
+ * The tick counters are updated only when the timer base wakes up, so the
+ * ticks elapsed since then are read from the timer hardware.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The extended tick count
+ */
+static uint64_t read_tickless_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        uint64_t const tick_count64 = read_tick_count64(sw_timer_base);
+
+        // The lowest bits of the extended tick count equal to the counter
+        // value of the latest wake-up
+        return tick_count64 +
+               ((sw_timer_base->timer_driver->get_count() -
+                 (uint32_t)tick_count64) & sw_timer_base->timer_mask);
+}
+
+/**
+ * \brief Read the extended tick count in the polling mode
+ *
+ * One context at a time samples the timer hardware and updates the extended
+ * tick count. A context interrupting the update, such as an interrupt handler
+ * starting a software timer, doesn't wait for it, but adds the ticks elapsed
+ * since the published count, as in the tickless mode.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The extended tick count
+ */
+static uint64_t read_polling_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        uint32_t expected = 0;
+        uint64_t tick_count64;
+
+        if (!mdv_atomic_compare_exchange_u32(&(sw_timer_base->update_lock),
+                                             &expected, 1u)) {
+                return read_tickless_tick_count64(sw_timer_base);
+        }
+
+        // The counter is sampled only after the update has been claimed, so
+        // the samples never go backwards
+        extend_tick_count(sw_timer_base,
+                          sw_timer_base->timer_driver->get_count());
+        tick_count64 = sw_timer_base->tick_counter64;
+
+        mdv_atomic_store_release_u32(&(sw_timer_base->update_lock), 0u);
+
+        return tick_count64;
+}
+
+/**
+ * \brief Handle a counter overflow event in the width extension mode
+ *
+ * \param[in] user_data The software timer base
+ * \param[in] counter The current timer counter value
+ *
+ * \return No return value
+ */
+static void handle_overflow_event(void *const user_data,
+                                  uint32_t const counter)
+{
+        mdv_sw_timer_base_t *const sw_timer_base =
+                (mdv_sw_timer_base_t *)user_data;
+
+        assert(sw_timer_base);
+
+        // The high part of the tick count advances by one counter period
+        sw_timer_base->tick_counter64 +=
+                (uint64_t)sw_timer_base->counter_mask + 1u;
+        mdv_atomic_store_release_u32(&(sw_timer_base->tick_counter),
+                                     (uint32_t)sw_timer_base->tick_counter64);
+        publish_tick_count64(sw_timer_base);
+
+        // Keep the guard less than one counter period old, so that a tick
+        // count far ahead of it is never taken for a step back
+        mdv_atomic_store_relaxed_u32(
+                &(sw_timer_base->guard_tick_count),
+                (uint32_t)sw_timer_base->tick_counter64 +
+                (counter & sw_timer_base->counter_mask));
+}
+
+/**
+ * \brief Read the extended tick count in the width extension mode
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The extended tick count
+ */
+static uint64_t read_extended_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        uint64_t tick_count64;
+        uint32_t counter;
+        uint32_t step_back;
+
+        // Read the high part before and after the hardware counter. If they
+        // differ, an overflow was handled between the reads, and the counter
+        // value may belong to either period.
+        do {
+                tick_count64 = read_tick_count64(sw_timer_base);
+                counter = sw_timer_base->timer_driver->get_count();
+        } while (tick_count64 != read_tick_count64(sw_timer_base));
+
+        tick_count64 += counter & sw_timer_base->counter_mask;
+
+        // A count less than one counter period behind the latest count seen
+        // means that the counter has overflowed, but the overflow event is
+        // still pending
+        step_back = mdv_atomic_load_relaxed_u32(
+                &(sw_timer_base->guard_tick_count)) - (uint32_t)tick_count64;
+        if (step_back && (step_back <= sw_timer_base->counter_mask)) {
+                tick_count64 += (uint64_t)sw_timer_base->counter_mask + 1u;
+        }
+
+        mdv_atomic_store_relaxed_u32(&(sw_timer_base->guard_tick_count),
+                                     (uint32_t)tick_count64);
+
+        return tick_count64;
+}
+
+/**
+ * \brief Read the current extended tick count in any operating mode
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The extended tick count
+ */
+static uint64_t read_current_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        switch (sw_timer_base->mode) {
+        case MDV_SW_TIMER_BASE_MODE_POLLING:
+                // In the polling mode, the local tick counter keeps the
+                // previous hardware counter sample for tracking the
+                // wrap-arounds
+                if (sw_timer_base->timer_driver) {
+                        return read_polling_tick_count64(sw_timer_base);
+                }
+                break;
+        case MDV_SW_TIMER_BASE_MODE_TICKLESS:
+                return read_tickless_tick_count64(sw_timer_base);
+        case MDV_SW_TIMER_BASE_MODE_EXTENDED:
+                return read_extended_tick_count64(sw_timer_base);
+        default:
+                break;
+        }
+
+        return read_tick_count64(sw_timer_base);
+}
+
+/**
+ * \brief Estimate the time of the ongoing stall
+ *
+ * \param[in] starvation_monitor Starvation monitor in use
+ * \param[in] conversion Conversion factors of the timer base
+ *
+ * \return Estimated stall time in microseconds
+ */
+static uint64_t get_stall_time_us(
+        mdv_sw_timer_base_starvation_monitor_t const *const starvation_monitor,
+        mdv_sw_timer_conversion_t const *const conversion)
+{
+        // The stalled counter doesn't tell the time, so each stalled latch is
+        // assumed to take as many ticks as the latches before the stall
+        return mdv_sw_timer_conversion_get_time64(
+                conversion,
+                starvation_monitor->stall_count *
+                starvation_monitor->latch_period_ticks,
+                MDV_SW_TIMER_US);
+}
+
+/**
+ * \brief Update the starvation monitor with a latched tick count
+ *
+ * \param[in] starvation_monitor Starvation monitor in use
+ * \param[in] conversion Conversion factors of the timer base
+ * \param[in] tick_count64 Latched extended tick count
+ *
+ * \return No return value
+ */
+static void update_starvation_monitor(
+        mdv_sw_timer_base_starvation_monitor_t *const starvation_monitor,
+        mdv_sw_timer_conversion_t const *const conversion,
+        uint64_t const tick_count64)
+{
+        if (!starvation_monitor->stall_limit) {
+                return;
+        }
+
+        // The extended tick count never wraps around, so any change means
+        // that the counter is alive. The advance is shared by the latches
+        // since the previous advance.
+        if (starvation_monitor->last_tick_count64 != tick_count64) {
+                starvation_monitor->latch_period_ticks =
+                        (tick_count64 - starvation_monitor->last_tick_count64) /
+                        ((uint64_t)starvation_monitor->stall_count + 1u);
+                starvation_monitor->last_tick_count64 = tick_count64;
+                starvation_monitor->stall_count = 0;
+                return;
+        }
+
+        // Stop the stall counter to the maximum value
+        if (starvation_monitor->stall_count < UINT32_MAX) {
+                ++starvation_monitor->stall_count;
+        }
+
+        // Report the stall once, when it reaches the limit
+        if ((starvation_monitor->stall_count ==
+             starvation_monitor->stall_limit) &&
+            starvation_monitor->handler) {
+                starvation_monitor->handler(
+                        starvation_monitor->user_data,
+                        get_stall_time_us(starvation_monitor, conversion));
+        }
+}
+
 /** @} mdv-sw-timer-base-internals */
 
 void mdv_sw_timer_base_init(mdv_sw_timer_base_t *const sw_timer_base,
@@ -66,14 +566,20 @@ void mdv_sw_timer_base_init(mdv_sw_timer_base_t *const sw_timer_base,
                             uint8_t const timer_width_bits,
                             mdv_timer_driver_t *const timer_driver)
 {
-        assert(sw_timer_base);
-        assert(tick_duration_us > 0);
-        assert((timer_width_bits > 0) && (timer_width_bits <= 32));
+        mdv_sw_timer_base_init_period(sw_timer_base,
+                                      get_tick_period(tick_duration_us),
+                                      timer_width_bits, timer_driver);
+}
 
-        sw_timer_base->timer_mask = create_mask(timer_width_bits);
-        sw_timer_base->tick_counter = 0;
-        sw_timer_base->tick_duration_us = tick_duration_us;
-        sw_timer_base->timer_driver = timer_driver;
+void mdv_sw_timer_base_init_period(mdv_sw_timer_base_t *const sw_timer_base,
+                                   uint64_t const tick_period_ns_q32,
+                                   uint8_t const timer_width_bits,
+                                   mdv_timer_driver_t *const timer_driver)
+{
+        init_instance(sw_timer_base, timer_width_bits, timer_driver,
+                      timer_driver ? MDV_SW_TIMER_BASE_MODE_POLLING :
+                      MDV_SW_TIMER_BASE_MODE_TICK);
+        set_tick_period(sw_timer_base, tick_period_ns_q32);
 
         // Initialize the timer driver if needed
         if (sw_timer_base->timer_driver) {
@@ -83,6 +589,128 @@ void mdv_sw_timer_base_init(mdv_sw_timer_base_t *const sw_timer_base,
         }
 }
 
+void mdv_sw_timer_base_init_event_driven(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const tick_duration_us,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        mdv_sw_timer_base_init_event_driven_period(
+                sw_timer_base, get_tick_period(tick_duration_us),
+                timer_width_bits, timer_driver);
+}
+
+void mdv_sw_timer_base_init_event_driven_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        assert(timer_driver);
+
+        init_instance(sw_timer_base, timer_width_bits, timer_driver,
+                      MDV_SW_TIMER_BASE_MODE_EVENT);
+        set_tick_period(sw_timer_base, tick_period_ns_q32);
+
+        // The timer driver advances the tick counter through the event handler
+        sw_timer_base->timer_driver->init(handle_timer_event, sw_timer_base);
+}
+
+void mdv_sw_timer_base_init_tickless(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const timer_width_bits,
+                                     mdv_timer_driver_t *const timer_driver)
+{
+        mdv_sw_timer_base_init_tickless_period(
+                sw_timer_base, get_tick_period(tick_duration_us),
+                timer_width_bits, timer_driver);
+}
+
+void mdv_sw_timer_base_init_tickless_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        assert(timer_driver);
+        assert(timer_driver->set_compare);
+
+        init_instance(sw_timer_base, timer_width_bits, timer_driver,
+                      MDV_SW_TIMER_BASE_MODE_TICKLESS);
+        set_tick_period(sw_timer_base, tick_period_ns_q32);
+
+        // The timer driver wakes up the timer base at the compare value
+        sw_timer_base->timer_driver->init(handle_tickless_event,
+                                          sw_timer_base);
+        program_deadline(sw_timer_base);
+}
+
+void mdv_sw_timer_base_init_extended(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const counter_width_bits,
+                                     mdv_timer_driver_t *const timer_driver)
+{
+        mdv_sw_timer_base_init_extended_period(
+                sw_timer_base, get_tick_period(tick_duration_us),
+                counter_width_bits, timer_driver);
+}
+
+void mdv_sw_timer_base_init_extended_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const counter_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        assert(timer_driver);
+        assert((counter_width_bits > 0) && (counter_width_bits < 32));
+
+        // The software timers see the full 32-bit width
+        init_instance(sw_timer_base, 32u, timer_driver,
+                      MDV_SW_TIMER_BASE_MODE_EXTENDED);
+        sw_timer_base->counter_mask = create_mask(counter_width_bits);
+        set_tick_period(sw_timer_base, tick_period_ns_q32);
+
+        // The timer driver reports the counter overflows through the event
+        // handler
+        sw_timer_base->timer_driver->init(handle_overflow_event,
+                                          sw_timer_base);
+}
+
+void mdv_sw_timer_base_set_deadline_provider(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_deadline_provider_t const deadline_provider,
+        void *const user_data)
+{
+        assert(sw_timer_base);
+
+        sw_timer_base->deadline_provider = deadline_provider;
+        sw_timer_base->deadline_user_data = user_data;
+}
+
+void mdv_sw_timer_base_update_deadline(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(sw_timer_base);
+
+        if (sw_timer_base->mode != MDV_SW_TIMER_BASE_MODE_TICKLESS) {
+                return;
+        }
+
+        handle_tickless_event(sw_timer_base,
+                              sw_timer_base->timer_driver->get_count());
+}
+
+void mdv_sw_timer_base_set_event_handler(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_timer_event_handler_t const event_handler,
+        void *const user_data)
+{
+        assert(sw_timer_base);
+
+        sw_timer_base->event_handler = event_handler;
+        sw_timer_base->event_user_data = user_data;
+}
+
 void mdv_sw_timer_base_uninit(mdv_sw_timer_base_t *const sw_timer_base)
 {
         assert(sw_timer_base);
@@ -99,28 +727,130 @@ void mdv_sw_timer_base_tick(mdv_sw_timer_base_t *const sw_timer_base,
         assert(sw_timer_base);
         assert(tick_count);
 
-        // Advance the tick counter
-        sw_timer_base->tick_counter += tick_count;
+        // Advance the tick counters. Emulate the width of the timer by
+        // limiting the tick counter by the timer mask. Only this context
+        // writes the counters, so the new value is stored at once, and the
+        // readers never see an unmasked value.
+        mdv_atomic_store_release_u32(&(sw_timer_base->tick_counter),
+                                     (sw_timer_base->tick_counter +
+                                      tick_count) &
+                                     sw_timer_base->timer_mask);
+        sw_timer_base->tick_counter64 += tick_count;
+        publish_tick_count64(sw_timer_base);
 
-        // Emulate the width of the timer by limiting the tick counter by the
-        // timer mask
-        sw_timer_base->tick_counter &= sw_timer_base->timer_mask;
+        dispatch_event(sw_timer_base);
 }
 
 uint32_t mdv_sw_timer_base_get_tick_count(mdv_sw_timer_base_t *sw_timer_base)
 {
         assert(sw_timer_base);
 
-        // If the timer driver has been set, use the direct hardware polling
-        // mode (return the hardware counter value). Otherwise, return the local
-        // tick counter.
-        if (sw_timer_base->timer_driver) {
+        // In the snapshot mode, all timers get the latched tick count
+        if (sw_timer_base->is_snapshot_enabled) {
+                return sw_timer_base->snapshot_tick_count;
+        }
+
+        // In the width extension mode, the narrow hardware counter is
+        // combined with the counted overflows
+        if (sw_timer_base->mode == MDV_SW_TIMER_BASE_MODE_EXTENDED) {
+                return (uint32_t)read_extended_tick_count64(sw_timer_base);
+        }
+
+        // If the timer driver has been set for polling, or the counters are
+        // updated only when waking up in the tickless mode, use the direct
+        // hardware polling mode (return the hardware counter value).
+        // Otherwise, return the local tick counter.
+        if (sw_timer_base->timer_driver &&
+            ((sw_timer_base->mode == MDV_SW_TIMER_BASE_MODE_POLLING) ||
+             (sw_timer_base->mode == MDV_SW_TIMER_BASE_MODE_TICKLESS))) {
                 return sw_timer_base->timer_driver->get_count();
         } else {
-                return sw_timer_base->tick_counter;
+                return mdv_atomic_load_acquire_u32(
+                        &(sw_timer_base->tick_counter));
         }
 }
 
+uint64_t mdv_sw_timer_base_get_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(sw_timer_base);
+
+        if (sw_timer_base->is_snapshot_enabled) {
+                return sw_timer_base->snapshot_tick_count64;
+        }
+
+        return read_current_tick_count64(sw_timer_base);
+}
+
+void mdv_sw_timer_base_set_snapshot_mode(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        bool const is_enabled)
+{
+        assert(sw_timer_base);
+
+        if (is_enabled) {
+                mdv_sw_timer_base_latch(sw_timer_base);
+        }
+
+        sw_timer_base->is_snapshot_enabled = is_enabled;
+}
+
+uint32_t mdv_sw_timer_base_latch(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(sw_timer_base);
+
+        // The timer driver is read once. The tick count is derived from the
+        // extended tick count, so the latched values are consistent with each
+        // other.
+        sw_timer_base->snapshot_tick_count64 =
+                read_current_tick_count64(sw_timer_base);
+        sw_timer_base->snapshot_tick_count =
+                (uint32_t)sw_timer_base->snapshot_tick_count64 &
+                sw_timer_base->timer_mask;
+
+        update_starvation_monitor(&(sw_timer_base->starvation_monitor),
+                                  &(sw_timer_base->conversion),
+                                  sw_timer_base->snapshot_tick_count64);
+
+        return sw_timer_base->snapshot_tick_count;
+}
+
+void mdv_sw_timer_base_set_starvation_monitor(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const stall_limit,
+        mdv_sw_timer_base_starvation_handler_t const handler,
+        void *const user_data)
+{
+        assert(sw_timer_base);
+
+        sw_timer_base->starvation_monitor.stall_limit = stall_limit;
+        sw_timer_base->starvation_monitor.stall_count = 0;
+        // The latched tick count may be stale, or zero if the timer base has
+        // never been latched, so the first advance would span the uptime
+        sw_timer_base->starvation_monitor.last_tick_count64 =
+                read_current_tick_count64(sw_timer_base);
+        sw_timer_base->starvation_monitor.latch_period_ticks = 0;
+        sw_timer_base->starvation_monitor.handler = handler;
+        sw_timer_base->starvation_monitor.user_data = user_data;
+}
+
+void mdv_sw_timer_base_get_starvation_status(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_starvation_status_t *const status)
+{
+        assert(sw_timer_base);
+        assert(status);
+
+        status->stall_count = sw_timer_base->starvation_monitor.stall_count;
+        status->stall_time_us = get_stall_time_us(
+                &(sw_timer_base->starvation_monitor),
+                &(sw_timer_base->conversion));
+        status->is_starving =
+                sw_timer_base->starvation_monitor.stall_limit &&
+                (status->stall_count >=
+                 sw_timer_base->starvation_monitor.stall_limit);
+}
+
 uint32_t mdv_sw_timer_base_get_tick_duration_us(
         mdv_sw_timer_base_t *const sw_timer_base)
 {
@@ -129,6 +859,14 @@ uint32_t mdv_sw_timer_base_get_tick_duration_us(
         return sw_timer_base->tick_duration_us;
 }
 
+uint64_t mdv_sw_timer_base_get_tick_period_ns_q32(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(sw_timer_base);
+
+        return sw_timer_base->tick_period_ns_q32;
+}
+
 uint32_t mdv_sw_timer_base_get_timer_mask(
         mdv_sw_timer_base_t *const sw_timer_base)
 {
@@ -137,4 +875,12 @@ uint32_t mdv_sw_timer_base_get_timer_mask(
         return sw_timer_base->timer_mask;
 }
 
-/* EOF */
\ No newline at end of file
+mdv_sw_timer_conversion_t const *mdv_sw_timer_base_get_conversion(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(sw_timer_base);
+
+        return &(sw_timer_base->conversion);
+}
+
+/* EOF */
@@ -34,7 +34,9 @@
 #ifndef MDV_SW_TIMER_BASE_H
 #define MDV_SW_TIMER_BASE_H
 
+#include "mdv_atomic.h"
 #include "mdv_timer_driver.h"
+#include "mdv_sw_timer_conversion.h"
 
 /**
  * \file       mdv_sw_timer_base.h
@@ -46,13 +48,115 @@
  * software timers. It provides an interface and configuration for software
  * timers using the base.
  *
- * The software timer base can be used by two ways depending on the behavior of
- * the hardware timer: interrupt based, or directly polling the hardware timer
- * counter. If the hardware timer driver is provided as a parameter to the
- * initialization function, the software timer base uses the direct polling.
- * If no hardware time driver is provided, the timer interrupt must call the
- * tick function from the timer interrupt handler sequentially to advance the
- * internal counter of the timer base.
+ * The software timer base can be used by three ways depending on the behavior
+ * of the hardware timer: interrupt based, directly polling the hardware timer
+ * counter, or event driven. If the hardware timer driver is provided as a
+ * parameter to the initialization function, the software timer base uses the
+ * direct polling. If no hardware time driver is provided, the timer interrupt
+ * must call the tick function from the timer interrupt handler sequentially to
+ * advance the internal counter of the timer base.
+ *
+ * In the event driven mode, initialized with
+ * \ref mdv_sw_timer_base_init_event_driven, the timer driver calls the event
+ * handler of the timer base with the current counter value. The timer base
+ * stores the value, so reading the tick count doesn't access the timer
+ * hardware at all. This is useful when the timer peripheral is slow to access.
+ *
+ * Besides the tick count limited by the timer width, the timer base maintains
+ * an extended 64-bit tick count, which doesn't wrap around in practice. In the
+ * interrupt based and event driven modes, the extended tick count is updated
+ * each time the counter advances. In the polling mode, the extended tick count
+ * is updated when it is read with \ref mdv_sw_timer_base_get_tick_count64, so
+ * it must be read at least once per one period of the timer counter.
+ *
+ * The tick counters are updated by one writer: the context calling
+ * \ref mdv_sw_timer_base_tick, or the timer driver events. The tick counts can
+ * be read concurrently from any thread, core or interrupt handler without
+ * locks and without disabling the interrupts. The tick count is stored
+ * atomically. The extended tick count is published through two copies
+ * selected by a sequence counter, so a reader always finds a stable copy,
+ * even when it interrupts the writer in the middle of an update. In the
+ * polling mode, reading the extended tick count updates it. One reader at a
+ * time updates the count, and a reader interrupting the update adds the
+ * ticks elapsed since the published count instead, so the extended tick count
+ * can be read from any context as well.
+ *
+ * In the snapshot mode, enabled with
+ * \ref mdv_sw_timer_base_set_snapshot_mode, the tick counts are read once by
+ * \ref mdv_sw_timer_base_latch, and all software timers using the timer base
+ * get the latched values until the next latch. A superloop latches the counter
+ * once per iteration, so querying many timers doesn't read the timer hardware
+ * for each timer, and all timers see the same time during the iteration.
+ * The latched values are as old as the latest latch, so the time measured
+ * by the timers can lag by up to one iteration of the loop.
+ *
+ * The timer base has one starvation monitor for all software timers using it,
+ * configured with \ref mdv_sw_timer_base_set_starvation_monitor. It detects
+ * situations where the underlying hardware or software timer stops running,
+ * but the software is still waiting the timer. The monitor is updated only by
+ * \ref mdv_sw_timer_base_latch, so the application must latch the timer base
+ * periodically, for example once per iteration of the main loop, also when
+ * the snapshot mode is disabled. Without the latches, no starvation is ever
+ * detected. Each latch which finds the extended tick count not advanced since
+ * the previous latch lengthens the stall by one. When the stall reaches the
+ * configured limit, the starvation handler is called once, and the stall is
+ * reported by \ref mdv_sw_timer_base_get_starvation_status until the counter
+ * advances again. The monitor must be updated from one context only.
+ *
+ * A stalled counter can't measure the stall itself, so the stall time is
+ * estimated from the count of stalled latches and the ticks the counter
+ * advanced per latch before the stall, and converted to microseconds with the
+ * conversion factors of the timer base. If the counter hasn't advanced since
+ * the monitor was configured, the estimated stall time is zero.
+ *
+ * The tick duration is given in whole microseconds, or with the \c _period
+ * variants of the initialization functions, as a tick period in nanoseconds
+ * in an unsigned Q32.32 fixed-point format. The fixed-point period describes
+ * high-frequency counters, such as a 48 MHz cycle counter, and counters with
+ * a fractional period, such as a 32.768 kHz RTC, without rounding the period
+ * to microseconds. See \ref MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ. The
+ * initialization functions taking the tick duration in microseconds convert
+ * it to the tick period, so the duration must be shorter than 2^32
+ * nanoseconds, see \ref MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US.
+ *
+ * The tick duration in microseconds, returned by
+ * \ref mdv_sw_timer_base_get_tick_duration_us and inherited by the software
+ * timers, is deprecated. It is derived from the tick period rounded down, so
+ * it is zero for the periods shorter than one microsecond. Use
+ * \ref mdv_sw_timer_base_get_tick_period_ns_q32 instead.
+ *
+ * In the interrupt based and event driven modes, the timer base dispatches
+ * the due work by calling the event handler set with
+ * \ref mdv_sw_timer_base_set_event_handler each time the counter advances.
+ *
+ * The tickless mode, initialized with \ref mdv_sw_timer_base_init_tickless,
+ * uses a free running hardware counter with a compare capability. Instead of
+ * waking up on every tick, the timer base asks the deadline provider set with
+ * \ref mdv_sw_timer_base_set_deadline_provider for the ticks until the
+ * earliest pending deadline, and programs the compare value of the timer
+ * driver once. When the compare event wakes it up, all the ticks elapsed
+ * since the previous event are credited to the tick counters in one step, the
+ * event handler is called, and the next deadline is programmed. The base wakes
+ * up at least twice per one counter period to keep track of the
+ * wrap-arounds. After arming a deadline earlier than the programmed one
+ * outside the event handler, the application calls
+ * \ref mdv_sw_timer_base_update_deadline. In the tickless mode, the tick
+ * counts are read from the timer hardware, because the counters are updated
+ * only when the base wakes up.
+ *
+ * The width extension mode, initialized with
+ * \ref mdv_sw_timer_base_init_extended, extends a narrow hardware counter,
+ * such as a 16-bit timer, to the full 32-bit tick count and to the 64-bit
+ * extended tick count without losing the timer resolution. The timer driver
+ * calls the event handler of the timer base once per counter overflow, and
+ * the timer base adds one counter period to the high part of the count. The
+ * tick count is read with a high/low/high sequence: the high part is read
+ * before and after the hardware counter, and the read is retried if an
+ * overflow event was handled in between. If the counter has overflowed but the
+ * overflow event is still pending, for example when the count is read with
+ * the timer interrupt disabled, the count would appear to step back by one
+ * counter period. A monotonic guard detects this from the latest count seen
+ * by the readers and the overflow events, and credits the pending overflow.
  *
  * The other interface functions are used by software timers which rely on this
  * timer base.
@@ -60,6 +164,88 @@
  * @{
  */
 
+/**
+ * \brief Software timer base operating mode
+ */
+typedef enum _mdv_sw_timer_base_mode_t{
+        /// The tick counter is advanced by \ref mdv_sw_timer_base_tick
+        MDV_SW_TIMER_BASE_MODE_TICK = 0,
+        /// The hardware timer counter is polled directly
+        MDV_SW_TIMER_BASE_MODE_POLLING,
+        /// The tick counter is updated by the timer driver events
+        MDV_SW_TIMER_BASE_MODE_EVENT,
+        /// The timer driver events are programmed at the pending deadlines
+        MDV_SW_TIMER_BASE_MODE_TICKLESS,
+        /// The hardware counter is extended by the overflow events
+        MDV_SW_TIMER_BASE_MODE_EXTENDED
+} mdv_sw_timer_base_mode_t;
+
+/// Deadline provider return value when there are no pending deadlines
+#define MDV_SW_TIMER_BASE_NO_DEADLINE UINT32_MAX
+
+/// Longest tick duration in microseconds which fits the Q32.32 tick period
+#define MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US \
+        (UINT32_MAX / MDV_SW_TIMER_NS_IN_ONE_US)
+
+/**
+ * \brief Deadline provider
+ *
+ * Called by the timer base in the tickless mode after the event handler, to
+ * find out when the base must wake up next time.
+ *
+ * \param[in] user_data User data set with the deadline provider
+ * \param[in] tick_count Current tick count of the timer base
+ *
+ * \return Count of ticks from the given tick count to the earliest pending
+ *      deadline, or \ref MDV_SW_TIMER_BASE_NO_DEADLINE
+ */
+typedef uint32_t (*mdv_sw_timer_base_deadline_provider_t)(
+        void *const user_data,
+        uint32_t const tick_count);
+
+/**
+ * \brief Starvation handler
+ *
+ * \param[in] user_data User data set with the starvation handler
+ * \param[in] stall_time_us Estimated time of the stall in microseconds
+ *
+ * \return No return value
+ */
+typedef void (*mdv_sw_timer_base_starvation_handler_t)(
+        void *const user_data,
+        uint64_t const stall_time_us);
+
+/**
+ * \brief Starvation status of the timer base
+ */
+typedef struct _mdv_sw_timer_base_starvation_status_t{
+        /// Set while the stall has reached the limit
+        bool is_starving;
+        /// Count of latches without the tick count advancing
+        uint32_t stall_count;
+        /// Estimated time of the stall in microseconds
+        uint64_t stall_time_us;
+} mdv_sw_timer_base_starvation_status_t;
+
+/**
+ * \brief Starvation monitor data
+ */
+typedef struct _mdv_sw_timer_base_starvation_monitor_t{
+        /// Count of stalled latches to detect the starvation (0 disables the
+        /// monitor)
+        uint32_t stall_limit;
+        /// Count of latches without the tick count advancing
+        uint32_t stall_count;
+        /// Extended tick count of the previous latch
+        uint64_t last_tick_count64;
+        /// Ticks advanced per latch before the stall
+        uint64_t latch_period_ticks;
+        /// Starvation handler
+        mdv_sw_timer_base_starvation_handler_t handler;
+        /// User data passed to the starvation handler
+        void *user_data;
+} mdv_sw_timer_base_starvation_monitor_t;
+
 /**
  * \brief Software timer base instance data
  */
@@ -68,10 +254,48 @@ typedef struct _mdv_sw_timer_base_t{
         mdv_timer_driver_t *timer_driver;
         /// Timer tick counter
         uint32_t tick_counter;
-        /// One time tick duration (in microseconds)
+        /// Extended 64-bit tick counter which keeps track of the wrap-arounds
+        uint64_t tick_counter64;
+        /// Copies of the extended tick counter for the lock-free readers
+        uint64_t tick_counter64_latch[2];
+        /// Sequence counter selecting the stable copy of the extended tick
+        /// counter
+        uint32_t sequence;
+        /// Set while a reader updates the extended tick count in the polling
+        /// mode
+        uint32_t update_lock;
+        /// One time tick duration (in microseconds), rounded down from the
+        /// tick period (deprecated)
         uint32_t tick_duration_us;
+        /// One time tick period in Q32.32 nanoseconds
+        uint64_t tick_period_ns_q32;
         /// Timer mask
         uint32_t timer_mask;
+        /// Hardware counter mask in the width extension mode
+        uint32_t counter_mask;
+        /// Lowest 32 bits of the latest extended tick count seen in the
+        /// width extension mode
+        uint32_t guard_tick_count;
+        /// Precomputed conversion factors for the tick duration
+        mdv_sw_timer_conversion_t conversion;
+        /// Operating mode
+        mdv_sw_timer_base_mode_t mode;
+        /// Event handler to dispatch the due work when the counter advances
+        mdv_timer_event_handler_t event_handler;
+        /// User data passed to the event handler
+        void *event_user_data;
+        /// Deadline provider for the tickless mode
+        mdv_sw_timer_base_deadline_provider_t deadline_provider;
+        /// User data passed to the deadline provider
+        void *deadline_user_data;
+        /// Set while the tick counts are read from the snapshot
+        bool is_snapshot_enabled;
+        /// Tick count latched to the snapshot
+        uint32_t snapshot_tick_count;
+        /// Extended tick count latched to the snapshot
+        uint64_t snapshot_tick_count64;
+        /// Starvation monitor for all software timers using the timer base
+        mdv_sw_timer_base_starvation_monitor_t starvation_monitor;
 } mdv_sw_timer_base_t;
 
 #ifdef __cplusplus
@@ -83,7 +307,7 @@ extern "C"{
  *
  * \param[in] sw_timer_base Software timer base to be initialized
  * \param[in] tick_duration_us Configures duration of one timer tick in
- *      microseconds
+ *      microseconds, at most \ref MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US
  * \param[in] timer_width_bits Timer width in bits from 1 to 32
  * \param[in] timer_driver A pointer to a hardware timer driver (optional, used
  *      for polling)
@@ -95,6 +319,204 @@ void mdv_sw_timer_base_init(mdv_sw_timer_base_t *const sw_timer_base,
                             uint8_t const timer_width_bits,
                             mdv_timer_driver_t *const timer_driver);
 
+/**
+ * \brief Initialize the software timer base in the event driven mode
+ *
+ * The timer driver is initialized with the event handler of the timer base.
+ * The driver must call the event handler with the current counter value each
+ * time the counter advances, typically from the timer interrupt.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_duration_us Configures duration of one timer tick in
+ *      microseconds, at most \ref MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_event_driven(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const tick_duration_us,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base with a fixed-point tick period
+ *
+ * Works like \ref mdv_sw_timer_base_init, but the tick period is given in
+ * nanoseconds as an unsigned Q32.32 fixed-point value.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_period_ns_q32 Configures period of one timer tick in Q32.32
+ *      nanoseconds
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver (optional, used
+ *      for polling)
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_period(mdv_sw_timer_base_t *const sw_timer_base,
+                                   uint64_t const tick_period_ns_q32,
+                                   uint8_t const timer_width_bits,
+                                   mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base in the event driven mode with
+ *      a fixed-point tick period
+ *
+ * Works like \ref mdv_sw_timer_base_init_event_driven, but the tick period is
+ * given in nanoseconds as an unsigned Q32.32 fixed-point value.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_period_ns_q32 Configures period of one timer tick in Q32.32
+ *      nanoseconds
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_event_driven_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base in the tickless mode
+ *
+ * The timer driver must support the compare value. It is initialized with
+ * the event handler of the timer base, and the first wake-up is programmed
+ * half of the counter period ahead.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_duration_us Configures duration of one timer tick in
+ *      microseconds, at most \ref MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_tickless(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const timer_width_bits,
+                                     mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base in the tickless mode with
+ *      a fixed-point tick period
+ *
+ * Works like \ref mdv_sw_timer_base_init_tickless, but the tick period is
+ * given in nanoseconds as an unsigned Q32.32 fixed-point value.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_period_ns_q32 Configures period of one timer tick in Q32.32
+ *      nanoseconds
+ * \param[in] timer_width_bits Timer width in bits from 1 to 32
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_tickless_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base in the width extension mode
+ *
+ * The timer driver is initialized with the overflow handler of the timer
+ * base. The driver must call the handler once each time the counter overflows,
+ * typically from the overflow interrupt. The tick count is extended to 32
+ * bits, so the software timers see the full 32-bit timer width.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_duration_us Configures duration of one timer tick in
+ *      microseconds, at most \ref MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US
+ * \param[in] counter_width_bits Hardware counter width in bits from 1 to 31
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_extended(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const counter_width_bits,
+                                     mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Initialize the software timer base in the width extension mode with
+ *      a fixed-point tick period
+ *
+ * Works like \ref mdv_sw_timer_base_init_extended, but the tick period is
+ * given in nanoseconds as an unsigned Q32.32 fixed-point value.
+ *
+ * \param[in] sw_timer_base Software timer base to be initialized
+ * \param[in] tick_period_ns_q32 Configures period of one timer tick in Q32.32
+ *      nanoseconds
+ * \param[in] counter_width_bits Hardware counter width in bits from 1 to 31
+ * \param[in] timer_driver A pointer to a hardware timer driver
+ *
+ * \return No return value
+*/
+void mdv_sw_timer_base_init_extended_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const counter_width_bits,
+        mdv_timer_driver_t *const timer_driver);
+
+/**
+ * \brief Set the deadline provider for the tickless mode
+ *
+ * The new provider is consulted on the next wake-up, or immediately with
+ * \ref mdv_sw_timer_base_update_deadline.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[in] deadline_provider Deadline provider (set to null to wake up only
+ *      for the wrap-arounds)
+ * \param[in] user_data User data to be passed to the deadline provider
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_set_deadline_provider(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_deadline_provider_t const deadline_provider,
+        void *const user_data);
+
+/**
+ * \brief Update the tick counters and reprogram the deadline
+ *
+ * In the tickless mode, credits the elapsed ticks, calls the event handler and
+ * programs the compare value for the earliest pending deadline. Must be called
+ * after arming a deadline earlier than the programmed one outside the event
+ * handler. The call must not be interrupted by the timer driver event, so
+ * typically the timer interrupt is disabled for the duration of the call.
+ * Has no effect in the other modes.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_update_deadline(
+        mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Set the event handler for dispatching the due work
+ *
+ * The event handler is called with the current tick count each time the tick
+ * counter advances in the interrupt based, event driven or tickless mode. It
+ * is called from the same context which advances the counter.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[in] event_handler Event handler (set to null to disable)
+ * \param[in] user_data User data to be passed to the event handler
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_set_event_handler(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_timer_event_handler_t const event_handler,
+        void *const user_data);
+
 /**
  * \brief Uninitialize the software timer base
  *
@@ -125,16 +547,105 @@ void mdv_sw_timer_base_tick(mdv_sw_timer_base_t *const sw_timer_base,
 uint32_t mdv_sw_timer_base_get_tick_count(
         mdv_sw_timer_base_t *const sw_timer_base);
 
+/**
+ * \brief Get the extended 64-bit tick count
+ *
+ * The lowest bits of the extended tick count, limited by the timer mask, equal
+ * to the tick count returned by \ref mdv_sw_timer_base_get_tick_count.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return Current extended tick count
+ */
+uint64_t mdv_sw_timer_base_get_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Enable or disable the snapshot mode
+ *
+ * Enabling the snapshot mode latches the tick counts.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[in] is_enabled Enable the snapshot mode if true, otherwise disable it
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_set_snapshot_mode(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        bool const is_enabled);
+
+/**
+ * \brief Latch the current tick counts to the snapshot
+ *
+ * In the polling mode, the timer driver is read once. The tick counts are
+ * latched also when the snapshot mode is disabled, but they are used only in
+ * the snapshot mode.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return The latched tick count
+ */
+uint32_t mdv_sw_timer_base_latch(mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Configure the starvation monitor
+ *
+ * Configuring the monitor resets the stall, and reads the current tick count
+ * as the starting point of the monitoring. The monitor is updated only by
+ * \ref mdv_sw_timer_base_latch.
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[in] stall_limit Count of latches without the tick count advancing to
+ *      detect the starvation (set to 0 to disable the monitor)
+ * \param[in] handler Starvation handler (optional)
+ * \param[in] user_data User data to be passed to the starvation handler
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_set_starvation_monitor(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const stall_limit,
+        mdv_sw_timer_base_starvation_handler_t const handler,
+        void *const user_data);
+
+/**
+ * \brief Get the starvation status
+ *
+ * \param[in] sw_timer_base Timer system in use
+ * \param[out] status Starvation status
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_base_get_starvation_status(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_starvation_status_t *const status);
+
 /**
  * \brief Get the tick duration
  *
  * \param[in] sw_timer_base Timer system in use
  *
- * \return Tick duration in microseconds
+ * \deprecated The tick duration is the tick period rounded down to
+ *      microseconds, so it is zero for the periods shorter than one
+ *      microsecond. Use \ref mdv_sw_timer_base_get_tick_period_ns_q32
+ *      instead.
+ *
+ * \return Tick duration in microseconds, rounded down if the timer base has
+ *      been initialized with a fractional tick period
  */
 uint32_t mdv_sw_timer_base_get_tick_duration_us(
         mdv_sw_timer_base_t *const sw_timer_base);
 
+/**
+ * \brief Get the tick period
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return Tick period in Q32.32 nanoseconds
+ */
+uint64_t mdv_sw_timer_base_get_tick_period_ns_q32(
+        mdv_sw_timer_base_t *const sw_timer_base);
+
 /**
  * \brief Get the timer mask
  *
@@ -145,6 +656,16 @@ uint32_t mdv_sw_timer_base_get_tick_duration_us(
 uint32_t mdv_sw_timer_base_get_timer_mask(
         mdv_sw_timer_base_t *const sw_timer_base);
 
+/**
+ * \brief Get the conversion factors
+ *
+ * \param[in] sw_timer_base Timer system in use
+ *
+ * \return Conversion factors precomputed for the tick duration
+ */
+mdv_sw_timer_conversion_t const *mdv_sw_timer_base_get_conversion(
+        mdv_sw_timer_base_t *const sw_timer_base);
+
 #ifdef __cplusplus
 }
 #endif // ifdef __cplusplus
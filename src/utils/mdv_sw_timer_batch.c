@@ -0,0 +1,396 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_sw_timer_batch.h"
+#include <assert.h>
+
+#ifndef MDV_DISABLE_SW_TIMER_BATCH_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MDV_SW_TIMER_BATCH_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MDV_SW_TIMER_BATCH_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MDV_SW_TIMER_BATCH_NEON
+#endif
+#endif // ifndef MDV_DISABLE_SW_TIMER_BATCH_SIMD
+
+/**
+ * \defgroup mdv-sw-timer-batch-internals Internals
+ * \ingroup  mdv-sw-timer-batch
+ * @{
+ */
+
+/**
+ * \brief Evaluate the expiry of up to one bitmap word of timers
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer_mask Timer counter mask
+ * \param[in] tick_count_startup_samples Startup samples of the timers
+ * \param[in] timeouts Timeouts of the timers
+ * \param[in] timer_count Count of timers to evaluate, from 1 to 32
+ *
+ * \return Expiry bitmap word
+ */
+static uint32_t evaluate_word(uint32_t const tick_count,
+                              uint32_t const timer_mask,
+                              uint32_t const *const tick_count_startup_samples,
+                              uint32_t const *const timeouts,
+                              uint32_t const timer_count)
+{
+        uint32_t expired = 0;
+        uint32_t elapsed;
+        uint32_t i;
+
+        for (i = 0; i < timer_count; i++) {
+                // The timer mask handles the wrap-around without a branch
+                elapsed = (tick_count - tick_count_startup_samples[i]) &
+                          timer_mask;
+                // The elapsed time reaches the never expiring timeout with
+                // the 32-bit timer width
+                expired |= (uint32_t)((elapsed >= timeouts[i]) &
+                                      (timeouts[i] !=
+                                       MDV_SW_TIMER_BATCH_TIMEOUT_NEVER)) << i;
+        }
+
+        return expired;
+}
+
+#if defined(MDV_SW_TIMER_BATCH_AVX2)
+
+/**
+ * \brief Evaluate the expiry of one full bitmap word of timers using AVX2
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer_mask Timer counter mask
+ * \param[in] tick_count_startup_samples Startup samples of the timers
+ * \param[in] timeouts Timeouts of the timers
+ *
+ * \return Expiry bitmap word
+ */
+static uint32_t evaluate_full_word(
+        uint32_t const tick_count,
+        uint32_t const timer_mask,
+        uint32_t const *const tick_count_startup_samples,
+        uint32_t const *const timeouts)
+{
+        __m256i const now = _mm256_set1_epi32((int)tick_count);
+        __m256i const mask = _mm256_set1_epi32((int)timer_mask);
+        __m256i const never = _mm256_set1_epi32(
+                (int)MDV_SW_TIMER_BATCH_TIMEOUT_NEVER);
+        __m256i elapsed;
+        __m256i timeout;
+        __m256i is_expired;
+        uint32_t expired = 0;
+        uint32_t i;
+
+        for (i = 0; i < MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS; i += 8u) {
+                elapsed = _mm256_loadu_si256(
+                        (__m256i const *)&(tick_count_startup_samples[i]));
+                timeout = _mm256_loadu_si256((__m256i const *)&(timeouts[i]));
+                elapsed = _mm256_and_si256(_mm256_sub_epi32(now, elapsed),
+                                           mask);
+
+                // Unsigned comparison: elapsed >= timeout, if the maximum of
+                // them equals to the elapsed time. The never expiring timeouts
+                // are cleared from the result.
+                is_expired = _mm256_andnot_si256(
+                        _mm256_cmpeq_epi32(timeout, never),
+                        _mm256_cmpeq_epi32(_mm256_max_epu32(elapsed, timeout),
+                                           elapsed));
+
+                expired |= (uint32_t)_mm256_movemask_ps(
+                        _mm256_castsi256_ps(is_expired)) << i;
+        }
+
+        return expired;
+}
+
+#elif defined(MDV_SW_TIMER_BATCH_SSE2)
+
+/**
+ * \brief Evaluate the expiry of one full bitmap word of timers using SSE2
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer_mask Timer counter mask
+ * \param[in] tick_count_startup_samples Startup samples of the timers
+ * \param[in] timeouts Timeouts of the timers
+ *
+ * \return Expiry bitmap word
+ */
+static uint32_t evaluate_full_word(
+        uint32_t const tick_count,
+        uint32_t const timer_mask,
+        uint32_t const *const tick_count_startup_samples,
+        uint32_t const *const timeouts)
+{
+        __m128i const now = _mm_set1_epi32((int)tick_count);
+        __m128i const mask = _mm_set1_epi32((int)timer_mask);
+        __m128i const sign = _mm_set1_epi32((int)0x80000000u);
+        __m128i const never = _mm_set1_epi32(
+                (int)MDV_SW_TIMER_BATCH_TIMEOUT_NEVER);
+        __m128i elapsed;
+        __m128i timeout;
+        __m128i is_running;
+        uint32_t running = 0;
+        uint32_t i;
+
+        for (i = 0; i < MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS; i += 4u) {
+                elapsed = _mm_loadu_si128(
+                        (__m128i const *)&(tick_count_startup_samples[i]));
+                timeout = _mm_loadu_si128((__m128i const *)&(timeouts[i]));
+                elapsed = _mm_and_si128(_mm_sub_epi32(now, elapsed), mask);
+
+                // SSE2 has only the signed comparison. Flipping the sign bits
+                // gives the unsigned comparison timeout > elapsed. The never
+                // expiring timeouts keep running.
+                is_running = _mm_or_si128(
+                        _mm_cmpgt_epi32(_mm_xor_si128(timeout, sign),
+                                        _mm_xor_si128(elapsed, sign)),
+                        _mm_cmpeq_epi32(timeout, never));
+
+                running |= (uint32_t)_mm_movemask_ps(
+                        _mm_castsi128_ps(is_running)) << i;
+        }
+
+        return ~running;
+}
+
+#elif defined(MDV_SW_TIMER_BATCH_NEON)
+
+/**
+ * \brief Evaluate the expiry of one full bitmap word of timers using NEON
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer_mask Timer counter mask
+ * \param[in] tick_count_startup_samples Startup samples of the timers
+ * \param[in] timeouts Timeouts of the timers
+ *
+ * \return Expiry bitmap word
+ */
+static uint32_t evaluate_full_word(
+        uint32_t const tick_count,
+        uint32_t const timer_mask,
+        uint32_t const *const tick_count_startup_samples,
+        uint32_t const *const timeouts)
+{
+        static uint32_t const lane_bits[4] = {1u, 2u, 4u, 8u};
+        uint32x4_t const now = vdupq_n_u32(tick_count);
+        uint32x4_t const mask = vdupq_n_u32(timer_mask);
+        uint32x4_t const bits = vld1q_u32(lane_bits);
+        uint32x4_t const never = vdupq_n_u32(MDV_SW_TIMER_BATCH_TIMEOUT_NEVER);
+        uint32x4_t elapsed;
+        uint32x4_t timeout;
+        uint32x4_t is_expired;
+        uint32_t expired = 0;
+        uint32_t i;
+
+        for (i = 0; i < MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS; i += 4u) {
+                elapsed = vandq_u32(vsubq_u32(now, vld1q_u32(
+                        &(tick_count_startup_samples[i]))), mask);
+                timeout = vld1q_u32(&(timeouts[i]));
+                // The never expiring timeouts are cleared from the result
+                is_expired = vbicq_u32(vcgeq_u32(elapsed, timeout),
+                                       vceqq_u32(timeout, never));
+
+                // NEON has no move mask, so sum the lane bits instead
+                expired |= vaddvq_u32(vandq_u32(is_expired, bits)) << i;
+        }
+
+        return expired;
+}
+
+#else
+
+/**
+ * \brief Evaluate the expiry of one full bitmap word of timers
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer_mask Timer counter mask
+ * \param[in] tick_count_startup_samples Startup samples of the timers
+ * \param[in] timeouts Timeouts of the timers
+ *
+ * \return Expiry bitmap word
+ */
+static uint32_t evaluate_full_word(
+        uint32_t const tick_count,
+        uint32_t const timer_mask,
+        uint32_t const *const tick_count_startup_samples,
+        uint32_t const *const timeouts)
+{
+        return evaluate_word(tick_count, timer_mask,
+                             tick_count_startup_samples, timeouts,
+                             MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS);
+}
+
+#endif
+
+/**
+ * \brief Count the set bits of a bitmap word
+ *
+ * \param[in] word Bitmap word
+ *
+ * \return Count of the set bits
+ */
+static uint32_t count_bits(uint32_t word)
+{
+        word = word - ((word >> 1) & 0x55555555u);
+        word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+        word = (word + (word >> 4)) & 0x0f0f0f0fu;
+
+        return (word * 0x01010101u) >> 24;
+}
+
+/** @} mdv-sw-timer-batch-internals */
+
+void mdv_sw_timer_batch_init(mdv_sw_timer_batch_t *const sw_timer_batch,
+                             mdv_sw_timer_base_t *const sw_timer_base,
+                             uint32_t *const tick_count_startup_samples,
+                             uint32_t *const timeouts,
+                             uint32_t const timer_count)
+{
+        uint32_t tick_count;
+        uint32_t i;
+
+        assert(sw_timer_batch);
+        assert(sw_timer_base);
+        assert(tick_count_startup_samples);
+        assert(timeouts);
+        assert(timer_count);
+
+        sw_timer_batch->sw_timer_base = sw_timer_base;
+        sw_timer_batch->timer_mask =
+                mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        sw_timer_batch->conversion =
+                mdv_sw_timer_base_get_conversion(sw_timer_base);
+        sw_timer_batch->tick_count_startup_samples =
+                tick_count_startup_samples;
+        sw_timer_batch->timeouts = timeouts;
+        sw_timer_batch->timer_count = timer_count;
+
+        tick_count = mdv_sw_timer_base_get_tick_count(sw_timer_base);
+
+        for (i = 0; i < timer_count; i++) {
+                tick_count_startup_samples[i] = tick_count;
+                timeouts[i] = MDV_SW_TIMER_BATCH_TIMEOUT_NEVER;
+        }
+}
+
+void mdv_sw_timer_batch_start(mdv_sw_timer_batch_t *const sw_timer_batch,
+                              uint32_t const index,
+                              uint32_t const timeout_ticks)
+{
+        assert(sw_timer_batch);
+        assert(index < sw_timer_batch->timer_count);
+
+        sw_timer_batch->tick_count_startup_samples[index] =
+                mdv_sw_timer_base_get_tick_count(sw_timer_batch->sw_timer_base);
+        sw_timer_batch->timeouts[index] = timeout_ticks;
+}
+
+void mdv_sw_timer_batch_get_time(
+        mdv_sw_timer_batch_t *const sw_timer_batch,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const times)
+{
+        uint32_t tick_count;
+        uint32_t i;
+
+        assert(sw_timer_batch);
+        assert(times);
+
+        // One tick count sample is used for all timers
+        tick_count = mdv_sw_timer_base_get_tick_count(
+                sw_timer_batch->sw_timer_base);
+
+        for (i = 0; i < sw_timer_batch->timer_count; i++) {
+                times[i] = mdv_sw_timer_conversion_get_time(
+                        sw_timer_batch->conversion,
+                        (tick_count -
+                         sw_timer_batch->tick_count_startup_samples[i]) &
+                        sw_timer_batch->timer_mask,
+                        order_of_magnitude);
+        }
+}
+
+uint32_t mdv_sw_timer_batch_get_expired(
+        mdv_sw_timer_batch_t *const sw_timer_batch,
+        uint32_t *const expired)
+{
+        uint32_t const *tick_count_startup_samples;
+        uint32_t const *timeouts;
+        uint32_t tick_count;
+        uint32_t remaining;
+        uint32_t word = 0;
+        uint32_t expired_count = 0;
+
+        assert(sw_timer_batch);
+        assert(expired);
+
+        tick_count_startup_samples = sw_timer_batch->tick_count_startup_samples;
+        timeouts = sw_timer_batch->timeouts;
+        remaining = sw_timer_batch->timer_count;
+
+        // One tick count sample is used for all timers
+        tick_count = mdv_sw_timer_base_get_tick_count(
+                sw_timer_batch->sw_timer_base);
+
+        for (; remaining >= MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS;
+             remaining -= MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS) {
+                expired[word] = evaluate_full_word(tick_count,
+                                                   sw_timer_batch->timer_mask,
+                                                   tick_count_startup_samples,
+                                                   timeouts);
+                expired_count += count_bits(expired[word]);
+
+                ++word;
+                tick_count_startup_samples +=
+                        MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS;
+                timeouts += MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS;
+        }
+
+        // The last partial word
+        if (remaining) {
+                expired[word] = evaluate_word(tick_count,
+                                              sw_timer_batch->timer_mask,
+                                              tick_count_startup_samples,
+                                              timeouts, remaining);
+                expired_count += count_bits(expired[word]);
+        }
+
+        return expired_count;
+}
+
+/* EOF */
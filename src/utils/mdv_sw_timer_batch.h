@@ -0,0 +1,171 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_SW_TIMER_BATCH_H
+#define MDV_SW_TIMER_BATCH_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_sw_timer_batch.h
+ * \defgroup   mdv-sw-timer-batch Batch of software timers
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * A batch evaluates the elapsed time or the expiry of many timers using one
+ * tick count sample from the timer base. The timers are stored as a
+ * structure of arrays: the startup samples and the timeouts are kept in
+ * separate arrays given by the user, so the evaluation streams over
+ * consecutive memory.
+ *
+ * The expiry is evaluated without branches, and reported as a bitmap where
+ * bit (index % 32) of word (index / 32) is set, if the timer with the index
+ * has expired. The evaluation uses AVX2, SSE2 or NEON instructions when the
+ * compiler targets them, unless disabled by defining
+ * MDV_DISABLE_SW_TIMER_BATCH_SIMD. Otherwise, a plain C implementation is
+ * used.
+ *
+ * A timer with the timeout \ref MDV_SW_TIMER_BATCH_TIMEOUT_NEVER never
+ * expires, so it can be used for unused timers. The timeout is excluded
+ * explicitly, because with the 32-bit timer width, the elapsed time reaches
+ * it. The longest timeout is therefore one tick shorter than the timer mask
+ * with the 32-bit width. With narrower widths, any timeout greater than the
+ * timer mask never expires as well.
+ *
+ * @{
+ */
+
+/// Timeout which never expires, regardless of the timer width
+#define MDV_SW_TIMER_BATCH_TIMEOUT_NEVER 0xffffffffu
+
+/// Count of timers in one word of the expiry bitmap
+#define MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS 32u
+
+/// Count of words in the expiry bitmap for the given count of timers
+#define MDV_SW_TIMER_BATCH_BITMAP_WORDS(timer_count) \
+        (((timer_count) + MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS - 1u) / \
+         MDV_SW_TIMER_BATCH_BITMAP_WORD_BITS)
+
+/**
+ * \brief Batch of software timers
+ */
+typedef struct _mdv_sw_timer_batch_t{
+        /// Timer base used by the timers
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Timer counter mask, inherited from the timer base
+        uint32_t timer_mask;
+        /// Conversion factors, inherited from the timer base
+        mdv_sw_timer_conversion_t const *conversion;
+        /// Samples from the tick counter when the timers are started
+        uint32_t *tick_count_startup_samples;
+        /// Timeouts of the timers in ticks
+        uint32_t *timeouts;
+        /// Count of timers in the batch
+        uint32_t timer_count;
+} mdv_sw_timer_batch_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a batch of timers
+ *
+ * All timers are initialized as started at the current tick count, and with
+ * a timeout which never expires.
+ *
+ * \param[in] sw_timer_batch Batch to initialize
+ * \param[in] sw_timer_base Timer base which the timers will use
+ * \param[in] tick_count_startup_samples Storage for the startup samples
+ * \param[in] timeouts Storage for the timeouts
+ * \param[in] timer_count Count of timers in the storages
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_batch_init(mdv_sw_timer_batch_t *const sw_timer_batch,
+                             mdv_sw_timer_base_t *const sw_timer_base,
+                             uint32_t *const tick_count_startup_samples,
+                             uint32_t *const timeouts,
+                             uint32_t const timer_count);
+
+/**
+ * \brief Start a timer in the batch
+ *
+ * \param[in] sw_timer_batch Batch in use
+ * \param[in] index Index of the timer to start
+ * \param[in] timeout_ticks Timeout in ticks, or
+ *      \ref MDV_SW_TIMER_BATCH_TIMEOUT_NEVER
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_batch_start(mdv_sw_timer_batch_t *const sw_timer_batch,
+                              uint32_t const index,
+                              uint32_t const timeout_ticks);
+
+/**
+ * \brief Get the time elapsed from the start of each timer
+ *
+ * \param[in] sw_timer_batch Batch in use
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[out] times Elapsed times, one for each timer in the batch
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_batch_get_time(
+        mdv_sw_timer_batch_t *const sw_timer_batch,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const times);
+
+/**
+ * \brief Get the expired timers
+ *
+ * \param[in] sw_timer_batch Batch in use
+ * \param[out] expired Expiry bitmap of
+ *      \ref MDV_SW_TIMER_BATCH_BITMAP_WORDS words. The unused bits of the last
+ *      word are cleared.
+ *
+ * \return Count of expired timers
+ */
+uint32_t mdv_sw_timer_batch_get_expired(
+        mdv_sw_timer_batch_t *const sw_timer_batch,
+        uint32_t *const expired);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-sw-timer-batch */
+
+#endif // ifndef MDV_SW_TIMER_BATCH_H
+
+/* EOF */
@@ -0,0 +1,183 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_sw_timer_compact.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-sw-timer-compact-internals Internals
+ * \ingroup  mdv-sw-timer-compact
+ * @{
+ */
+
+/**
+ * \brief Get the elapsed ticks of a compact timer
+ *
+ * \param[in] tick_count Current tick count
+ * \param[in] timer Timer in use
+ * \param[in] mask Timer mask limited to the range of the sample
+ *
+ * \return Elapsed ticks
+ */
+static uint32_t get_elapsed_ticks(uint32_t const tick_count,
+                                  mdv_sw_timer_compact_t const timer,
+                                  uint32_t const mask)
+{
+        // The mask handles both the wrap-around of the timer and the
+        // wrap-around of the sample
+        return (tick_count - (uint32_t)timer) & mask;
+}
+
+/**
+ * \brief Get the timer mask limited to the range of the sample
+ *
+ * \param[in] sw_timer_base Timer base in use
+ *
+ * \return The mask
+ */
+static uint32_t get_mask(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return mdv_sw_timer_base_get_timer_mask(sw_timer_base) &
+               MDV_SW_TIMER_COMPACT_SAMPLE_MASK;
+}
+
+/** @} mdv-sw-timer-compact-internals */
+
+void mdv_sw_timer_compact_start(mdv_sw_timer_base_t *const sw_timer_base,
+                                mdv_sw_timer_compact_t *const timer)
+{
+        assert(sw_timer_base);
+        assert(timer);
+
+        *timer = (mdv_sw_timer_compact_t)
+                 mdv_sw_timer_base_get_tick_count(sw_timer_base);
+}
+
+void mdv_sw_timer_compact_get_time(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_compact_t const *const timer,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const time)
+{
+        assert(sw_timer_base);
+        assert(timer);
+        assert(time);
+
+        *time = mdv_sw_timer_conversion_get_time(
+                mdv_sw_timer_base_get_conversion(sw_timer_base),
+                get_elapsed_ticks(
+                        mdv_sw_timer_base_get_tick_count(sw_timer_base),
+                        *timer, get_mask(sw_timer_base)),
+                order_of_magnitude);
+}
+
+void mdv_sw_timer_compact_array_init(
+        mdv_sw_timer_compact_array_t *const array,
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_compact_t *const timers,
+        uint32_t const timer_count)
+{
+        mdv_sw_timer_compact_t timer;
+        uint32_t i;
+
+        assert(array);
+        assert(sw_timer_base);
+        assert(timers);
+        assert(timer_count);
+
+        array->sw_timer_base = sw_timer_base;
+        array->timer_mask = get_mask(sw_timer_base);
+        array->conversion = mdv_sw_timer_base_get_conversion(sw_timer_base);
+        array->timers = timers;
+        array->timer_count = timer_count;
+
+        mdv_sw_timer_compact_start(sw_timer_base, &timer);
+
+        for (i = 0; i < timer_count; i++) {
+                timers[i] = timer;
+        }
+}
+
+void mdv_sw_timer_compact_array_start(
+        mdv_sw_timer_compact_array_t *const array,
+        uint32_t const index)
+{
+        assert(array);
+        assert(index < array->timer_count);
+
+        mdv_sw_timer_compact_start(array->sw_timer_base,
+                                   &(array->timers[index]));
+}
+
+void mdv_sw_timer_compact_array_get_time(
+        mdv_sw_timer_compact_array_t *const array,
+        uint32_t const index,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const time)
+{
+        assert(array);
+        assert(index < array->timer_count);
+        assert(time);
+
+        *time = mdv_sw_timer_conversion_get_time(
+                array->conversion,
+                get_elapsed_ticks(
+                        mdv_sw_timer_base_get_tick_count(array->sw_timer_base),
+                        array->timers[index], array->timer_mask),
+                order_of_magnitude);
+}
+
+void mdv_sw_timer_compact_array_get_times(
+        mdv_sw_timer_compact_array_t *const array,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const times)
+{
+        uint32_t tick_count;
+        uint32_t i;
+
+        assert(array);
+        assert(times);
+
+        // One tick count sample is used for all timers
+        tick_count = mdv_sw_timer_base_get_tick_count(array->sw_timer_base);
+
+        for (i = 0; i < array->timer_count; i++) {
+                times[i] = mdv_sw_timer_conversion_get_time(
+                        array->conversion,
+                        get_elapsed_ticks(tick_count, array->timers[i],
+                                          array->timer_mask),
+                        order_of_magnitude);
+        }
+}
+
+/* EOF */
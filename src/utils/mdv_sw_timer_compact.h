@@ -0,0 +1,206 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_SW_TIMER_COMPACT_H
+#define MDV_SW_TIMER_COMPACT_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_sw_timer_compact.h
+ * \defgroup   mdv-sw-timer-compact Compact software timer
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * A compact software timer is only the tick count sampled when the timer is
+ * started. The tick duration, the timer mask and the conversion factors are
+ * read from the timer base at each query, so they are stored once per timer
+ * base instead of once per timer. This suits large timer populations, where
+ * the size of \ref mdv_sw_timer_t adds up.
+ *
+ * The sample is 32 bits by default. Defining
+ * MDV_SW_TIMER_COMPACT_SAMPLE_BITS as 16 halves the size, but then the longest
+ * measurable time is 65535 ticks, regardless of the timer width.
+ *
+ * The starvation of the timers is detected by the starvation monitor of the
+ * timer base.
+ *
+ * \ref mdv_sw_timer_compact_array_t keeps an array of compact timers on one
+ * timer base. The array copies the timer mask and the conversion factors from
+ * the base once for all its timers, and can read the time of all timers with
+ * one tick count sample.
+ *
+ * @{
+ */
+
+#ifndef MDV_SW_TIMER_COMPACT_SAMPLE_BITS
+/// Size of the compact timer in bits, 16 or 32
+#define MDV_SW_TIMER_COMPACT_SAMPLE_BITS 32
+#endif // ifndef MDV_SW_TIMER_COMPACT_SAMPLE_BITS
+
+#if MDV_SW_TIMER_COMPACT_SAMPLE_BITS == 16
+/// Mask for the range of the sample
+#define MDV_SW_TIMER_COMPACT_SAMPLE_MASK 0x0000ffffu
+
+/**
+ * \brief Compact software timer
+ */
+typedef uint16_t mdv_sw_timer_compact_t;
+#elif MDV_SW_TIMER_COMPACT_SAMPLE_BITS == 32
+/// Mask for the range of the sample
+#define MDV_SW_TIMER_COMPACT_SAMPLE_MASK 0xffffffffu
+
+/**
+ * \brief Compact software timer
+ */
+typedef uint32_t mdv_sw_timer_compact_t;
+#else
+#error "MDV_SW_TIMER_COMPACT_SAMPLE_BITS must be 16 or 32"
+#endif
+
+/**
+ * \brief Array of compact software timers
+ */
+typedef struct _mdv_sw_timer_compact_array_t{
+        /// Timer base used by the timers
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Timer mask of the timer base limited to the range of the timers
+        uint32_t timer_mask;
+        /// Conversion factors of the timer base
+        mdv_sw_timer_conversion_t const *conversion;
+        /// Timers
+        mdv_sw_timer_compact_t *timers;
+        /// Count of timers in the array
+        uint32_t timer_count;
+} mdv_sw_timer_compact_array_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Start a compact timer
+ *
+ * \param[in] sw_timer_base Timer base in use
+ * \param[out] timer Timer to start
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_start(mdv_sw_timer_base_t *const sw_timer_base,
+                                mdv_sw_timer_compact_t *const timer);
+
+/**
+ * \brief Get the time elapsed from the start of a compact timer
+ *
+ * \param[in] sw_timer_base Timer base used when the timer was started
+ * \param[in] timer Timer in use
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[out] time Elapsed time in the given order of magnitude
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_get_time(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_compact_t const *const timer,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const time);
+
+/**
+ * \brief Initialize an array of compact timers and start all timers
+ *
+ * \param[in] array Array to initialize
+ * \param[in] sw_timer_base Timer base which the timers will use
+ * \param[in] timers Storage for the timers
+ * \param[in] timer_count Count of timers in the storage
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_array_init(
+        mdv_sw_timer_compact_array_t *const array,
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_compact_t *const timers,
+        uint32_t const timer_count);
+
+/**
+ * \brief Start a timer in the array
+ *
+ * \param[in] array Array in use
+ * \param[in] index Index of the timer to start
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_array_start(
+        mdv_sw_timer_compact_array_t *const array,
+        uint32_t const index);
+
+/**
+ * \brief Get the time elapsed from the start of a timer in the array
+ *
+ * \param[in] array Array in use
+ * \param[in] index Index of the timer
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[out] time Elapsed time in the given order of magnitude
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_array_get_time(
+        mdv_sw_timer_compact_array_t *const array,
+        uint32_t const index,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const time);
+
+/**
+ * \brief Get the time elapsed from the start of all timers in the array
+ *
+ * One tick count sample is used for all timers.
+ *
+ * \param[in] array Array in use
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ * \param[out] times Elapsed times, one for each timer in the array
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_compact_array_get_times(
+        mdv_sw_timer_compact_array_t *const array,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude,
+        uint32_t *const times);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-sw-timer-compact */
+
+#endif // ifndef MDV_SW_TIMER_COMPACT_H
+
+/* EOF */
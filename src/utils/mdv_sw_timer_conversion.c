@@ -0,0 +1,262 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_sw_timer_conversion.h"
+#include <assert.h>
+
+/**
+ * \defgroup mdv-sw-timer-conversion-internals Internals
+ * \ingroup  mdv-sw-timer-conversion
+ * @{
+ */
+
+/**
+ * \brief Get the greatest common divisor
+ *
+ * \param[in] a First value
+ * \param[in] b Second value
+ *
+ * \return The greatest common divisor of the values
+ */
+static uint32_t get_gcd(uint32_t a, uint32_t b)
+{
+        uint32_t remainder;
+
+        while (b) {
+                remainder = a % b;
+                a = b;
+                b = remainder;
+        }
+
+        return a;
+}
+
+/**
+ * \brief Compute a conversion factor
+ *
+ * The reciprocal is computed as described by Granlund and Montgomery in
+ * "Division by Invariant Integers using Multiplication" (figure 4.1), which
+ * gives an exact quotient for every 32-bit dividend.
+ *
+ * \param[out] factor Conversion factor to compute
+ * \param[in] tick_duration_us Duration of one timer tick in microseconds
+ * \param[in] divisor Microseconds in one unit of the order of magnitude
+ *
+ * \return No return value
+ */
+static void compute_factor(mdv_sw_timer_conversion_factor_t *const factor,
+                           uint32_t const tick_duration_us,
+                           uint32_t const divisor)
+{
+        uint32_t const gcd = get_gcd(tick_duration_us, divisor);
+        uint32_t const reduced_divisor = divisor / gcd;
+        uint8_t log2_ceil = 0;
+
+        // Find the smallest power of two not less than the divisor
+        while (((uint64_t)1u << log2_ceil) < reduced_divisor) {
+                ++log2_ceil;
+        }
+
+        factor->multiplier = tick_duration_us / gcd;
+        factor->divisor = reduced_divisor;
+        factor->reciprocal = (uint32_t)(((((uint64_t)1u << log2_ceil) -
+                                          reduced_divisor) << 32) /
+                                        reduced_divisor + 1u);
+        factor->shift_1 = log2_ceil ? 1u : 0u;
+        factor->shift_2 = log2_ceil ? (uint8_t)(log2_ceil - 1u) : 0u;
+}
+
+/**
+ * \brief Compute a conversion factor for a fractional tick period
+ *
+ * The multiplier is the quotient of the period and the divisor, shifted left
+ * until its highest bit is set, and rounded up.
+ *
+ * \param[out] fraction Conversion factor to compute
+ * \param[in] tick_period_ns_q32 Tick period in Q32.32 nanoseconds
+ * \param[in] divisor Nanoseconds in one unit of the order of magnitude
+ *
+ * \return No return value
+ */
+static void compute_fraction(mdv_sw_timer_conversion_fraction_t *const fraction,
+                             uint64_t const tick_period_ns_q32,
+                             uint32_t const divisor)
+{
+        uint64_t quotient = tick_period_ns_q32 / divisor;
+        uint64_t remainder = tick_period_ns_q32 % divisor;
+        uint8_t shift = 0;
+
+        // Normalize the quotient with long division, one bit at a time
+        while (!(quotient >> 63) && (shift < 63u)) {
+                remainder <<= 1;
+                quotient <<= 1;
+
+                if (remainder >= divisor) {
+                        remainder -= divisor;
+                        quotient |= 1u;
+                }
+
+                ++shift;
+        }
+
+        // Round up. The quotient has been shifted if there is a remainder, so
+        // it can be shifted back on overflow.
+        if (remainder && !++quotient) {
+                quotient = (uint64_t)1u << 63;
+                --shift;
+        }
+
+        fraction->multiplier = quotient;
+        fraction->shift = shift;
+}
+
+/**
+ * \brief Multiply two 64-bit values and shift the 128-bit product right
+ *
+ * \param[in] a First value
+ * \param[in] b Second value
+ * \param[in] shift Right shift from 1 to 127
+ *
+ * \return The lowest 64 bits of the shifted product
+ */
+static uint64_t multiply_shift(uint64_t const a, uint64_t const b,
+                               uint8_t const shift)
+{
+        uint64_t const a_low = a & 0xffffffffu;
+        uint64_t const a_high = a >> 32;
+        uint64_t const b_low = b & 0xffffffffu;
+        uint64_t const b_high = b >> 32;
+        uint64_t const low_low = a_low * b_low;
+        uint64_t const low_high = a_low * b_high;
+        uint64_t const high_low = a_high * b_low;
+        uint64_t const middle = (low_low >> 32) + (low_high & 0xffffffffu) +
+                                (high_low & 0xffffffffu);
+        uint64_t const low = (middle << 32) | (low_low & 0xffffffffu);
+        uint64_t const high = a_high * b_high + (low_high >> 32) +
+                              (high_low >> 32) + (middle >> 32);
+
+        if (shift >= 64u) {
+                return high >> (shift - 64u);
+        }
+
+        return (high << (64u - shift)) | (low >> shift);
+}
+
+/** @} mdv-sw-timer-conversion-internals */
+
+void mdv_sw_timer_conversion_init(mdv_sw_timer_conversion_t *const conversion,
+                                  uint32_t const tick_duration_us)
+{
+        assert(conversion);
+        assert(tick_duration_us > 0);
+
+        compute_factor(&(conversion->factors[MDV_SW_TIMER_TIMERTICK]), 1u, 1u);
+        compute_factor(&(conversion->factors[MDV_SW_TIMER_US]),
+                       tick_duration_us, 1u);
+        compute_factor(&(conversion->factors[MDV_SW_TIMER_MS]),
+                       tick_duration_us, MDV_SW_TIMER_US_IN_ONE_MS);
+        compute_factor(&(conversion->factors[MDV_SW_TIMER_S]),
+                       tick_duration_us, MDV_SW_TIMER_US_IN_ONE_SECOND);
+        // The 32-bit time in nanoseconds wraps around like the product
+        compute_factor(&(conversion->factors[MDV_SW_TIMER_NS]),
+                       tick_duration_us * MDV_SW_TIMER_NS_IN_ONE_US, 1u);
+        conversion->is_fractional = false;
+}
+
+void mdv_sw_timer_conversion_init_period(
+        mdv_sw_timer_conversion_t *const conversion,
+        uint64_t const tick_period_ns_q32)
+{
+        assert(conversion);
+        assert(tick_period_ns_q32 > 0);
+
+        // One tick in Q32.32 ticks
+        compute_fraction(&(conversion->fractions[MDV_SW_TIMER_TIMERTICK]),
+                         (uint64_t)1u << 32, 1u);
+        compute_fraction(&(conversion->fractions[MDV_SW_TIMER_US]),
+                         tick_period_ns_q32, MDV_SW_TIMER_NS_IN_ONE_US);
+        compute_fraction(&(conversion->fractions[MDV_SW_TIMER_MS]),
+                         tick_period_ns_q32,
+                         MDV_SW_TIMER_NS_IN_ONE_US * MDV_SW_TIMER_US_IN_ONE_MS);
+        compute_fraction(&(conversion->fractions[MDV_SW_TIMER_S]),
+                         tick_period_ns_q32,
+                         MDV_SW_TIMER_NS_IN_ONE_US *
+                         MDV_SW_TIMER_US_IN_ONE_SECOND);
+        compute_fraction(&(conversion->fractions[MDV_SW_TIMER_NS]),
+                         tick_period_ns_q32, 1u);
+        conversion->is_fractional = true;
+}
+
+uint64_t mdv_sw_timer_conversion_get_time64(
+        mdv_sw_timer_conversion_t const *const conversion,
+        uint64_t const tick_count,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude)
+{
+        mdv_sw_timer_conversion_factor_t const *factor;
+
+        assert(conversion);
+
+        // The time value is in correct order of magnitude, or the order of
+        // magnitude is unknown
+        if ((uint32_t)order_of_magnitude >=
+            (uint32_t)MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT) {
+                return tick_count;
+        }
+
+        if (conversion->is_fractional) {
+                return multiply_shift(
+                        tick_count,
+                        conversion->fractions[order_of_magnitude].multiplier,
+                        (uint8_t)(32u + conversion->fractions[
+                                order_of_magnitude].shift));
+        }
+
+        // The nanoseconds are calculated from the microseconds, because the
+        // multiplier of the 32-bit conversion wraps around
+        if (order_of_magnitude == MDV_SW_TIMER_NS) {
+                return tick_count *
+                       conversion->factors[MDV_SW_TIMER_US].multiplier *
+                       MDV_SW_TIMER_NS_IN_ONE_US;
+        }
+
+        factor = &(conversion->factors[order_of_magnitude]);
+
+        // Skip the division if the tick duration is a multiple of the unit
+        if (factor->divisor == 1u) {
+                return tick_count * factor->multiplier;
+        }
+
+        return (tick_count * factor->multiplier) / factor->divisor;
+}
+
+/* EOF */
@@ -0,0 +1,253 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_SW_TIMER_CONVERSION_H
+#define MDV_SW_TIMER_CONVERSION_H
+
+#include "mdv_common.h"
+#include <assert.h>
+
+/**
+ * \file       mdv_sw_timer_conversion.h
+ * \defgroup   mdv-sw-timer-conversion Tick to time conversion
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * Converts timer ticks to time in different orders of magnitude without
+ * runtime divisions. The conversion factors are precomputed once for the tick
+ * duration: the tick duration and the divisor of each order of magnitude are
+ * reduced by their greatest common divisor, and the remaining divisor is
+ * replaced with a fixed-point reciprocal. The conversion itself uses only
+ * multiplications, a subtraction and shifts.
+ *
+ * The result equals to (tick_count * tick_duration_us) / divisor exactly,
+ * whenever the reduced product tick_count * (tick_duration_us / gcd) fits in
+ * 32 bits. That range is never smaller than the range of the plain 32-bit
+ * multiplication.
+ *
+ * The 64-bit conversion is meant for long intervals, such as uptime, and it
+ * uses a 64-bit division.
+ *
+ * A tick period which is not a whole number of microseconds, such as the
+ * period of a 48 MHz cycle counter or a 32.768 kHz RTC, is given in
+ * nanoseconds as an unsigned Q32.32 fixed-point value. The period is then
+ * converted to each order of magnitude once, as a normalized 64-bit
+ * multiplier and a shift, and the conversion takes two 32-bit by 32-bit
+ * multiplications and shifts. The multipliers are rounded up, so a whole
+ * unit is never lost: the result equals to the exact value for the Q32.32
+ * period rounded down, unless the exact value is closer than about 2^-63 of
+ * its magnitude to the next whole unit.
+ *
+ * @{
+ */
+
+/// Microseconds in one millisecond
+#define MDV_SW_TIMER_US_IN_ONE_MS 1000u
+/// Microseconds in one second
+#define MDV_SW_TIMER_US_IN_ONE_SECOND 1000000u
+/// Nanoseconds in one microsecond
+#define MDV_SW_TIMER_NS_IN_ONE_US 1000u
+
+/// Tick period in Q32.32 nanoseconds for a counter frequency in hertz,
+/// rounded up so that whole units are not lost
+#define MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(hz) \
+        ((4294967296000000000ull + (uint64_t)(hz) - 1u) / (uint64_t)(hz))
+
+/**
+ * \brief Order of magnitude of time
+ */
+typedef enum _mdv_sw_timer_order_of_magnitude_t{
+        /// The order of magnitude equals to timer ticks
+        MDV_SW_TIMER_TIMERTICK = 0,
+        /// The order of magnitude is microseconds
+        MDV_SW_TIMER_US,
+        /// The order of magnitude is milliseconds
+        MDV_SW_TIMER_MS,
+        /// The order of magnitude is seconds
+        MDV_SW_TIMER_S,
+        /// The order of magnitude is nanoseconds
+        MDV_SW_TIMER_NS,
+        /// Count of the orders of magnitude
+        MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT
+} mdv_sw_timer_order_of_magnitude_t;
+
+/**
+ * \brief Conversion factor for one order of magnitude
+ */
+typedef struct _mdv_sw_timer_conversion_factor_t{
+        /// Tick duration reduced by the common divisor
+        uint32_t multiplier;
+        /// Divisor of the order of magnitude reduced by the common divisor
+        uint32_t divisor;
+        /// Fixed-point reciprocal of the reduced divisor
+        uint32_t reciprocal;
+        /// Shift applied to the correction term
+        uint8_t shift_1;
+        /// Final shift
+        uint8_t shift_2;
+} mdv_sw_timer_conversion_factor_t;
+
+/**
+ * \brief Conversion factor of a fractional tick period for one order of
+ *      magnitude
+ */
+typedef struct _mdv_sw_timer_conversion_fraction_t{
+        /// Tick period in the unit of the order of magnitude, scaled by
+        /// 2^(32 + shift)
+        uint64_t multiplier;
+        /// Shift of the multiplier in addition to the 32 fraction bits
+        uint8_t shift;
+} mdv_sw_timer_conversion_fraction_t;
+
+/**
+ * \brief Precomputed conversion factors for all orders of magnitude
+ */
+typedef struct _mdv_sw_timer_conversion_t{
+        /// Conversion factors indexed by the order of magnitude
+        mdv_sw_timer_conversion_factor_t factors[
+                MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT];
+        /// Conversion factors of a fractional tick period indexed by the order
+        /// of magnitude
+        mdv_sw_timer_conversion_fraction_t fractions[
+                MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT];
+        /// Set if the fractional conversion factors are in use
+        bool is_fractional;
+} mdv_sw_timer_conversion_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Precompute the conversion factors
+ *
+ * \param[in] conversion Conversion factors to initialize
+ * \param[in] tick_duration_us Duration of one timer tick in microseconds
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_conversion_init(mdv_sw_timer_conversion_t *const conversion,
+                                  uint32_t const tick_duration_us);
+
+/**
+ * \brief Precompute the conversion factors for a fractional tick period
+ *
+ * \param[in] conversion Conversion factors to initialize
+ * \param[in] tick_period_ns_q32 Period of one timer tick in nanoseconds as
+ *      an unsigned Q32.32 fixed-point value
+ *
+ * \return No return value
+ */
+void mdv_sw_timer_conversion_init_period(
+        mdv_sw_timer_conversion_t *const conversion,
+        uint64_t const tick_period_ns_q32);
+
+/**
+ * \brief Convert a tick count to time
+ *
+ * This function is defined inline, because it is on the hot path of every
+ * time query.
+ *
+ * \param[in] conversion Precomputed conversion factors
+ * \param[in] tick_count Tick count to convert
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ *
+ * \return Time in the given order of magnitude, or the tick count if the
+ *      order of magnitude is unknown
+ */
+static inline uint32_t mdv_sw_timer_conversion_get_time(
+        mdv_sw_timer_conversion_t const *const conversion,
+        uint32_t const tick_count,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude)
+{
+        mdv_sw_timer_conversion_fraction_t const *fraction;
+        mdv_sw_timer_conversion_factor_t const *factor;
+        uint32_t scaled;
+        uint32_t high;
+
+        assert(conversion);
+
+        // The time value is in correct order of magnitude, or the order of
+        // magnitude is unknown
+        if ((uint32_t)order_of_magnitude >=
+            (uint32_t)MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT) {
+                return tick_count;
+        }
+
+        if (conversion->is_fractional) {
+                fraction = &(conversion->fractions[order_of_magnitude]);
+
+                // Multiply the tick count by the 64-bit multiplier in two
+                // halves, dropping the 32 fraction bits of the lower half
+                return (uint32_t)(((uint64_t)tick_count *
+                                   (uint32_t)(fraction->multiplier >> 32) +
+                                   (((uint64_t)tick_count *
+                                     (uint32_t)fraction->multiplier) >> 32)) >>
+                                  fraction->shift);
+        }
+
+        factor = &(conversion->factors[order_of_magnitude]);
+
+        // Scale the tick count with the reduced tick duration, and divide the
+        // result by the reduced divisor using the reciprocal
+        scaled = tick_count * factor->multiplier;
+        high = (uint32_t)(((uint64_t)scaled * factor->reciprocal) >> 32);
+
+        return (high + ((scaled - high) >> factor->shift_1)) >>
+               factor->shift_2;
+}
+
+/**
+ * \brief Convert a 64-bit tick count to time
+ *
+ * \param[in] conversion Precomputed conversion factors
+ * \param[in] tick_count Tick count to convert
+ * \param[in] order_of_magnitude The order of magnitude of time to use
+ *
+ * \return Time in the given order of magnitude, or the tick count if the
+ *      order of magnitude is unknown
+ */
+uint64_t mdv_sw_timer_conversion_get_time64(
+        mdv_sw_timer_conversion_t const *const conversion,
+        uint64_t const tick_count,
+        mdv_sw_timer_order_of_magnitude_t const order_of_magnitude);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-sw-timer-conversion */
+
+#endif // ifndef MDV_SW_TIMER_CONVERSION_H
+
+/* EOF */
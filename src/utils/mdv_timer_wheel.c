@@ -0,0 +1,544 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mdv_timer_wheel.h"
+#include <assert.h>
+#include <string.h>
+
+/**
+ * \defgroup mdv-timer-wheel-internals Internals
+ * \ingroup  mdv-timer-wheel
+ * @{
+ */
+
+/// Mask for the slot index of one wheel level
+#define SLOT_MASK (MDV_TIMER_WHEEL_SLOTS - 1u)
+/// Range of the wheel in ticks
+#define WHEEL_RANGE (1u << (MDV_TIMER_WHEEL_SLOT_BITS * MDV_TIMER_WHEEL_LEVELS))
+
+/**
+ * \brief Count trailing zero bits
+ *
+ * \param[in] value A non-zero value
+ *
+ * \return Count of trailing zero bits
+ */
+static uint32_t count_trailing_zeros(uint32_t value)
+{
+#if defined(__GNUC__)
+        return (uint32_t)__builtin_ctz(value);
+#else
+        uint32_t count = 0;
+
+        while (!(value & 1u)) {
+                value >>= 1u;
+                ++count;
+        }
+
+        return count;
+#endif // if defined(__GNUC__)
+}
+
+/**
+ * \brief Link an entry to the slot matching its expiration time
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] entry Entry to link
+ *
+ * \return No return value
+ */
+static void link_entry(mdv_timer_wheel_t *const timer_wheel,
+                       mdv_timer_wheel_entry_t *const entry)
+{
+        mdv_timer_wheel_entry_t **slot;
+        uint32_t expires = entry->expires;
+        uint32_t delta = expires - timer_wheel->next_tick;
+        uint8_t level;
+
+        if (delta > MDV_TIMER_WHEEL_MAX_DELAY) {
+                // The entry is already due, expire it on the next tick
+                expires = timer_wheel->next_tick;
+                delta = 0;
+        } else if (delta >= WHEEL_RANGE) {
+                // The entry is beyond the range of the wheel. Park it to the
+                // furthest slot, from where it gets cascaded again.
+                expires = timer_wheel->next_tick + WHEEL_RANGE - 1u;
+                delta = WHEEL_RANGE - 1u;
+        }
+
+        // Find the lowest level covering the delta
+        for (level = 0; level < (MDV_TIMER_WHEEL_LEVELS - 1u); level++) {
+                if (delta < (1u << (MDV_TIMER_WHEEL_SLOT_BITS *
+                                    (level + 1u)))) {
+                        break;
+                }
+        }
+
+        entry->level = level;
+        entry->index = (uint8_t)((expires >> (MDV_TIMER_WHEEL_SLOT_BITS *
+                                              level)) & SLOT_MASK);
+
+        // Push the entry to the head of the slot list
+        slot = &(timer_wheel->slots[level][entry->index]);
+        entry->next = *slot;
+        if (entry->next) {
+                entry->next->pprev = &(entry->next);
+        }
+        entry->pprev = slot;
+        *slot = entry;
+
+        timer_wheel->occupancy[level] |= (1u << entry->index);
+}
+
+/**
+ * \brief Unlink an entry from the list it is in
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] entry Entry to unlink
+ *
+ * \return No return value
+ */
+static void unlink_entry(mdv_timer_wheel_t *const timer_wheel,
+                         mdv_timer_wheel_entry_t *const entry)
+{
+        *(entry->pprev) = entry->next;
+        if (entry->next) {
+                entry->next->pprev = entry->pprev;
+        }
+        entry->next = 0;
+        entry->pprev = 0;
+
+        // The entry may also be in a detached list being processed, in which
+        // case its slot is either empty or has new entries. Either way, the
+        // occupancy bit can be derived from the slot list.
+        if (!timer_wheel->slots[entry->level][entry->index]) {
+                timer_wheel->occupancy[entry->level] &= ~(1u << entry->index);
+        }
+}
+
+/**
+ * \brief Detach all entries from a slot
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] level Level of the slot
+ * \param[in] index Index of the slot
+ * \param[out] list List to receive the entries
+ *
+ * \return No return value
+ */
+static void detach_slot(mdv_timer_wheel_t *const timer_wheel,
+                        uint32_t const level, uint32_t const index,
+                        mdv_timer_wheel_entry_t **const list)
+{
+        *list = timer_wheel->slots[level][index];
+        if (*list) {
+                (*list)->pprev = list;
+        }
+        timer_wheel->slots[level][index] = 0;
+        timer_wheel->occupancy[level] &= ~(1u << index);
+}
+
+/**
+ * \brief Cascade the entries of the higher levels to the lower levels
+ *
+ * Called when the next tick is at the boundary of level 0.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ *
+ * \return No return value
+ */
+static void cascade(mdv_timer_wheel_t *const timer_wheel)
+{
+        mdv_timer_wheel_entry_t *pending;
+        mdv_timer_wheel_entry_t *entry;
+        uint32_t level;
+        uint32_t index;
+
+        for (level = 1; level < MDV_TIMER_WHEEL_LEVELS; level++) {
+                index = (timer_wheel->next_tick >>
+                         (MDV_TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+
+                detach_slot(timer_wheel, level, index, &pending);
+
+                while (pending) {
+                        entry = pending;
+                        unlink_entry(timer_wheel, entry);
+                        link_entry(timer_wheel, entry);
+                }
+
+                // Continue to the next level only if this level wrapped around
+                if (index) {
+                        break;
+                }
+        }
+}
+
+/**
+ * \brief Expire the entries of a level 0 slot
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] index Index of the slot
+ *
+ * \return No return value
+ */
+static void run_slot(mdv_timer_wheel_t *const timer_wheel,
+                     uint32_t const index)
+{
+        mdv_timer_wheel_entry_t *pending;
+        mdv_timer_wheel_entry_t *entry;
+        uint32_t const now = timer_wheel->next_tick - 1u;
+
+        detach_slot(timer_wheel, 0, index, &pending);
+
+        // The callbacks may cancel other pending entries, so take the entries
+        // one by one from the head of the detached list
+        while (pending) {
+                entry = pending;
+                unlink_entry(timer_wheel, entry);
+
+                // An entry parked beyond the range of a single level wheel is
+                // not due yet
+                if ((entry->expires - now - 1u) < MDV_TIMER_WHEEL_MAX_DELAY) {
+                        link_entry(timer_wheel, entry);
+                        continue;
+                }
+
+                // Re-arm a periodic entry relative to its expiration time to
+                // prevent drifting
+                if (entry->period) {
+                        entry->expires += entry->period;
+                        link_entry(timer_wheel, entry);
+                }
+
+                entry->callback(entry, entry->user_data);
+        }
+}
+
+/**
+ * \brief Get the count of ticks which can be skipped without processing
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ *
+ * \return Count of ticks from the next tick having nothing to do
+ */
+static uint32_t get_idle_tick_count(mdv_timer_wheel_t *const timer_wheel)
+{
+        uint32_t const index = timer_wheel->next_tick & SLOT_MASK;
+        uint32_t pending;
+        uint32_t level;
+
+        if (timer_wheel->occupancy[0]) {
+                // Stop at the level boundary to cascade the higher levels
+                if (!index) {
+                        return 0;
+                }
+
+                // Skip to the next occupied slot, or to the level boundary
+                pending = timer_wheel->occupancy[0] >> index;
+                return pending ? count_trailing_zeros(pending) :
+                                 (MDV_TIMER_WHEEL_SLOTS - index);
+        }
+
+        // Level 0 is empty. Skip to the boundary of the lowest occupied level.
+        for (level = 1; level < MDV_TIMER_WHEEL_LEVELS; level++) {
+                if (timer_wheel->occupancy[level]) {
+                        return (0u - timer_wheel->next_tick) &
+                               ((1u << (MDV_TIMER_WHEEL_SLOT_BITS * level)) -
+                                1u);
+                }
+        }
+
+        // The wheel is empty
+        return UINT32_MAX;
+}
+
+/**
+ * \brief Get the offset to the next occupied slot of a level
+ *
+ * \param[in] occupancy Occupancy bitmap of the level (non-zero)
+ * \param[in] index Index of the slot to start from
+ *
+ * \return Count of slots from the given index to the next occupied slot,
+ *      wrapping around the end of the level
+ */
+static uint32_t get_occupied_slot_offset(uint32_t const occupancy,
+                                         uint32_t const index)
+{
+        uint32_t const pending = occupancy >> index;
+
+        return pending ? count_trailing_zeros(pending) :
+                         (MDV_TIMER_WHEEL_SLOTS - index) +
+                         count_trailing_zeros(occupancy);
+}
+
+/**
+ * \brief Advance the wheel to the given tick count of the timer base
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] tick_count Current tick count of the timer base
+ *
+ * \return No return value
+ */
+static void advance_to_tick_count(mdv_timer_wheel_t *const timer_wheel,
+                                  uint32_t const tick_count)
+{
+        uint32_t elapsed;
+
+        // The timer mask handles the wrap-around of the timer counter
+        elapsed = (tick_count - timer_wheel->last_tick_count) &
+                  timer_wheel->timer_mask;
+        timer_wheel->last_tick_count = tick_count;
+
+        if (elapsed) {
+                mdv_timer_wheel_advance(timer_wheel, elapsed);
+        }
+}
+
+/** @} mdv-timer-wheel-internals */
+
+void mdv_timer_wheel_init(mdv_timer_wheel_t *const timer_wheel,
+                          mdv_sw_timer_base_t *const sw_timer_base)
+{
+        assert(timer_wheel);
+        assert(sw_timer_base);
+
+        // Reset all slots and occupancy bitmaps
+        memset(timer_wheel, 0, sizeof(mdv_timer_wheel_t));
+        // Link the wheel with the timer base
+        timer_wheel->sw_timer_base = sw_timer_base;
+        // Get the timer mask from the timer base
+        timer_wheel->timer_mask =
+                mdv_sw_timer_base_get_timer_mask(sw_timer_base);
+        // Take the reference point for the elapsed time
+        timer_wheel->last_tick_count =
+                mdv_sw_timer_base_get_tick_count(sw_timer_base);
+        // The wheel time starts from zero
+        timer_wheel->next_tick = 1u;
+}
+
+void mdv_timer_wheel_entry_init(mdv_timer_wheel_entry_t *const entry,
+                                mdv_timer_wheel_callback_t const callback,
+                                void *const user_data)
+{
+        assert(entry);
+        assert(callback);
+
+        entry->next = 0;
+        entry->pprev = 0;
+        entry->expires = 0u;
+        entry->period = 0u;
+        entry->callback = callback;
+        entry->user_data = user_data;
+        entry->level = 0u;
+        entry->index = 0u;
+}
+
+void mdv_timer_wheel_arm(mdv_timer_wheel_t *const timer_wheel,
+                         mdv_timer_wheel_entry_t *const entry,
+                         uint32_t const delay_ticks,
+                         uint32_t const period_ticks)
+{
+        assert(timer_wheel);
+        assert(entry);
+        assert(delay_ticks <= MDV_TIMER_WHEEL_MAX_DELAY);
+        assert(period_ticks <= MDV_TIMER_WHEEL_MAX_DELAY);
+
+        if (entry->pprev) {
+                unlink_entry(timer_wheel, entry);
+        }
+
+        entry->expires = (timer_wheel->next_tick - 1u) + delay_ticks;
+        entry->period = period_ticks;
+
+        link_entry(timer_wheel, entry);
+}
+
+void mdv_timer_wheel_cancel(mdv_timer_wheel_t *const timer_wheel,
+                            mdv_timer_wheel_entry_t *const entry)
+{
+        assert(timer_wheel);
+        assert(entry);
+
+        if (entry->pprev) {
+                unlink_entry(timer_wheel, entry);
+        }
+}
+
+bool mdv_timer_wheel_is_armed(mdv_timer_wheel_entry_t *const entry)
+{
+        assert(entry);
+
+        return !!(entry->pprev);
+}
+
+void mdv_timer_wheel_advance(mdv_timer_wheel_t *const timer_wheel,
+                             uint32_t const tick_count)
+{
+        uint32_t remaining = tick_count;
+        uint32_t index;
+        uint32_t idle;
+
+        assert(timer_wheel);
+
+        while (remaining) {
+                index = timer_wheel->next_tick & SLOT_MASK;
+
+                if (!index) {
+                        cascade(timer_wheel);
+                }
+
+                ++timer_wheel->next_tick;
+                --remaining;
+
+                if (timer_wheel->occupancy[0] & (1u << index)) {
+                        run_slot(timer_wheel, index);
+                }
+
+                // Fast forward over the ticks having nothing to do
+                idle = get_idle_tick_count(timer_wheel);
+                if (idle > remaining) {
+                        idle = remaining;
+                }
+                timer_wheel->next_tick += idle;
+                remaining -= idle;
+        }
+}
+
+void mdv_timer_wheel_process(mdv_timer_wheel_t *const timer_wheel)
+{
+        assert(timer_wheel);
+
+        advance_to_tick_count(timer_wheel, mdv_sw_timer_base_get_tick_count(
+                timer_wheel->sw_timer_base));
+}
+
+void mdv_timer_wheel_handle_event(void *const user_data,
+                                  uint32_t const tick_count)
+{
+        mdv_timer_wheel_t *const timer_wheel = (mdv_timer_wheel_t *)user_data;
+
+        assert(timer_wheel);
+
+        advance_to_tick_count(timer_wheel, tick_count);
+}
+
+uint32_t mdv_timer_wheel_get_next_deadline(
+        mdv_timer_wheel_t *const timer_wheel)
+{
+        mdv_timer_wheel_entry_t *entry;
+        uint32_t now;
+        uint32_t deadline = MDV_SW_TIMER_BASE_NO_DEADLINE;
+        uint32_t shift;
+        uint32_t slot;
+        uint32_t start;
+        uint32_t delay;
+        uint32_t level;
+
+        assert(timer_wheel);
+
+        now = timer_wheel->next_tick - 1u;
+
+        // The entries of level 0 expire at the tick of their slot
+        if (timer_wheel->occupancy[0]) {
+                deadline = get_occupied_slot_offset(
+                        timer_wheel->occupancy[0],
+                        timer_wheel->next_tick & SLOT_MASK) + 1u;
+        }
+
+        for (level = 1; level < MDV_TIMER_WHEEL_LEVELS; level++) {
+                if (!timer_wheel->occupancy[level]) {
+                        continue;
+                }
+
+                // The slot of the next tick is still to be cascaded only if
+                // the next tick is at the level boundary
+                shift = MDV_TIMER_WHEEL_SLOT_BITS * level;
+                slot = (timer_wheel->next_tick >> shift) +
+                       ((timer_wheel->next_tick & ((1u << shift) - 1u)) ?
+                        1u : 0u);
+                slot += get_occupied_slot_offset(timer_wheel->occupancy[level],
+                                                 slot & SLOT_MASK);
+
+                // No entry of the slot expires before the slot is cascaded
+                start = (slot << shift) - now;
+                if (start >= deadline) {
+                        continue;
+                }
+
+                // An entry parked beyond the range of the wheel is due for
+                // the cascade only
+                for (entry = timer_wheel->slots[level][slot & SLOT_MASK];
+                     entry; entry = entry->next) {
+                        delay = entry->expires - now;
+                        if ((delay - start) >= (1u << shift)) {
+                                delay = start;
+                        }
+                        if (delay < deadline) {
+                                deadline = delay;
+                        }
+                }
+        }
+
+        return deadline;
+}
+
+uint32_t mdv_timer_wheel_provide_deadline(void *const user_data,
+                                          uint32_t const tick_count)
+{
+        mdv_timer_wheel_t *const timer_wheel = (mdv_timer_wheel_t *)user_data;
+        uint32_t deadline;
+        uint32_t elapsed;
+
+        assert(timer_wheel);
+
+        deadline = mdv_timer_wheel_get_next_deadline(timer_wheel);
+        if (deadline == MDV_SW_TIMER_BASE_NO_DEADLINE) {
+                return deadline;
+        }
+
+        // The wheel may lag behind the timer base if it is not processed by
+        // the event handler
+        elapsed = (tick_count - timer_wheel->last_tick_count) &
+                  timer_wheel->timer_mask;
+
+        return (deadline > elapsed) ? (deadline - elapsed) : 0u;
+}
+
+uint32_t mdv_timer_wheel_get_time(mdv_timer_wheel_t *const timer_wheel)
+{
+        assert(timer_wheel);
+
+        return timer_wheel->next_tick - 1u;
+}
+
+/* EOF */
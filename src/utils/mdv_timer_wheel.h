@@ -0,0 +1,321 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2020, Tuomas Terho
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MDV_TIMER_WHEEL_H
+#define MDV_TIMER_WHEEL_H
+
+#include "mdv_sw_timer_base.h"
+
+/**
+ * \file       mdv_timer_wheel.h
+ * \defgroup   mdv-timer-wheel Hierarchical timing wheel
+ * \ingroup    madivaru-lib-v2
+ * \copyright  Copyright &copy; 2020, Tuomas Terho. All rights reserved.
+ *
+ * The timing wheel keeps track of a large number of deadlines on top of one
+ * software timer base. Instead of polling each timer separately, the
+ * application arms wheel entries with a callback and calls
+ * \ref mdv_timer_wheel_process from the main loop (or from the timer base
+ * event). Arming, cancelling and expiring an entry are constant time
+ * operations, and the work done per processed tick depends on the number of
+ * expiring entries only, not on the number of armed entries.
+ *
+ * The wheel consists of MDV_TIMER_WHEEL_LEVELS levels, each having
+ * 2^MDV_TIMER_WHEEL_SLOT_BITS slots. Level 0 has one tick resolution, and each
+ * higher level covers the full range of the level below it with one slot.
+ * Entries are cascaded to the lower levels when their time approaches. Delays
+ * longer than the range of the wheel are parked on the highest level and
+ * cascaded again until they are due.
+ *
+ * The wheel measures the elapsed time from the timer base tick count using the
+ * timer mask, so the wrap-around of the timer counter is handled as long as
+ * \ref mdv_timer_wheel_process is called at least once per one counter period.
+ *
+ * In the tickless mode of the timer base, the wheel is set as the deadline
+ * provider with \ref mdv_timer_wheel_provide_deadline, so the timer base
+ * wakes up only when an entry expires.
+ *
+ * @{
+ */
+
+#ifndef MDV_TIMER_WHEEL_SLOT_BITS
+/// Number of bits in the slot index of one wheel level (1 to 5)
+#define MDV_TIMER_WHEEL_SLOT_BITS 5u
+#endif // ifndef MDV_TIMER_WHEEL_SLOT_BITS
+
+#ifndef MDV_TIMER_WHEEL_LEVELS
+/// Number of levels in the wheel
+#define MDV_TIMER_WHEEL_LEVELS 6u
+#endif // ifndef MDV_TIMER_WHEEL_LEVELS
+
+#if (MDV_TIMER_WHEEL_SLOT_BITS < 1) || (MDV_TIMER_WHEEL_SLOT_BITS > 5)
+#error "MDV_TIMER_WHEEL_SLOT_BITS must be from 1 to 5"
+#endif
+
+#if (MDV_TIMER_WHEEL_LEVELS < 1) || \
+    ((MDV_TIMER_WHEEL_LEVELS * MDV_TIMER_WHEEL_SLOT_BITS) > 30)
+#error "MDV_TIMER_WHEEL_LEVELS * MDV_TIMER_WHEEL_SLOT_BITS must not exceed 30"
+#endif
+
+/// Number of slots in one wheel level
+#define MDV_TIMER_WHEEL_SLOTS (1u << MDV_TIMER_WHEEL_SLOT_BITS)
+
+/// Maximum delay of an entry in ticks
+#define MDV_TIMER_WHEEL_MAX_DELAY 0x7fffffffu
+
+struct _mdv_timer_wheel_entry_t;
+
+/**
+ * \brief Timer wheel callback function type
+ *
+ * The callback is called when the entry expires. A one-shot entry is disarmed
+ * before the callback is called, and a periodic entry is already re-armed for
+ * the next period, so the callback is free to arm or cancel the entry, or any
+ * other entry in the wheel.
+ *
+ * \param[in] entry The expired entry
+ * \param[in] user_data User data given when the entry was initialized
+ *
+ * \return No return value
+ */
+typedef void (*mdv_timer_wheel_callback_t)(
+        struct _mdv_timer_wheel_entry_t *const entry, void *const user_data);
+
+/**
+ * \brief Timer wheel entry
+ *
+ * The entry is owned by the caller and linked into the wheel while armed. The
+ * fields are internal to the timer wheel.
+ */
+typedef struct _mdv_timer_wheel_entry_t{
+        /// Next entry in the same slot
+        struct _mdv_timer_wheel_entry_t *next;
+        /// Pointer to the link pointing to this entry (null if not armed)
+        struct _mdv_timer_wheel_entry_t **pprev;
+        /// Expiration time in wheel ticks
+        uint32_t expires;
+        /// Period in ticks (zero for a one-shot entry)
+        uint32_t period;
+        /// Callback to call when the entry expires
+        mdv_timer_wheel_callback_t callback;
+        /// User data passed to the callback
+        void *user_data;
+        /// Level of the slot holding the entry
+        uint8_t level;
+        /// Index of the slot holding the entry
+        uint8_t index;
+} mdv_timer_wheel_entry_t;
+
+/**
+ * \brief Timer wheel instance data
+ */
+typedef struct _mdv_timer_wheel_t{
+        /// Timer base on which this wheel runs
+        mdv_sw_timer_base_t *sw_timer_base;
+        /// Timer counter mask, inherited from the timer base
+        uint32_t timer_mask;
+        /// Tick count of the timer base when the wheel was last processed
+        uint32_t last_tick_count;
+        /// Next wheel tick to be processed
+        uint32_t next_tick;
+        /// Slot occupancy bitmaps, one bit per non-empty slot
+        uint32_t occupancy[MDV_TIMER_WHEEL_LEVELS];
+        /// Slot lists
+        mdv_timer_wheel_entry_t *slots[MDV_TIMER_WHEEL_LEVELS]
+                                      [MDV_TIMER_WHEEL_SLOTS];
+} mdv_timer_wheel_t;
+
+#ifdef __cplusplus
+extern "C"{
+#endif // ifdef __cplusplus
+
+/**
+ * \brief Initialize a timer wheel
+ *
+ * \param[in] timer_wheel Timer wheel to initialize
+ * \param[in] sw_timer_base Timer base which this wheel will use
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_init(mdv_timer_wheel_t *const timer_wheel,
+                          mdv_sw_timer_base_t *const sw_timer_base);
+
+/**
+ * \brief Initialize a timer wheel entry
+ *
+ * \param[in] entry Entry to initialize
+ * \param[in] callback Callback to call when the entry expires
+ * \param[in] user_data User data passed to the callback
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_entry_init(mdv_timer_wheel_entry_t *const entry,
+                                mdv_timer_wheel_callback_t const callback,
+                                void *const user_data);
+
+/**
+ * \brief Arm an entry
+ *
+ * If the entry is already armed, it is re-armed with the new delay.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] entry Entry to arm
+ * \param[in] delay_ticks Delay from the current wheel time in ticks (zero
+ *      expires the entry on the next processed tick)
+ * \param[in] period_ticks Period in ticks for a periodic entry, or zero for a
+ *      one-shot entry
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_arm(mdv_timer_wheel_t *const timer_wheel,
+                         mdv_timer_wheel_entry_t *const entry,
+                         uint32_t const delay_ticks,
+                         uint32_t const period_ticks);
+
+/**
+ * \brief Cancel an entry
+ *
+ * Cancelling an entry which is not armed has no effect.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] entry Entry to cancel
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_cancel(mdv_timer_wheel_t *const timer_wheel,
+                            mdv_timer_wheel_entry_t *const entry);
+
+/**
+ * \brief Check if an entry is armed
+ *
+ * \param[in] entry Entry to check
+ *
+ * \retval true The entry is armed
+ * \retval false The entry is not armed
+ */
+bool mdv_timer_wheel_is_armed(mdv_timer_wheel_entry_t *const entry);
+
+/**
+ * \brief Advance the wheel by the given tick count
+ *
+ * Expires all entries which become due during the given ticks, in the order of
+ * their expiration time. This function does not read the timer base, so it can
+ * be used to drive the wheel from a tick interrupt directly.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ * \param[in] tick_count Count to advance the wheel by
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_advance(mdv_timer_wheel_t *const timer_wheel,
+                             uint32_t const tick_count);
+
+/**
+ * \brief Process the wheel
+ *
+ * Reads the tick count from the timer base and advances the wheel by the ticks
+ * elapsed since the previous call.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_process(mdv_timer_wheel_t *const timer_wheel);
+
+/**
+ * \brief Handle a timer base event
+ *
+ * This function can be set as the event handler of the timer base with
+ * \ref mdv_sw_timer_base_set_event_handler, in which case the wheel is
+ * processed each time the tick counter of the timer base advances.
+ *
+ * \param[in] user_data Timer wheel in use
+ * \param[in] tick_count Current tick count of the timer base
+ *
+ * \return No return value
+ */
+void mdv_timer_wheel_handle_event(void *const user_data,
+                                  uint32_t const tick_count);
+
+/**
+ * \brief Get the ticks until the earliest armed entry expires
+ *
+ * Only the earliest occupied slot of each level is examined, so the cost does
+ * not depend on the number of armed entries in the other slots. An entry
+ * parked beyond the range of the wheel is reported at the time it is cascaded
+ * again.
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ *
+ * \return Count of ticks from the current wheel time to the earliest
+ *      expiration, or \ref MDV_SW_TIMER_BASE_NO_DEADLINE if no entries are
+ *      armed
+ */
+uint32_t mdv_timer_wheel_get_next_deadline(
+        mdv_timer_wheel_t *const timer_wheel);
+
+/**
+ * \brief Provide the next deadline to the timer base
+ *
+ * This function can be set as the deadline provider of the timer base with
+ * \ref mdv_sw_timer_base_set_deadline_provider, in which case the timer base
+ * in the tickless mode wakes up when the earliest armed entry expires.
+ *
+ * \param[in] user_data Timer wheel in use
+ * \param[in] tick_count Current tick count of the timer base
+ *
+ * \return Count of ticks from the given tick count to the earliest
+ *      expiration, or \ref MDV_SW_TIMER_BASE_NO_DEADLINE if no entries are
+ *      armed
+ */
+uint32_t mdv_timer_wheel_provide_deadline(void *const user_data,
+                                          uint32_t const tick_count);
+
+/**
+ * \brief Get the current wheel time
+ *
+ * \param[in] timer_wheel Timer wheel in use
+ *
+ * \return The last processed wheel tick
+ */
+uint32_t mdv_timer_wheel_get_time(mdv_timer_wheel_t *const timer_wheel);
+
+#ifdef __cplusplus
+}
+#endif // ifdef __cplusplus
+
+/** @} mdv-timer-wheel */
+
+#endif // ifndef MDV_TIMER_WHEEL_H
+
+/* EOF */
@@ -39,6 +39,121 @@ void mdv_sw_timer_base_init(mdv_sw_timer_base_t *const sw_timer_base,
                                        timer_width_bits, timer_driver);
 }
 
+void mdv_sw_timer_base_init_event_driven(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const tick_duration_us,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_event_driven(sw_timer_base,
+                                                    tick_duration_us,
+                                                    timer_width_bits,
+                                                    timer_driver);
+}
+
+void mdv_sw_timer_base_init_period(mdv_sw_timer_base_t *const sw_timer_base,
+                                   uint64_t const tick_period_ns_q32,
+                                   uint8_t const timer_width_bits,
+                                   mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_period(sw_timer_base,
+                                              tick_period_ns_q32,
+                                              timer_width_bits, timer_driver);
+}
+
+void mdv_sw_timer_base_init_event_driven_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_event_driven_period(sw_timer_base,
+                                                           tick_period_ns_q32,
+                                                           timer_width_bits,
+                                                           timer_driver);
+}
+
+void mdv_sw_timer_base_init_tickless(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const timer_width_bits,
+                                     mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_tickless(sw_timer_base,
+                                                tick_duration_us,
+                                                timer_width_bits,
+                                                timer_driver);
+}
+
+void mdv_sw_timer_base_init_tickless_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const timer_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_tickless_period(sw_timer_base,
+                                                       tick_period_ns_q32,
+                                                       timer_width_bits,
+                                                       timer_driver);
+}
+
+void mdv_sw_timer_base_init_extended(mdv_sw_timer_base_t *const sw_timer_base,
+                                     uint32_t const tick_duration_us,
+                                     uint8_t const counter_width_bits,
+                                     mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_extended(sw_timer_base,
+                                                tick_duration_us,
+                                                counter_width_bits,
+                                                timer_driver);
+}
+
+void mdv_sw_timer_base_init_extended_period(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint64_t const tick_period_ns_q32,
+        uint8_t const counter_width_bits,
+        mdv_timer_driver_t *const timer_driver)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_init_extended_period(sw_timer_base,
+                                                       tick_period_ns_q32,
+                                                       counter_width_bits,
+                                                       timer_driver);
+}
+
+void mdv_sw_timer_base_set_deadline_provider(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_deadline_provider_t const deadline_provider,
+        void *const user_data)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_set_deadline_provider(sw_timer_base,
+                                                        deadline_provider,
+                                                        user_data);
+}
+
+void mdv_sw_timer_base_update_deadline(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_update_deadline(sw_timer_base);
+}
+
+void mdv_sw_timer_base_set_event_handler(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_timer_event_handler_t const event_handler,
+        void *const user_data)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_set_event_handler(sw_timer_base,
+                                                    event_handler, user_data);
+}
+
 void mdv_sw_timer_base_uninit(mdv_sw_timer_base_t *const sw_timer_base)
 {
         return MockMdvSwTimerBase::instance().
@@ -59,6 +174,47 @@ uint32_t mdv_sw_timer_base_get_tick_count(
                 mdv_sw_timer_base_get_tick_count(sw_timer_base);
 }
 
+uint64_t mdv_sw_timer_base_get_tick_count64(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_get_tick_count64(sw_timer_base);
+}
+
+void mdv_sw_timer_base_set_snapshot_mode(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        bool const is_enabled)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_set_snapshot_mode(sw_timer_base, is_enabled);
+}
+
+uint32_t mdv_sw_timer_base_latch(mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_latch(sw_timer_base);
+}
+
+void mdv_sw_timer_base_set_starvation_monitor(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        uint32_t const stall_limit,
+        mdv_sw_timer_base_starvation_handler_t const handler,
+        void *const user_data)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_set_starvation_monitor(sw_timer_base,
+                                                         stall_limit, handler,
+                                                         user_data);
+}
+
+void mdv_sw_timer_base_get_starvation_status(
+        mdv_sw_timer_base_t *const sw_timer_base,
+        mdv_sw_timer_base_starvation_status_t *const status)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_get_starvation_status(sw_timer_base, status);
+}
+
 uint32_t mdv_sw_timer_base_get_tick_duration_us(
         mdv_sw_timer_base_t *const sw_timer_base)
 {
@@ -66,6 +222,13 @@ uint32_t mdv_sw_timer_base_get_tick_duration_us(
                 mdv_sw_timer_base_get_tick_duration_us(sw_timer_base);
 }
 
+uint64_t mdv_sw_timer_base_get_tick_period_ns_q32(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_get_tick_period_ns_q32(sw_timer_base);
+}
+
 uint32_t mdv_sw_timer_base_get_timer_mask(
         mdv_sw_timer_base_t *const sw_timer_base)
 {
@@ -73,4 +236,11 @@ uint32_t mdv_sw_timer_base_get_timer_mask(
                 mdv_sw_timer_base_get_timer_mask(sw_timer_base);
 }
 
+mdv_sw_timer_conversion_t const *mdv_sw_timer_base_get_conversion(
+        mdv_sw_timer_base_t *const sw_timer_base)
+{
+        return MockMdvSwTimerBase::instance().
+                mdv_sw_timer_base_get_conversion(sw_timer_base);
+}
+
 } // extern "C"
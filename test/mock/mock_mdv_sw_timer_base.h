@@ -20,16 +20,64 @@ class MockMdvSwTimerBase {
         MOCK_METHOD4(mdv_sw_timer_base_init,
                      void(mdv_sw_timer_base_t *const, uint32_t const,
                      uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_event_driven,
+                     void(mdv_sw_timer_base_t *const, uint32_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_period,
+                     void(mdv_sw_timer_base_t *const, uint64_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_event_driven_period,
+                     void(mdv_sw_timer_base_t *const, uint64_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_tickless,
+                     void(mdv_sw_timer_base_t *const, uint32_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_tickless_period,
+                     void(mdv_sw_timer_base_t *const, uint64_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_extended,
+                     void(mdv_sw_timer_base_t *const, uint32_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_init_extended_period,
+                     void(mdv_sw_timer_base_t *const, uint64_t const,
+                     uint8_t const, mdv_timer_driver_t *const));
+        MOCK_METHOD3(mdv_sw_timer_base_set_deadline_provider,
+                     void(mdv_sw_timer_base_t *const,
+                     mdv_sw_timer_base_deadline_provider_t const,
+                     void *const));
+        MOCK_METHOD1(mdv_sw_timer_base_update_deadline,
+                     void(mdv_sw_timer_base_t *const));
+        MOCK_METHOD3(mdv_sw_timer_base_set_event_handler,
+                     void(mdv_sw_timer_base_t *const,
+                     mdv_timer_event_handler_t const, void *const));
         MOCK_METHOD1(mdv_sw_timer_base_uninit,
                      void(mdv_sw_timer_base_t *const));
         MOCK_METHOD2(mdv_sw_timer_base_tick,
                      void(mdv_sw_timer_base_t *const, uint32_t const));
         MOCK_METHOD1(mdv_sw_timer_base_get_tick_count,
                      uint32_t(mdv_sw_timer_base_t *const));
+        MOCK_METHOD1(mdv_sw_timer_base_get_tick_count64,
+                     uint64_t(mdv_sw_timer_base_t *const));
+        MOCK_METHOD2(mdv_sw_timer_base_set_snapshot_mode,
+                     void(mdv_sw_timer_base_t *const, bool const));
+        MOCK_METHOD1(mdv_sw_timer_base_latch,
+                     uint32_t(mdv_sw_timer_base_t *const));
+        MOCK_METHOD4(mdv_sw_timer_base_set_starvation_monitor,
+                     void(mdv_sw_timer_base_t *const, uint32_t const,
+                          mdv_sw_timer_base_starvation_handler_t const,
+                          void *const));
+        MOCK_METHOD2(mdv_sw_timer_base_get_starvation_status,
+                     void(mdv_sw_timer_base_t *const,
+                          mdv_sw_timer_base_starvation_status_t *const));
         MOCK_METHOD1(mdv_sw_timer_base_get_tick_duration_us,
                      uint32_t(mdv_sw_timer_base_t *const));
+        MOCK_METHOD1(mdv_sw_timer_base_get_tick_period_ns_q32,
+                     uint64_t(mdv_sw_timer_base_t *const));
         MOCK_METHOD1(mdv_sw_timer_base_get_timer_mask,
                      uint32_t(mdv_sw_timer_base_t *const));
+        MOCK_METHOD1(mdv_sw_timer_base_get_conversion,
+                     mdv_sw_timer_conversion_t const *(
+                     mdv_sw_timer_base_t *const));
 
         private:
 
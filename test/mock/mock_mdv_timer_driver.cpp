@@ -71,6 +71,12 @@ bool mdv_timer_driver_is_running(void)
         return MockMdvTimerDriver::instance().mdv_timer_driver_is_running();
 }
 
+mdv_result_t mdv_timer_driver_set_compare(uint32_t const counter)
+{
+        return MockMdvTimerDriver::instance().mdv_timer_driver_set_compare(
+                counter);
+}
+
 } // extern "C"
 
 /*
@@ -80,5 +86,5 @@ mdv_timer_driver_t MockMdvTimerDriver::m_mdvTimerDriver = {
         ::mdv_timer_driver_init, ::mdv_timer_driver_uninit,
         ::mdv_timer_driver_start, ::mdv_timer_driver_stop,
         ::mdv_timer_driver_reset, ::mdv_timer_driver_get_count,
-        ::mdv_timer_driver_is_running
+        ::mdv_timer_driver_is_running, ::mdv_timer_driver_set_compare
 };
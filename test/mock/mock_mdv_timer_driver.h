@@ -27,6 +27,8 @@ class MockMdvTimerDriver {
         MOCK_METHOD0(mdv_timer_driver_reset, mdv_result_t(void));
         MOCK_METHOD0(mdv_timer_driver_get_count, uint32_t(void));
         MOCK_METHOD0(mdv_timer_driver_is_running, bool(void));
+        MOCK_METHOD1(mdv_timer_driver_set_compare,
+                mdv_result_t(uint32_t const));
 
         private:
 
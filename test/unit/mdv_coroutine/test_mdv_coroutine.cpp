@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "mdv_coroutine.hpp"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 1000u
+// Test value for timer width in bits
+#define TEST_TIMER_WIDTH_BITS 32u
+// Test value for the delay in ticks
+#define TEST_DELAY 10u
+// Count of flows in the test with many flows
+#define TEST_FLOW_COUNT 10000u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Counts the destructions of the coroutine frames holding it
+ */
+struct test_guard {
+        explicit test_guard(uint32_t *const count) : m_count(count)
+        {
+        }
+
+        ~test_guard()
+        {
+                ++*m_count;
+        }
+
+        uint32_t *m_count;
+};
+
+class test_mdv_coroutine : public Test
+{
+        protected:
+
+        void SetUp() override {
+                mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                                       TEST_TIMER_WIDTH_BITS, 0);
+                m_wake_ticks.clear();
+                m_destroy_count = 0;
+        }
+
+        // Advance the timer base tick by tick, running the loop on each tick
+        void Run(mdv::coroutine_loop &loop, uint32_t const tick_count) {
+                for (uint32_t i = 0; i < tick_count; i++) {
+                        mdv_sw_timer_base_tick(&m_sw_timer_base, 1u);
+                        loop.run_once();
+                }
+        }
+
+        uint64_t GetTickCount64() {
+                return mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base);
+        }
+
+        mdv::task<> Sleeper(mdv::coroutine_loop &loop, uint32_t const delay) {
+                test_guard guard(&m_destroy_count);
+
+                co_await mdv::sleep_for(loop, delay);
+                m_wake_ticks.push_back(GetTickCount64());
+        }
+
+        mdv::task<int> Answer(mdv::coroutine_loop &loop, uint32_t const delay,
+                              int const value) {
+                test_guard guard(&m_destroy_count);
+
+                co_await mdv::sleep_for(loop, delay);
+                co_return value;
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        std::vector<uint64_t> m_wake_ticks;
+        uint32_t m_destroy_count;
+};
+
+TEST_F(test_mdv_coroutine, sleep_for__resumed_after_delay)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+
+        loop.spawn(Sleeper(loop, TEST_DELAY));
+
+        EXPECT_EQ(1u, loop.get_flow_count()) << "The flow must be running.";
+        EXPECT_EQ(TEST_DELAY, loop.get_next_deadline())
+                << "The flow must wait for the delay.";
+
+        Run(loop, TEST_DELAY - 1u);
+        EXPECT_TRUE(m_wake_ticks.empty())
+                << "The flow must not resume before the delay.";
+
+        Run(loop, 1u);
+        ASSERT_EQ(1u, m_wake_ticks.size()) << "The flow must resume.";
+        EXPECT_EQ((uint64_t)TEST_DELAY, m_wake_ticks[0])
+                << "The flow must resume at the delay.";
+        EXPECT_EQ(0u, loop.get_flow_count())
+                << "The returned flow must be removed.";
+        EXPECT_EQ(1u, m_destroy_count)
+                << "The frame of the returned flow must be destroyed.";
+}
+
+TEST_F(test_mdv_coroutine, sleep_for__delay_relative_to_timer_base)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+
+        // The loop has not been run during these ticks
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_DELAY);
+        loop.spawn(Sleeper(loop, TEST_DELAY));
+
+        EXPECT_EQ(TEST_DELAY, loop.get_next_deadline())
+                << "The delay must start from the current tick count.";
+        Run(loop, TEST_DELAY);
+        ASSERT_EQ(1u, m_wake_ticks.size()) << "The flow must resume.";
+        EXPECT_EQ(2u * TEST_DELAY, m_wake_ticks[0])
+                << "The flow must resume after the delay from the spawn.";
+}
+
+TEST_F(test_mdv_coroutine, sleep_for__zero_delay_does_not_suspend)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+
+        loop.spawn(Sleeper(loop, 0));
+
+        EXPECT_EQ(1u, m_wake_ticks.size())
+                << "The flow must not suspend.";
+        EXPECT_EQ(0u, loop.get_flow_count())
+                << "The flow must have returned.";
+}
+
+TEST_F(test_mdv_coroutine, sleep_until__resumed_at_tick_count)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        auto flow = [&]() -> mdv::task<> {
+                co_await mdv::sleep_until(loop, 3u * TEST_DELAY);
+                m_wake_ticks.push_back(GetTickCount64());
+                co_await mdv::sleep_until(loop, TEST_DELAY);
+                m_wake_ticks.push_back(GetTickCount64());
+        };
+
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_DELAY);
+        loop.spawn(flow());
+        Run(loop, 2u * TEST_DELAY);
+
+        EXPECT_EQ(std::vector<uint64_t>({ 3u * TEST_DELAY, 3u * TEST_DELAY }),
+                  m_wake_ticks)
+                << "The flow must resume at the tick count, and a past tick " \
+                   "count must not suspend.";
+}
+
+TEST_F(test_mdv_coroutine, task__awaited_task_returns_value)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        int result = 0;
+        auto flow = [&]() -> mdv::task<> {
+                result = co_await Answer(loop, TEST_DELAY, 42);
+        };
+
+        loop.spawn(flow());
+        Run(loop, TEST_DELAY);
+
+        EXPECT_EQ(42, result) << "The value must be returned.";
+        EXPECT_EQ(0u, loop.get_flow_count()) << "The flow must return.";
+}
+
+TEST_F(test_mdv_coroutine, with_timeout__task_returns_before_deadline)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        std::optional<int> result;
+        auto flow = [&]() -> mdv::task<> {
+                result = co_await mdv::with_timeout(
+                        loop, Answer(loop, TEST_DELAY, 42), 2u * TEST_DELAY);
+                m_wake_ticks.push_back(GetTickCount64());
+        };
+
+        loop.spawn(flow());
+        Run(loop, TEST_DELAY);
+
+        ASSERT_TRUE(result.has_value()) << "The task must return.";
+        EXPECT_EQ(42, *result) << "The value must be returned.";
+        EXPECT_EQ(std::vector<uint64_t>({ TEST_DELAY }), m_wake_ticks)
+                << "The flow must continue when the task returns.";
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE, loop.get_next_deadline())
+                << "The deadline must be cancelled.";
+}
+
+TEST_F(test_mdv_coroutine, with_timeout__task_destroyed_at_deadline)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        std::optional<int> result = 0;
+        auto flow = [&]() -> mdv::task<> {
+                result = co_await mdv::with_timeout(
+                        loop, Answer(loop, 2u * TEST_DELAY, 42), TEST_DELAY);
+                m_wake_ticks.push_back(GetTickCount64());
+        };
+
+        loop.spawn(flow());
+        Run(loop, TEST_DELAY);
+
+        EXPECT_FALSE(result.has_value()) << "The deadline must expire.";
+        EXPECT_EQ(std::vector<uint64_t>({ TEST_DELAY }), m_wake_ticks)
+                << "The flow must continue at the deadline.";
+        EXPECT_EQ(1u, m_destroy_count)
+                << "The task must be destroyed at the deadline.";
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE, loop.get_next_deadline())
+                << "The wait of the destroyed task must be cancelled.";
+        EXPECT_EQ(0u, loop.get_flow_count()) << "The flow must return.";
+}
+
+TEST_F(test_mdv_coroutine, with_timeout__task_returning_no_value)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        std::vector<bool> results;
+        auto flow = [&]() -> mdv::task<> {
+                results.push_back(co_await mdv::with_timeout(
+                        loop, Sleeper(loop, TEST_DELAY), TEST_DELAY + 1u));
+                results.push_back(co_await mdv::with_timeout(
+                        loop, Sleeper(loop, TEST_DELAY), TEST_DELAY - 1u));
+        };
+
+        loop.spawn(flow());
+        Run(loop, 2u * TEST_DELAY);
+
+        EXPECT_EQ(std::vector<bool>({ true, false }), results)
+                << "The result must tell if the task returned.";
+}
+
+TEST_F(test_mdv_coroutine, with_timeout__nested_deadlines)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        bool outer_result = true;
+        auto inner = [&]() -> mdv::task<> {
+                test_guard guard(&m_destroy_count);
+
+                // The inner deadline is later than the outer one
+                co_await mdv::with_timeout(loop, Sleeper(loop, 4u * TEST_DELAY),
+                                           3u * TEST_DELAY);
+        };
+        auto flow = [&]() -> mdv::task<> {
+                outer_result = co_await mdv::with_timeout(loop, inner(),
+                                                          TEST_DELAY);
+        };
+
+        loop.spawn(flow());
+        Run(loop, TEST_DELAY);
+
+        EXPECT_FALSE(outer_result) << "The outer deadline must expire.";
+        EXPECT_EQ(2u, m_destroy_count)
+                << "The nested tasks must be destroyed.";
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE, loop.get_next_deadline())
+                << "All waits and deadlines must be cancelled.";
+}
+
+TEST_F(test_mdv_coroutine, run__many_flows_resumed_on_time)
+{
+        mdv::coroutine_loop loop(&m_sw_timer_base);
+        uint32_t late_count = 0;
+        uint32_t wake_count = 0;
+        auto flow = [&](uint32_t const period) -> mdv::task<> {
+                for (uint32_t i = 1u; i <= 3u; i++) {
+                        uint64_t const start = GetTickCount64();
+
+                        co_await mdv::sleep_for(loop, period);
+
+                        if (GetTickCount64() != start + period) {
+                                ++late_count;
+                        }
+
+                        ++wake_count;
+                }
+        };
+
+        for (uint32_t i = 0; i < TEST_FLOW_COUNT; i++) {
+                loop.spawn(flow(1u + i % 100u));
+        }
+
+        loop.run([&](uint32_t const idle_ticks) {
+                // Jump to the next deadline without processing the ticks
+                // in between
+                mdv_sw_timer_base_tick(&m_sw_timer_base, idle_ticks);
+        });
+
+        EXPECT_EQ(3u * TEST_FLOW_COUNT, wake_count)
+                << "All flows must resume.";
+        EXPECT_EQ(0u, late_count) << "All flows must resume on time.";
+        EXPECT_EQ(0u, loop.get_flow_count()) << "All flows must return.";
+}
+
+} // namespace
\ No newline at end of file
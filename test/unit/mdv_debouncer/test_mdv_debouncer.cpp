@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "mdv_debouncer.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test mask (24-bit) for the timer counter
+#define TEST_TIMER_MASK 0x00ffffffu
+// Test value for the initial tick count, close to the wrap-around
+#define TEST_INITIAL_TICK_COUNT 0x00fffff0u
+// Test value for the sampling period
+#define TEST_SAMPLE_PERIOD 10u
+// Test value for the count of the stable samples
+#define TEST_STABLE_SAMPLES 4u
+// Count of the ports in the bank tests, not a multiple of the vector lanes
+#define TEST_PORT_COUNT 7u
+// Count of the samples in the comparisons with the reference model
+#define TEST_SAMPLE_COUNT 2000u
+
+using namespace testing;
+
+namespace{
+
+uint32_t test_input_value;
+uint32_t test_input_read_count;
+
+uint32_t test_input_get(void)
+{
+        ++test_input_read_count;
+
+        return test_input_value;
+}
+
+mdv_digital_input_t test_input = {NULL, NULL, test_input_get};
+
+/*
+ * Debounces each line with a counter of its own
+ */
+class reference_debouncer
+{
+        public:
+
+        reference_debouncer(uint32_t const stable_samples,
+                            uint32_t const state) :
+                m_stable_samples(stable_samples),
+                m_state(state),
+                m_counters(32u, 0) {}
+
+        uint32_t Sample(uint32_t const sample) {
+                uint32_t changed = 0;
+
+                for (uint32_t n = 0; n < 32u; ++n) {
+                        if (((sample ^ m_state) >> n) & 1u) {
+                                if (++m_counters[n] == m_stable_samples) {
+                                        changed |= 1u << n;
+                                        m_counters[n] = 0;
+                                }
+                        } else {
+                                m_counters[n] = 0;
+                        }
+                }
+                m_state ^= changed;
+
+                return changed;
+        }
+
+        uint32_t GetState() const {
+                return m_state;
+        }
+
+        private:
+
+        uint32_t m_stable_samples;
+        uint32_t m_state;
+        std::vector<uint32_t> m_counters;
+};
+
+/*
+ * Generates bouncing samples: each line follows a slowly changing level, with
+ * short glitches of different lengths on some lines
+ */
+class bouncing_input
+{
+        public:
+
+        explicit bouncing_input(uint32_t const seed) : m_random(seed) {}
+
+        uint32_t Next() {
+                m_level ^= m_random() & m_random() & m_random();
+
+                return m_level ^ (m_random() & m_random() & 0x0000ffffu);
+        }
+
+        private:
+
+        std::mt19937 m_random;
+        uint32_t m_level = 0;
+};
+
+class test_mdv_debouncer : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                SetTickCount(TEST_INITIAL_TICK_COUNT);
+                test_input_value = 0;
+                test_input_read_count = 0;
+                mdv_debouncer_init(&m_debouncer, &test_input,
+                                   &m_sw_timer_base, TEST_SAMPLE_PERIOD,
+                                   TEST_STABLE_SAMPLES);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void SetTickCount(uint32_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count & TEST_TIMER_MASK));
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_debouncer_t m_debouncer;
+};
+
+TEST_F(test_mdv_debouncer, init__state_read_from_input)
+{
+        test_input_value = 0x12345678u;
+        mdv_debouncer_init(&m_debouncer, &test_input, &m_sw_timer_base,
+                           TEST_SAMPLE_PERIOD, TEST_STABLE_SAMPLES);
+
+        EXPECT_EQ(0x12345678u, mdv_debouncer_get_state(&m_debouncer))
+                << "State not read from the input";
+}
+
+TEST_F(test_mdv_debouncer, init__invalid_stable_samples_asserted)
+{
+        EXPECT_DEATH(mdv_debouncer_init(&m_debouncer, &test_input,
+                                        &m_sw_timer_base, TEST_SAMPLE_PERIOD,
+                                        0), "")
+                << "Zero stable samples not asserted";
+        EXPECT_DEATH(mdv_debouncer_init(&m_debouncer, &test_input,
+                                        &m_sw_timer_base, TEST_SAMPLE_PERIOD,
+                                        MDV_DEBOUNCER_MAX_STABLE_SAMPLES + 1u),
+                     "") << "Too many stable samples not asserted";
+}
+
+TEST_F(test_mdv_debouncer, sample__short_glitch_filtered)
+{
+        for (uint32_t i = 0; i < TEST_STABLE_SAMPLES - 1u; ++i) {
+                EXPECT_EQ(0u, mdv_debouncer_sample(&m_debouncer, 0x80u))
+                        << "Line changed by a glitch";
+        }
+        EXPECT_EQ(0u, mdv_debouncer_sample(&m_debouncer, 0))
+                << "Line changed by a glitch";
+        for (uint32_t i = 0; i < TEST_STABLE_SAMPLES - 1u; ++i) {
+                EXPECT_EQ(0u, mdv_debouncer_sample(&m_debouncer, 0x80u))
+                        << "Count not restarted after the glitch";
+        }
+
+        EXPECT_EQ(0x80u, mdv_debouncer_sample(&m_debouncer, 0x80u))
+                << "Stable line not changed";
+        EXPECT_EQ(0x80u, mdv_debouncer_get_state(&m_debouncer))
+                << "Invalid state";
+}
+
+TEST_F(test_mdv_debouncer, sample__edges_collected_until_taken)
+{
+        uint32_t rising;
+        uint32_t falling;
+
+        for (uint32_t i = 0; i < TEST_STABLE_SAMPLES; ++i) {
+                mdv_debouncer_sample(&m_debouncer, 0x03u);
+        }
+        for (uint32_t i = 0; i < TEST_STABLE_SAMPLES; ++i) {
+                mdv_debouncer_sample(&m_debouncer, 0x06u);
+        }
+        mdv_debouncer_take_edges(&m_debouncer, &rising, &falling);
+
+        EXPECT_EQ(0x07u, rising) << "Invalid rising edges";
+        EXPECT_EQ(0x01u, falling) << "Invalid falling edges";
+
+        mdv_debouncer_take_edges(&m_debouncer, &rising, &falling);
+
+        EXPECT_EQ(0u, rising | falling) << "Edges not cleared";
+}
+
+TEST_F(test_mdv_debouncer, sample__matches_per_line_counters)
+{
+        for (uint32_t stable_samples = 1u;
+             stable_samples <= MDV_DEBOUNCER_MAX_STABLE_SAMPLES;
+             ++stable_samples) {
+                reference_debouncer reference(stable_samples, 0);
+                bouncing_input input(stable_samples);
+
+                mdv_debouncer_init(&m_debouncer, &test_input,
+                                   &m_sw_timer_base, TEST_SAMPLE_PERIOD,
+                                   stable_samples);
+                for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; ++i) {
+                        uint32_t const sample = input.Next();
+
+                        ASSERT_EQ(reference.Sample(sample),
+                                  mdv_debouncer_sample(&m_debouncer, sample))
+                                << "Invalid changes with " << stable_samples
+                                << " stable samples at sample " << i;
+                }
+                EXPECT_EQ(reference.GetState(),
+                          mdv_debouncer_get_state(&m_debouncer))
+                        << "Invalid state";
+        }
+}
+
+TEST_F(test_mdv_debouncer, process__input_sampled_at_period)
+{
+        test_input_value = 0x01u;
+        SetTickCount(TEST_INITIAL_TICK_COUNT + TEST_SAMPLE_PERIOD - 1u);
+        mdv_debouncer_process(&m_debouncer);
+
+        EXPECT_EQ(1u, test_input_read_count)
+                << "Input sampled before the period";
+
+        // The samples keep the period across the wrap-around of the counter
+        for (uint32_t i = 1u; i < TEST_STABLE_SAMPLES; ++i) {
+                SetTickCount(TEST_INITIAL_TICK_COUNT + i * TEST_SAMPLE_PERIOD +
+                             i % 2u);
+                EXPECT_EQ(0u, mdv_debouncer_process(&m_debouncer))
+                        << "Line changed too early";
+        }
+        SetTickCount(TEST_INITIAL_TICK_COUNT +
+                     TEST_STABLE_SAMPLES * TEST_SAMPLE_PERIOD);
+
+        EXPECT_EQ(0x01u, mdv_debouncer_process(&m_debouncer))
+                << "Line not changed";
+        EXPECT_EQ(1u + TEST_STABLE_SAMPLES, test_input_read_count)
+                << "Invalid count of the samples";
+}
+
+TEST_F(test_mdv_debouncer, process__missed_samples_skipped)
+{
+        SetTickCount(TEST_INITIAL_TICK_COUNT + 5u * TEST_SAMPLE_PERIOD + 3u);
+        mdv_debouncer_process(&m_debouncer);
+        mdv_debouncer_process(&m_debouncer);
+
+        EXPECT_EQ(2u, test_input_read_count)
+                << "Missed samples not skipped";
+
+        SetTickCount(TEST_INITIAL_TICK_COUNT + 6u * TEST_SAMPLE_PERIOD + 3u);
+        mdv_debouncer_process(&m_debouncer);
+
+        EXPECT_EQ(3u, test_input_read_count)
+                << "Period not restarted from the late sample";
+}
+
+TEST_F(test_mdv_debouncer, bank_sample__matches_per_line_counters)
+{
+        uint32_t buffer[MDV_DEBOUNCER_BANK_WORDS(TEST_PORT_COUNT)];
+        uint32_t states[TEST_PORT_COUNT];
+        uint32_t samples[TEST_PORT_COUNT];
+        std::vector<reference_debouncer> references;
+        std::vector<bouncing_input> inputs;
+        std::vector<uint32_t> rising(TEST_PORT_COUNT, 0);
+        std::vector<uint32_t> falling(TEST_PORT_COUNT, 0);
+        mdv_debouncer_bank_t bank;
+
+        for (uint32_t port = 0; port < TEST_PORT_COUNT; ++port) {
+                states[port] = port * 0x01010101u;
+                references.emplace_back(TEST_STABLE_SAMPLES, states[port]);
+                inputs.emplace_back(port);
+        }
+        mdv_debouncer_bank_init(&bank, buffer, TEST_PORT_COUNT,
+                                TEST_STABLE_SAMPLES, states);
+
+        for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; ++i) {
+                for (uint32_t port = 0; port < TEST_PORT_COUNT; ++port) {
+                        uint32_t changed;
+
+                        samples[port] = inputs[port].Next() ^ states[port];
+                        changed = references[port].Sample(samples[port]);
+                        rising[port] |= changed & references[port].GetState();
+                        falling[port] |= changed &
+                                         ~references[port].GetState();
+                }
+                mdv_debouncer_bank_sample(&bank, samples);
+        }
+
+        for (uint32_t port = 0; port < TEST_PORT_COUNT; ++port) {
+                uint32_t bank_rising;
+                uint32_t bank_falling;
+
+                mdv_debouncer_bank_take_edges(&bank, port, &bank_rising,
+                                              &bank_falling);
+                EXPECT_EQ(references[port].GetState(),
+                          mdv_debouncer_bank_get_state(&bank, port))
+                        << "Invalid state of port " << port;
+                EXPECT_EQ(rising[port], bank_rising)
+                        << "Invalid rising edges of port " << port;
+                EXPECT_EQ(falling[port], bank_falling)
+                        << "Invalid falling edges of port " << port;
+        }
+}
+
+TEST_F(test_mdv_debouncer, bank_get_state__invalid_port_asserted)
+{
+        uint32_t buffer[MDV_DEBOUNCER_BANK_WORDS(TEST_PORT_COUNT)];
+        mdv_debouncer_bank_t bank;
+
+        mdv_debouncer_bank_init(&bank, buffer, TEST_PORT_COUNT,
+                                TEST_STABLE_SAMPLES, NULL);
+
+        EXPECT_EQ(0u, mdv_debouncer_bank_get_state(&bank, 0))
+                << "State not initialized to zero";
+        EXPECT_DEATH(mdv_debouncer_bank_get_state(&bank, TEST_PORT_COUNT), "")
+                << "Invalid port not asserted";
+}
+
+} // namespace
\ No newline at end of file
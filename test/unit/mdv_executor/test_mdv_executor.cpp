@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "mdv_executor.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test value for the initial extended tick count, wider than 32 bits
+#define TEST_INITIAL_TICK_COUNT64 0x00000001fffffff0ull
+// Test value for the release delay in ticks
+#define TEST_RELEASE_DELAY 10u
+// Test value for the relative deadline in ticks
+#define TEST_RELATIVE_DEADLINE 5u
+// Test value for the period in ticks
+#define TEST_PERIOD 10u
+// Count of tasks in the test with many tasks
+#define TEST_TASK_COUNT 500u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Action of the test task function
+ */
+enum test_action {
+        TEST_ACTION_NONE,
+        TEST_ACTION_CANCEL,
+        TEST_ACTION_SUBMIT
+};
+
+struct test_context;
+
+/*
+ * Test task
+ */
+struct test_task {
+        mdv_executor_task_t task;
+        test_context *context;
+        uint32_t id;
+        uint32_t execution_ticks;
+        test_action action;
+};
+
+/*
+ * Shared state of the test tasks
+ */
+struct test_context {
+        uint64_t tick_count;
+        std::vector<uint32_t> run_ids;
+        std::vector<uint64_t> idle_ticks;
+};
+
+void test_task_function(mdv_executor_t *const executor,
+                        mdv_executor_task_t *const task,
+                        void *const user_data)
+{
+        test_task *test = static_cast<test_task *>(user_data);
+
+        test->context->run_ids.push_back(test->id);
+        test->context->tick_count += test->execution_ticks;
+
+        if (test->action == TEST_ACTION_CANCEL) {
+                mdv_executor_cancel(executor, task);
+        } else if (test->action == TEST_ACTION_SUBMIT) {
+                mdv_executor_submit(executor, task, TEST_RELEASE_DELAY,
+                                    TEST_RELATIVE_DEADLINE, 0);
+        }
+}
+
+void test_idle_hook(void *const user_data, uint64_t const idle_ticks)
+{
+        test_context *context = static_cast<test_context *>(user_data);
+
+        context->idle_ticks.push_back(idle_ticks);
+}
+
+class test_mdv_executor : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                m_context.tick_count = TEST_INITIAL_TICK_COUNT64;
+                m_context.run_ids.clear();
+                m_context.idle_ticks.clear();
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                        .WillByDefault(ReturnPointee(&m_context.tick_count));
+                mdv_executor_init(&m_executor, &m_sw_timer_base);
+                mdv_executor_set_idle_hook(&m_executor, test_idle_hook,
+                                           &m_context);
+                m_tasks.resize(TEST_TASK_COUNT);
+
+                for (uint32_t i = 0; i < TEST_TASK_COUNT; i++) {
+                        m_tasks[i].context = &m_context;
+                        m_tasks[i].id = i;
+                        m_tasks[i].execution_ticks = 0;
+                        m_tasks[i].action = TEST_ACTION_NONE;
+                        mdv_executor_task_init(&m_tasks[i].task,
+                                               test_task_function,
+                                               &m_tasks[i]);
+                }
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        // Run until no task is ready
+        uint32_t RunAll() {
+                uint32_t run_count = 0;
+
+                while (mdv_executor_run_once(&m_executor)) {
+                        ++run_count;
+                }
+
+                return run_count;
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_executor_t m_executor;
+        std::vector<test_task> m_tasks;
+        test_context m_context;
+};
+
+TEST_F(test_mdv_executor,
+       invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_executor_init(0, &m_sw_timer_base), "")
+                << "If null, executor must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_init(&m_executor, 0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_task_init(0, test_task_function, 0), "")
+                << "If null, task must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_task_init(&m_tasks[0].task, 0, 0), "")
+                << "If null, function must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_submit(0, &m_tasks[0].task, 0, 0, 0), "")
+                << "If null, executor must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_submit(&m_executor, 0, 0, 0, 0), "")
+                << "If null, task must cause an assertion failure.";
+        EXPECT_DEATH(mdv_executor_run_once(0), "")
+                << "If null, executor must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_executor, run_once__idle_without_tasks)
+{
+        EXPECT_FALSE(mdv_executor_run_once(&m_executor))
+                << "No task must be run.";
+        ASSERT_EQ(1u, m_context.idle_ticks.size())
+                << "The idle hook must be called.";
+        EXPECT_EQ(MDV_EXECUTOR_NO_RELEASE, m_context.idle_ticks[0])
+                << "No release must be pending.";
+}
+
+TEST_F(test_mdv_executor, run_once__task_run_at_release_time)
+{
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, TEST_RELEASE_DELAY,
+                            TEST_RELATIVE_DEADLINE, 0);
+
+        EXPECT_EQ(MDV_EXECUTOR_TASK_PENDING,
+                  mdv_executor_task_get_state(&m_tasks[0].task))
+                << "The task must be pending.";
+        EXPECT_FALSE(mdv_executor_run_once(&m_executor))
+                << "The task must not run before the release time.";
+        ASSERT_EQ(1u, m_context.idle_ticks.size())
+                << "The idle hook must be called.";
+        EXPECT_EQ(TEST_RELEASE_DELAY, m_context.idle_ticks[0])
+                << "The idle hook must get the ticks until the release.";
+
+        m_context.tick_count += TEST_RELEASE_DELAY;
+
+        EXPECT_TRUE(mdv_executor_run_once(&m_executor))
+                << "The task must run at the release time.";
+        EXPECT_EQ(MDV_EXECUTOR_TASK_IDLE,
+                  mdv_executor_task_get_state(&m_tasks[0].task))
+                << "A one-shot task must be idle after the run.";
+        EXPECT_EQ(0u, RunAll())
+                << "A one-shot task must run once.";
+}
+
+TEST_F(test_mdv_executor, run_once__earliest_deadline_first)
+{
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0, 30u, 0);
+        mdv_executor_submit(&m_executor, &m_tasks[1].task, 0, 10u, 0);
+        mdv_executor_submit(&m_executor, &m_tasks[2].task, 0, 20u, 0);
+
+        EXPECT_EQ(3u, RunAll()) << "All tasks must run.";
+        EXPECT_EQ(std::vector<uint32_t>({ 1u, 2u, 0u }), m_context.run_ids)
+                << "The tasks must run in the order of their deadlines.";
+}
+
+TEST_F(test_mdv_executor, run_once__equal_deadlines_in_release_order)
+{
+        for (uint32_t i = 0; i < 5u; i++) {
+                mdv_executor_submit(&m_executor, &m_tasks[i].task, 0,
+                                    TEST_RELATIVE_DEADLINE, 0);
+        }
+
+        EXPECT_EQ(5u, RunAll()) << "All tasks must run.";
+        EXPECT_EQ(std::vector<uint32_t>({ 0, 1u, 2u, 3u, 4u }),
+                  m_context.run_ids)
+                << "Tasks with equal deadlines must run in the release order.";
+}
+
+TEST_F(test_mdv_executor, run_once__statistics_recorded)
+{
+        mdv_executor_task_stats_t const *stats =
+                mdv_executor_task_get_stats(&m_tasks[0].task);
+
+        m_tasks[0].execution_ticks = TEST_RELATIVE_DEADLINE;
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0,
+                            TEST_RELATIVE_DEADLINE, 0);
+        RunAll();
+
+        m_tasks[0].execution_ticks = TEST_RELATIVE_DEADLINE + 2u;
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0,
+                            TEST_RELATIVE_DEADLINE, 0);
+        RunAll();
+
+        EXPECT_EQ(2u, stats->run_count)
+                << "The runs must be counted.";
+        EXPECT_EQ(1u, stats->deadline_miss_count)
+                << "A run completed after the deadline must be a miss.";
+        EXPECT_EQ(TEST_RELATIVE_DEADLINE + 2u, stats->last_execution_ticks)
+                << "The latest execution time must be recorded.";
+        EXPECT_EQ(TEST_RELATIVE_DEADLINE + 2u, stats->max_execution_ticks)
+                << "The longest execution time must be recorded.";
+        EXPECT_EQ(2u * TEST_RELATIVE_DEADLINE + 2u,
+                  stats->total_execution_ticks)
+                << "The total execution time must be recorded.";
+}
+
+TEST_F(test_mdv_executor, run_once__periodic_task_released_without_drift)
+{
+        m_tasks[0].execution_ticks = 3u;
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, TEST_RELEASE_DELAY,
+                            TEST_RELATIVE_DEADLINE, TEST_PERIOD);
+
+        for (uint32_t i = 1u; i <= 10u; i++) {
+                // Run late by a varying latency
+                m_context.tick_count = TEST_INITIAL_TICK_COUNT64 +
+                                       TEST_RELEASE_DELAY +
+                                       (i - 1u) * TEST_PERIOD + i % 3u;
+
+                ASSERT_TRUE(mdv_executor_run_once(&m_executor))
+                        << "The task must run once per period.";
+                ASSERT_EQ(TEST_INITIAL_TICK_COUNT64 + TEST_RELEASE_DELAY +
+                          i * TEST_PERIOD, m_tasks[0].task.release)
+                        << "The releases must not drift.";
+                ASSERT_FALSE(mdv_executor_run_once(&m_executor))
+                        << "The task must not run again before the release.";
+        }
+
+        EXPECT_EQ(0u, mdv_executor_task_get_stats(
+                          &m_tasks[0].task)->deadline_miss_count)
+                << "The task must meet its deadlines.";
+}
+
+TEST_F(test_mdv_executor, cancel__pending_and_ready_tasks_removed)
+{
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0,
+                            TEST_RELATIVE_DEADLINE, 0);
+        mdv_executor_submit(&m_executor, &m_tasks[1].task, TEST_RELEASE_DELAY,
+                            TEST_RELATIVE_DEADLINE, 0);
+        mdv_executor_submit(&m_executor, &m_tasks[2].task, 0,
+                            TEST_RELATIVE_DEADLINE + 1u, 0);
+
+        // Release the tasks due
+        mdv_executor_run_once(&m_executor);
+        mdv_executor_cancel(&m_executor, &m_tasks[1].task);
+        mdv_executor_cancel(&m_executor, &m_tasks[2].task);
+        mdv_executor_cancel(&m_executor, &m_tasks[3].task);
+
+        EXPECT_EQ(MDV_EXECUTOR_TASK_IDLE,
+                  mdv_executor_task_get_state(&m_tasks[2].task))
+                << "A cancelled task must be idle.";
+
+        m_context.tick_count += TEST_RELEASE_DELAY;
+
+        EXPECT_EQ(0u, RunAll()) << "Cancelled tasks must not run.";
+        EXPECT_EQ(std::vector<uint32_t>({ 0 }), m_context.run_ids)
+                << "Only the task run before the cancels must have run.";
+}
+
+TEST_F(test_mdv_executor, cancel__periodic_task_cancelled_by_itself)
+{
+        m_tasks[0].action = TEST_ACTION_CANCEL;
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0,
+                            TEST_RELATIVE_DEADLINE, TEST_PERIOD);
+
+        EXPECT_EQ(1u, RunAll()) << "The task must run once.";
+        m_context.tick_count += TEST_PERIOD;
+        EXPECT_EQ(0u, RunAll())
+                << "The cancelled periodic task must not be released again.";
+}
+
+TEST_F(test_mdv_executor, submit__task_submitted_again_by_itself)
+{
+        m_tasks[0].action = TEST_ACTION_SUBMIT;
+        m_tasks[0].execution_ticks = 2u * TEST_RELATIVE_DEADLINE;
+        mdv_executor_submit(&m_executor, &m_tasks[0].task, 0,
+                            TEST_RELATIVE_DEADLINE, TEST_PERIOD);
+
+        EXPECT_EQ(1u, RunAll()) << "The task must run once.";
+        EXPECT_EQ(1u, mdv_executor_task_get_stats(
+                          &m_tasks[0].task)->deadline_miss_count)
+                << "The miss must be checked against the deadline of the run.";
+        EXPECT_EQ(MDV_EXECUTOR_TASK_PENDING,
+                  mdv_executor_task_get_state(&m_tasks[0].task))
+                << "The task must be pending with the new parameters.";
+
+        m_context.tick_count += TEST_RELEASE_DELAY;
+        m_tasks[0].action = TEST_ACTION_NONE;
+
+        EXPECT_EQ(1u, RunAll()) << "The submitted task must run.";
+        EXPECT_EQ(MDV_EXECUTOR_TASK_IDLE,
+                  mdv_executor_task_get_state(&m_tasks[0].task))
+                << "The task must be one-shot after submitted as one-shot.";
+}
+
+TEST_F(test_mdv_executor, run_once__many_tasks_in_deadline_order)
+{
+        std::mt19937 random(1u);
+        std::vector<uint64_t> deadlines;
+        uint32_t expected_count = 0;
+
+        for (uint32_t i = 0; i < TEST_TASK_COUNT; i++) {
+                mdv_executor_submit(&m_executor, &m_tasks[i].task,
+                                    random() % 100u, random() % 1000u, 0);
+        }
+
+        // Release some of the tasks, and cancel every third task, pending or
+        // ready
+        m_context.tick_count += 50u;
+        mdv_executor_run_once(&m_executor);
+        m_context.run_ids.clear();
+
+        for (uint32_t i = 0; i < TEST_TASK_COUNT; i += 3u) {
+                mdv_executor_cancel(&m_executor, &m_tasks[i].task);
+        }
+
+        for (uint32_t i = 0; i < TEST_TASK_COUNT; i++) {
+                if (mdv_executor_task_get_state(&m_tasks[i].task) !=
+                    MDV_EXECUTOR_TASK_IDLE) {
+                        ++expected_count;
+                }
+        }
+
+        m_context.tick_count += 50u;
+        RunAll();
+
+        ASSERT_EQ(expected_count, m_context.run_ids.size())
+                << "All tasks not cancelled must run.";
+
+        for (uint32_t id : m_context.run_ids) {
+                deadlines.push_back(m_tasks[id].task.deadline);
+        }
+
+        EXPECT_TRUE(std::is_sorted(deadlines.begin(), deadlines.end()))
+                << "The tasks must run in the order of their deadlines.";
+}
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "mdv_histogram.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test mask (24-bit) for the timer counter
+#define TEST_TIMER_MASK 0x00ffffffu
+// Test value for the start tick count, close to the wrap-around of the counter
+#define TEST_START_TICK_COUNT 0x00fffff0u
+// Test value for the measured ticks, crosses the wrap-around of the counter
+#define TEST_ELAPSED_TICK_COUNT 0x0123u
+// Count of the recording threads in the concurrency test
+#define TEST_THREAD_COUNT 4u
+// Count of the values recorded by each thread in the concurrency test
+#define TEST_VALUES_PER_THREAD 100000u
+
+using namespace testing;
+
+namespace{
+
+class test_mdv_histogram : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                mdv_histogram_init(&m_histogram);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void RecordRange(mdv_histogram_t *const histogram,
+                         uint32_t const first,
+                         uint32_t const last) {
+                for (uint32_t value = first; value <= last; ++value) {
+                        mdv_histogram_record(histogram, value);
+                }
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_histogram_t m_histogram;
+};
+
+TEST_F(test_mdv_histogram, init__histogram_empty)
+{
+        EXPECT_EQ(0u, mdv_histogram_get_count(&m_histogram))
+                << "Empty histogram has values";
+        EXPECT_EQ(UINT32_MAX, m_histogram.min) << "Invalid minimum";
+        EXPECT_EQ(0u, m_histogram.max) << "Invalid maximum";
+        EXPECT_EQ(0u, mdv_histogram_get_value_at_quantile(
+                          &m_histogram, MDV_HISTOGRAM_PPM))
+                << "Empty histogram has a maximum";
+}
+
+TEST_F(test_mdv_histogram, get_bucket__buckets_contiguous)
+{
+        EXPECT_EQ(0u, mdv_histogram_get_bucket_lowest(0))
+                << "First bucket doesn't start from zero";
+        EXPECT_EQ(UINT32_MAX, mdv_histogram_get_bucket_highest(
+                                      MDV_HISTOGRAM_BUCKETS - 1u))
+                << "Last bucket doesn't end to the largest value";
+        for (uint32_t i = 0; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                uint32_t const lowest = mdv_histogram_get_bucket_lowest(i);
+                uint32_t const highest = mdv_histogram_get_bucket_highest(i);
+
+                EXPECT_LE(lowest, highest) << "Empty bucket " << i;
+                EXPECT_EQ(i, mdv_histogram_get_bucket(lowest))
+                        << "Lowest value in a wrong bucket " << i;
+                EXPECT_EQ(i, mdv_histogram_get_bucket(highest))
+                        << "Highest value in a wrong bucket " << i;
+                if (i + 1u < MDV_HISTOGRAM_BUCKETS) {
+                        EXPECT_EQ(highest + 1u,
+                                  mdv_histogram_get_bucket_lowest(i + 1u))
+                                << "Gap after bucket " << i;
+                }
+        }
+}
+
+TEST_F(test_mdv_histogram, get_bucket__relative_error_bounded)
+{
+        for (uint32_t i = SUB_BUCKETS; i < MDV_HISTOGRAM_BUCKETS; ++i) {
+                uint64_t const lowest = mdv_histogram_get_bucket_lowest(i);
+                uint64_t const width =
+                        (uint64_t)mdv_histogram_get_bucket_highest(i) -
+                        lowest + 1u;
+
+                EXPECT_LE(width << MDV_HISTOGRAM_SUB_BUCKET_BITS, lowest)
+                        << "Too wide bucket " << i;
+        }
+}
+
+TEST_F(test_mdv_histogram, record__values_counted)
+{
+        mdv_histogram_record(&m_histogram, 5u);
+        mdv_histogram_record(&m_histogram, 5u);
+        mdv_histogram_record(&m_histogram, 1000u);
+        mdv_histogram_record(&m_histogram, UINT32_MAX);
+
+        EXPECT_EQ(4u, mdv_histogram_get_count(&m_histogram))
+                << "Invalid count";
+        EXPECT_EQ(2u, m_histogram.counts[mdv_histogram_get_bucket(5u)])
+                << "Invalid bucket count";
+        EXPECT_EQ(1u, m_histogram.counts[MDV_HISTOGRAM_BUCKETS - 1u])
+                << "Largest value not in the last bucket";
+        EXPECT_EQ(5u, m_histogram.min) << "Invalid minimum";
+        EXPECT_EQ(UINT32_MAX, m_histogram.max) << "Invalid maximum";
+}
+
+TEST_F(test_mdv_histogram, record_elapsed__ticks_recorded_across_wrap_around)
+{
+        ON_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillByDefault(Return((TEST_START_TICK_COUNT +
+                                       TEST_ELAPSED_TICK_COUNT) &
+                                      TEST_TIMER_MASK));
+
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT,
+                  mdv_histogram_record_elapsed(&m_histogram, &m_sw_timer_base,
+                                               TEST_START_TICK_COUNT))
+                << "Invalid elapsed ticks";
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, m_histogram.max)
+                << "Elapsed ticks not recorded";
+}
+
+TEST_F(test_mdv_histogram, get_value_at_quantile__quantiles_within_error)
+{
+        RecordRange(&m_histogram, 1u, 1000u);
+
+        EXPECT_EQ(1u, mdv_histogram_get_value_at_quantile(&m_histogram, 0))
+                << "Invalid minimum";
+        EXPECT_EQ(1000u, mdv_histogram_get_value_at_quantile(
+                                 &m_histogram, MDV_HISTOGRAM_PPM))
+                << "Invalid maximum";
+        for (uint32_t percent = 1u; percent < 100u; ++percent) {
+                uint32_t const exact = percent * 10u;
+                uint32_t const value = mdv_histogram_get_value_at_quantile(
+                        &m_histogram, percent * 10000u);
+
+                EXPECT_GE(value, exact) << "Too small percentile " << percent;
+                EXPECT_LE(value - exact,
+                          exact >> MDV_HISTOGRAM_SUB_BUCKET_BITS)
+                        << "Too large percentile " << percent;
+        }
+}
+
+TEST_F(test_mdv_histogram, get_value_at_quantile__invalid_quantile_asserted)
+{
+        EXPECT_DEATH(mdv_histogram_get_value_at_quantile(
+                             &m_histogram, MDV_HISTOGRAM_PPM + 1u), "")
+                << "Invalid quantile not asserted";
+}
+
+TEST_F(test_mdv_histogram, snapshot__histogram_copied)
+{
+        mdv_histogram_t snapshot;
+
+        RecordRange(&m_histogram, 10u, 20u);
+        mdv_histogram_snapshot(&m_histogram, &snapshot);
+        mdv_histogram_record(&m_histogram, 30u);
+
+        EXPECT_EQ(11u, mdv_histogram_get_count(&snapshot))
+                << "Invalid count in the snapshot";
+        EXPECT_EQ(10u, snapshot.min) << "Invalid minimum in the snapshot";
+        EXPECT_EQ(20u, snapshot.max) << "Invalid maximum in the snapshot";
+        EXPECT_EQ(12u, mdv_histogram_get_count(&m_histogram))
+                << "Source histogram changed";
+}
+
+TEST_F(test_mdv_histogram, merge__histograms_added)
+{
+        mdv_histogram_t other;
+
+        mdv_histogram_init(&other);
+        RecordRange(&m_histogram, 1u, 500u);
+        RecordRange(&other, 501u, 1000u);
+        mdv_histogram_merge(&m_histogram, &other);
+
+        EXPECT_EQ(1000u, mdv_histogram_get_count(&m_histogram))
+                << "Invalid merged count";
+        EXPECT_EQ(500u, mdv_histogram_get_count(&other))
+                << "Source histogram changed";
+        EXPECT_EQ(1u, m_histogram.min) << "Invalid merged minimum";
+        EXPECT_EQ(1000u, m_histogram.max) << "Invalid merged maximum";
+        EXPECT_EQ(mdv_histogram_get_bucket_highest(
+                          mdv_histogram_get_bucket(500u)),
+                  mdv_histogram_get_value_at_quantile(&m_histogram, 500000u))
+                << "Invalid merged median";
+}
+
+TEST_F(test_mdv_histogram, drain__counts_moved)
+{
+        mdv_histogram_t total;
+
+        mdv_histogram_init(&total);
+        RecordRange(&m_histogram, 1u, 100u);
+        mdv_histogram_drain(&total, &m_histogram);
+
+        EXPECT_EQ(100u, mdv_histogram_get_count(&total))
+                << "Counts not moved";
+        EXPECT_EQ(0u, mdv_histogram_get_count(&m_histogram))
+                << "Source histogram not emptied";
+        EXPECT_EQ(100u, total.max) << "Maximum not moved";
+}
+
+TEST_F(test_mdv_histogram, drain__concurrent_values_not_lost)
+{
+        mdv_histogram_t total;
+        std::vector<std::thread> threads;
+
+        mdv_histogram_init(&total);
+        for (uint32_t i = 0; i < TEST_THREAD_COUNT; ++i) {
+                threads.emplace_back([this, i]() {
+                        for (uint32_t j = 0; j < TEST_VALUES_PER_THREAD;
+                             ++j) {
+                                mdv_histogram_record(&m_histogram, i * j);
+                        }
+                });
+        }
+        for (uint32_t i = 0; i < 1000u; ++i) {
+                mdv_histogram_drain(&total, &m_histogram);
+        }
+        for (std::thread &thread : threads) {
+                thread.join();
+        }
+        mdv_histogram_drain(&total, &m_histogram);
+
+        EXPECT_EQ(TEST_THREAD_COUNT * TEST_VALUES_PER_THREAD,
+                  mdv_histogram_get_count(&total)) << "Values lost";
+        EXPECT_EQ(0u, total.min) << "Invalid minimum";
+        EXPECT_EQ((TEST_THREAD_COUNT - 1u) * (TEST_VALUES_PER_THREAD - 1u),
+                  total.max) << "Invalid maximum";
+}
+
+} // namespace
\ No newline at end of file
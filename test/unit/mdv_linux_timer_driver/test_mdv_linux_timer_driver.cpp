@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "mdv_linux_timer_driver.c"
+
+// Test value for timer tick duration (1 ms)
+#define TEST_TICK_DURATION_US 1000u
+// Test value for the sleep between the counter samples in milliseconds
+#define TEST_SLEEP_MS 50u
+// Lower limit for the ticks counted during the sleep
+#define TEST_MIN_TICKS (TEST_SLEEP_MS - 1u)
+// Upper limit for the ticks counted during the sleep (scheduling delays)
+#define TEST_MAX_TICKS (TEST_SLEEP_MS * 10u)
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Record of the delivered timer events
+ */
+struct test_events {
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> counter;
+        std::atomic<bool> is_monotonic;
+};
+
+void test_event_handler(void *const user_data, uint32_t const counter)
+{
+        test_events *events = static_cast<test_events *>(user_data);
+
+        if (counter < events->counter.load()) {
+                events->is_monotonic = false;
+        }
+
+        events->counter = counter;
+        ++events->count;
+}
+
+void Sleep(uint32_t const milliseconds)
+{
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+class test_mdv_linux_timer_driver : public Test
+{
+        protected:
+
+        void SetUp() override {
+                m_config.clock_source = MDV_LINUX_TIMER_CLOCK_MONOTONIC_RAW;
+                m_config.tick_duration_us = TEST_TICK_DURATION_US;
+                m_config.timer_width_bits = 32u;
+                m_config.event_period_ticks = 0;
+                m_events.count = 0;
+                m_events.counter = 0;
+                m_events.is_monotonic = true;
+        }
+
+        void TearDown() override {
+                mdv_linux_timer_driver.uninit();
+        }
+
+        void Init() {
+                ASSERT_EQ(MDV_RESULT_OK,
+                          mdv_linux_timer_driver_configure(&m_config));
+                ASSERT_EQ(MDV_RESULT_OK,
+                          mdv_linux_timer_driver.init(test_event_handler,
+                                                      &m_events));
+        }
+
+        void ExpectCounting(char const *const clock_source) {
+                uint32_t const start = mdv_linux_timer_driver.get_count();
+
+                Sleep(TEST_SLEEP_MS);
+
+                uint32_t const ticks = mdv_linux_timer_driver.get_count() -
+                                       start;
+
+                EXPECT_GE(ticks, TEST_MIN_TICKS)
+                        << "The counter must advance with " << clock_source;
+                EXPECT_LE(ticks, TEST_MAX_TICKS)
+                        << "The counter must advance with " << clock_source;
+        }
+
+        mdv_linux_timer_driver_config_t m_config;
+        test_events m_events;
+};
+
+TEST_F(test_mdv_linux_timer_driver,
+       configure__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_linux_timer_driver_configure(0), "")
+                << "If null, config must cause an assertion failure.";
+
+        m_config.tick_duration_us = 0;
+        EXPECT_DEATH(mdv_linux_timer_driver_configure(&m_config), "")
+                << "If zero, tick_duration_us must cause an assertion failure.";
+
+        m_config.tick_duration_us = TEST_TICK_DURATION_US;
+        m_config.timer_width_bits = 0;
+        EXPECT_DEATH(mdv_linux_timer_driver_configure(&m_config), "")
+                << "If zero, timer_width_bits must cause an assertion failure.";
+
+        m_config.timer_width_bits = 33u;
+        EXPECT_DEATH(mdv_linux_timer_driver_configure(&m_config), "")
+                << "If over 32, timer_width_bits must cause an assertion " \
+                   "failure.";
+}
+
+TEST_F(test_mdv_linux_timer_driver, configure__fails_when_initialized)
+{
+        Init();
+
+        EXPECT_EQ(MDV_LINUX_TIMER_DRIVER_ERROR_STATE,
+                  mdv_linux_timer_driver_configure(&m_config))
+                << "The driver can't be configured when initialized.";
+        EXPECT_EQ(MDV_LINUX_TIMER_DRIVER_ERROR_STATE,
+                  mdv_linux_timer_driver.init(0, 0))
+                << "The driver can't be initialized twice.";
+}
+
+TEST_F(test_mdv_linux_timer_driver, uninit__fails_when_not_initialized)
+{
+        EXPECT_EQ(MDV_LINUX_TIMER_DRIVER_ERROR_STATE,
+                  mdv_linux_timer_driver.uninit())
+                << "The driver can't be uninitialized when not initialized.";
+        EXPECT_EQ(MDV_LINUX_TIMER_DRIVER_ERROR_STATE,
+                  mdv_linux_timer_driver.start())
+                << "The driver can't be started when not initialized.";
+}
+
+TEST_F(test_mdv_linux_timer_driver, get_count__counts_with_clock_sources)
+{
+        Init();
+        EXPECT_TRUE(mdv_linux_timer_driver.is_running())
+                << "The timer must run after the initialization.";
+        ExpectCounting("CLOCK_MONOTONIC_RAW");
+        mdv_linux_timer_driver.uninit();
+
+        m_config.clock_source = MDV_LINUX_TIMER_CLOCK_MONOTONIC;
+        Init();
+        ExpectCounting("CLOCK_MONOTONIC");
+        mdv_linux_timer_driver.uninit();
+
+        m_config.clock_source = MDV_LINUX_TIMER_CLOCK_TSC;
+
+        if (!mdv_linux_timer_driver_is_clock_source_available(
+                    MDV_LINUX_TIMER_CLOCK_TSC)) {
+                EXPECT_EQ(MDV_LINUX_TIMER_DRIVER_ERROR_CLOCK_SOURCE,
+                          mdv_linux_timer_driver_configure(&m_config))
+                        << "An unavailable clock source must be rejected.";
+                return;
+        }
+
+        Init();
+        ExpectCounting("TSC");
+}
+
+TEST_F(test_mdv_linux_timer_driver, get_count__limited_by_timer_width)
+{
+        m_config.tick_duration_us = 1u;
+        m_config.timer_width_bits = 4u;
+
+        Init();
+
+        for (uint32_t i = 0; i < 1000u; i++) {
+                ASSERT_LE(mdv_linux_timer_driver.get_count(), 0x0fu)
+                        << "The counter must be limited by the timer width.";
+        }
+}
+
+TEST_F(test_mdv_linux_timer_driver, stop__counter_frozen_until_started)
+{
+        uint32_t count;
+
+        Init();
+        Sleep(2u);
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_linux_timer_driver.stop());
+        EXPECT_FALSE(mdv_linux_timer_driver.is_running())
+                << "The timer must not run after stopped.";
+
+        count = mdv_linux_timer_driver.get_count();
+        Sleep(TEST_SLEEP_MS);
+
+        EXPECT_EQ(count, mdv_linux_timer_driver.get_count())
+                << "The counter must not advance while stopped.";
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_linux_timer_driver.start());
+        ExpectCounting("CLOCK_MONOTONIC_RAW");
+        EXPECT_GE(mdv_linux_timer_driver.get_count(), count)
+                << "The counter must continue from the stopped value.";
+}
+
+TEST_F(test_mdv_linux_timer_driver, reset__counter_restarted_from_zero)
+{
+        Init();
+        Sleep(TEST_SLEEP_MS);
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_linux_timer_driver.reset());
+        EXPECT_LT(mdv_linux_timer_driver.get_count(), TEST_MIN_TICKS)
+                << "The counter must restart from zero.";
+}
+
+TEST_F(test_mdv_linux_timer_driver, init__events_delivered_periodically)
+{
+        m_config.event_period_ticks = 1u;
+
+        Init();
+        Sleep(TEST_SLEEP_MS);
+
+        EXPECT_GE(m_events.count.load(), TEST_SLEEP_MS / 5u)
+                << "Events must be delivered once per the event period.";
+        EXPECT_TRUE(m_events.is_monotonic.load())
+                << "The events must carry the current counter value.";
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_linux_timer_driver.uninit());
+
+        uint32_t const count = m_events.count.load();
+
+        Sleep(5u);
+
+        EXPECT_EQ(count, m_events.count.load())
+                << "No events may be delivered after the uninitialization.";
+}
+
+} // namespace
@@ -0,0 +1,327 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "mdv_periodic_timer.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test value for the initial extended tick count, wider than 32 bits
+#define TEST_INITIAL_TICK_COUNT64 0x00000001fffffff0ull
+// Test value for the period in ticks
+#define TEST_PERIOD_TICKS 10u
+// Test values for a 1 kHz period on a 32.768 kHz counter
+#define TEST_FRACTION_NUMERATOR 32768u
+#define TEST_FRACTION_DENOMINATOR 1000u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Action of the test callback
+ */
+enum test_action {
+        TEST_ACTION_NONE,
+        TEST_ACTION_STOP,
+        TEST_ACTION_RESTART
+};
+
+/*
+ * Record of the callback calls
+ */
+struct test_calls {
+        std::vector<uint32_t> missed_counts;
+        test_action action;
+};
+
+void test_callback(mdv_periodic_timer_t *const timer,
+                   uint32_t const missed_count,
+                   void *const user_data)
+{
+        test_calls *calls = static_cast<test_calls *>(user_data);
+
+        calls->missed_counts.push_back(missed_count);
+
+        if (calls->action == TEST_ACTION_STOP) {
+                mdv_periodic_timer_stop(timer);
+        } else if (calls->action == TEST_ACTION_RESTART) {
+                mdv_periodic_timer_start(timer);
+        }
+}
+
+class test_mdv_periodic_timer : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                m_calls.missed_counts.clear();
+                m_calls.action = TEST_ACTION_NONE;
+                SetTickCount64(TEST_INITIAL_TICK_COUNT64);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void SetTickCount64(uint64_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count));
+        }
+
+        void Init(mdv_periodic_timer_policy_t const policy) {
+                mdv_periodic_timer_init(&m_timer, &m_sw_timer_base,
+                                        TEST_PERIOD_TICKS, policy,
+                                        test_callback, &m_calls);
+                mdv_periodic_timer_start(&m_timer);
+        }
+
+        // Poll the timer once per tick over the given ticks
+        uint64_t Poll(uint64_t const tick_count) {
+                uint64_t call_count = 0;
+
+                for (uint64_t i = 1u; i <= tick_count; i++) {
+                        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + i);
+                        call_count += mdv_periodic_timer_process(&m_timer);
+                }
+
+                return call_count;
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_periodic_timer_t m_timer;
+        test_calls m_calls;
+};
+
+TEST_F(test_mdv_periodic_timer,
+       init__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_periodic_timer_init(0, &m_sw_timer_base,
+                                             TEST_PERIOD_TICKS,
+                                             MDV_PERIODIC_TIMER_SKIP,
+                                             test_callback, 0), "")
+                << "If null, timer must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init(&m_timer, 0, TEST_PERIOD_TICKS,
+                                             MDV_PERIODIC_TIMER_SKIP,
+                                             test_callback, 0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init(&m_timer, &m_sw_timer_base, 0,
+                                             MDV_PERIODIC_TIMER_SKIP,
+                                             test_callback, 0), "")
+                << "If zero, period_ticks must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init(
+                        &m_timer, &m_sw_timer_base, TEST_PERIOD_TICKS,
+                        (mdv_periodic_timer_policy_t)3, test_callback, 0), "")
+                << "If unknown, policy must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init(&m_timer, &m_sw_timer_base,
+                                             TEST_PERIOD_TICKS,
+                                             MDV_PERIODIC_TIMER_SKIP, 0, 0),
+                     "")
+                << "If null, callback must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init_fraction(
+                        &m_timer, &m_sw_timer_base, TEST_PERIOD_TICKS, 0,
+                        MDV_PERIODIC_TIMER_SKIP, test_callback, 0), "")
+                << "If zero, denominator must cause an assertion failure.";
+        EXPECT_DEATH(mdv_periodic_timer_init_fraction(
+                        &m_timer, &m_sw_timer_base, TEST_PERIOD_TICKS,
+                        TEST_PERIOD_TICKS + 1u, MDV_PERIODIC_TIMER_SKIP,
+                        test_callback, 0), "")
+                << "A period shorter than one tick must cause an assertion " \
+                   "failure.";
+}
+
+TEST_F(test_mdv_periodic_timer, init__timer_stopped)
+{
+        mdv_periodic_timer_init(&m_timer, &m_sw_timer_base, TEST_PERIOD_TICKS,
+                                MDV_PERIODIC_TIMER_SKIP, test_callback,
+                                &m_calls);
+
+        EXPECT_FALSE(mdv_periodic_timer_is_running(&m_timer))
+                << "The timer must be stopped after the initialization.";
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + TEST_PERIOD_TICKS);
+        EXPECT_EQ(0u, mdv_periodic_timer_process(&m_timer))
+                << "A stopped timer must not call the callback.";
+}
+
+TEST_F(test_mdv_periodic_timer, start__first_deadline_one_period_ahead)
+{
+        Init(MDV_PERIODIC_TIMER_SKIP);
+
+        EXPECT_TRUE(mdv_periodic_timer_is_running(&m_timer))
+                << "The timer must be running.";
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 + TEST_PERIOD_TICKS,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The first deadline must be one period ahead.";
+
+        EXPECT_EQ(0u, Poll(TEST_PERIOD_TICKS - 1u))
+                << "The callback must not be called before the deadline.";
+        EXPECT_EQ(1u, Poll(TEST_PERIOD_TICKS))
+                << "The callback must be called at the deadline.";
+}
+
+TEST_F(test_mdv_periodic_timer, stop__timer_stopped)
+{
+        Init(MDV_PERIODIC_TIMER_SKIP);
+
+        mdv_periodic_timer_stop(&m_timer);
+
+        EXPECT_FALSE(mdv_periodic_timer_is_running(&m_timer))
+                << "The timer must be stopped.";
+        EXPECT_EQ(0u, Poll(2u * TEST_PERIOD_TICKS))
+                << "A stopped timer must not call the callback.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__called_once_per_period)
+{
+        Init(MDV_PERIODIC_TIMER_SKIP);
+
+        EXPECT_EQ(100u, Poll(100u * TEST_PERIOD_TICKS))
+                << "The callback must be called once per period.";
+        EXPECT_EQ(0u, mdv_periodic_timer_get_missed_count(&m_timer))
+                << "No periods must be missed.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__polling_latency_does_not_drift)
+{
+        uint64_t tick_count = TEST_INITIAL_TICK_COUNT64;
+
+        Init(MDV_PERIODIC_TIMER_SKIP);
+
+        for (uint32_t i = 1u; i <= 100u; i++) {
+                // Poll late by a varying latency shorter than one period
+                tick_count = TEST_INITIAL_TICK_COUNT64 + i * TEST_PERIOD_TICKS +
+                             i % TEST_PERIOD_TICKS;
+                SetTickCount64(tick_count);
+
+                ASSERT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                        << "The callback must be called once per period.";
+                ASSERT_EQ(TEST_INITIAL_TICK_COUNT64 +
+                          (i + 1u) * TEST_PERIOD_TICKS,
+                          mdv_periodic_timer_get_deadline64(&m_timer))
+                        << "The deadlines must not drift.";
+        }
+}
+
+TEST_F(test_mdv_periodic_timer, process__fractional_period_exact_rate)
+{
+        mdv_periodic_timer_init_fraction(&m_timer, &m_sw_timer_base,
+                                         TEST_FRACTION_NUMERATOR,
+                                         TEST_FRACTION_DENOMINATOR,
+                                         MDV_PERIODIC_TIMER_SKIP,
+                                         test_callback, &m_calls);
+        mdv_periodic_timer_start(&m_timer);
+
+        // Ten seconds on a 32.768 kHz counter
+        EXPECT_EQ(10000u, Poll(10u * TEST_FRACTION_NUMERATOR))
+                << "The callback must be called exactly at 1 kHz.";
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 +
+                  10001u * TEST_FRACTION_NUMERATOR / TEST_FRACTION_DENOMINATOR,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The next deadline must be the whole part of the exact " \
+                   "deadline.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__skip_policy_drops_missed_periods)
+{
+        Init(MDV_PERIODIC_TIMER_SKIP);
+
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + 3u * TEST_PERIOD_TICKS + 5u);
+
+        EXPECT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                << "The callback must be called once.";
+        ASSERT_EQ(1u, m_calls.missed_counts.size());
+        EXPECT_EQ(0u, m_calls.missed_counts[0])
+                << "The callback must not get the missed count.";
+        EXPECT_EQ(2u, mdv_periodic_timer_get_missed_count(&m_timer))
+                << "The missed periods must be counted.";
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 + 4u * TEST_PERIOD_TICKS,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The next deadline must stay in phase.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__burst_policy_catches_up)
+{
+        Init(MDV_PERIODIC_TIMER_BURST);
+
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + 3u * TEST_PERIOD_TICKS + 5u);
+
+        EXPECT_EQ(3u, mdv_periodic_timer_process(&m_timer))
+                << "The callback must be called once per due period.";
+        EXPECT_EQ(2u, mdv_periodic_timer_get_missed_count(&m_timer))
+                << "The late periods must be counted.";
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 + 4u * TEST_PERIOD_TICKS,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The next deadline must stay in phase.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__coalesce_policy_reports_missed)
+{
+        Init(MDV_PERIODIC_TIMER_COALESCE);
+
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + 3u * TEST_PERIOD_TICKS + 5u);
+
+        EXPECT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                << "The callback must be called once.";
+        ASSERT_EQ(1u, m_calls.missed_counts.size());
+        EXPECT_EQ(2u, m_calls.missed_counts[0])
+                << "The callback must get the missed count.";
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 + 4u * TEST_PERIOD_TICKS,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The next deadline must stay in phase.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__burst_ended_by_stop_in_callback)
+{
+        Init(MDV_PERIODIC_TIMER_BURST);
+        m_calls.action = TEST_ACTION_STOP;
+
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + 3u * TEST_PERIOD_TICKS);
+
+        EXPECT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                << "Stopping the timer must end the burst.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__burst_ended_by_restart_in_callback)
+{
+        uint64_t const tick_count =
+                TEST_INITIAL_TICK_COUNT64 + 3u * TEST_PERIOD_TICKS;
+
+        Init(MDV_PERIODIC_TIMER_BURST);
+        m_calls.action = TEST_ACTION_RESTART;
+
+        SetTickCount64(tick_count);
+
+        EXPECT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                << "Restarting the timer must end the burst.";
+        EXPECT_EQ(tick_count + TEST_PERIOD_TICKS,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The restarted timer must expire one period later.";
+}
+
+TEST_F(test_mdv_periodic_timer, process__long_overrun)
+{
+        uint64_t const overrun = 1ull << 40;
+
+        mdv_periodic_timer_init_fraction(&m_timer, &m_sw_timer_base,
+                                         TEST_FRACTION_NUMERATOR,
+                                         TEST_FRACTION_DENOMINATOR,
+                                         MDV_PERIODIC_TIMER_COALESCE,
+                                         test_callback, &m_calls);
+        mdv_periodic_timer_start(&m_timer);
+
+        SetTickCount64(TEST_INITIAL_TICK_COUNT64 + overrun);
+
+        EXPECT_EQ(1u, mdv_periodic_timer_process(&m_timer))
+                << "The callback must be called once.";
+        ASSERT_EQ(1u, m_calls.missed_counts.size());
+        EXPECT_EQ(UINT32_MAX, m_calls.missed_counts[0])
+                << "The missed count must saturate.";
+        // The first period after the overrun
+        EXPECT_EQ(TEST_INITIAL_TICK_COUNT64 +
+                  (overrun * TEST_FRACTION_DENOMINATOR /
+                   TEST_FRACTION_NUMERATOR + 1u) *
+                  TEST_FRACTION_NUMERATOR / TEST_FRACTION_DENOMINATOR,
+                  mdv_periodic_timer_get_deadline64(&m_timer))
+                << "The next deadline must stay in phase.";
+}
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "mdv_pool.c"
+#include "mdv_sw_timer.h"
+
+// Count of the blocks in the test pool
+#define TEST_BLOCK_COUNT 64u
+// Object size of the test pool, not a multiple of the alignment
+#define TEST_OBJECT_SIZE 20u
+// Count of the operations in the churn tests
+#define TEST_OPERATION_COUNT 100000u
+// Count of the threads in the concurrency test
+#define TEST_THREAD_COUNT 4u
+
+using namespace testing;
+
+namespace{
+
+class test_mdv_pool : public Test
+{
+        protected:
+
+        void SetUp() override {
+                mdv_pool_init(&m_pool, m_storage, TEST_OBJECT_SIZE,
+                              TEST_BLOCK_COUNT);
+        }
+
+        bool IsInStorage(void const *const block) {
+                return (uint8_t const *)block >= (uint8_t const *)m_storage &&
+                       (uint8_t const *)block <
+                       (uint8_t const *)m_storage + sizeof(m_storage);
+        }
+
+        MDV_POOL_STORAGE(m_storage, TEST_OBJECT_SIZE, TEST_BLOCK_COUNT);
+        mdv_pool_t m_pool;
+};
+
+TEST_F(test_mdv_pool, init__all_blocks_free)
+{
+        EXPECT_EQ(MDV_POOL_BLOCK_SIZE(TEST_OBJECT_SIZE), m_pool.block_size)
+                << "Invalid block size";
+        EXPECT_EQ(0u, m_pool.block_size % sizeof(mdv_pool_align_t))
+                << "Blocks not aligned";
+        EXPECT_GE(m_pool.block_size, TEST_OBJECT_SIZE)
+                << "Objects don't fit in the blocks";
+        EXPECT_EQ(TEST_BLOCK_COUNT, mdv_pool_get_free_count(&m_pool))
+                << "Invalid free count";
+        EXPECT_EQ(TEST_BLOCK_COUNT, mdv_pool_get_min_free_count(&m_pool))
+                << "Invalid smallest free count";
+}
+
+TEST_F(test_mdv_pool, init__unaligned_buffer_asserted)
+{
+        EXPECT_DEATH(mdv_pool_init(&m_pool, (uint8_t *)m_storage + 1,
+                                   TEST_OBJECT_SIZE, TEST_BLOCK_COUNT - 1u),
+                     "") << "Unaligned buffer not asserted";
+}
+
+TEST_F(test_mdv_pool, alloc__all_blocks_allocated_once)
+{
+        std::set<void *> blocks;
+
+        for (uint32_t i = 0; i < TEST_BLOCK_COUNT; ++i) {
+                void *const block = mdv_pool_alloc(&m_pool);
+
+                EXPECT_TRUE(IsInStorage(block)) << "Block outside the buffer";
+                blocks.insert(block);
+        }
+
+        EXPECT_EQ(TEST_BLOCK_COUNT, blocks.size())
+                << "Block allocated twice";
+        EXPECT_EQ(NULL, mdv_pool_alloc(&m_pool))
+                << "Block allocated from an empty pool";
+        EXPECT_EQ(0u, mdv_pool_get_free_count(&m_pool))
+                << "Invalid free count";
+        EXPECT_EQ(0u, mdv_pool_get_min_free_count(&m_pool))
+                << "Invalid smallest free count";
+}
+
+TEST_F(test_mdv_pool, free__released_block_reused)
+{
+        void *const first = mdv_pool_alloc(&m_pool);
+        void *const second = mdv_pool_alloc(&m_pool);
+
+        mdv_pool_free(&m_pool, first);
+
+        EXPECT_EQ(TEST_BLOCK_COUNT - 1u, mdv_pool_get_free_count(&m_pool))
+                << "Invalid free count";
+        EXPECT_EQ(TEST_BLOCK_COUNT - 2u, mdv_pool_get_min_free_count(&m_pool))
+                << "Smallest free count not kept";
+        EXPECT_EQ(first, mdv_pool_alloc(&m_pool))
+                << "Most recently released block not reused";
+        EXPECT_NE(second, first) << "Block allocated twice";
+}
+
+TEST_F(test_mdv_pool, free__foreign_block_asserted)
+{
+        uint8_t *const block = (uint8_t *)mdv_pool_alloc(&m_pool);
+        mdv_pool_align_t other;
+
+        EXPECT_DEATH(mdv_pool_free(&m_pool, block + 1), "")
+                << "Pointer inside a block not asserted";
+        EXPECT_DEATH(mdv_pool_free(&m_pool, &other), "")
+                << "Block outside the pool not asserted";
+}
+
+TEST_F(test_mdv_pool, alloc__churn_never_fragments)
+{
+        std::mt19937 random(1u);
+        std::vector<uint8_t *> live;
+        uint32_t corrupted = 0;
+
+        // Each live block is filled with a pattern of its own, so that any
+        // overlap of two blocks shows up as a changed pattern
+        for (uint32_t i = 0; i < TEST_OPERATION_COUNT; ++i) {
+                if (random() % 2u) {
+                        uint8_t *const block =
+                                (uint8_t *)mdv_pool_alloc(&m_pool);
+
+                        ASSERT_EQ(live.size() < TEST_BLOCK_COUNT,
+                                  block != NULL)
+                                << "Allocation failed with free blocks";
+                        if (block) {
+                                memset(block, (int)(i & 0xffu),
+                                       TEST_OBJECT_SIZE);
+                                live.push_back(block);
+                        }
+                } else if (!live.empty()) {
+                        size_t const index = random() % live.size();
+                        uint8_t *const block = live[index];
+
+                        for (uint32_t j = 1; j < TEST_OBJECT_SIZE; ++j) {
+                                corrupted += block[j] != block[0];
+                        }
+                        live[index] = live.back();
+                        live.pop_back();
+                        mdv_pool_free(&m_pool, block);
+                }
+                ASSERT_EQ(TEST_BLOCK_COUNT - live.size(),
+                          mdv_pool_get_free_count(&m_pool))
+                        << "Invalid free count";
+        }
+
+        EXPECT_EQ(0u, corrupted) << "Blocks overlap";
+}
+
+TEST_F(test_mdv_pool, alloc__timers_allocated_from_pool)
+{
+        MDV_POOL_STORAGE(storage, sizeof(mdv_sw_timer_t), 2u);
+        mdv_pool_t pool;
+        mdv_sw_timer_t *first;
+        mdv_sw_timer_t *second;
+
+        mdv_pool_init(&pool, storage, sizeof(mdv_sw_timer_t), 2u);
+        first = (mdv_sw_timer_t *)mdv_pool_alloc(&pool);
+        second = (mdv_sw_timer_t *)mdv_pool_alloc(&pool);
+
+        EXPECT_EQ(0u, (uintptr_t)first % alignof(mdv_sw_timer_t))
+                << "Timer not aligned";
+        EXPECT_GE((uint8_t *)second - (uint8_t *)first,
+                  (ptrdiff_t)sizeof(mdv_sw_timer_t)) << "Timers overlap";
+        EXPECT_EQ(NULL, mdv_pool_alloc(&pool)) << "Too many timers";
+}
+
+TEST_F(test_mdv_pool, cache_alloc__blocks_moved_in_batches)
+{
+        mdv_pool_cache_t cache;
+        void *block;
+
+        mdv_pool_cache_init(&cache, &m_pool);
+        block = mdv_pool_cache_alloc(&cache);
+
+        EXPECT_TRUE(IsInStorage(block)) << "Block outside the buffer";
+        EXPECT_EQ(TEST_BLOCK_COUNT - MDV_POOL_CACHE_SIZE / 2u,
+                  mdv_pool_get_free_count(&m_pool))
+                << "Cache not refilled with half of its size";
+        EXPECT_EQ(MDV_POOL_CACHE_SIZE / 2u - 1u, cache.count)
+                << "Invalid count of the cached blocks";
+
+        mdv_pool_cache_free(&cache, block);
+        mdv_pool_cache_flush(&cache);
+
+        EXPECT_EQ(TEST_BLOCK_COUNT, mdv_pool_get_free_count(&m_pool))
+                << "Blocks not returned by the flush";
+        EXPECT_EQ(0u, cache.count) << "Cache not emptied";
+}
+
+TEST_F(test_mdv_pool, cache_free__full_cache_returns_half)
+{
+        mdv_pool_cache_t cache;
+        std::vector<void *> blocks;
+
+        for (uint32_t i = 0; i < MDV_POOL_CACHE_SIZE + 1u; ++i) {
+                blocks.push_back(mdv_pool_alloc(&m_pool));
+        }
+        mdv_pool_cache_init(&cache, &m_pool);
+        for (void *const block : blocks) {
+                mdv_pool_cache_free(&cache, block);
+        }
+
+        EXPECT_EQ(MDV_POOL_CACHE_SIZE / 2u + 1u, cache.count)
+                << "Invalid count of the cached blocks";
+        EXPECT_EQ(TEST_BLOCK_COUNT - MDV_POOL_CACHE_SIZE / 2u - 1u,
+                  mdv_pool_get_free_count(&m_pool))
+                << "Half of the blocks not returned to the pool";
+        EXPECT_EQ(blocks.back(), mdv_pool_cache_alloc(&cache))
+                << "Most recently released block not reused";
+}
+
+TEST_F(test_mdv_pool, cache_alloc__empty_pool_returns_null)
+{
+        mdv_pool_cache_t first;
+        mdv_pool_cache_t second;
+        std::set<void *> blocks;
+        void *block;
+
+        mdv_pool_cache_init(&first, &m_pool);
+        mdv_pool_cache_init(&second, &m_pool);
+        while ((block = mdv_pool_cache_alloc(&first)) != NULL) {
+                blocks.insert(block);
+        }
+
+        EXPECT_EQ(TEST_BLOCK_COUNT, blocks.size())
+                << "Not all blocks allocated through the cache";
+        EXPECT_EQ(NULL, mdv_pool_cache_alloc(&second))
+                << "Block allocated from an empty pool";
+}
+
+TEST_F(test_mdv_pool, cache_alloc__concurrent_caches_share_pool)
+{
+        std::vector<std::thread> threads;
+        uint32_t corrupted[TEST_THREAD_COUNT] = {0};
+
+        for (uint32_t t = 0; t < TEST_THREAD_COUNT; ++t) {
+                threads.emplace_back([this, t, &corrupted]() {
+                        std::mt19937 random(t);
+                        std::vector<uint8_t *> live;
+                        mdv_pool_cache_t cache;
+
+                        mdv_pool_cache_init(&cache, &m_pool);
+                        for (uint32_t i = 0; i < TEST_OPERATION_COUNT; ++i) {
+                                if ((random() % 2u) &&
+                                    (live.size() < TEST_BLOCK_COUNT /
+                                     TEST_THREAD_COUNT)) {
+                                        uint8_t *const block = (uint8_t *)
+                                                mdv_pool_cache_alloc(&cache);
+
+                                        if (block) {
+                                                memset(block, (int)t,
+                                                       TEST_OBJECT_SIZE);
+                                                live.push_back(block);
+                                        }
+                                } else if (!live.empty()) {
+                                        uint8_t *const block = live.back();
+
+                                        for (uint32_t j = 0;
+                                             j < TEST_OBJECT_SIZE; ++j) {
+                                                corrupted[t] += block[j] != t;
+                                        }
+                                        live.pop_back();
+                                        mdv_pool_cache_free(&cache, block);
+                                }
+                        }
+                        for (uint8_t *const block : live) {
+                                mdv_pool_cache_free(&cache, block);
+                        }
+                        mdv_pool_cache_flush(&cache);
+                });
+        }
+        for (std::thread &thread : threads) {
+                thread.join();
+        }
+
+        for (uint32_t t = 0; t < TEST_THREAD_COUNT; ++t) {
+                EXPECT_EQ(0u, corrupted[t])
+                        << "Block shared by two threads " << t;
+        }
+        EXPECT_EQ(TEST_BLOCK_COUNT, mdv_pool_get_free_count(&m_pool))
+                << "Blocks lost";
+}
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "mdv_profiler.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test mask (24-bit) for the timer counter
+#define TEST_TIMER_MASK 0x00ffffffu
+// Test value for the initial tick count
+#define TEST_TIMER_INITIAL_TICK_COUNT 0x00fffff0u
+// Test value for the measured ticks, crosses the wrap-around of the counter
+#define TEST_ELAPSED_TICK_COUNT 0x0123u
+
+using namespace testing;
+
+namespace{
+
+void test_report_function(void *const user_data,
+                          mdv_profiler_report_t const *const report)
+{
+        static_cast<std::vector<mdv_profiler_report_t> *>(user_data)
+                ->push_back(*report);
+}
+
+class test_mdv_profiler : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                mdv_sw_timer_conversion_init(&m_conversion,
+                                             TEST_TICK_DURATION_US);
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_conversion(&m_sw_timer_base))
+                        .WillByDefault(Return(&m_conversion));
+                SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT);
+                mdv_profiler_init(&m_profiler, &m_sw_timer_base);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void SetTickCount(uint32_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count));
+        }
+
+        std::vector<mdv_profiler_report_t> Report(
+                mdv_sw_timer_order_of_magnitude_t const order_of_magnitude) {
+                std::vector<mdv_profiler_report_t> reports;
+
+                mdv_profiler_report(&m_profiler, order_of_magnitude,
+                                    test_report_function, &reports);
+
+                return reports;
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_sw_timer_conversion_t m_conversion;
+        mdv_profiler_t m_profiler;
+};
+
+#ifndef MDV_DISABLE_PROFILER
+
+TEST_F(test_mdv_profiler,
+       invalid_function_parameters_cause_assertion_failure)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+
+        EXPECT_DEATH(mdv_profiler_init(0, &m_sw_timer_base), "")
+                << "If null, profiler must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_init(&m_profiler, 0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_begin(0), "")
+                << "If null, profiler must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_end(0, &site, 0), "")
+                << "If null, profiler must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_end(&m_profiler, 0, 0), "")
+                << "If null, site must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_report(&m_profiler, MDV_SW_TIMER_US, 0, 0),
+                     "")
+                << "If null, function must cause an assertion failure.";
+        EXPECT_DEATH(mdv_profiler_get_bucket_limit(
+                             MDV_PROFILER_HISTOGRAM_BUCKETS), "")
+                << "An invalid bucket must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_profiler, probe__raw_ticks_recorded_across_wrap_around)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+        uint32_t ticks;
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                    mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .Times(2);
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                    mdv_sw_timer_base_get_conversion(_))
+                .Times(0);
+
+        MDV_PROFILER_BEGIN(&m_profiler, start);
+        SetTickCount((TEST_TIMER_INITIAL_TICK_COUNT +
+                      TEST_ELAPSED_TICK_COUNT) & TEST_TIMER_MASK);
+        ticks = MDV_PROFILER_END(&m_profiler, &site, start);
+
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, ticks)
+                << "The sample must be the masked tick count difference.";
+        EXPECT_EQ(1u, site.count) << "The sample must be counted.";
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, site.min)
+                << "The raw ticks must be recorded.";
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, site.max)
+                << "The raw ticks must be recorded.";
+        EXPECT_EQ(&site, m_profiler.sites)
+                << "The site must be linked on the first sample.";
+}
+
+TEST_F(test_mdv_profiler, record__statistics_accumulated)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+        uint32_t const samples[] = { 0, 1u, 2u, 3u, 4u, 7u, 8u };
+
+        for (uint32_t sample : samples) {
+                mdv_profiler_record(&m_profiler, &site, sample);
+        }
+
+        EXPECT_EQ(7u, site.count) << "The samples must be counted.";
+        EXPECT_EQ(0u, site.min) << "The minimum must be recorded.";
+        EXPECT_EQ(8u, site.max) << "The maximum must be recorded.";
+        EXPECT_EQ(25u, site.sum) << "The sum must be recorded.";
+        EXPECT_EQ(1u, site.histogram[0]) << "Zero must be in bucket 0.";
+        EXPECT_EQ(1u, site.histogram[1]) << "One must be in bucket 1.";
+        EXPECT_EQ(2u, site.histogram[2]) << "2..3 must be in bucket 2.";
+        EXPECT_EQ(2u, site.histogram[3]) << "4..7 must be in bucket 3.";
+        EXPECT_EQ(1u, site.histogram[4]) << "8..15 must be in bucket 4.";
+}
+
+TEST_F(test_mdv_profiler, record__longest_samples_in_last_bucket)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+
+        mdv_profiler_record(&m_profiler, &site, UINT32_MAX);
+
+        EXPECT_EQ(1u, site.histogram[MDV_PROFILER_HISTOGRAM_BUCKETS - 1u])
+                << "The longest sample must be in the last bucket.";
+}
+
+TEST_F(test_mdv_profiler, get_bucket_limit__limits_of_buckets)
+{
+        EXPECT_EQ(0u, mdv_profiler_get_bucket_limit(0))
+                << "Bucket 0 must count zero only.";
+        EXPECT_EQ(1u, mdv_profiler_get_bucket_limit(1u))
+                << "Bucket 1 must count one.";
+        EXPECT_EQ(7u, mdv_profiler_get_bucket_limit(3u))
+                << "Bucket 3 must count up to seven.";
+        EXPECT_EQ(UINT32_MAX, mdv_profiler_get_bucket_limit(
+                          MDV_PROFILER_HISTOGRAM_BUCKETS - 1u))
+                << "The last bucket must count all longer samples.";
+
+        for (uint32_t i = 1u; i < MDV_PROFILER_HISTOGRAM_BUCKETS; i++) {
+                EXPECT_EQ(i, get_bucket(mdv_profiler_get_bucket_limit(i - 1u) +
+                                        1u))
+                        << "The bucket must begin after the previous limit.";
+        }
+}
+
+TEST_F(test_mdv_profiler, add_site__site_linked_once)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+
+        mdv_profiler_add_site(&m_profiler, &site);
+        mdv_profiler_add_site(&m_profiler, &site);
+        mdv_profiler_record(&m_profiler, &site, 1u);
+
+        EXPECT_EQ(1u, Report(MDV_SW_TIMER_TIMERTICK).size())
+                << "The site must be reported once.";
+}
+
+TEST_F(test_mdv_profiler, report__statistics_converted_to_time)
+{
+        MDV_PROFILER_DEFINE_SITE(site_a, "a");
+        MDV_PROFILER_DEFINE_SITE(site_b, "b");
+        std::vector<mdv_profiler_report_t> reports;
+
+        mdv_profiler_add_site(&m_profiler, &site_b);
+        mdv_profiler_record(&m_profiler, &site_a, 10u);
+        mdv_profiler_record(&m_profiler, &site_a, 21u);
+
+        reports = Report(MDV_SW_TIMER_US);
+
+        ASSERT_EQ(2u, reports.size()) << "All sites must be reported.";
+        EXPECT_EQ(std::string("a"), reports[0].name)
+                << "The name must be reported.";
+        EXPECT_EQ(2u, reports[0].count) << "The count must be reported.";
+        EXPECT_EQ(10u * TEST_TICK_DURATION_US, reports[0].min)
+                << "The minimum must be converted.";
+        EXPECT_EQ(21u * TEST_TICK_DURATION_US, reports[0].max)
+                << "The maximum must be converted.";
+        EXPECT_EQ(15u * TEST_TICK_DURATION_US, reports[0].mean)
+                << "The mean must be converted and rounded down.";
+        EXPECT_EQ(site_a.histogram, reports[0].histogram)
+                << "The histogram must be reported.";
+        EXPECT_EQ(std::string("b"), reports[1].name)
+                << "A site without samples must be reported.";
+        EXPECT_EQ(0u, reports[1].count) << "The count must be zero.";
+        EXPECT_EQ(0u, reports[1].min) << "The minimum must be zero.";
+}
+
+TEST_F(test_mdv_profiler, reset__statistics_cleared)
+{
+        MDV_PROFILER_DEFINE_SITE(site, "site");
+
+        mdv_profiler_record(&m_profiler, &site, 5u);
+        mdv_profiler_reset(&m_profiler);
+
+        EXPECT_EQ(0u, site.count) << "The count must be cleared.";
+        EXPECT_EQ(UINT32_MAX, site.min) << "The minimum must be cleared.";
+        EXPECT_EQ(0u, site.max) << "The maximum must be cleared.";
+        EXPECT_EQ(0u, site.sum) << "The sum must be cleared.";
+        EXPECT_EQ(0u, site.histogram[get_bucket(5u)])
+                << "The histogram must be cleared.";
+        EXPECT_EQ(&site, m_profiler.sites) << "The site must stay linked.";
+}
+
+#else
+
+MDV_PROFILER_DEFINE_SITE(test_site, "site");
+
+TEST_F(test_mdv_profiler, probe__disabled_probes_do_nothing)
+{
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                    mdv_sw_timer_base_get_tick_count(_))
+                .Times(0);
+
+        MDV_PROFILER_BEGIN(&m_profiler, start);
+        MDV_PROFILER_END(&m_profiler, &test_site, start);
+
+        EXPECT_EQ(nullptr, m_profiler.sites)
+                << "No sites must be linked.";
+}
+
+#endif // ifndef MDV_DISABLE_PROFILER
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "mdv_queue.c"
+
+// Capacity of the test queues
+#define TEST_CAPACITY 8u
+// Count of the elements passed in the concurrency tests
+#define TEST_ELEMENT_COUNT 200000u
+// Count of the producers in the concurrency test of the MPSC queue
+#define TEST_PRODUCER_COUNT 4u
+// Largest batch in the concurrency tests
+#define TEST_MAX_BATCH 5u
+
+using namespace testing;
+
+namespace{
+
+class test_mdv_queue : public Test
+{
+        protected:
+
+        void SetUp() override {
+                mdv_spsc_queue_init(&m_spsc_queue, m_spsc_buffer,
+                                    sizeof(uint32_t), TEST_CAPACITY);
+                mdv_mpsc_queue_init(&m_mpsc_queue, m_mpsc_buffer,
+                                    sizeof(uint32_t), TEST_CAPACITY);
+        }
+
+        mdv_spsc_queue_t m_spsc_queue;
+        uint32_t m_spsc_buffer[TEST_CAPACITY];
+        mdv_mpsc_queue_t m_mpsc_queue;
+        uint32_t m_mpsc_buffer[MDV_MPSC_QUEUE_BUFFER_SIZE(sizeof(uint32_t),
+                                                          TEST_CAPACITY) /
+                               sizeof(uint32_t)];
+};
+
+TEST_F(test_mdv_queue, init__invalid_parameters_asserted)
+{
+        EXPECT_DEATH(mdv_spsc_queue_init(&m_spsc_queue, m_spsc_buffer,
+                                         sizeof(uint32_t), 6u), "")
+                << "Capacity not a power of two not asserted";
+        EXPECT_DEATH(mdv_spsc_queue_init(&m_spsc_queue, m_spsc_buffer, 0,
+                                         TEST_CAPACITY), "")
+                << "Zero element size not asserted";
+        EXPECT_DEATH(mdv_mpsc_queue_init(&m_mpsc_queue,
+                                         (uint8_t *)m_mpsc_buffer + 1,
+                                         sizeof(uint32_t), TEST_CAPACITY),
+                     "") << "Unaligned buffer not asserted";
+}
+
+TEST_F(test_mdv_queue, spsc_queue__elements_dequeued_in_order)
+{
+        uint32_t const input[] = {1u, 2u, 3u};
+        uint32_t output[TEST_CAPACITY] = {0};
+
+        EXPECT_EQ(0u, mdv_spsc_queue_dequeue(&m_spsc_queue, output, 1u))
+                << "Element dequeued from an empty queue";
+        EXPECT_EQ(3u, mdv_spsc_queue_enqueue(&m_spsc_queue, input, 3u))
+                << "Elements not enqueued";
+        EXPECT_EQ(3u, mdv_spsc_queue_get_count(&m_spsc_queue))
+                << "Invalid count";
+        EXPECT_EQ(3u, mdv_spsc_queue_dequeue(&m_spsc_queue, output,
+                                             TEST_CAPACITY))
+                << "Elements not dequeued";
+        EXPECT_EQ(1u, output[0]) << "Invalid first element";
+        EXPECT_EQ(2u, output[1]) << "Invalid second element";
+        EXPECT_EQ(3u, output[2]) << "Invalid third element";
+        EXPECT_EQ(0u, mdv_spsc_queue_get_count(&m_spsc_queue))
+                << "Queue not empty";
+}
+
+TEST_F(test_mdv_queue, spsc_queue__full_queue_enqueues_partially)
+{
+        uint32_t input[TEST_CAPACITY + 2u];
+        uint32_t output[TEST_CAPACITY];
+
+        for (uint32_t i = 0; i < TEST_CAPACITY + 2u; ++i) {
+                input[i] = i;
+        }
+
+        EXPECT_EQ(TEST_CAPACITY - 2u,
+                  mdv_spsc_queue_enqueue(&m_spsc_queue, input,
+                                         TEST_CAPACITY - 2u))
+                << "Elements not enqueued";
+        EXPECT_EQ(2u, mdv_spsc_queue_enqueue(&m_spsc_queue,
+                                             &input[TEST_CAPACITY - 2u], 4u))
+                << "Queue not filled";
+        EXPECT_EQ(0u, mdv_spsc_queue_enqueue(&m_spsc_queue, input, 1u))
+                << "Element enqueued to a full queue";
+        EXPECT_EQ(TEST_CAPACITY, mdv_spsc_queue_dequeue(&m_spsc_queue, output,
+                                                        TEST_CAPACITY))
+                << "Queue not emptied";
+        for (uint32_t i = 0; i < TEST_CAPACITY; ++i) {
+                EXPECT_EQ(i, output[i]) << "Invalid element " << i;
+        }
+}
+
+TEST_F(test_mdv_queue, spsc_queue__batches_wrap_around_indexes)
+{
+        uint32_t const input[] = {1u, 2u, 3u, 4u, 5u};
+        uint32_t output[5];
+
+        // Start close to the wrap-around of both the storage and the indexes
+        m_spsc_queue.tail = UINT32_MAX - 1u;
+        m_spsc_queue.cached_head = UINT32_MAX - 1u;
+        m_spsc_queue.head = UINT32_MAX - 1u;
+        m_spsc_queue.cached_tail = UINT32_MAX - 1u;
+
+        EXPECT_EQ(5u, mdv_spsc_queue_enqueue(&m_spsc_queue, input, 5u))
+                << "Elements not enqueued";
+        EXPECT_EQ(5u, mdv_spsc_queue_get_count(&m_spsc_queue))
+                << "Invalid count";
+        EXPECT_EQ(5u, mdv_spsc_queue_dequeue(&m_spsc_queue, output, 5u))
+                << "Elements not dequeued";
+        for (uint32_t i = 0; i < 5u; ++i) {
+                EXPECT_EQ(input[i], output[i]) << "Invalid element " << i;
+        }
+}
+
+TEST_F(test_mdv_queue, mpsc_queue__elements_dequeued_in_order)
+{
+        uint32_t const input[] = {1u, 2u, 3u};
+        uint32_t output[TEST_CAPACITY] = {0};
+
+        EXPECT_EQ(0u, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output, 1u))
+                << "Element dequeued from an empty queue";
+        EXPECT_EQ(3u, mdv_mpsc_queue_enqueue(&m_mpsc_queue, input, 3u))
+                << "Elements not enqueued";
+        EXPECT_EQ(3u, mdv_mpsc_queue_get_count(&m_mpsc_queue))
+                << "Invalid count";
+        EXPECT_EQ(3u, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output,
+                                             TEST_CAPACITY))
+                << "Elements not dequeued";
+        EXPECT_EQ(1u, output[0]) << "Invalid first element";
+        EXPECT_EQ(2u, output[1]) << "Invalid second element";
+        EXPECT_EQ(3u, output[2]) << "Invalid third element";
+}
+
+TEST_F(test_mdv_queue, mpsc_queue__full_queue_enqueues_partially)
+{
+        uint32_t input[TEST_CAPACITY + 3u];
+        uint32_t output[TEST_CAPACITY];
+
+        for (uint32_t i = 0; i < TEST_CAPACITY + 3u; ++i) {
+                input[i] = i;
+        }
+
+        EXPECT_EQ(TEST_CAPACITY, mdv_mpsc_queue_enqueue(&m_mpsc_queue, input,
+                                                        TEST_CAPACITY + 2u))
+                << "Queue not filled";
+        EXPECT_EQ(0u, mdv_mpsc_queue_enqueue(&m_mpsc_queue, input, 1u))
+                << "Element enqueued to a full queue";
+        EXPECT_EQ(3u, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output, 3u))
+                << "Elements not dequeued";
+        EXPECT_EQ(3u, mdv_mpsc_queue_enqueue(&m_mpsc_queue,
+                                             &input[TEST_CAPACITY], 3u))
+                << "Freed slots not reused";
+        EXPECT_EQ(TEST_CAPACITY, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output,
+                                                        TEST_CAPACITY))
+                << "Queue not emptied";
+        for (uint32_t i = 0; i < TEST_CAPACITY; ++i) {
+                EXPECT_EQ(i + 3u, output[i]) << "Invalid element " << i;
+        }
+}
+
+TEST_F(test_mdv_queue, mpsc_queue__unpublished_slot_stops_consumer)
+{
+        uint32_t const input[] = {1u, 2u};
+        uint32_t output[TEST_CAPACITY];
+
+        // Reserve a slot like an interrupted producer would
+        m_mpsc_queue.tail = 1u;
+        mdv_mpsc_queue_enqueue(&m_mpsc_queue, input, 2u);
+
+        EXPECT_EQ(0u, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output,
+                                             TEST_CAPACITY))
+                << "Consumer passed an unpublished slot";
+
+        m_mpsc_queue.sequences[0] = 1u;
+
+        EXPECT_EQ(3u, mdv_mpsc_queue_dequeue(&m_mpsc_queue, output,
+                                             TEST_CAPACITY))
+                << "Published elements not dequeued";
+        EXPECT_EQ(1u, output[1]) << "Invalid element after the slot";
+}
+
+TEST_F(test_mdv_queue, spsc_queue__concurrent_elements_passed_in_order)
+{
+        uint32_t received = 0;
+        uint32_t errors = 0;
+
+        std::thread producer([this]() {
+                uint32_t batch[TEST_MAX_BATCH];
+                uint32_t next = 0;
+                uint32_t size = 1u;
+
+                while (next < TEST_ELEMENT_COUNT) {
+                        uint32_t const count =
+                                TEST_ELEMENT_COUNT - next < size ?
+                                TEST_ELEMENT_COUNT - next : size;
+
+                        uint32_t enqueued;
+
+                        for (uint32_t i = 0; i < count; ++i) {
+                                batch[i] = next + i;
+                        }
+                        enqueued = mdv_spsc_queue_enqueue(&m_spsc_queue, batch,
+                                                          count);
+                        if (!enqueued) {
+                                std::this_thread::yield();
+                        }
+                        next += enqueued;
+                        size = size % TEST_MAX_BATCH + 1u;
+                }
+        });
+
+        while (received < TEST_ELEMENT_COUNT) {
+                uint32_t batch[TEST_MAX_BATCH];
+                uint32_t const count = mdv_spsc_queue_dequeue(
+                        &m_spsc_queue, batch, TEST_MAX_BATCH);
+
+                if (!count) {
+                        std::this_thread::yield();
+                }
+                for (uint32_t i = 0; i < count; ++i) {
+                        errors += batch[i] != received++;
+                }
+        }
+        producer.join();
+
+        EXPECT_EQ(0u, errors) << "Elements lost or reordered";
+        EXPECT_EQ(0u, mdv_spsc_queue_get_count(&m_spsc_queue))
+                << "Queue not empty";
+}
+
+TEST_F(test_mdv_queue, mpsc_queue__concurrent_batches_kept_together)
+{
+        std::vector<std::thread> producers;
+        uint32_t next[TEST_PRODUCER_COUNT] = {0};
+        uint32_t previous = 0;
+        uint32_t received = 0;
+        uint32_t errors = 0;
+
+        // Each element holds the producer in bits 24 to 31, the position in
+        // the batch in bits 20 to 23, and the sequence number of the producer
+        // in bits 0 to 19
+        for (uint32_t p = 0; p < TEST_PRODUCER_COUNT; ++p) {
+                producers.emplace_back([this, p]() {
+                        uint32_t batch[TEST_MAX_BATCH];
+                        uint32_t sent = 0;
+                        uint32_t size = 1u;
+
+                        while (sent < TEST_ELEMENT_COUNT) {
+                                uint32_t const count =
+                                        TEST_ELEMENT_COUNT - sent < size ?
+                                        TEST_ELEMENT_COUNT - sent : size;
+
+                                uint32_t enqueued;
+
+                                for (uint32_t i = 0; i < count; ++i) {
+                                        batch[i] = (p << 24) | (i << 20) |
+                                                   (sent + i);
+                                }
+                                enqueued = mdv_mpsc_queue_enqueue(
+                                        &m_mpsc_queue, batch, count);
+                                if (!enqueued) {
+                                        std::this_thread::yield();
+                                }
+                                sent += enqueued;
+                                size = size % TEST_MAX_BATCH + 1u;
+                        }
+                });
+        }
+
+        while (received < TEST_PRODUCER_COUNT * TEST_ELEMENT_COUNT) {
+                uint32_t batch[TEST_MAX_BATCH];
+                uint32_t const count = mdv_mpsc_queue_dequeue(
+                        &m_mpsc_queue, batch, TEST_MAX_BATCH);
+
+                if (!count) {
+                        std::this_thread::yield();
+                }
+                for (uint32_t i = 0; i < count; ++i) {
+                        uint32_t const element = batch[i];
+                        uint32_t const p = element >> 24;
+                        uint32_t const position = (element >> 20) & 0x0fu;
+
+                        errors += (p >= TEST_PRODUCER_COUNT) ||
+                                  ((element & 0x000fffffu) != next[p]++);
+                        // The previous element is from the same batch
+                        errors += position &&
+                                  (element != previous + 0x00100001u);
+                        previous = element;
+                }
+                received += count;
+        }
+        for (std::thread &producer : producers) {
+                producer.join();
+        }
+
+        EXPECT_EQ(0u, errors) << "Elements lost, reordered or interleaved";
+        EXPECT_EQ(0u, mdv_mpsc_queue_get_count(&m_mpsc_queue))
+                << "Queue not empty";
+}
+
+} // namespace
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "mdv_shadow_output.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test mask (24-bit) for the timer counter
+#define TEST_TIMER_MASK 0x00ffffffu
+// Test value for the initial tick count
+#define TEST_INITIAL_TICK_COUNT 0x1000u
+// Test value for the initial output value
+#define TEST_INITIAL_VALUE 0x000000f0u
+// Test value for a failed write
+#define TEST_WRITE_ERROR -1
+
+using namespace testing;
+
+namespace{
+
+std::vector<uint32_t> test_output_values;
+mdv_result_t test_output_result;
+
+mdv_result_t test_output_set(uint32_t const output)
+{
+        test_output_values.push_back(output);
+
+        return test_output_result;
+}
+
+mdv_digital_output_t test_output = {NULL, NULL, test_output_set};
+
+class test_mdv_shadow_output : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                SetTickCount(TEST_INITIAL_TICK_COUNT);
+                test_output_values.clear();
+                test_output_result = MDV_RESULT_OK;
+                mdv_shadow_output_init(&m_shadow_output, &test_output,
+                                       &m_sw_timer_base, TEST_INITIAL_VALUE);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void SetTickCount(uint32_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count));
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_shadow_output_t m_shadow_output;
+};
+
+TEST_F(test_mdv_shadow_output, init__nothing_written)
+{
+        EXPECT_EQ(TEST_INITIAL_VALUE, mdv_shadow_output_get(&m_shadow_output))
+                << "Invalid initial value";
+        EXPECT_FALSE(mdv_shadow_output_is_pending(&m_shadow_output))
+                << "Initial value pending";
+        EXPECT_EQ(MDV_RESULT_OK, mdv_shadow_output_commit(&m_shadow_output))
+                << "Invalid result";
+        EXPECT_TRUE(test_output_values.empty()) << "Initial value written";
+}
+
+TEST_F(test_mdv_shadow_output, operations__masks_applied)
+{
+        mdv_shadow_output_set(&m_shadow_output, 0x00000003u);
+        EXPECT_EQ(0x000000f3u, mdv_shadow_output_get(&m_shadow_output))
+                << "Lines not set";
+        mdv_shadow_output_clear(&m_shadow_output, 0x00000030u);
+        EXPECT_EQ(0x000000c3u, mdv_shadow_output_get(&m_shadow_output))
+                << "Lines not cleared";
+        mdv_shadow_output_toggle(&m_shadow_output, 0x00000101u);
+        EXPECT_EQ(0x000001c2u, mdv_shadow_output_get(&m_shadow_output))
+                << "Lines not toggled";
+        mdv_shadow_output_modify(&m_shadow_output, 0x0000f00fu, 0x00005555u);
+        EXPECT_EQ(0x000051c5u, mdv_shadow_output_get(&m_shadow_output))
+                << "Lines not modified";
+        EXPECT_TRUE(test_output_values.empty())
+                << "Output written before the commit";
+}
+
+TEST_F(test_mdv_shadow_output, commit__changes_written_once)
+{
+        mdv_shadow_output_stats_t stats;
+
+        mdv_shadow_output_set(&m_shadow_output, 0x00000001u);
+        mdv_shadow_output_set(&m_shadow_output, 0x00000002u);
+        mdv_shadow_output_clear(&m_shadow_output, 0x00000010u);
+
+        EXPECT_TRUE(mdv_shadow_output_is_pending(&m_shadow_output))
+                << "Changes not pending";
+        EXPECT_EQ(MDV_RESULT_OK, mdv_shadow_output_commit(&m_shadow_output))
+                << "Invalid result";
+        EXPECT_EQ(MDV_RESULT_OK, mdv_shadow_output_commit(&m_shadow_output))
+                << "Invalid result";
+        ASSERT_EQ(1u, test_output_values.size())
+                << "Invalid count of the writes";
+        EXPECT_EQ(0x000000e3u, test_output_values[0]) << "Invalid value";
+
+        mdv_shadow_output_get_stats(&m_shadow_output, &stats);
+
+        EXPECT_EQ(3u, stats.operation_count) << "Invalid operation count";
+        EXPECT_EQ(1u, stats.write_count) << "Invalid write count";
+        EXPECT_EQ(2u, stats.saved_write_count) << "Invalid saved writes";
+        EXPECT_EQ(0u, stats.error_count) << "Invalid error count";
+}
+
+TEST_F(test_mdv_shadow_output, commit__reverted_changes_not_written)
+{
+        mdv_shadow_output_toggle(&m_shadow_output, 0x00000100u);
+        mdv_shadow_output_toggle(&m_shadow_output, 0x00000100u);
+        mdv_shadow_output_commit(&m_shadow_output);
+
+        EXPECT_TRUE(test_output_values.empty())
+                << "Unchanged value written";
+}
+
+TEST_F(test_mdv_shadow_output, commit__failed_write_kept_pending)
+{
+        mdv_shadow_output_stats_t stats;
+
+        mdv_shadow_output_set(&m_shadow_output, 0x00000001u);
+        test_output_result = TEST_WRITE_ERROR;
+
+        EXPECT_EQ(TEST_WRITE_ERROR, mdv_shadow_output_commit(&m_shadow_output))
+                << "Error not returned";
+        EXPECT_TRUE(mdv_shadow_output_is_pending(&m_shadow_output))
+                << "Failed write not pending";
+
+        test_output_result = MDV_RESULT_OK;
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_shadow_output_commit(&m_shadow_output))
+                << "Invalid result";
+        EXPECT_FALSE(mdv_shadow_output_is_pending(&m_shadow_output))
+                << "Write not retried";
+
+        mdv_shadow_output_get_stats(&m_shadow_output, &stats);
+
+        EXPECT_EQ(1u, stats.write_count) << "Invalid write count";
+        EXPECT_EQ(1u, stats.error_count) << "Invalid error count";
+}
+
+TEST_F(test_mdv_shadow_output, process__written_once_per_tick)
+{
+        mdv_shadow_output_set(&m_shadow_output, 0x00000001u);
+        mdv_shadow_output_process(&m_shadow_output);
+        mdv_shadow_output_set(&m_shadow_output, 0x00000002u);
+        mdv_shadow_output_process(&m_shadow_output);
+
+        ASSERT_EQ(1u, test_output_values.size())
+                << "Output written twice during a tick";
+        EXPECT_EQ(0x000000f1u, test_output_values[0]) << "Invalid value";
+
+        SetTickCount(TEST_INITIAL_TICK_COUNT + 1u);
+        mdv_shadow_output_process(&m_shadow_output);
+        mdv_shadow_output_process(&m_shadow_output);
+
+        ASSERT_EQ(2u, test_output_values.size())
+                << "Pending changes not written on the next tick";
+        EXPECT_EQ(0x000000f3u, test_output_values[1]) << "Invalid value";
+}
+
+TEST_F(test_mdv_shadow_output, process__commit_not_limited)
+{
+        mdv_shadow_output_set(&m_shadow_output, 0x00000001u);
+        mdv_shadow_output_process(&m_shadow_output);
+        mdv_shadow_output_set(&m_shadow_output, 0x00000002u);
+        mdv_shadow_output_commit(&m_shadow_output);
+
+        EXPECT_EQ(2u, test_output_values.size())
+                << "Commit limited by the tick";
+}
+
+TEST_F(test_mdv_shadow_output, process__no_timer_base_asserted)
+{
+        mdv_shadow_output_init(&m_shadow_output, &test_output, NULL,
+                               TEST_INITIAL_VALUE);
+        mdv_shadow_output_set(&m_shadow_output, 0x00000001u);
+
+        EXPECT_DEATH(mdv_shadow_output_process(&m_shadow_output), "")
+                << "Missing timer base not asserted";
+}
+
+} // namespace
\ No newline at end of file
@@ -6,8 +6,8 @@
 #define TEST_TICK_DURATION_US 100u
 // Test mask (23-bit) for the timer counter
 #define TEST_TIMER_MASK 0x007fffffu
-// Test value for invocation limit
-#define TEST_INVOCATION_LIMIT 10000u
+// Test count of queries with a stopped timer
+#define TEST_QUERY_COUNT 10000u
 // Test value for the initial tick count
 #define TEST_TIMER_INITIAL_TICK_COUNT 1234u
 // Test value for the timer tick count
@@ -16,6 +16,12 @@
 #define TEST_TIME_IN_TICKS (TEST_TIMER_TICK_COUNT - TEST_TIMER_INITIAL_TICK_COUNT)
 // Test value for ticking the timer
 #define TEST_TIMER_TICK 10u
+// Test value for the initial extended tick count
+#define TEST_TIMER_INITIAL_TICK_COUNT64 0x123456789ull
+// Test time in ticks exceeding the 32-bit range
+#define TEST_TIME_IN_TICKS64 0x300000000ull
+// Test value for invocation limit
+#define TEST_INVOCATION_LIMIT 10000u
 
 using namespace testing;
 
@@ -28,7 +34,10 @@ class test_mdv_sw_timer : public Test
         void SetUp() override {
                 MockMdvSwTimerBase::init();
                 memset(&m_sw_timer, 0, sizeof(mdv_sw_timer_t));
+                mdv_sw_timer_conversion_init(&m_conversion,
+                                             TEST_TICK_DURATION_US);
                 m_time = 0;
+                m_time64 = 0;
 
                 static_assert(TEST_TIMER_MASK > TEST_TIMER_TICK_COUNT,
                         "Timer mask must be always greater than the counter " \
@@ -47,18 +56,18 @@ class test_mdv_sw_timer : public Test
                 Init();
                 m_sw_timer.tick_duration_us = TEST_TICK_DURATION_US;
                 m_sw_timer.timer_mask = TEST_TIMER_MASK;
+                m_sw_timer.conversion = &m_conversion;
                 m_sw_timer.tick_count_startup_sample =
                         TEST_TIMER_INITIAL_TICK_COUNT;
-                m_sw_timer.starvation_avereness.last_tick_count =
-                        TEST_TIMER_INITIAL_TICK_COUNT;
-                m_sw_timer.starvation_avereness.invocation_count = 0;
-                m_sw_timer.starvation_avereness.invocation_limit =
-                        TEST_INVOCATION_LIMIT;
+                m_sw_timer.tick_count_startup_sample64 =
+                        TEST_TIMER_INITIAL_TICK_COUNT64;
         }
 
         mdv_sw_timer_t m_sw_timer;
         mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_sw_timer_conversion_t m_conversion;
         uint32_t m_time;
+        uint64_t m_time64;
 };
 
 TEST_F(test_mdv_sw_timer,
@@ -84,6 +93,10 @@ TEST_F(test_mdv_sw_timer, init__sw_timer_initialized)
                 mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
                 .WillOnce(Return(TEST_TIMER_MASK));
 
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_conversion(&m_sw_timer_base))
+                .WillOnce(Return(&m_conversion));
+
         mdv_sw_timer_init(&m_sw_timer, &m_sw_timer_base);
 
         EXPECT_EQ(&m_sw_timer_base, m_sw_timer.sw_timer_base)
@@ -92,24 +105,30 @@ TEST_F(test_mdv_sw_timer, init__sw_timer_initialized)
                 << "Timer tick duration must be retrieved from the timer base.";
         EXPECT_EQ(TEST_TIMER_MASK, m_sw_timer.timer_mask)
                 << "Timer mask must be retrieved from the timer base.";
+        EXPECT_EQ(&m_conversion, m_sw_timer.conversion)
+                << "Conversion factors must be retrieved from the timer base.";
 }
 
 TEST_F(test_mdv_sw_timer,
         set_invocation_limit__invalid_function_parameters_cause_assertion_failure)
 {
-        EXPECT_DEATH(mdv_sw_timer_set_invocation_limit(0, TEST_INVOCATION_LIMIT), "")
+        EXPECT_DEATH(mdv_sw_timer_set_invocation_limit(0,
+                                                       TEST_INVOCATION_LIMIT),
+                     "")
                 << "If null, sw_timer must cause an assertion failure.";
 }
 
-TEST_F(test_mdv_sw_timer,
-        set_invocation_limit__successful)
+TEST_F(test_mdv_sw_timer, set_invocation_limit__timer_base_monitor_configured)
 {
         Init();
-        mdv_sw_timer_set_invocation_limit(&m_sw_timer, TEST_INVOCATION_LIMIT);
 
-        EXPECT_EQ(TEST_INVOCATION_LIMIT,
-                m_sw_timer.starvation_avereness.invocation_limit)
-                << "Invocation limit must be set to the given value.";
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_set_starvation_monitor(
+                        &m_sw_timer_base, TEST_INVOCATION_LIMIT, nullptr,
+                        nullptr))
+                .Times(1);
+
+        mdv_sw_timer_set_invocation_limit(&m_sw_timer, TEST_INVOCATION_LIMIT);
 }
 
 TEST_F(test_mdv_sw_timer,
@@ -122,20 +141,25 @@ TEST_F(test_mdv_sw_timer,
 TEST_F(test_mdv_sw_timer, start__successful)
 {
         Init();
+        m_sw_timer.timer_mask = TEST_TIMER_MASK;
 
         EXPECT_CALL(MockMdvSwTimerBase::instance(),
                 mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
-                .WillOnce(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+                .Times(0);
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_INITIAL_TICK_COUNT64));
 
         mdv_sw_timer_start(&m_sw_timer);
 
-        EXPECT_EQ(TEST_TIMER_INITIAL_TICK_COUNT,
+        EXPECT_EQ((uint32_t)TEST_TIMER_INITIAL_TICK_COUNT64 & TEST_TIMER_MASK,
                   m_sw_timer.tick_count_startup_sample)
-                << "Tick count startup value must be got from the timer base.";
-        EXPECT_EQ(TEST_TIMER_INITIAL_TICK_COUNT,
-                  m_sw_timer.starvation_avereness.last_tick_count)
-                << "The starvation avereness must be initialized with the " \
-                   " current tick count.";
+                << "Tick count startup value must be derived from the " \
+                   "extended tick count of the same sample.";
+        EXPECT_EQ(TEST_TIMER_INITIAL_TICK_COUNT64,
+                  m_sw_timer.tick_count_startup_sample64)
+                << "Extended tick count startup value must be got from the " \
+                   "timer base.";
 }
 
 TEST_F(test_mdv_sw_timer,
@@ -175,13 +199,13 @@ TEST_F(test_mdv_sw_timer, get_time__successful)
         // Get the time in milliseconds
         mdv_sw_timer_get_time(&m_sw_timer, MDV_SW_TIMER_MS, &m_time);
 
-        EXPECT_EQ(test_time_us / US_IN_ONE_MS, m_time)
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_MS, m_time)
                 << "Time must be returned correctly.";
 
         // Get the time in seconds
         mdv_sw_timer_get_time(&m_sw_timer, MDV_SW_TIMER_S, &m_time);
 
-        EXPECT_EQ(test_time_us / US_IN_ONE_SECOND, m_time)
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_SECOND, m_time)
                 << "Time must be returned correctly.";
 }
 
@@ -205,40 +229,67 @@ TEST_F(test_mdv_sw_timer, get_time__manage_tick_counter_wrap_around)
                 << "Time must be returned correctly.";
 }
 
-TEST_F(test_mdv_sw_timer, get_time__timer_is_starving_when_timer_not_counting)
+TEST_F(test_mdv_sw_timer, get_time__no_starvation_check_when_timer_not_counting)
 {
-        uint32_t test_time_us;
-
         StartTimer();
 
-        // Setup almost-starving situation
-        m_sw_timer.starvation_avereness.invocation_count =
-                TEST_INVOCATION_LIMIT - 1;
-
         EXPECT_CALL(MockMdvSwTimerBase::instance(),
                 mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
                 .WillRepeatedly(Return(TEST_TIMER_INITIAL_TICK_COUNT));
 
-        // Get the time in timer ticks
-        EXPECT_NO_FATAL_FAILURE(mdv_sw_timer_get_time(&m_sw_timer,
-                MDV_SW_TIMER_TIMERTICK, &m_time));
+        // The starvation is detected by the timer base, so querying a stopped
+        // timer repeatedly must not fail
+        for (uint32_t i = 0; i < TEST_QUERY_COUNT; i++) {
+                mdv_sw_timer_get_time(&m_sw_timer, MDV_SW_TIMER_TIMERTICK,
+                                      &m_time);
+        }
 
-        // Timer not ticked, but this is the first time. Assume that the time is
-        // zero, but the invocation counter is resetted.
         EXPECT_EQ(0, m_time)
                 << "Time must be zero when timer is not ticked.";
-        EXPECT_EQ(0, m_sw_timer.starvation_avereness.invocation_count)
-                << "Invocation counter must be reset.";
-
-        // Setup almost-starving situation again
-        m_sw_timer.starvation_avereness.invocation_count =
-                TEST_INVOCATION_LIMIT - 1;
-
-        // Get the time in timer ticks, now increasing the invocation counter
-        // to the limit
-        EXPECT_DEATH(mdv_sw_timer_get_time(&m_sw_timer,
-                MDV_SW_TIMER_TIMERTICK, &m_time), "")
-                << "If starving, the timer must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer,
+        get_time64__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_get_time64(0, MDV_SW_TIMER_MS, &m_time64), "")
+                << "If null, sw_timer must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_get_time64(&m_sw_timer, MDV_SW_TIMER_MS, 0),
+                     "")
+                << "If null, time must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer, get_time64__time_exceeding_32_bits_successful)
+{
+        uint64_t const test_time_us =
+                TEST_TICK_DURATION_US * TEST_TIME_IN_TICKS64;
+
+        StartTimer();
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                .WillRepeatedly(Return(TEST_TIMER_INITIAL_TICK_COUNT64 +
+                                       TEST_TIME_IN_TICKS64));
+
+        mdv_sw_timer_get_time64(&m_sw_timer, MDV_SW_TIMER_TIMERTICK,
+                                &m_time64);
+
+        EXPECT_EQ(TEST_TIME_IN_TICKS64, m_time64)
+                << "Time must be returned correctly.";
+
+        mdv_sw_timer_get_time64(&m_sw_timer, MDV_SW_TIMER_US, &m_time64);
+
+        EXPECT_EQ(test_time_us, m_time64)
+                << "Time must be returned correctly.";
+
+        mdv_sw_timer_get_time64(&m_sw_timer, MDV_SW_TIMER_MS, &m_time64);
+
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_MS, m_time64)
+                << "Time must be returned correctly.";
+
+        mdv_sw_timer_get_time64(&m_sw_timer, MDV_SW_TIMER_S, &m_time64);
+
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_SECOND, m_time64)
+                << "Time must be returned correctly.";
 }
 
 } // namespace
\ No newline at end of file
@@ -12,11 +12,81 @@
 #define TEST_TIMER_SYSTEM_ILIM 10000
 // Test value for ticking the timer
 #define TEST_TIMER_TICK 10
+// Test value for the stall limit of the starvation monitor
+#define TEST_STALL_LIMIT 3u
+// Test count of ticks before configuring the starvation monitor
+#define TEST_UPTIME_TICK_COUNT 10000u
+// Test value for the fractional tick period (32.768 kHz) in Q32.32 ns
+#define TEST_TICK_PERIOD_NS_Q32 MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(32768u)
+// Test value for the sub-microsecond tick period (48 MHz) in Q32.32 ns
+#define TEST_SHORT_TICK_PERIOD_NS_Q32 \
+        MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(48000000u)
+// Test value for the delay to the next deadline in the tickless mode
+#define TEST_DEADLINE_DELAY 250u
+// Test value for hardware counter width in the width extension mode
+#define TEST_COUNTER_WIDTH_BITS 16u
+// Test mask (16-bit) for the hardware counter
+#define TEST_COUNTER_MASK 0x0000ffffu
+// Test value for the period of the hardware counter
+#define TEST_COUNTER_PERIOD 0x00010000u
 
 using namespace testing;
 
 namespace{
 
+/*
+ * Record of dispatched timer base events
+ */
+struct test_event {
+        uint32_t count;
+        uint32_t tick_count;
+};
+
+void test_event_handler(void *const user_data, uint32_t const tick_count)
+{
+        test_event *event = static_cast<test_event *>(user_data);
+
+        ++event->count;
+        event->tick_count = tick_count;
+}
+
+/*
+ * Record of reported stalls
+ */
+struct test_stall {
+        uint32_t count;
+        uint64_t stall_time_us;
+};
+
+void test_starvation_handler(void *const user_data,
+                             uint64_t const stall_time_us)
+{
+        test_stall *stall = static_cast<test_stall *>(user_data);
+
+        ++stall->count;
+        stall->stall_time_us = stall_time_us;
+}
+
+/*
+ * Deadline provider returning a fixed delay
+ */
+struct test_deadline {
+        uint32_t count;
+        uint32_t tick_count;
+        uint32_t delay;
+};
+
+uint32_t test_deadline_provider(void *const user_data,
+                                uint32_t const tick_count)
+{
+        test_deadline *deadline = static_cast<test_deadline *>(user_data);
+
+        ++deadline->count;
+        deadline->tick_count = tick_count;
+
+        return deadline->delay;
+}
+
 class test_mdv_sw_timer_base : public Test
 {
         protected:
@@ -25,6 +95,8 @@ class test_mdv_sw_timer_base : public Test
                 MockMdvTimerDriver::init();
                 m_timer_driver = MockMdvTimerDriver::GetMdvTimerDriver();
                 memset(&m_sw_timer_base, 0, sizeof(mdv_sw_timer_base_t));
+                memset(&m_event, 0, sizeof(test_event));
+                memset(&m_stall, 0, sizeof(test_stall));
         }
 
         void TearDown() override {
@@ -36,8 +108,39 @@ class test_mdv_sw_timer_base : public Test
                                        TEST_TIMER_WIDTH_BITS, m_timer_driver);
         }
 
+        void InitTickless(mdv_timer_event_handler_t *const event_handler,
+                          void **const user_data) {
+                EXPECT_CALL(MockMdvTimerDriver::instance(),
+                            mdv_timer_driver_init(_, _))
+                        .WillOnce(DoAll(SaveArg<0>(event_handler),
+                                        SaveArg<1>(user_data),
+                                        Return(MDV_RESULT_OK)));
+                mdv_sw_timer_base_init_tickless(&m_sw_timer_base,
+                                                TEST_TICK_DURATION_US,
+                                                TEST_TIMER_WIDTH_BITS,
+                                                m_timer_driver);
+                mdv_sw_timer_base_set_event_handler(&m_sw_timer_base,
+                                                    test_event_handler,
+                                                    &m_event);
+        }
+
+        void InitExtended(mdv_timer_event_handler_t *const event_handler,
+                          void **const user_data) {
+                EXPECT_CALL(MockMdvTimerDriver::instance(),
+                            mdv_timer_driver_init(_, _))
+                        .WillOnce(DoAll(SaveArg<0>(event_handler),
+                                        SaveArg<1>(user_data),
+                                        Return(MDV_RESULT_OK)));
+                mdv_sw_timer_base_init_extended(&m_sw_timer_base,
+                                                TEST_TICK_DURATION_US,
+                                                TEST_COUNTER_WIDTH_BITS,
+                                                m_timer_driver);
+        }
+
         mdv_sw_timer_base_t m_sw_timer_base;
         mdv_timer_driver_t *m_timer_driver;
+        test_event m_event;
+        test_stall m_stall;
 };
 
 TEST_F(test_mdv_sw_timer_base,
@@ -85,6 +188,12 @@ TEST_F(test_mdv_sw_timer_base, init__sw_timer_base_initialized)
         EXPECT_EQ(m_timer_driver, m_sw_timer_base.timer_driver)
                 << "The pointer to the timer driver must be set to the given " \
                    "value.";
+        EXPECT_EQ(TEST_TIMER_TICK * TEST_TICK_DURATION_US /
+                  MDV_SW_TIMER_US_IN_ONE_MS,
+                  mdv_sw_timer_conversion_get_time(&m_sw_timer_base.conversion,
+                                                   TEST_TIMER_TICK,
+                                                   MDV_SW_TIMER_MS))
+                << "Conversion factors must be computed for the tick duration.";
 }
 
 TEST_F(test_mdv_sw_timer_base,
@@ -99,6 +208,175 @@ TEST_F(test_mdv_sw_timer_base,
                                TEST_TIMER_WIDTH_BITS, 0);
 }
 
+TEST_F(test_mdv_sw_timer_base,
+       init_period__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_init_period(0, TEST_TICK_PERIOD_NS_Q32,
+                                                   TEST_TIMER_WIDTH_BITS,
+                                                   m_timer_driver), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_period(&m_sw_timer_base, 0,
+                                                   TEST_TIMER_WIDTH_BITS,
+                                                   m_timer_driver), "")
+                << "If zero, tick_period_ns_q32 must cause an assertion " \
+                   "failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_period(&m_sw_timer_base,
+                                                   TEST_TICK_PERIOD_NS_Q32, 0,
+                                                   m_timer_driver), "")
+                << "If null, timer_width parameter must cause an assertion " \
+                   "failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base, init_period__sw_timer_base_initialized)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_init(0, 0))
+                .WillOnce(Return(MDV_RESULT_OK));
+
+        mdv_sw_timer_base_init_period(&m_sw_timer_base, TEST_TICK_PERIOD_NS_Q32,
+                                      TEST_TIMER_WIDTH_BITS, m_timer_driver);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_POLLING, m_sw_timer_base.mode)
+                << "Timer base must be in the polling mode.";
+        EXPECT_EQ(TEST_TIMER_MASK, m_sw_timer_base.timer_mask)
+                << "Valid test mask must be created for the timer counter.";
+        EXPECT_EQ(TEST_TICK_PERIOD_NS_Q32, m_sw_timer_base.tick_period_ns_q32)
+                << "Tick period must be initialized with the given value.";
+        EXPECT_EQ(30u, m_sw_timer_base.tick_duration_us)
+                << "Tick duration must be the period rounded down.";
+        EXPECT_EQ(1000u,
+                  mdv_sw_timer_conversion_get_time(&m_sw_timer_base.conversion,
+                                                   32768u, MDV_SW_TIMER_MS))
+                << "Conversion factors must be computed for the tick period.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_period__sub_microsecond_period_converted_exactly)
+{
+        mdv_sw_timer_base_init_period(&m_sw_timer_base,
+                                      TEST_SHORT_TICK_PERIOD_NS_Q32,
+                                      TEST_TIMER_WIDTH_BITS, 0);
+
+        EXPECT_EQ(0u, mdv_sw_timer_base_get_tick_duration_us(&m_sw_timer_base))
+                << "The deprecated tick duration must be the period rounded " \
+                   "down.";
+        EXPECT_EQ(1000u,
+                  mdv_sw_timer_conversion_get_time(&m_sw_timer_base.conversion,
+                                                   48000u, MDV_SW_TIMER_US))
+                << "Conversion factors must be computed for the tick period.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init__whole_microseconds_use_integer_conversion)
+{
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        EXPECT_FALSE(m_sw_timer_base.conversion.is_fractional)
+                << "A tick duration in microseconds must use the exact " \
+                   "integer conversion factors.";
+        EXPECT_EQ(TEST_TICK_DURATION_US,
+                  mdv_sw_timer_base_get_tick_duration_us(&m_sw_timer_base))
+                << "The tick duration must be kept.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_event_driven_period__timer_driver_initialized_with_event_handler)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_init(handle_timer_event, &m_sw_timer_base))
+                .WillOnce(Return(MDV_RESULT_OK));
+
+        mdv_sw_timer_base_init_event_driven_period(&m_sw_timer_base,
+                                                   TEST_TICK_PERIOD_NS_Q32,
+                                                   TEST_TIMER_WIDTH_BITS,
+                                                   m_timer_driver);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_EVENT, m_sw_timer_base.mode)
+                << "Timer base must be in the event driven mode.";
+        EXPECT_EQ(TEST_TICK_PERIOD_NS_Q32,
+                  mdv_sw_timer_base_get_tick_period_ns_q32(&m_sw_timer_base))
+                << "Tick period must be initialized with the given value.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_event_driven__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_init_event_driven(0,
+                        TEST_TICK_DURATION_US, TEST_TIMER_WIDTH_BITS,
+                        m_timer_driver), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_event_driven(&m_sw_timer_base,
+                        TEST_TICK_DURATION_US, TEST_TIMER_WIDTH_BITS, 0), "")
+                << "If null, timer_driver must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_event_driven__timer_driver_initialized_with_event_handler)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_init(handle_timer_event, &m_sw_timer_base))
+                .WillOnce(Return(MDV_RESULT_OK));
+
+        mdv_sw_timer_base_init_event_driven(&m_sw_timer_base,
+                                            TEST_TICK_DURATION_US,
+                                            TEST_TIMER_WIDTH_BITS,
+                                            m_timer_driver);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_EVENT, m_sw_timer_base.mode)
+                << "Timer base must be in the event driven mode.";
+        EXPECT_EQ(TEST_TIMER_MASK, m_sw_timer_base.timer_mask)
+                << "Valid test mask must be created for the timer counter.";
+        EXPECT_EQ(m_timer_driver, m_sw_timer_base.timer_driver)
+                << "The pointer to the timer driver must be set to the given " \
+                   "value.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_event_driven__tick_count_read_from_memory_and_event_dispatched)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        uint32_t tick_count;
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_init(_, _))
+                .WillOnce(DoAll(SaveArg<0>(&event_handler),
+                                SaveArg<1>(&user_data),
+                                Return(MDV_RESULT_OK)));
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .Times(0);
+
+        mdv_sw_timer_base_init_event_driven(&m_sw_timer_base,
+                                            TEST_TICK_DURATION_US,
+                                            TEST_TIMER_WIDTH_BITS,
+                                            m_timer_driver);
+        mdv_sw_timer_base_set_event_handler(&m_sw_timer_base,
+                                            test_event_handler, &m_event);
+
+        ASSERT_TRUE(event_handler)
+                << "Event handler must be given to the timer driver.";
+
+        // Simulate a timer event with a counter exceeding the timer width
+        event_handler(user_data, TEST_TIMER_MASK + 1u + TEST_TIMER_TICK);
+
+        tick_count = mdv_sw_timer_base_get_tick_count(&m_sw_timer_base);
+
+        EXPECT_EQ(TEST_TIMER_TICK, tick_count)
+                << "The tick count must be stored from the event and limited " \
+                   "by the timer mask.";
+        EXPECT_EQ(1u, m_event.count)
+                << "The event must be dispatched to the event handler.";
+        EXPECT_EQ(TEST_TIMER_TICK, m_event.tick_count)
+                << "The event handler must receive the current tick count.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       set_event_handler__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_set_event_handler(0, test_event_handler,
+                                                         &m_event), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
 TEST_F(test_mdv_sw_timer_base,
        uninit__invalid_function_parameters_cause_assertion_failure)
 {
@@ -160,6 +438,21 @@ TEST_F(test_mdv_sw_timer_base,
                    "maximum value.";
 }
 
+TEST_F(test_mdv_sw_timer_base, tick__event_dispatched_on_tick)
+{
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_base_set_event_handler(&m_sw_timer_base,
+                                            test_event_handler, &m_event);
+
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+
+        EXPECT_EQ(1u, m_event.count)
+                << "The event must be dispatched on each tick.";
+        EXPECT_EQ(TEST_TIMER_TICK, m_event.tick_count)
+                << "The event handler must receive the current tick count.";
+}
+
 TEST_F(test_mdv_sw_timer_base,
        get_tick_count__invalid_function_parameters_cause_assertion_failure)
 {
@@ -199,6 +492,367 @@ TEST_F(test_mdv_sw_timer_base,
                     "counter variable, when the timer driver is not present.";
 }
 
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_count64__invalid_function_parameters_cause_assertion_failure)
+{
+        Init();
+
+        EXPECT_DEATH(mdv_sw_timer_base_get_tick_count64(0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_count64__tick_count_not_wrapped_around_in_tick_mode)
+{
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        // Advance the tick counter over the timer width
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_MASK);
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+
+        EXPECT_EQ(TEST_TIMER_TICK - 1u,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must wrap around at the timer width.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must not wrap around.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_count64__wrap_arounds_tracked_in_polling_mode)
+{
+        Init();
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillOnce(Return(TEST_TIMER_TICK))
+                .WillOnce(Return(TEST_TIMER_MASK - 5u))
+                .WillOnce(Return(4u));
+
+        EXPECT_EQ((uint64_t)TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must follow the timer driver.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK - 5u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must follow the timer driver.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + 5u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must continue over the " \
+                   "wrap-around of the timer driver.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_count64__wrap_arounds_tracked_in_event_driven_mode)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_init(_, _))
+                .WillOnce(DoAll(SaveArg<0>(&event_handler),
+                                SaveArg<1>(&user_data),
+                                Return(MDV_RESULT_OK)));
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .Times(0);
+
+        mdv_sw_timer_base_init_event_driven(&m_sw_timer_base,
+                                            TEST_TICK_DURATION_US,
+                                            TEST_TIMER_WIDTH_BITS,
+                                            m_timer_driver);
+
+        ASSERT_TRUE(event_handler)
+                << "Event handler must be given to the timer driver.";
+
+        event_handler(user_data, TEST_TIMER_MASK);
+        event_handler(user_data, TEST_TIMER_TICK);
+
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + 1u + TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must continue over the " \
+                   "wrap-around of the timer driver.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       set_snapshot_mode__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_set_snapshot_mode(0, true), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       latch__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_latch(0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       latch__timer_driver_read_once_per_latch_in_snapshot_mode)
+{
+        Init();
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillOnce(Return(TEST_TIMER_TICK))
+                .WillOnce(Return(TEST_TIMER_TICK * 2u));
+
+        mdv_sw_timer_base_set_snapshot_mode(&m_sw_timer_base, true);
+
+        for (uint32_t i = 0; i < TEST_TIMER_TICK; i++) {
+                ASSERT_EQ(TEST_TIMER_TICK,
+                          mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        << "The latched tick count must be returned without " \
+                           "reading the timer driver.";
+                ASSERT_EQ((uint64_t)TEST_TIMER_TICK,
+                          mdv_sw_timer_base_get_tick_count64(
+                                  &m_sw_timer_base))
+                        << "The latched extended tick count must be " \
+                           "returned without reading the timer driver.";
+        }
+
+        EXPECT_EQ(TEST_TIMER_TICK * 2u,
+                  mdv_sw_timer_base_latch(&m_sw_timer_base))
+                << "The latch must return the latched tick count.";
+        EXPECT_EQ(TEST_TIMER_TICK * 2u,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must be updated by the latch.";
+}
+
+TEST_F(test_mdv_sw_timer_base, latch__tick_count_frozen_in_snapshot_mode)
+{
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_MASK);
+
+        mdv_sw_timer_base_set_snapshot_mode(&m_sw_timer_base, true);
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+
+        EXPECT_EQ(TEST_TIMER_MASK,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must not advance until latched.";
+
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+
+        EXPECT_EQ(TEST_TIMER_TICK - 1u,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The latched tick count must be limited by the timer mask.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The latched extended tick count must match the tick count.";
+
+        mdv_sw_timer_base_set_snapshot_mode(&m_sw_timer_base, false);
+        mdv_sw_timer_base_tick(&m_sw_timer_base, 1u);
+
+        EXPECT_EQ(TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The live tick count must be returned when the snapshot " \
+                   "mode is disabled.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       set_starvation_monitor__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_set_starvation_monitor(
+                0, TEST_STALL_LIMIT, test_starvation_handler, &m_stall), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_starvation_status__invalid_function_parameters_cause_assertion_failure)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        EXPECT_DEATH(mdv_sw_timer_base_get_starvation_status(0, &status), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base,
+                                                             0), "")
+                << "If null, status must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base, latch__starvation_not_monitored_by_default)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT * 2u; i++) {
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_FALSE(status.is_starving)
+                << "The starvation must not be detected when not monitored.";
+        EXPECT_EQ(0u, status.stall_count)
+                << "The stall must not be counted when not monitored.";
+        EXPECT_EQ(0u, status.stall_time_us)
+                << "The stall time must be zero when not monitored.";
+}
+
+TEST_F(test_mdv_sw_timer_base, latch__starvation_reported_once_per_stall)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_base_set_starvation_monitor(&m_sw_timer_base,
+                                                 TEST_STALL_LIMIT,
+                                                 test_starvation_handler,
+                                                 &m_stall);
+
+        // The counter advances between the latches
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT * 2u; i++) {
+                mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_FALSE(status.is_starving)
+                << "An advancing counter must not be starving.";
+        EXPECT_EQ(0u, m_stall.count)
+                << "An advancing counter must not be reported.";
+
+        // The counter stops
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT - 1u; i++) {
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_FALSE(status.is_starving)
+                << "The starvation must not be detected below the limit.";
+        EXPECT_EQ(TEST_STALL_LIMIT - 1u, status.stall_count)
+                << "Each stalled latch must lengthen the stall.";
+        EXPECT_EQ(0u, m_stall.count)
+                << "The stall must not be reported below the limit.";
+
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_TRUE(status.is_starving)
+                << "The starvation must be detected at the limit.";
+        EXPECT_EQ(TEST_STALL_LIMIT + 1u, status.stall_count)
+                << "The stall must be counted beyond the limit.";
+        EXPECT_EQ((uint64_t)(TEST_STALL_LIMIT + 1u) * TEST_TIMER_TICK *
+                  TEST_TICK_DURATION_US, status.stall_time_us)
+                << "The stall time must be estimated from the ticks per " \
+                   "latch before the stall.";
+        EXPECT_EQ(1u, m_stall.count)
+                << "The stall must be reported once.";
+        EXPECT_EQ((uint64_t)TEST_STALL_LIMIT * TEST_TIMER_TICK *
+                  TEST_TICK_DURATION_US, m_stall.stall_time_us)
+                << "The stall time at the limit must be reported.";
+
+        // The counter runs again
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_FALSE(status.is_starving)
+                << "The starvation must end when the counter advances.";
+        EXPECT_EQ(0u, status.stall_count)
+                << "The stall must end when the counter advances.";
+        EXPECT_EQ(0u, status.stall_time_us)
+                << "The stall time must end when the counter advances.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       latch__stall_time_not_affected_by_uptime_before_monitoring)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        // The timer base runs for a while without being latched
+        for (uint32_t i = 0; i < TEST_UPTIME_TICK_COUNT; i++) {
+                mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+        }
+
+        mdv_sw_timer_base_set_starvation_monitor(&m_sw_timer_base,
+                                                 TEST_STALL_LIMIT,
+                                                 test_starvation_handler,
+                                                 &m_stall);
+
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT; i++) {
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_TRUE(status.is_starving)
+                << "The starvation must be detected at the limit.";
+        EXPECT_EQ((uint64_t)TEST_STALL_LIMIT * TEST_TIMER_TICK *
+                  TEST_TICK_DURATION_US, m_stall.stall_time_us)
+                << "The ticks before configuring the monitor must not be " \
+                   "counted to the first advance.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       latch__stall_time_estimated_from_sparse_advances)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+        mdv_sw_timer_base_set_starvation_monitor(&m_sw_timer_base,
+                                                 TEST_STALL_LIMIT, 0, 0);
+
+        // The counter advances once per two latches, so one latch takes half
+        // a tick advance
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+        mdv_sw_timer_base_tick(&m_sw_timer_base, TEST_TIMER_TICK);
+        mdv_sw_timer_base_latch(&m_sw_timer_base);
+
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT; i++) {
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_TRUE(status.is_starving)
+                << "The starvation must be detected at the limit.";
+        EXPECT_EQ((uint64_t)TEST_STALL_LIMIT * (TEST_TIMER_TICK / 2u) *
+                  TEST_TICK_DURATION_US, status.stall_time_us)
+                << "The advance must be shared by the latches since the " \
+                   "previous advance.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       latch__starvation_detected_without_handler_in_polling_mode)
+{
+        mdv_sw_timer_base_starvation_status_t status;
+
+        // The counter advances once after the monitor has been configured
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillOnce(Return(0))
+                .WillRepeatedly(Return(TEST_TIMER_TICK));
+
+        Init();
+        mdv_sw_timer_base_set_starvation_monitor(&m_sw_timer_base,
+                                                 TEST_STALL_LIMIT, 0, 0);
+
+        for (uint32_t i = 0; i < TEST_STALL_LIMIT + 1u; i++) {
+                mdv_sw_timer_base_latch(&m_sw_timer_base);
+        }
+
+        mdv_sw_timer_base_get_starvation_status(&m_sw_timer_base, &status);
+
+        EXPECT_TRUE(status.is_starving)
+                << "A stopped hardware counter must be detected.";
+        EXPECT_EQ(TEST_STALL_LIMIT, status.stall_count)
+                << "The first latch must see the counter advanced.";
+        EXPECT_EQ((uint64_t)TEST_STALL_LIMIT * TEST_TIMER_TICK *
+                  TEST_TICK_DURATION_US, status.stall_time_us)
+                << "The stall time must be estimated from the first advance.";
+}
+
 TEST_F(test_mdv_sw_timer_base,
        get_tick_duration_us__invalid_function_parameters_cause_assertion_failure)
 {
@@ -221,6 +875,48 @@ TEST_F(test_mdv_sw_timer_base,
                 << "The tick duration must be returned.";
 }
 
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_period_ns_q32__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_get_tick_period_ns_q32(0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_period_ns_q32__value_derived_from_tick_duration)
+{
+        Init();
+
+        EXPECT_EQ((uint64_t)TEST_TICK_DURATION_US * 1000u << 32,
+                  mdv_sw_timer_base_get_tick_period_ns_q32(&m_sw_timer_base))
+                << "The tick period must match the tick duration.";
+
+        EXPECT_DEATH(mdv_sw_timer_base_init(
+                             &m_sw_timer_base,
+                             MDV_SW_TIMER_BASE_MAX_TICK_DURATION_US + 1u,
+                             TEST_TIMER_WIDTH_BITS, 0), "")
+                << "A tick duration which doesn't fit the tick period must " \
+                   "cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_conversion__invalid_function_parameters_cause_assertion_failure)
+{
+        Init();
+
+        EXPECT_DEATH(mdv_sw_timer_base_get_conversion(0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base, get_conversion__value_returned_successfully)
+{
+        Init();
+
+        EXPECT_EQ(&m_sw_timer_base.conversion,
+                  mdv_sw_timer_base_get_conversion(&m_sw_timer_base))
+                << "The conversion factors must be returned.";
+}
+
 TEST_F(test_mdv_sw_timer_base,
        get_timer_mask__invalid_function_parameters_cause_assertion_failure)
 {
@@ -243,4 +939,394 @@ TEST_F(test_mdv_sw_timer_base,
                 << "The timer mask must be returned.";
 }
 
+TEST_F(test_mdv_sw_timer_base,
+       init_tickless__invalid_function_parameters_cause_assertion_failure)
+{
+        mdv_timer_driver_t no_compare_driver = {
+                m_timer_driver->init, m_timer_driver->uninit,
+                m_timer_driver->start, m_timer_driver->stop,
+                m_timer_driver->reset, m_timer_driver->get_count,
+                m_timer_driver->is_running, 0
+        };
+
+        EXPECT_DEATH(mdv_sw_timer_base_init_tickless(0, TEST_TICK_DURATION_US,
+                                                     TEST_TIMER_WIDTH_BITS,
+                                                     m_timer_driver), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_tickless(&m_sw_timer_base,
+                                                     TEST_TICK_DURATION_US,
+                                                     TEST_TIMER_WIDTH_BITS,
+                                                     0), "")
+                << "If null, timer_driver must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_tickless(&m_sw_timer_base,
+                                                     TEST_TICK_DURATION_US,
+                                                     TEST_TIMER_WIDTH_BITS,
+                                                     &no_compare_driver), "")
+                << "Timer driver without the compare value must cause an " \
+                   "assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_tickless__first_wake_up_programmed_at_half_period)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare((TEST_TIMER_MASK >> 1u) + 1u))
+                .Times(1);
+
+        InitTickless(&event_handler, &user_data);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_TICKLESS, m_sw_timer_base.mode)
+                << "Timer base must be in the tickless mode.";
+        EXPECT_TRUE(event_handler)
+                << "Event handler must be given to the timer driver.";
+        EXPECT_EQ(&m_sw_timer_base, user_data)
+                << "Timer base must be given as the user data.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_tickless_period__first_wake_up_programmed_at_half_period)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_init(_, _))
+                .WillOnce(Return(MDV_RESULT_OK));
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare((TEST_TIMER_MASK >> 1u) + 1u))
+                .Times(1);
+
+        mdv_sw_timer_base_init_tickless_period(&m_sw_timer_base,
+                                               TEST_TICK_PERIOD_NS_Q32,
+                                               TEST_TIMER_WIDTH_BITS,
+                                               m_timer_driver);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_TICKLESS, m_sw_timer_base.mode)
+                << "Timer base must be in the tickless mode.";
+        EXPECT_EQ(TEST_TICK_PERIOD_NS_Q32,
+                  mdv_sw_timer_base_get_tick_period_ns_q32(&m_sw_timer_base))
+                << "Tick period must be initialized with the given value.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       tickless_event__skipped_ticks_credited_and_next_deadline_programmed)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        test_deadline deadline = { 0, 0, TEST_DEADLINE_DELAY };
+        uint32_t const counter = TEST_TIMER_MASK - 5u;
+
+        InitTickless(&event_handler, &user_data);
+        mdv_sw_timer_base_set_deadline_provider(&m_sw_timer_base,
+                                                test_deadline_provider,
+                                                &deadline);
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .WillRepeatedly(Return(counter));
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare((counter +
+                                                  TEST_DEADLINE_DELAY) &
+                                                 TEST_TIMER_MASK))
+                .Times(1);
+
+        event_handler(user_data, counter);
+
+        EXPECT_EQ((uint64_t)counter,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "All the ticks since the previous event must be credited.";
+        EXPECT_EQ(1u, m_event.count)
+                << "The event must be dispatched once.";
+        EXPECT_EQ(counter, m_event.tick_count)
+                << "The event handler must receive the current tick count.";
+        EXPECT_EQ(1u, deadline.count)
+                << "The deadline must be asked once.";
+        EXPECT_EQ(counter, deadline.tick_count)
+                << "The deadline provider must receive the current tick count.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       tickless_event__deadline_limited_to_half_period)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        test_deadline deadline = { 0, 0, MDV_SW_TIMER_BASE_NO_DEADLINE };
+
+        InitTickless(&event_handler, &user_data);
+        mdv_sw_timer_base_set_deadline_provider(&m_sw_timer_base,
+                                                test_deadline_provider,
+                                                &deadline);
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .WillRepeatedly(Return(TEST_TIMER_TICK));
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare(TEST_TIMER_TICK +
+                                                 (TEST_TIMER_MASK >> 1u) + 1u))
+                .Times(1);
+
+        event_handler(user_data, TEST_TIMER_TICK);
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       tickless_event__deadline_passed_while_programming_handled_at_once)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        test_deadline deadline = { 0, 0, TEST_DEADLINE_DELAY };
+
+        InitTickless(&event_handler, &user_data);
+        mdv_sw_timer_base_set_deadline_provider(&m_sw_timer_base,
+                                                test_deadline_provider,
+                                                &deadline);
+
+        // The counter passes the first programmed compare value before it is
+        // read back
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .WillOnce(Return(TEST_TIMER_TICK + TEST_DEADLINE_DELAY))
+                .WillRepeatedly(Return(TEST_TIMER_TICK + TEST_DEADLINE_DELAY +
+                                       1u));
+
+        event_handler(user_data, TEST_TIMER_TICK);
+
+        EXPECT_EQ(2u, m_event.count)
+                << "The passed deadline must be dispatched right away.";
+        EXPECT_EQ(TEST_TIMER_TICK + TEST_DEADLINE_DELAY, m_event.tick_count)
+                << "The event handler must receive the tick count read back.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       get_tick_count__tickless_mode_reads_timer_hardware)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+
+        InitTickless(&event_handler, &user_data);
+
+        ON_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillByDefault(Return(TEST_TIMER_MASK));
+        event_handler(user_data, TEST_TIMER_MASK);
+
+        // The counter wraps around after the latest wake-up
+        ON_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillByDefault(Return(TEST_TIMER_TICK));
+
+        EXPECT_EQ((uint32_t)TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must be read from the timer hardware.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + 1u + TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The ticks since the latest wake-up must be added to the " \
+                   "extended tick count.";
+        EXPECT_EQ((uint32_t)TEST_TIMER_TICK,
+                  mdv_sw_timer_base_latch(&m_sw_timer_base))
+                << "The latched tick count must include the ticks since " \
+                   "the latest wake-up.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       update_deadline__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_update_deadline(0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_set_deadline_provider(
+                             0, test_deadline_provider, 0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base, update_deadline__deadline_reprogrammed)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        test_deadline deadline = { 0, 0, TEST_DEADLINE_DELAY };
+
+        InitTickless(&event_handler, &user_data);
+        mdv_sw_timer_base_set_deadline_provider(&m_sw_timer_base,
+                                                test_deadline_provider,
+                                                &deadline);
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .WillRepeatedly(Return(TEST_TIMER_TICK));
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare(TEST_TIMER_TICK +
+                                                 TEST_DEADLINE_DELAY))
+                .Times(1);
+
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        EXPECT_EQ(1u, deadline.count)
+                << "The deadline must be asked once.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_TICK, m_sw_timer_base.tick_counter64)
+                << "The elapsed ticks must be credited.";
+}
+
+TEST_F(test_mdv_sw_timer_base, update_deadline__no_effect_in_other_modes)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_set_compare(_))
+                .Times(0);
+
+        Init();
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_extended__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_base_init_extended(0, TEST_TICK_DURATION_US,
+                                                     TEST_COUNTER_WIDTH_BITS,
+                                                     m_timer_driver), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_extended(&m_sw_timer_base,
+                                                     TEST_TICK_DURATION_US,
+                                                     TEST_COUNTER_WIDTH_BITS,
+                                                     0), "")
+                << "If null, timer_driver must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_extended(&m_sw_timer_base,
+                                                     TEST_TICK_DURATION_US, 0,
+                                                     m_timer_driver), "")
+                << "If null, counter_width_bits must cause an assertion " \
+                   "failure.";
+        EXPECT_DEATH(mdv_sw_timer_base_init_extended(&m_sw_timer_base,
+                                                     TEST_TICK_DURATION_US, 32,
+                                                     m_timer_driver), "")
+                << "If 32 or greater, counter_width_bits must cause an " \
+                   "assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_extended__timer_width_extended_to_32_bits)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+
+        InitExtended(&event_handler, &user_data);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_EXTENDED, m_sw_timer_base.mode)
+                << "Timer base must be in the width extension mode.";
+        EXPECT_EQ(0xffffffffu,
+                  mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                << "Software timers must see the full 32-bit width.";
+        EXPECT_EQ(TEST_COUNTER_MASK, m_sw_timer_base.counter_mask)
+                << "Counter mask must be created for the hardware counter.";
+        EXPECT_TRUE(event_handler)
+                << "Overflow handler must be given to the timer driver.";
+        EXPECT_EQ(&m_sw_timer_base, user_data)
+                << "Timer base must be given as the user data.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       init_extended_period__timer_width_extended_to_32_bits)
+{
+        EXPECT_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_init(_, _))
+                .WillOnce(Return(MDV_RESULT_OK));
+
+        mdv_sw_timer_base_init_extended_period(&m_sw_timer_base,
+                                               TEST_TICK_PERIOD_NS_Q32,
+                                               TEST_COUNTER_WIDTH_BITS,
+                                               m_timer_driver);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_MODE_EXTENDED, m_sw_timer_base.mode)
+                << "Timer base must be in the width extension mode.";
+        EXPECT_EQ(0xffffffffu,
+                  mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                << "Software timers must see the full 32-bit width.";
+        EXPECT_EQ(TEST_TICK_PERIOD_NS_Q32,
+                  mdv_sw_timer_base_get_tick_period_ns_q32(&m_sw_timer_base))
+                << "Tick period must be initialized with the given value.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       extended__overflow_events_extend_tick_count_beyond_32_bits)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        uint64_t const overflow_count = 70000u;
+        uint64_t const expected = overflow_count * TEST_COUNTER_PERIOD +
+                                  TEST_TIMER_TICK;
+
+        InitExtended(&event_handler, &user_data);
+
+        ON_CALL(MockMdvTimerDriver::instance(), mdv_timer_driver_get_count())
+                .WillByDefault(Return(TEST_TIMER_TICK));
+
+        EXPECT_EQ((uint32_t)TEST_TIMER_TICK,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must equal to the hardware counter before " \
+                   "the first overflow.";
+
+        // The count passes 2^32 ticks without any reads in between
+        for (uint64_t i = 0; i < overflow_count; i++) {
+                event_handler(user_data, 0);
+        }
+
+        EXPECT_EQ(expected,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "Each overflow must add one counter period to the " \
+                   "extended tick count.";
+        EXPECT_EQ((uint32_t)expected,
+                  mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                << "The tick count must hold the lowest 32 bits of the " \
+                   "extended tick count.";
+        EXPECT_EQ((uint32_t)expected, mdv_sw_timer_base_latch(&m_sw_timer_base))
+                << "The latched tick count must be extended as well.";
+}
+
+TEST_F(test_mdv_sw_timer_base, extended__overflow_during_read_retried)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+        uint32_t reads = 0;
+
+        InitExtended(&event_handler, &user_data);
+
+        // The overflow event is handled between reading the high part and
+        // the hardware counter
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .Times(2)
+                .WillRepeatedly(Invoke([&]() {
+                        if (!reads++) {
+                                event_handler(user_data, 1u);
+                        }
+                        return reads;
+                }));
+
+        EXPECT_EQ((uint64_t)TEST_COUNTER_PERIOD + 2u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The read must be retried after the overflow event.";
+}
+
+TEST_F(test_mdv_sw_timer_base,
+       extended__pending_overflow_credited_by_monotonic_guard)
+{
+        mdv_timer_event_handler_t event_handler = 0;
+        void *user_data = 0;
+
+        InitExtended(&event_handler, &user_data);
+
+        EXPECT_CALL(MockMdvTimerDriver::instance(),
+                    mdv_timer_driver_get_count())
+                .WillOnce(Return(TEST_COUNTER_MASK - 1u))
+                .WillOnce(Return(5u))
+                .WillOnce(Return(7u));
+
+        EXPECT_EQ((uint64_t)TEST_COUNTER_MASK - 1u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The tick count must equal to the hardware counter before " \
+                   "the first overflow.";
+
+        // The counter has overflowed, but the overflow event is pending
+        EXPECT_EQ((uint64_t)TEST_COUNTER_PERIOD + 5u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The pending overflow must be credited.";
+
+        event_handler(user_data, 6u);
+
+        EXPECT_EQ((uint64_t)TEST_COUNTER_PERIOD + 7u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The overflow must not be credited twice.";
+}
+
 } // namespace
\ No newline at end of file
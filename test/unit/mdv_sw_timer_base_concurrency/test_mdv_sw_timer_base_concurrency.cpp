@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "mdv_sw_timer_base.c"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test value for timer width in bits
+#define TEST_TIMER_WIDTH_BITS 16u
+// Test mask (16-bit) for the timer counter
+#define TEST_TIMER_MASK 0x0000ffffu
+// Test extended tick count close to the 32-bit boundary
+#define TEST_TICK_COUNT64_START 0xfffe0000ull
+// Test count of updates by the writer
+#define TEST_UPDATE_COUNT 200000u
+// Test count of reader threads
+#define TEST_READER_COUNT 3u
+// Test count of counter updates between yielding the writer
+#define TEST_YIELD_INTERVAL 256u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Timer driver which only captures the event handler
+ */
+mdv_timer_event_handler_t test_event_handler;
+void *test_event_user_data;
+
+mdv_result_t test_driver_init(mdv_timer_event_handler_t const event_handler,
+                              void *const user_data)
+{
+        test_event_handler = event_handler;
+        test_event_user_data = user_data;
+
+        return MDV_RESULT_OK;
+}
+
+mdv_timer_driver_t test_timer_driver = {
+        test_driver_init, 0, 0, 0, 0, 0, 0, 0
+};
+
+/*
+ * Timer driver which returns the counter advanced by the test
+ */
+std::atomic<uint32_t> test_counter;
+
+uint32_t test_driver_get_count(void)
+{
+        return test_counter.load();
+}
+
+mdv_timer_driver_t test_polling_driver = {
+        test_driver_init, 0, 0, 0, 0, test_driver_get_count, 0, 0
+};
+
+class test_mdv_sw_timer_base_concurrency : public Test
+{
+        protected:
+
+        void SetUp() override {
+                memset(&m_sw_timer_base, 0, sizeof(mdv_sw_timer_base_t));
+                m_done = false;
+                m_failures = 0;
+        }
+
+        /*
+         * Reads the tick counts concurrently with the writer, and checks
+         * that the extended tick count is monotonic and consistent with the
+         * tick count.
+         */
+        void Reader() {
+                uint64_t previous = 0;
+                uint64_t before;
+                uint64_t after;
+                uint32_t tick_count;
+
+                while (!m_done.load(std::memory_order_relaxed)) {
+                        before = mdv_sw_timer_base_get_tick_count64(
+                                &m_sw_timer_base);
+                        tick_count = mdv_sw_timer_base_get_tick_count(
+                                &m_sw_timer_base);
+                        after = mdv_sw_timer_base_get_tick_count64(
+                                &m_sw_timer_base);
+
+                        // The tick count is stored before the extended tick
+                        // count is published, so it can be one update ahead
+                        if ((before < previous) || (after < before) ||
+                            (((tick_count - (uint32_t)before) &
+                              TEST_TIMER_MASK) > (after - before + 1u))) {
+                                ++m_failures;
+                        }
+
+                        previous = after;
+                }
+        }
+
+        void RunReaders(std::function<void()> const &writer) {
+                std::vector<std::thread> readers;
+
+                for (uint32_t i = 0; i < TEST_READER_COUNT; i++) {
+                        readers.emplace_back([this] { Reader(); });
+                }
+
+                writer();
+
+                m_done = true;
+
+                for (auto &reader : readers) {
+                        reader.join();
+                }
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        std::atomic<bool> m_done;
+        std::atomic<uint32_t> m_failures;
+};
+
+TEST_F(test_mdv_sw_timer_base_concurrency,
+       tick__readers_see_consistent_tick_counts)
+{
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        // Start close to the 32-bit boundary to catch torn 64-bit reads
+        m_sw_timer_base.tick_counter64 = TEST_TICK_COUNT64_START;
+        m_sw_timer_base.tick_counter = (uint32_t)TEST_TICK_COUNT64_START &
+                                       TEST_TIMER_MASK;
+        publish_tick_count64(&m_sw_timer_base);
+
+        RunReaders([this] {
+                for (uint32_t i = 0; i < TEST_UPDATE_COUNT; i++) {
+                        mdv_sw_timer_base_tick(&m_sw_timer_base, 1u);
+                }
+        });
+
+        EXPECT_EQ(0u, m_failures.load())
+                << "Readers must never see torn or decreasing tick counts.";
+        EXPECT_EQ(TEST_TICK_COUNT64_START + TEST_UPDATE_COUNT,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "No tick may be lost.";
+}
+
+TEST_F(test_mdv_sw_timer_base_concurrency,
+       event__readers_see_consistent_tick_counts)
+{
+        mdv_sw_timer_base_init_event_driven(&m_sw_timer_base,
+                                            TEST_TICK_DURATION_US,
+                                            TEST_TIMER_WIDTH_BITS,
+                                            &test_timer_driver);
+
+        ASSERT_TRUE(test_event_handler)
+                << "Event handler must be given to the timer driver.";
+
+        RunReaders([] {
+                // The counter wraps around the timer width several times
+                for (uint32_t i = 1; i <= TEST_UPDATE_COUNT; i++) {
+                        test_event_handler(test_event_user_data, i);
+                }
+        });
+
+        EXPECT_EQ(0u, m_failures.load())
+                << "Readers must never see torn or decreasing tick counts.";
+        EXPECT_EQ((uint64_t)TEST_UPDATE_COUNT,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "No counter wrap-around may be lost.";
+}
+
+TEST_F(test_mdv_sw_timer_base_concurrency,
+       polling__readers_see_consistent_tick_counts)
+{
+        test_counter = 0;
+
+        mdv_sw_timer_base_init(&m_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS, &test_polling_driver);
+
+        RunReaders([this] {
+                // Every reader updates the extended tick count, and the
+                // counter wraps around the timer width several times
+                for (uint32_t i = 1; i <= TEST_UPDATE_COUNT; i++) {
+                        test_counter = i;
+                        mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base);
+
+                        // Let the readers interrupt the updates often
+                        if (!(i % TEST_YIELD_INTERVAL)) {
+                                std::this_thread::yield();
+                        }
+                }
+        });
+
+        EXPECT_EQ(0u, m_failures.load())
+                << "Readers must never see torn or decreasing tick counts.";
+        EXPECT_EQ((uint64_t)TEST_UPDATE_COUNT,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "No counter wrap-around may be lost.";
+}
+
+} // namespace
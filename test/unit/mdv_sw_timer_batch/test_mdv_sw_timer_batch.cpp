@@ -0,0 +1,302 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "mdv_sw_timer_batch.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test mask (23-bit) for the timer counter
+#define TEST_TIMER_MASK 0x007fffffu
+// Test mask (32-bit) for the timer counter
+#define TEST_TIMER_MASK32 0xffffffffu
+// Test value for the initial tick count
+#define TEST_TIMER_INITIAL_TICK_COUNT 1234u
+// Test count of timers, not a multiple of the bitmap word size
+#define TEST_TIMER_COUNT 1000u
+// Test count of random rounds
+#define TEST_ROUND_COUNT 100u
+
+using namespace testing;
+
+namespace{
+
+class test_mdv_sw_timer_batch : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                memset(&m_sw_timer_batch, 0, sizeof(mdv_sw_timer_batch_t));
+                mdv_sw_timer_conversion_init(&m_conversion,
+                                             TEST_TICK_DURATION_US);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void Init(uint32_t const timer_mask = TEST_TIMER_MASK) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(timer_mask));
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_conversion(&m_sw_timer_base))
+                        .WillByDefault(Return(&m_conversion));
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+
+                mdv_sw_timer_batch_init(&m_sw_timer_batch, &m_sw_timer_base,
+                                        m_startup_samples, m_timeouts,
+                                        TEST_TIMER_COUNT);
+        }
+
+        void SetTickCount(uint32_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count));
+        }
+
+        mdv_sw_timer_batch_t m_sw_timer_batch;
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_sw_timer_conversion_t m_conversion;
+        uint32_t m_startup_samples[TEST_TIMER_COUNT];
+        uint32_t m_timeouts[TEST_TIMER_COUNT];
+        uint32_t m_times[TEST_TIMER_COUNT];
+        uint32_t m_expired[MDV_SW_TIMER_BATCH_BITMAP_WORDS(TEST_TIMER_COUNT)];
+};
+
+TEST_F(test_mdv_sw_timer_batch,
+       init__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_batch_init(0, &m_sw_timer_base,
+                                             m_startup_samples, m_timeouts,
+                                             TEST_TIMER_COUNT), "")
+                << "If null, sw_timer_batch must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_init(&m_sw_timer_batch, 0,
+                                             m_startup_samples, m_timeouts,
+                                             TEST_TIMER_COUNT), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_init(&m_sw_timer_batch,
+                                             &m_sw_timer_base, 0, m_timeouts,
+                                             TEST_TIMER_COUNT), "")
+                << "If null, tick_count_startup_samples must cause an " \
+                   "assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_init(&m_sw_timer_batch,
+                                             &m_sw_timer_base,
+                                             m_startup_samples, 0,
+                                             TEST_TIMER_COUNT), "")
+                << "If null, timeouts must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_init(&m_sw_timer_batch,
+                                             &m_sw_timer_base,
+                                             m_startup_samples, m_timeouts,
+                                             0), "")
+                << "If zero, timer_count must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_batch, init__sw_timer_batch_initialized)
+{
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .Times(1);
+
+        Init();
+
+        EXPECT_EQ(&m_sw_timer_base, m_sw_timer_batch.sw_timer_base)
+                << "Timer base must be set.";
+        EXPECT_EQ(TEST_TIMER_MASK, m_sw_timer_batch.timer_mask)
+                << "Timer mask must be got from the timer base.";
+        EXPECT_EQ(&m_conversion, m_sw_timer_batch.conversion)
+                << "Conversion factors must be got from the timer base.";
+        EXPECT_EQ(TEST_TIMER_COUNT, m_sw_timer_batch.timer_count)
+                << "Timer count must be set.";
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                ASSERT_EQ(TEST_TIMER_INITIAL_TICK_COUNT, m_startup_samples[i])
+                        << "Timers must be started at the current tick count.";
+                ASSERT_EQ(MDV_SW_TIMER_BATCH_TIMEOUT_NEVER, m_timeouts[i])
+                        << "Timers must not expire before started.";
+        }
+}
+
+TEST_F(test_mdv_sw_timer_batch,
+       start__invalid_function_parameters_cause_assertion_failure)
+{
+        Init();
+
+        EXPECT_DEATH(mdv_sw_timer_batch_start(0, 0, 1u), "")
+                << "If null, sw_timer_batch must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_start(&m_sw_timer_batch,
+                                              TEST_TIMER_COUNT, 1u), "")
+                << "If out of range, index must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_batch, start__successful)
+{
+        Init();
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT * 2u);
+
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, 10u, 100u);
+
+        EXPECT_EQ(TEST_TIMER_INITIAL_TICK_COUNT * 2u, m_startup_samples[10])
+                << "Startup sample must be got from the timer base.";
+        EXPECT_EQ(100u, m_timeouts[10])
+                << "Timeout must be set.";
+}
+
+TEST_F(test_mdv_sw_timer_batch,
+       get_time__invalid_function_parameters_cause_assertion_failure)
+{
+        Init();
+
+        EXPECT_DEATH(mdv_sw_timer_batch_get_time(0, MDV_SW_TIMER_MS, m_times),
+                     "")
+                << "If null, sw_timer_batch must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_get_time(&m_sw_timer_batch,
+                                                 MDV_SW_TIMER_MS, 0), "")
+                << "If null, times must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_batch, get_time__one_sample_used_for_all_timers)
+{
+        Init();
+
+        // Start the timers at different ticks, some before the wrap-around
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                m_startup_samples[i] = (TEST_TIMER_MASK - i) & TEST_TIMER_MASK;
+        }
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+
+        mdv_sw_timer_batch_get_time(&m_sw_timer_batch, MDV_SW_TIMER_US,
+                                    m_times);
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                ASSERT_EQ((TEST_TIMER_INITIAL_TICK_COUNT + i + 1u) *
+                          TEST_TICK_DURATION_US, m_times[i])
+                        << "Time must be returned correctly for timer " << i;
+        }
+}
+
+TEST_F(test_mdv_sw_timer_batch,
+       get_expired__invalid_function_parameters_cause_assertion_failure)
+{
+        Init();
+
+        EXPECT_DEATH(mdv_sw_timer_batch_get_expired(0, m_expired), "")
+                << "If null, sw_timer_batch must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_batch_get_expired(&m_sw_timer_batch, 0), "")
+                << "If null, expired must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_batch, get_expired__expired_timers_reported)
+{
+        uint32_t expired_count;
+
+        Init();
+
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, 0, 0);
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, 33u, 10u);
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, 34u, 11u);
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, TEST_TIMER_COUNT - 1u,
+                                 10u);
+
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + 10u);
+
+        expired_count = mdv_sw_timer_batch_get_expired(&m_sw_timer_batch,
+                                                       m_expired);
+
+        EXPECT_EQ(3u, expired_count)
+                << "Count of expired timers must be returned.";
+        EXPECT_EQ(0x00000001u, m_expired[0])
+                << "Zero timeout must expire immediately.";
+        EXPECT_EQ(0x00000002u, m_expired[1])
+                << "Timer must expire when the timeout is reached.";
+        EXPECT_EQ(1u << ((TEST_TIMER_COUNT - 1u) % 32u),
+                  m_expired[MDV_SW_TIMER_BATCH_BITMAP_WORDS(
+                          TEST_TIMER_COUNT) - 1u])
+                << "Timer must expire in the last partial word, and the " \
+                   "unused bits must be cleared.";
+}
+
+TEST_F(test_mdv_sw_timer_batch,
+       get_expired__never_timeout_not_expired_with_32_bit_width)
+{
+        uint32_t expired_count;
+
+        Init(TEST_TIMER_MASK32);
+
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, 33u,
+                                 MDV_SW_TIMER_BATCH_TIMEOUT_NEVER - 1u);
+        mdv_sw_timer_batch_start(&m_sw_timer_batch, TEST_TIMER_COUNT - 1u,
+                                 MDV_SW_TIMER_BATCH_TIMEOUT_NEVER - 1u);
+
+        // The elapsed time of all timers reaches UINT32_MAX
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT - 1u);
+
+        expired_count = mdv_sw_timer_batch_get_expired(&m_sw_timer_batch,
+                                                       m_expired);
+
+        EXPECT_EQ(2u, expired_count)
+                << "Only the timers with the longest timeout must expire.";
+        EXPECT_EQ(0x00000002u, m_expired[1])
+                << "Never expiring timeouts must not expire in a full word.";
+        EXPECT_EQ(1u << ((TEST_TIMER_COUNT - 1u) % 32u),
+                  m_expired[MDV_SW_TIMER_BATCH_BITMAP_WORDS(
+                          TEST_TIMER_COUNT) - 1u])
+                << "Never expiring timeouts must not expire in the last " \
+                   "partial word.";
+}
+
+TEST_F(test_mdv_sw_timer_batch,
+       get_expired__matches_per_timer_evaluation_with_random_timers)
+{
+        std::mt19937 random(12345);
+        uint32_t tick_count;
+        uint32_t expected_count;
+        uint32_t elapsed;
+        bool is_expired;
+
+        Init();
+
+        for (uint32_t round = 0; round < TEST_ROUND_COUNT; round++) {
+                tick_count = random() & TEST_TIMER_MASK;
+                expected_count = 0;
+
+                for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                        m_startup_samples[i] = random() & TEST_TIMER_MASK;
+                        // Include timeouts over the timer mask and over the
+                        // sign bit
+                        m_timeouts[i] = (i % 7u) ? random() &
+                                        (TEST_TIMER_MASK >> (i % 5u)) :
+                                        (uint32_t)random();
+                }
+
+                SetTickCount(tick_count);
+
+                expected_count = mdv_sw_timer_batch_get_expired(
+                        &m_sw_timer_batch, m_expired);
+
+                for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                        elapsed = (tick_count - m_startup_samples[i]) &
+                                  TEST_TIMER_MASK;
+                        is_expired = (elapsed >= m_timeouts[i]) &&
+                                     (m_timeouts[i] !=
+                                      MDV_SW_TIMER_BATCH_TIMEOUT_NEVER);
+
+                        ASSERT_EQ(is_expired,
+                                  (bool)((m_expired[i / 32u] >> (i % 32u)) &
+                                         1u))
+                                << "Round " << round << ", timer " << i;
+
+                        expected_count -= is_expired ? 1u : 0u;
+                }
+
+                EXPECT_EQ(0u, expected_count)
+                        << "Count of expired timers must match the bitmap.";
+        }
+}
+
+} // namespace
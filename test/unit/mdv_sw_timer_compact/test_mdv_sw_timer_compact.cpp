@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "mdv_sw_timer_compact.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test mask (23-bit) for the timer counter
+#define TEST_TIMER_MASK 0x007fffffu
+// Test value for the initial tick count, wider than a 16-bit timer
+#define TEST_TIMER_INITIAL_TICK_COUNT 0x0001fff0u
+// Test value for the elapsed ticks, crosses the 16-bit boundary
+#define TEST_ELAPSED_TICK_COUNT 0x0123u
+// Test count of timers
+#define TEST_TIMER_COUNT 16u
+
+using namespace testing;
+
+namespace{
+
+class test_mdv_sw_timer_compact : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                memset(&m_array, 0, sizeof(mdv_sw_timer_compact_array_t));
+                memset(m_timers, 0, sizeof(m_timers));
+                mdv_sw_timer_conversion_init(&m_conversion,
+                                             TEST_TICK_DURATION_US);
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_conversion(&m_sw_timer_base))
+                        .WillByDefault(Return(&m_conversion));
+                SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT);
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void SetTickCount(uint32_t const tick_count) {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                        .WillByDefault(Return(tick_count));
+        }
+
+        mdv_sw_timer_compact_array_t m_array;
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_sw_timer_conversion_t m_conversion;
+        mdv_sw_timer_compact_t m_timers[TEST_TIMER_COUNT];
+        uint32_t m_times[TEST_TIMER_COUNT];
+};
+
+TEST_F(test_mdv_sw_timer_compact, timer__size_equals_to_sample_size)
+{
+        EXPECT_EQ(MDV_SW_TIMER_COMPACT_SAMPLE_BITS / 8,
+                  sizeof(mdv_sw_timer_compact_t))
+                << "The timer must consist of the sample only.";
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       start__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_compact_start(0, &m_timers[0]), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_start(&m_sw_timer_base, 0), "")
+                << "If null, timer must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, start__successful)
+{
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                    mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .Times(1);
+
+        mdv_sw_timer_compact_start(&m_sw_timer_base, &m_timers[0]);
+
+        EXPECT_EQ((mdv_sw_timer_compact_t)TEST_TIMER_INITIAL_TICK_COUNT,
+                  m_timers[0])
+                << "The tick count must be sampled.";
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       get_time__invalid_function_parameters_cause_assertion_failure)
+{
+        uint32_t time;
+
+        EXPECT_DEATH(mdv_sw_timer_compact_get_time(0, &m_timers[0],
+                                                   MDV_SW_TIMER_US, &time), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_get_time(&m_sw_timer_base, 0,
+                                                   MDV_SW_TIMER_US, &time), "")
+                << "If null, timer must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_get_time(&m_sw_timer_base,
+                                                   &m_timers[0],
+                                                   MDV_SW_TIMER_US, 0), "")
+                << "If null, time must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, get_time__successful)
+{
+        uint32_t time = 0;
+
+        mdv_sw_timer_compact_start(&m_sw_timer_base, &m_timers[0]);
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + TEST_ELAPSED_TICK_COUNT);
+
+        mdv_sw_timer_compact_get_time(&m_sw_timer_base, &m_timers[0],
+                                      MDV_SW_TIMER_TIMERTICK, &time);
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, time)
+                << "Time must be returned in timer ticks.";
+        mdv_sw_timer_compact_get_time(&m_sw_timer_base, &m_timers[0],
+                                      MDV_SW_TIMER_US, &time);
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT * TEST_TICK_DURATION_US, time)
+                << "Time must be returned in microseconds.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, get_time__timer_counter_overflow)
+{
+        uint32_t time = 0;
+
+        SetTickCount(TEST_TIMER_MASK - 1u);
+        mdv_sw_timer_compact_start(&m_sw_timer_base, &m_timers[0]);
+        SetTickCount(TEST_ELAPSED_TICK_COUNT - 2u);
+
+        mdv_sw_timer_compact_get_time(&m_sw_timer_base, &m_timers[0],
+                                      MDV_SW_TIMER_TIMERTICK, &time);
+        EXPECT_EQ(TEST_ELAPSED_TICK_COUNT, time)
+                << "Overflow of the timer counter must be handled.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, get_time__range_is_limited_by_sample)
+{
+        uint32_t const elapsed = MDV_SW_TIMER_COMPACT_SAMPLE_MASK & 0x00010005u;
+        uint32_t time = 0;
+
+        mdv_sw_timer_compact_start(&m_sw_timer_base, &m_timers[0]);
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + 0x00010005u);
+
+        mdv_sw_timer_compact_get_time(&m_sw_timer_base, &m_timers[0],
+                                      MDV_SW_TIMER_TIMERTICK, &time);
+        EXPECT_EQ(elapsed, time)
+                << "The elapsed ticks must wrap at the range of the sample.";
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       array_init__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_compact_array_init(0, &m_sw_timer_base,
+                                                     m_timers,
+                                                     TEST_TIMER_COUNT), "")
+                << "If null, array must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_init(&m_array, 0, m_timers,
+                                                     TEST_TIMER_COUNT), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_init(&m_array,
+                                                     &m_sw_timer_base, 0,
+                                                     TEST_TIMER_COUNT), "")
+                << "If null, timers must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_init(&m_array,
+                                                     &m_sw_timer_base,
+                                                     m_timers, 0), "")
+                << "If zero, timer_count must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, array_init__successful)
+{
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+
+        EXPECT_EQ(&m_sw_timer_base, m_array.sw_timer_base)
+                << "Timer base must be set.";
+        EXPECT_EQ(TEST_TIMER_MASK & MDV_SW_TIMER_COMPACT_SAMPLE_MASK,
+                  m_array.timer_mask)
+                << "Timer mask must be limited to the range of the timers.";
+        EXPECT_EQ(&m_conversion, m_array.conversion)
+                << "Conversion must be set.";
+        EXPECT_EQ(m_timers, m_array.timers)
+                << "Timers must be set.";
+        EXPECT_EQ(TEST_TIMER_COUNT, m_array.timer_count)
+                << "Timer count must be set.";
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                EXPECT_EQ((mdv_sw_timer_compact_t)
+                          TEST_TIMER_INITIAL_TICK_COUNT, m_timers[i])
+                        << "All timers must be started.";
+        }
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       array_start__invalid_function_parameters_cause_assertion_failure)
+{
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+
+        EXPECT_DEATH(mdv_sw_timer_compact_array_start(0, 0), "")
+                << "If null, array must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_start(&m_array,
+                                                      TEST_TIMER_COUNT), "")
+                << "If out of range, index must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, array_start__successful)
+{
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + TEST_ELAPSED_TICK_COUNT);
+
+        mdv_sw_timer_compact_array_start(&m_array, 3);
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                EXPECT_EQ((mdv_sw_timer_compact_t)
+                          (i == 3 ? TEST_TIMER_INITIAL_TICK_COUNT +
+                                    TEST_ELAPSED_TICK_COUNT :
+                                    TEST_TIMER_INITIAL_TICK_COUNT),
+                          m_timers[i])
+                        << "Only the given timer must be started.";
+        }
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       array_get_time__invalid_function_parameters_cause_assertion_failure)
+{
+        uint32_t time;
+
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+
+        EXPECT_DEATH(mdv_sw_timer_compact_array_get_time(0, 0,
+                                                         MDV_SW_TIMER_US,
+                                                         &time), "")
+                << "If null, array must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_get_time(&m_array,
+                                                         TEST_TIMER_COUNT,
+                                                         MDV_SW_TIMER_US,
+                                                         &time), "")
+                << "If out of range, index must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_get_time(&m_array, 0,
+                                                         MDV_SW_TIMER_US, 0),
+                     "")
+                << "If null, time must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, array_get_time__successful)
+{
+        uint32_t time = 0;
+
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + TEST_ELAPSED_TICK_COUNT);
+
+        mdv_sw_timer_compact_array_get_time(&m_array, 5, MDV_SW_TIMER_MS,
+                                            &time);
+        EXPECT_EQ((TEST_ELAPSED_TICK_COUNT * TEST_TICK_DURATION_US) /
+                  MDV_SW_TIMER_US_IN_ONE_MS, time)
+                << "Time must be returned correctly.";
+}
+
+TEST_F(test_mdv_sw_timer_compact,
+       array_get_times__invalid_function_parameters_cause_assertion_failure)
+{
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+
+        EXPECT_DEATH(mdv_sw_timer_compact_array_get_times(0, MDV_SW_TIMER_US,
+                                                          m_times), "")
+                << "If null, array must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_compact_array_get_times(&m_array,
+                                                          MDV_SW_TIMER_US, 0),
+                     "")
+                << "If null, times must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_compact, array_get_times__successful)
+{
+        mdv_sw_timer_compact_array_init(&m_array, &m_sw_timer_base, m_timers,
+                                        TEST_TIMER_COUNT);
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + i);
+                mdv_sw_timer_compact_array_start(&m_array, i);
+        }
+
+        SetTickCount(TEST_TIMER_INITIAL_TICK_COUNT + TEST_ELAPSED_TICK_COUNT);
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                    mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .Times(1);
+
+        mdv_sw_timer_compact_array_get_times(&m_array, MDV_SW_TIMER_US,
+                                             m_times);
+
+        for (uint32_t i = 0; i < TEST_TIMER_COUNT; i++) {
+                EXPECT_EQ((TEST_ELAPSED_TICK_COUNT - i) * TEST_TICK_DURATION_US,
+                          m_times[i])
+                        << "Time of each timer must be returned correctly.";
+        }
+}
+
+} // namespace
@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "mdv_sw_timer_conversion.c"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test value for the tick count
+#define TEST_TICK_COUNT 1232766u
+// Test count of random samples per tick duration
+#define TEST_SAMPLE_COUNT 100000u
+// Test value for the fractional tick period (48 MHz) in Q32.32 nanoseconds
+#define TEST_TICK_PERIOD_NS_Q32 MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(48000000u)
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Check a conversion of a fractional tick period against the exact value
+ * calculated with 128-bit arithmetic. The time must equal to the exact value
+ * rounded down, or, if the exact value is closer than 2^-62 of its magnitude
+ * to the next whole unit, to the exact value rounded up.
+ */
+bool is_exact_time(uint64_t const time,
+                   uint64_t const time_mask,
+                   uint64_t const tick_count,
+                   uint64_t const tick_period_ns_q32,
+                   mdv_sw_timer_order_of_magnitude_t order_of_magnitude)
+{
+        static const uint64_t ns_in_unit[] = {
+                0u, 1000u, 1000000u, 1000000000u, 1u
+        };
+        unsigned __int128 numerator;
+        unsigned __int128 denominator;
+        unsigned __int128 exact;
+
+        if (order_of_magnitude == MDV_SW_TIMER_TIMERTICK) {
+                return time == (tick_count & time_mask);
+        }
+
+        numerator = (unsigned __int128)tick_count * tick_period_ns_q32;
+        denominator = ((unsigned __int128)1u << 32) *
+                      ns_in_unit[order_of_magnitude];
+        exact = numerator / denominator;
+
+        if (time == ((uint64_t)exact & time_mask)) {
+                return true;
+        }
+
+        return (time == ((uint64_t)(exact + 1u) & time_mask)) &&
+               ((((exact + 1u) * denominator - numerator) << 62) <=
+                numerator);
+}
+
+class test_mdv_sw_timer_conversion : public Test
+{
+        protected:
+
+        void SetUp() override {
+                memset(&m_conversion, 0, sizeof(mdv_sw_timer_conversion_t));
+        }
+
+        mdv_sw_timer_conversion_t m_conversion;
+};
+
+TEST_F(test_mdv_sw_timer_conversion,
+       init__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_conversion_init(0, TEST_TICK_DURATION_US), "")
+                << "If null, conversion must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_conversion_init(&m_conversion, 0), "")
+                << "If zero, tick_duration_us must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       get_time__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_conversion_get_time(0, TEST_TICK_COUNT,
+                                                      MDV_SW_TIMER_MS), "")
+                << "If null, conversion must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion, get_time__successful)
+{
+        uint32_t const test_time_us = TEST_TICK_COUNT * TEST_TICK_DURATION_US;
+
+        mdv_sw_timer_conversion_init(&m_conversion, TEST_TICK_DURATION_US);
+
+        EXPECT_EQ(TEST_TICK_COUNT, mdv_sw_timer_conversion_get_time(
+                &m_conversion, TEST_TICK_COUNT, MDV_SW_TIMER_TIMERTICK))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us, mdv_sw_timer_conversion_get_time(
+                &m_conversion, TEST_TICK_COUNT, MDV_SW_TIMER_US))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_MS,
+                  mdv_sw_timer_conversion_get_time(
+                          &m_conversion, TEST_TICK_COUNT, MDV_SW_TIMER_MS))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_SECOND,
+                  mdv_sw_timer_conversion_get_time(
+                          &m_conversion, TEST_TICK_COUNT, MDV_SW_TIMER_S))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us * MDV_SW_TIMER_NS_IN_ONE_US,
+                  mdv_sw_timer_conversion_get_time(
+                          &m_conversion, TEST_TICK_COUNT, MDV_SW_TIMER_NS))
+                << "Time in nanoseconds must wrap around like the product.";
+        EXPECT_EQ(TEST_TICK_COUNT, mdv_sw_timer_conversion_get_time(
+                &m_conversion, TEST_TICK_COUNT,
+                MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT))
+                << "Unknown order of magnitude must return the tick count.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       get_time__exact_for_all_tick_durations_in_supported_range)
+{
+        static const uint32_t tick_durations_us[] = {
+                1, 2, 3, 7, 10, 16, 25, 30, 64, 100, 125, 250, 333, 512, 1000,
+                1024, 3125, 4096, 10000, 15625, 65536, 100000, 999999, 1000000,
+                3000000, 0xffffffffu
+        };
+        std::mt19937 random(12345);
+
+        for (uint32_t tick_duration_us : tick_durations_us) {
+                uint32_t const max_tick_count = UINT32_MAX / tick_duration_us;
+
+                mdv_sw_timer_conversion_init(&m_conversion, tick_duration_us);
+
+                for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++) {
+                        // Cover both the small values and the whole range
+                        uint32_t const tick_count =
+                                ((i < 1000u) && (i <= max_tick_count)) ? i :
+                                (random() % max_tick_count) + 1u;
+                        uint32_t const time_us = tick_count * tick_duration_us;
+
+                        ASSERT_EQ(time_us, mdv_sw_timer_conversion_get_time(
+                                &m_conversion, tick_count, MDV_SW_TIMER_US))
+                                << "Tick duration " << tick_duration_us
+                                << ", tick count " << tick_count;
+                        ASSERT_EQ(time_us / MDV_SW_TIMER_US_IN_ONE_MS,
+                                  mdv_sw_timer_conversion_get_time(
+                                          &m_conversion, tick_count,
+                                          MDV_SW_TIMER_MS))
+                                << "Tick duration " << tick_duration_us
+                                << ", tick count " << tick_count;
+                        ASSERT_EQ(time_us / MDV_SW_TIMER_US_IN_ONE_SECOND,
+                                  mdv_sw_timer_conversion_get_time(
+                                          &m_conversion, tick_count,
+                                          MDV_SW_TIMER_S))
+                                << "Tick duration " << tick_duration_us
+                                << ", tick count " << tick_count;
+                }
+
+                // The upper limit of the range
+                ASSERT_EQ((max_tick_count * tick_duration_us) /
+                          MDV_SW_TIMER_US_IN_ONE_MS,
+                          mdv_sw_timer_conversion_get_time(
+                                  &m_conversion, max_tick_count,
+                                  MDV_SW_TIMER_MS))
+                        << "Tick duration " << tick_duration_us;
+        }
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       get_time64__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_conversion_get_time64(0, TEST_TICK_COUNT,
+                                                        MDV_SW_TIMER_MS), "")
+                << "If null, conversion must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion, get_time64__successful)
+{
+        uint64_t const tick_count = (uint64_t)TEST_TICK_COUNT << 20;
+        uint64_t const test_time_us = tick_count * TEST_TICK_DURATION_US;
+
+        mdv_sw_timer_conversion_init(&m_conversion, TEST_TICK_DURATION_US);
+
+        EXPECT_EQ(tick_count, mdv_sw_timer_conversion_get_time64(
+                &m_conversion, tick_count, MDV_SW_TIMER_TIMERTICK))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us, mdv_sw_timer_conversion_get_time64(
+                &m_conversion, tick_count, MDV_SW_TIMER_US))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_MS,
+                  mdv_sw_timer_conversion_get_time64(
+                          &m_conversion, tick_count, MDV_SW_TIMER_MS))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_SECOND,
+                  mdv_sw_timer_conversion_get_time64(
+                          &m_conversion, tick_count, MDV_SW_TIMER_S))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us * MDV_SW_TIMER_NS_IN_ONE_US,
+                  mdv_sw_timer_conversion_get_time64(
+                          &m_conversion, tick_count, MDV_SW_TIMER_NS))
+                << "Time must be returned correctly.";
+        EXPECT_EQ(tick_count, mdv_sw_timer_conversion_get_time64(
+                &m_conversion, tick_count,
+                MDV_SW_TIMER_ORDER_OF_MAGNITUDE_COUNT))
+                << "Unknown order of magnitude must return the tick count.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       init_period__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_sw_timer_conversion_init_period(
+                0, TEST_TICK_PERIOD_NS_Q32), "")
+                << "If null, conversion must cause an assertion failure.";
+        EXPECT_DEATH(mdv_sw_timer_conversion_init_period(&m_conversion, 0), "")
+                << "If zero, tick_period_ns_q32 must cause an assertion " \
+                   "failure.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion, get_time__fractional_tick_period)
+{
+        mdv_sw_timer_conversion_init_period(&m_conversion,
+                                            TEST_TICK_PERIOD_NS_Q32);
+
+        // 48 ticks of a 48 MHz counter take one microsecond
+        EXPECT_EQ(48u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, 48u, MDV_SW_TIMER_TIMERTICK))
+                << "Time must be returned in timer ticks.";
+        EXPECT_EQ(1000u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, 48u, MDV_SW_TIMER_NS))
+                << "Time must be returned in nanoseconds.";
+        EXPECT_EQ(20u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, 1u, MDV_SW_TIMER_NS))
+                << "Time must be rounded down.";
+        EXPECT_EQ(1u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, 48u, MDV_SW_TIMER_US))
+                << "Whole units must not be lost.";
+        EXPECT_EQ(1000u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, 48000000u, MDV_SW_TIMER_MS))
+                << "Time must be returned in milliseconds.";
+        EXPECT_EQ(89u, mdv_sw_timer_conversion_get_time(
+                &m_conversion, UINT32_MAX, MDV_SW_TIMER_S))
+                << "Time must be returned in seconds.";
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       get_time__exact_for_fractional_tick_periods)
+{
+        static const uint64_t tick_periods_ns_q32[] = {
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(1000000000u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(480000000u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(48000000u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(16000000u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(32768u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(1u),
+                1u, 0x0000000180000000ull, 0xffffffffffffffffull
+        };
+        static const mdv_sw_timer_order_of_magnitude_t orders[] = {
+                MDV_SW_TIMER_TIMERTICK, MDV_SW_TIMER_NS, MDV_SW_TIMER_US,
+                MDV_SW_TIMER_MS, MDV_SW_TIMER_S
+        };
+        std::mt19937 random(12345);
+
+        for (uint64_t tick_period_ns_q32 : tick_periods_ns_q32) {
+                mdv_sw_timer_conversion_init_period(&m_conversion,
+                                                    tick_period_ns_q32);
+
+                for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++) {
+                        uint32_t const tick_count = (i < 1000u) ? i : random();
+
+                        for (mdv_sw_timer_order_of_magnitude_t order : orders) {
+                                ASSERT_TRUE(is_exact_time(
+                                        mdv_sw_timer_conversion_get_time(
+                                                &m_conversion, tick_count,
+                                                order),
+                                        UINT32_MAX, tick_count,
+                                        tick_period_ns_q32, order))
+                                        << "Tick period " << tick_period_ns_q32
+                                        << ", tick count " << tick_count
+                                        << ", order " << order;
+                        }
+                }
+        }
+}
+
+TEST_F(test_mdv_sw_timer_conversion,
+       get_time64__exact_for_fractional_tick_periods)
+{
+        static const uint64_t tick_periods_ns_q32[] = {
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(48000000u),
+                MDV_SW_TIMER_TICK_PERIOD_NS_Q32_FROM_HZ(32768u),
+                0xffffffffffffffffull
+        };
+        static const mdv_sw_timer_order_of_magnitude_t orders[] = {
+                MDV_SW_TIMER_TIMERTICK, MDV_SW_TIMER_NS, MDV_SW_TIMER_US,
+                MDV_SW_TIMER_MS, MDV_SW_TIMER_S
+        };
+        std::mt19937_64 random(12345);
+
+        for (uint64_t tick_period_ns_q32 : tick_periods_ns_q32) {
+                mdv_sw_timer_conversion_init_period(&m_conversion,
+                                                    tick_period_ns_q32);
+
+                for (uint32_t i = 0; i < TEST_SAMPLE_COUNT; i++) {
+                        // Keep the time in nanoseconds within 64 bits
+                        uint64_t const tick_count = random() >> 32;
+
+                        for (mdv_sw_timer_order_of_magnitude_t order : orders) {
+                                ASSERT_TRUE(is_exact_time(
+                                        mdv_sw_timer_conversion_get_time64(
+                                                &m_conversion, tick_count,
+                                                order),
+                                        UINT64_MAX, tick_count,
+                                        tick_period_ns_q32, order))
+                                        << "Tick period " << tick_period_ns_q32
+                                        << ", tick count " << tick_count
+                                        << ", order " << order;
+                        }
+                }
+        }
+}
+
+} // namespace
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+#include "mdv_sw_timer.hpp"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test value for timer width in bits
+#define TEST_TIMER_WIDTH_BITS 23u
+// Test mask (23-bit) for the timer counter
+#define TEST_TIMER_MASK 0x007fffffu
+// Test value for the initial tick count
+#define TEST_TIMER_INITIAL_TICK_COUNT 1234u
+// Test time in ticks
+#define TEST_TIME_IN_TICKS 1232766u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Tick source with a counter set by the test
+ */
+struct test_tick_source {
+        static uint32_t count;
+
+        static uint32_t get_count()
+        {
+                return count;
+        }
+};
+
+uint32_t test_tick_source::count;
+
+/*
+ * Timer base shared by the C and C++ timers
+ */
+mdv_sw_timer_base_t test_sw_timer_base;
+
+using test_traits = mdv::sw_timer_traits<TEST_TICK_DURATION_US,
+                                         TEST_TIMER_WIDTH_BITS>;
+using test_timer = mdv::sw_timer<TEST_TICK_DURATION_US, TEST_TIMER_WIDTH_BITS,
+                                 test_tick_source>;
+using test_base_timer = mdv::sw_timer<
+        TEST_TICK_DURATION_US, TEST_TIMER_WIDTH_BITS,
+        mdv::sw_timer_base_tick_source<&test_sw_timer_base>>;
+
+static_assert(sizeof(test_timer) == sizeof(mdv_sw_timer_t),
+              "The C++ timer must have the layout of the C timer");
+static_assert(std::is_standard_layout<test_timer>::value,
+              "The C++ timer must have the layout of the C timer");
+static_assert(test_traits::timer_mask == TEST_TIMER_MASK,
+              "The timer mask must be a constant");
+static_assert(test_traits::get_time<MDV_SW_TIMER_MS>(TEST_TIME_IN_TICKS) ==
+              TEST_TIME_IN_TICKS * TEST_TICK_DURATION_US /
+              MDV_SW_TIMER_US_IN_ONE_MS,
+              "The conversion must be a constant expression");
+
+class test_mdv_sw_timer_cpp : public Test
+{
+        protected:
+
+        void SetUp() override {
+                test_tick_source::count = TEST_TIMER_INITIAL_TICK_COUNT;
+                mdv_sw_timer_base_init(&test_sw_timer_base,
+                                       TEST_TICK_DURATION_US,
+                                       TEST_TIMER_WIDTH_BITS, 0);
+        }
+};
+
+TEST_F(test_mdv_sw_timer_cpp, traits__conversions_match_c_conversions)
+{
+        mdv_sw_timer_conversion_t const *const conversion =
+                mdv_sw_timer_base_get_conversion(&test_sw_timer_base);
+
+        for (uint32_t tick_count = 0; tick_count < TEST_TIMER_MASK;
+             tick_count += 997u) {
+                ASSERT_EQ(mdv_sw_timer_conversion_get_time(
+                                  conversion, tick_count,
+                                  MDV_SW_TIMER_TIMERTICK),
+                          test_traits::get_time<MDV_SW_TIMER_TIMERTICK>(
+                                  tick_count));
+                ASSERT_EQ(mdv_sw_timer_conversion_get_time(
+                                  conversion, tick_count, MDV_SW_TIMER_US),
+                          test_traits::get_time<MDV_SW_TIMER_US>(tick_count));
+                ASSERT_EQ(mdv_sw_timer_conversion_get_time(
+                                  conversion, tick_count, MDV_SW_TIMER_MS),
+                          test_traits::get_time<MDV_SW_TIMER_MS>(tick_count));
+                ASSERT_EQ(mdv_sw_timer_conversion_get_time(
+                                  conversion, tick_count, MDV_SW_TIMER_S),
+                          test_traits::get_time<MDV_SW_TIMER_S>(tick_count));
+                ASSERT_EQ(mdv_sw_timer_conversion_get_time(
+                                  conversion, tick_count, MDV_SW_TIMER_NS),
+                          test_traits::get_time<MDV_SW_TIMER_NS>(tick_count));
+        }
+}
+
+TEST_F(test_mdv_sw_timer_cpp, get_time__successful)
+{
+        uint32_t const test_time_us = TEST_TIME_IN_TICKS *
+                                      TEST_TICK_DURATION_US;
+        test_timer timer;
+
+        timer.start();
+        test_tick_source::count += TEST_TIME_IN_TICKS;
+
+        EXPECT_EQ(TEST_TIME_IN_TICKS,
+                  timer.get_time<MDV_SW_TIMER_TIMERTICK>())
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us, timer.get_time<MDV_SW_TIMER_US>())
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_MS,
+                  timer.get_time<MDV_SW_TIMER_MS>())
+                << "Time must be returned correctly.";
+        EXPECT_EQ(test_time_us / MDV_SW_TIMER_US_IN_ONE_SECOND,
+                  timer.get_time<MDV_SW_TIMER_S>())
+                << "Time must be returned correctly.";
+}
+
+TEST_F(test_mdv_sw_timer_cpp, get_time__manage_tick_counter_wrap_around)
+{
+        test_timer timer;
+
+        test_tick_source::count = TEST_TIMER_MASK -
+                                  TEST_TIMER_INITIAL_TICK_COUNT;
+        timer.start();
+        test_tick_source::count = TEST_TIMER_INITIAL_TICK_COUNT;
+
+        EXPECT_EQ((TEST_TIMER_INITIAL_TICK_COUNT * 2u) + 1u,
+                  timer.get_time<MDV_SW_TIMER_TIMERTICK>())
+                << "Time must be returned correctly over the wrap-around.";
+}
+
+TEST_F(test_mdv_sw_timer_cpp, get_time__timer_base_shared_with_c_timer)
+{
+        test_base_timer timer(&test_sw_timer_base);
+        mdv_sw_timer_t c_timer;
+        uint32_t c_time;
+
+        mdv_sw_timer_init(&c_timer, &test_sw_timer_base);
+        mdv_sw_timer_base_tick(&test_sw_timer_base,
+                               TEST_TIMER_INITIAL_TICK_COUNT);
+
+        timer.start();
+        mdv_sw_timer_start(&c_timer);
+
+        mdv_sw_timer_base_tick(&test_sw_timer_base, TEST_TIME_IN_TICKS);
+
+        mdv_sw_timer_get_time(&c_timer, MDV_SW_TIMER_MS, &c_time);
+
+        EXPECT_EQ(c_time, timer.get_time<MDV_SW_TIMER_MS>())
+                << "The C and C++ timers must agree on a shared timer base.";
+
+        mdv_sw_timer_get_time(timer.c_timer(), MDV_SW_TIMER_MS, &c_time);
+
+        EXPECT_EQ(c_time, timer.get_time<MDV_SW_TIMER_MS>())
+                << "The C++ timer must be usable through the C interface.";
+}
+
+TEST_F(test_mdv_sw_timer_cpp,
+       init__mismatching_timer_base_causes_assertion_failure)
+{
+        mdv_sw_timer_base_init(&test_sw_timer_base, TEST_TICK_DURATION_US * 2u,
+                               TEST_TIMER_WIDTH_BITS, 0);
+
+        EXPECT_DEATH(test_base_timer timer(&test_sw_timer_base), "")
+                << "A timer base with another tick duration must cause an " \
+                   "assertion failure.";
+
+        // The fractional period rounds down to the same tick duration
+        mdv_sw_timer_base_init_period(&test_sw_timer_base,
+                                      test_traits::tick_period_ns_q32 +
+                                      0x80000000u,
+                                      TEST_TIMER_WIDTH_BITS, 0);
+
+        EXPECT_DEATH(test_base_timer timer(&test_sw_timer_base), "")
+                << "A timer base with another tick period must cause an " \
+                   "assertion failure.";
+
+        mdv_sw_timer_base_init(&test_sw_timer_base, TEST_TICK_DURATION_US,
+                               TEST_TIMER_WIDTH_BITS + 1u, 0);
+
+        EXPECT_DEATH(test_base_timer timer(&test_sw_timer_base), "")
+                << "A timer base with another timer width must cause an " \
+                   "assertion failure.";
+}
+
+} // namespace
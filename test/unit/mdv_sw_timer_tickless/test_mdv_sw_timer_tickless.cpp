@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "mdv_sw_timer_base.c"
+#include "mdv_timer_wheel.c"
+#include "mock_mdv_timer_driver.h"
+
+// Test value for timer tick duration
+#define TEST_TICK_DURATION_US 100u
+// Test value for timer width in bits
+#define TEST_TIMER_WIDTH_BITS 16u
+// Test mask (16-bit) for the timer counter
+#define TEST_TIMER_MASK 0x0000ffffu
+// Ticks between the forced wake-ups tracking the wrap-arounds
+#define TEST_HALF_PERIOD ((TEST_TIMER_MASK >> 1u) + 1u)
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Timer hardware with a free running counter and a compare value
+ */
+struct test_hardware {
+        uint32_t counter;
+        uint32_t compare;
+        bool is_compare_set;
+        uint32_t wake_up_count;
+        mdv_timer_event_handler_t event_handler;
+        void *user_data;
+};
+
+/*
+ * Record of entry expirations
+ */
+struct test_record {
+        mdv_sw_timer_base_t *sw_timer_base;
+        uint32_t expire_count;
+        uint64_t last_expire_tick_count64;
+};
+
+void test_callback(mdv_timer_wheel_entry_t *const entry, void *const user_data)
+{
+        test_record *record = static_cast<test_record *>(user_data);
+
+        (void)entry;
+
+        ++record->expire_count;
+        record->last_expire_tick_count64 =
+                mdv_sw_timer_base_get_tick_count64(record->sw_timer_base);
+}
+
+class test_mdv_sw_timer_tickless : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvTimerDriver::init();
+                memset(&m_hardware, 0, sizeof(test_hardware));
+
+                ON_CALL(MockMdvTimerDriver::instance(),
+                        mdv_timer_driver_init(_, _))
+                        .WillByDefault(DoAll(
+                                SaveArg<0>(&m_hardware.event_handler),
+                                SaveArg<1>(&m_hardware.user_data),
+                                Return(MDV_RESULT_OK)));
+                ON_CALL(MockMdvTimerDriver::instance(),
+                        mdv_timer_driver_get_count())
+                        .WillByDefault(ReturnPointee(&m_hardware.counter));
+                ON_CALL(MockMdvTimerDriver::instance(),
+                        mdv_timer_driver_set_compare(_))
+                        .WillByDefault(Invoke([this](uint32_t const counter) {
+                                m_hardware.compare = counter;
+                                m_hardware.is_compare_set = true;
+                                return MDV_RESULT_OK;
+                        }));
+
+                mdv_sw_timer_base_init_tickless(
+                        &m_sw_timer_base, TEST_TICK_DURATION_US,
+                        TEST_TIMER_WIDTH_BITS,
+                        MockMdvTimerDriver::GetMdvTimerDriver());
+                mdv_timer_wheel_init(&m_timer_wheel, &m_sw_timer_base);
+                mdv_sw_timer_base_set_event_handler(
+                        &m_sw_timer_base, mdv_timer_wheel_handle_event,
+                        &m_timer_wheel);
+                mdv_sw_timer_base_set_deadline_provider(
+                        &m_sw_timer_base, mdv_timer_wheel_provide_deadline,
+                        &m_timer_wheel);
+        }
+
+        void TearDown() override {
+                MockMdvTimerDriver::destroy();
+        }
+
+        void InitEntry(mdv_timer_wheel_entry_t *const entry,
+                       test_record *const record) {
+                memset(record, 0, sizeof(test_record));
+                record->sw_timer_base = &m_sw_timer_base;
+                mdv_timer_wheel_entry_init(entry, test_callback, record);
+        }
+
+        // Let the counter run for the given ticks, raising the event each
+        // time the counter reaches the compare value
+        void Run(uint32_t tick_count) {
+                uint32_t ticks_to_compare;
+
+                while (tick_count) {
+                        ticks_to_compare = (m_hardware.compare -
+                                            m_hardware.counter) &
+                                           TEST_TIMER_MASK;
+
+                        // The compare value equal to the counter is reached
+                        // after a full counter period
+                        if (!ticks_to_compare) {
+                                ticks_to_compare = TEST_TIMER_MASK + 1u;
+                        }
+
+                        if (!m_hardware.is_compare_set ||
+                            (ticks_to_compare > tick_count)) {
+                                m_hardware.counter = (m_hardware.counter +
+                                                      tick_count) &
+                                                     TEST_TIMER_MASK;
+                                return;
+                        }
+
+                        m_hardware.counter = m_hardware.compare;
+                        m_hardware.is_compare_set = false;
+                        tick_count -= ticks_to_compare;
+
+                        ++m_hardware.wake_up_count;
+                        m_hardware.event_handler(m_hardware.user_data,
+                                                 m_hardware.counter);
+                }
+        }
+
+        mdv_sw_timer_base_t m_sw_timer_base;
+        mdv_timer_wheel_t m_timer_wheel;
+        test_hardware m_hardware;
+};
+
+TEST_F(test_mdv_sw_timer_tickless, wake_up__one_per_distinct_deadline)
+{
+        uint32_t const delays[] = { 3u, 40u, 40u, 1000u, 1001u, 20000u, 20000u,
+                                    30000u };
+        uint32_t const entry_count = sizeof(delays) / sizeof(delays[0]);
+        mdv_timer_wheel_entry_t entries[entry_count];
+        test_record records[entry_count];
+
+        for (uint32_t i = 0; i < entry_count; i++) {
+                InitEntry(&entries[i], &records[i]);
+                mdv_timer_wheel_arm(&m_timer_wheel, &entries[i], delays[i], 0);
+        }
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        Run(delays[entry_count - 1u]);
+
+        EXPECT_EQ(6u, m_hardware.wake_up_count)
+                << "The timer base must wake up once per distinct deadline.";
+
+        for (uint32_t i = 0; i < entry_count; i++) {
+                EXPECT_EQ(1u, records[i].expire_count)
+                        << "Entry must expire once.";
+                EXPECT_EQ((uint64_t)delays[i],
+                          records[i].last_expire_tick_count64)
+                        << "Entry must expire exactly on time.";
+        }
+}
+
+TEST_F(test_mdv_sw_timer_tickless, wake_up__one_per_period)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        InitEntry(&entry, &record);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, 100u, 100u);
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        Run(100000u);
+
+        EXPECT_EQ(1000u, m_hardware.wake_up_count)
+                << "The timer base must wake up once per period.";
+        EXPECT_EQ(1000u, record.expire_count)
+                << "Entry must expire once per period.";
+        EXPECT_EQ(100000u, record.last_expire_tick_count64)
+                << "Entry must expire exactly on time.";
+}
+
+TEST_F(test_mdv_sw_timer_tickless,
+       wake_up__only_for_wrap_arounds_without_deadlines)
+{
+        Run(4u * (TEST_TIMER_MASK + 1u) + 5u);
+
+        EXPECT_EQ(8u, m_hardware.wake_up_count)
+                << "The timer base must wake up twice per counter period.";
+        EXPECT_EQ(4u * ((uint64_t)TEST_TIMER_MASK + 1u) + 5u,
+                  mdv_sw_timer_base_get_tick_count64(&m_sw_timer_base))
+                << "The extended tick count must track the wrap-arounds.";
+}
+
+TEST_F(test_mdv_sw_timer_tickless,
+       wake_up__deadline_longer_than_counter_period)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+        uint32_t const delay = 3u * TEST_HALF_PERIOD + 7u;
+
+        InitEntry(&entry, &record);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, delay, 0);
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        Run(delay);
+
+        EXPECT_EQ(4u, m_hardware.wake_up_count)
+                << "The timer base must wake up for the wrap-arounds and " \
+                   "the deadline only.";
+        EXPECT_EQ((uint64_t)delay, record.last_expire_tick_count64)
+                << "Entry must expire exactly on time.";
+}
+
+TEST_F(test_mdv_sw_timer_tickless,
+       update_deadline__earlier_deadline_armed_outside_event)
+{
+        mdv_timer_wheel_entry_t entries[2];
+        test_record records[2];
+
+        InitEntry(&entries[0], &records[0]);
+        InitEntry(&entries[1], &records[1]);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[0], 1000u, 0);
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        // Arm an earlier entry while the timer base sleeps
+        Run(10u);
+        mdv_timer_wheel_process(&m_timer_wheel);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[1], 20u, 0);
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        Run(990u);
+
+        EXPECT_EQ(2u, m_hardware.wake_up_count)
+                << "The timer base must wake up once per deadline.";
+        EXPECT_EQ(30u, records[1].last_expire_tick_count64)
+                << "Earlier entry must expire exactly on time.";
+        EXPECT_EQ(1000u, records[0].last_expire_tick_count64)
+                << "Later entry must expire exactly on time.";
+}
+
+TEST_F(test_mdv_sw_timer_tickless,
+       wake_up__randomized_deadlines_need_no_extra_wake_ups)
+{
+        uint32_t const entry_count = 500u;
+        std::vector<mdv_timer_wheel_entry_t> entries(entry_count);
+        std::vector<test_record> records(entry_count);
+        std::vector<uint32_t> delays(entry_count);
+        std::vector<uint32_t> distinct;
+        uint32_t seed = 1u;
+
+        for (uint32_t i = 0; i < entry_count; i++) {
+                // Linear congruential generator for repeatable delays
+                seed = seed * 1664525u + 1013904223u;
+                delays[i] = 1u + ((seed >> 8u) % TEST_HALF_PERIOD);
+
+                InitEntry(&entries[i], &records[i]);
+                mdv_timer_wheel_arm(&m_timer_wheel, &entries[i], delays[i], 0);
+                distinct.push_back(delays[i]);
+        }
+        mdv_sw_timer_base_update_deadline(&m_sw_timer_base);
+
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()),
+                       distinct.end());
+
+        Run(TEST_HALF_PERIOD);
+
+        EXPECT_EQ(distinct.size(), m_hardware.wake_up_count)
+                << "The timer base must wake up once per distinct deadline.";
+
+        for (uint32_t i = 0; i < entry_count; i++) {
+                EXPECT_EQ((uint64_t)delays[i],
+                          records[i].last_expire_tick_count64)
+                        << "Entry must expire exactly on time.";
+        }
+}
+
+} // namespace
\ No newline at end of file
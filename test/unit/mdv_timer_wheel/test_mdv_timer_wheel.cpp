@@ -0,0 +1,531 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "mdv_timer_wheel.c"
+#include "mock_mdv_sw_timer_base.h"
+
+// Test mask (23-bit) for the timer counter
+#define TEST_TIMER_MASK 0x007fffffu
+// Test value for the initial tick count
+#define TEST_TIMER_INITIAL_TICK_COUNT 1234u
+// Test value for a delay
+#define TEST_DELAY 10u
+// Test value for a period
+#define TEST_PERIOD 7u
+// Test count of entries for the randomized test
+#define TEST_ENTRY_COUNT 2000u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Expiration record of one test entry
+ */
+struct test_record {
+        mdv_timer_wheel_t *timer_wheel;
+        uint32_t expire_count;
+        uint32_t last_expire_time;
+        mdv_timer_wheel_entry_t *cancel_entry;
+};
+
+void test_callback(mdv_timer_wheel_entry_t *const entry, void *const user_data)
+{
+        test_record *record = static_cast<test_record *>(user_data);
+
+        (void)entry;
+
+        ++record->expire_count;
+        record->last_expire_time = mdv_timer_wheel_get_time(record->timer_wheel);
+
+        if (record->cancel_entry) {
+                mdv_timer_wheel_cancel(record->timer_wheel,
+                                       record->cancel_entry);
+        }
+}
+
+class test_mdv_timer_wheel : public Test
+{
+        protected:
+
+        void SetUp() override {
+                MockMdvSwTimerBase::init();
+                memset(&m_timer_wheel, 0, sizeof(mdv_timer_wheel_t));
+        }
+
+        void TearDown() override {
+                MockMdvSwTimerBase::destroy();
+        }
+
+        void Init() {
+                ON_CALL(MockMdvSwTimerBase::instance(),
+                        mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                        .WillByDefault(Return(TEST_TIMER_MASK));
+                mdv_timer_wheel_init(&m_timer_wheel, &m_sw_timer_base);
+        }
+
+        void InitEntry(mdv_timer_wheel_entry_t *const entry,
+                       test_record *const record) {
+                memset(record, 0, sizeof(test_record));
+                record->timer_wheel = &m_timer_wheel;
+                mdv_timer_wheel_entry_init(entry, test_callback, record);
+        }
+
+        mdv_timer_wheel_t m_timer_wheel;
+        mdv_sw_timer_base_t m_sw_timer_base;
+};
+
+TEST_F(test_mdv_timer_wheel,
+       init__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_timer_wheel_init(0, &m_sw_timer_base), "")
+                << "If null, timer_wheel must cause an assertion failure.";
+        EXPECT_DEATH(mdv_timer_wheel_init(&m_timer_wheel, 0), "")
+                << "If null, sw_timer_base must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_timer_wheel, init__timer_wheel_initialized)
+{
+        // Initialize the timer wheel with 0xff to ensure that all fields are
+        // filled properly
+        memset(&m_timer_wheel, 0xff, sizeof(mdv_timer_wheel_t));
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_timer_mask(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_MASK));
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+
+        mdv_timer_wheel_init(&m_timer_wheel, &m_sw_timer_base);
+
+        EXPECT_EQ(&m_sw_timer_base, m_timer_wheel.sw_timer_base)
+                << "Timer base pointer must be set to the given value.";
+        EXPECT_EQ(TEST_TIMER_MASK, m_timer_wheel.timer_mask)
+                << "Timer mask must be retrieved from the timer base.";
+        EXPECT_EQ(TEST_TIMER_INITIAL_TICK_COUNT, m_timer_wheel.last_tick_count)
+                << "Tick count must be sampled from the timer base.";
+        EXPECT_EQ(0u, mdv_timer_wheel_get_time(&m_timer_wheel))
+                << "Wheel time must start from zero.";
+
+        for (uint32_t level = 0; level < MDV_TIMER_WHEEL_LEVELS; level++) {
+                EXPECT_EQ(0u, m_timer_wheel.occupancy[level])
+                        << "All slots must be empty.";
+        }
+}
+
+TEST_F(test_mdv_timer_wheel,
+       entry_init__invalid_function_parameters_cause_assertion_failure)
+{
+        mdv_timer_wheel_entry_t entry;
+
+        EXPECT_DEATH(mdv_timer_wheel_entry_init(0, test_callback, 0), "")
+                << "If null, entry must cause an assertion failure.";
+        EXPECT_DEATH(mdv_timer_wheel_entry_init(&entry, 0, 0), "")
+                << "If null, callback must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_timer_wheel, arm__one_shot_entry_expires_on_time)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+
+        EXPECT_TRUE(mdv_timer_wheel_is_armed(&entry))
+                << "Entry must be armed.";
+
+        mdv_timer_wheel_advance(&m_timer_wheel, TEST_DELAY - 1);
+
+        EXPECT_EQ(0u, record.expire_count)
+                << "Entry must not expire before the delay.";
+
+        mdv_timer_wheel_advance(&m_timer_wheel, 1);
+
+        EXPECT_EQ(1u, record.expire_count)
+                << "Entry must expire once after the delay.";
+        EXPECT_EQ(TEST_DELAY, record.last_expire_time)
+                << "Entry must expire exactly on time.";
+        EXPECT_FALSE(mdv_timer_wheel_is_armed(&entry))
+                << "One-shot entry must be disarmed after expiration.";
+
+        mdv_timer_wheel_advance(&m_timer_wheel, 1000);
+
+        EXPECT_EQ(1u, record.expire_count)
+                << "One-shot entry must not expire again.";
+}
+
+TEST_F(test_mdv_timer_wheel, arm__entries_on_all_levels_expire_on_time)
+{
+        static const uint32_t delays[] = {
+                0, 1, 31, 32, 33, 1023, 1024, 1025, 40000, 1048576,
+                (1u << 25) + 7u, (1u << 30) - 1u, (1u << 30) + 5u,
+                MDV_TIMER_WHEEL_MAX_DELAY
+        };
+        const size_t count = sizeof(delays) / sizeof(delays[0]);
+        mdv_timer_wheel_entry_t entries[count];
+        test_record records[count];
+        uint32_t expected;
+
+        Init();
+
+        // Move the wheel off from the level boundaries
+        mdv_timer_wheel_advance(&m_timer_wheel, 12345);
+
+        for (size_t i = 0; i < count; i++) {
+                InitEntry(&entries[i], &records[i]);
+                mdv_timer_wheel_arm(&m_timer_wheel, &entries[i], delays[i], 0);
+        }
+
+        mdv_timer_wheel_advance(&m_timer_wheel, MDV_TIMER_WHEEL_MAX_DELAY);
+        mdv_timer_wheel_advance(&m_timer_wheel, 1);
+
+        for (size_t i = 0; i < count; i++) {
+                // Zero delay expires on the next tick
+                expected = 12345u + (delays[i] ? delays[i] : 1u);
+
+                EXPECT_EQ(1u, records[i].expire_count)
+                        << "Entry with delay " << delays[i]
+                        << " must expire once.";
+                EXPECT_EQ(expected, records[i].last_expire_time)
+                        << "Entry with delay " << delays[i]
+                        << " must expire exactly on time.";
+        }
+}
+
+TEST_F(test_mdv_timer_wheel, cancel__cancelled_entry_does_not_expire)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+        mdv_timer_wheel_cancel(&m_timer_wheel, &entry);
+
+        EXPECT_FALSE(mdv_timer_wheel_is_armed(&entry))
+                << "Cancelled entry must not be armed.";
+        EXPECT_EQ(0u, m_timer_wheel.occupancy[0])
+                << "Slot of the cancelled entry must be marked as empty.";
+
+        mdv_timer_wheel_advance(&m_timer_wheel, TEST_DELAY * 2);
+
+        EXPECT_EQ(0u, record.expire_count)
+                << "Cancelled entry must not expire.";
+
+        // Cancelling an entry that is not armed must be harmless
+        mdv_timer_wheel_cancel(&m_timer_wheel, &entry);
+}
+
+TEST_F(test_mdv_timer_wheel, cancel__callback_cancels_entry_in_same_slot)
+{
+        mdv_timer_wheel_entry_t entries[2];
+        test_record records[2];
+
+        Init();
+        InitEntry(&entries[0], &records[0]);
+        InitEntry(&entries[1], &records[1]);
+
+        // Both entries expire on the same tick, and whichever runs first
+        // cancels the other one
+        records[0].cancel_entry = &entries[1];
+        records[1].cancel_entry = &entries[0];
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[0], TEST_DELAY, 0);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[1], TEST_DELAY, 0);
+
+        mdv_timer_wheel_advance(&m_timer_wheel, TEST_DELAY);
+
+        EXPECT_EQ(1u, records[0].expire_count + records[1].expire_count)
+                << "Only the first entry may expire.";
+}
+
+TEST_F(test_mdv_timer_wheel, arm__periodic_entry_expires_every_period)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_PERIOD, TEST_PERIOD);
+
+        mdv_timer_wheel_advance(&m_timer_wheel, TEST_PERIOD * 100);
+
+        EXPECT_EQ(100u, record.expire_count)
+                << "Periodic entry must expire once per period.";
+        EXPECT_EQ(TEST_PERIOD * 100, record.last_expire_time)
+                << "Periodic entry must not drift.";
+        EXPECT_TRUE(mdv_timer_wheel_is_armed(&entry))
+                << "Periodic entry must stay armed.";
+}
+
+TEST_F(test_mdv_timer_wheel, process__manage_tick_counter_wrap_around)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_MASK - 5u))
+                .WillOnce(Return(4u));
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+
+        mdv_timer_wheel_process(&m_timer_wheel);
+
+        EXPECT_EQ(TEST_DELAY, mdv_timer_wheel_get_time(&m_timer_wheel))
+                << "Wheel must advance by the elapsed ticks over the " \
+                   "wrap-around.";
+        EXPECT_EQ(1u, record.expire_count)
+                << "Entry must expire when the time has elapsed.";
+}
+
+TEST_F(test_mdv_timer_wheel, handle_event__wheel_advanced_to_event_tick_count)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        EXPECT_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillOnce(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+
+        mdv_timer_wheel_handle_event(&m_timer_wheel,
+                                     TEST_TIMER_INITIAL_TICK_COUNT + TEST_DELAY);
+
+        EXPECT_EQ(TEST_DELAY, mdv_timer_wheel_get_time(&m_timer_wheel))
+                << "Wheel must advance to the tick count of the event.";
+        EXPECT_EQ(1u, record.expire_count)
+                << "Entry must expire when the time has elapsed.";
+}
+
+TEST_F(test_mdv_timer_wheel, advance__randomized_entries_expire_on_time)
+{
+        std::vector<mdv_timer_wheel_entry_t> entries(TEST_ENTRY_COUNT);
+        std::vector<test_record> records(TEST_ENTRY_COUNT);
+        std::vector<uint32_t> expected(TEST_ENTRY_COUNT);
+        std::vector<bool> cancelled(TEST_ENTRY_COUNT);
+        std::mt19937 random(12345);
+        uint32_t elapsed = 0;
+
+        Init();
+
+        for (uint32_t i = 0; i < TEST_ENTRY_COUNT; i++) {
+                uint32_t const delay = 1u + (random() % 200000u);
+
+                InitEntry(&entries[i], &records[i]);
+                mdv_timer_wheel_arm(&m_timer_wheel, &entries[i], delay, 0);
+                expected[i] = delay;
+                cancelled[i] = !(random() % 10u);
+        }
+
+        for (uint32_t i = 0; i < TEST_ENTRY_COUNT; i++) {
+                if (cancelled[i]) {
+                        mdv_timer_wheel_cancel(&m_timer_wheel, &entries[i]);
+                }
+        }
+
+        while (elapsed < 200001u) {
+                uint32_t const step = 1u + (random() % 3000u);
+
+                mdv_timer_wheel_advance(&m_timer_wheel, step);
+                elapsed += step;
+        }
+
+        for (uint32_t i = 0; i < TEST_ENTRY_COUNT; i++) {
+                if (cancelled[i]) {
+                        EXPECT_EQ(0u, records[i].expire_count)
+                                << "Cancelled entry must not expire.";
+                } else {
+                        EXPECT_EQ(1u, records[i].expire_count)
+                                << "Entry must expire once.";
+                        EXPECT_EQ(expected[i], records[i].last_expire_time)
+                                << "Entry must expire exactly on time.";
+                }
+        }
+
+        for (uint32_t level = 0; level < MDV_TIMER_WHEEL_LEVELS; level++) {
+                EXPECT_EQ(0u, m_timer_wheel.occupancy[level])
+                        << "All slots must be empty.";
+        }
+}
+
+TEST_F(test_mdv_timer_wheel,
+       get_next_deadline__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_timer_wheel_get_next_deadline(0), "")
+                << "If null, timer_wheel must cause an assertion failure.";
+        EXPECT_DEATH(mdv_timer_wheel_provide_deadline(0, 0), "")
+                << "If null, user_data must cause an assertion failure.";
+}
+
+TEST_F(test_mdv_timer_wheel, get_next_deadline__no_deadline_if_wheel_empty)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        Init();
+        InitEntry(&entry, &record);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE,
+                  mdv_timer_wheel_get_next_deadline(&m_timer_wheel))
+                << "Empty wheel must have no deadline.";
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+        mdv_timer_wheel_cancel(&m_timer_wheel, &entry);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE,
+                  mdv_timer_wheel_get_next_deadline(&m_timer_wheel))
+                << "Cancelled entry must not have a deadline.";
+}
+
+TEST_F(test_mdv_timer_wheel,
+       get_next_deadline__higher_level_entry_before_level_0_entry)
+{
+        mdv_timer_wheel_entry_t entries[2];
+        test_record records[2];
+
+        Init();
+        InitEntry(&entries[0], &records[0]);
+        InitEntry(&entries[1], &records[1]);
+
+        // Near the boundary of level 0, the first entry goes to level 1. Two
+        // ticks later, the second entry expiring after the first one goes to
+        // level 0.
+        mdv_timer_wheel_advance(&m_timer_wheel, MDV_TIMER_WHEEL_SLOTS - 4u);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[0],
+                            MDV_TIMER_WHEEL_SLOTS + 1u, 0);
+        mdv_timer_wheel_advance(&m_timer_wheel, 2u);
+        mdv_timer_wheel_arm(&m_timer_wheel, &entries[1],
+                            MDV_TIMER_WHEEL_SLOTS, 0);
+
+        ASSERT_EQ(1u, entries[0].level);
+        ASSERT_EQ(0u, entries[1].level);
+        EXPECT_EQ(MDV_TIMER_WHEEL_SLOTS - 1u,
+                  mdv_timer_wheel_get_next_deadline(&m_timer_wheel))
+                << "Deadline must be the earliest expiration on any level.";
+}
+
+TEST_F(test_mdv_timer_wheel,
+       get_next_deadline__parked_entry_reported_at_cascade)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+        uint32_t deadline;
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, MDV_TIMER_WHEEL_MAX_DELAY,
+                            0);
+
+        deadline = mdv_timer_wheel_get_next_deadline(&m_timer_wheel);
+
+        EXPECT_LE(deadline, WHEEL_RANGE)
+                << "Parked entry must be reported within the wheel range.";
+
+        // Advancing to the reported deadlines must end up to the expiration
+        while (!record.expire_count) {
+                mdv_timer_wheel_advance(&m_timer_wheel, deadline);
+                deadline = mdv_timer_wheel_get_next_deadline(&m_timer_wheel);
+        }
+
+        EXPECT_EQ(MDV_TIMER_WHEEL_MAX_DELAY, record.last_expire_time)
+                << "Entry must expire exactly on time.";
+}
+
+TEST_F(test_mdv_timer_wheel, provide_deadline__elapsed_ticks_subtracted)
+{
+        mdv_timer_wheel_entry_t entry;
+        test_record record;
+
+        ON_CALL(MockMdvSwTimerBase::instance(),
+                mdv_sw_timer_base_get_tick_count(&m_sw_timer_base))
+                .WillByDefault(Return(TEST_TIMER_INITIAL_TICK_COUNT));
+
+        Init();
+        InitEntry(&entry, &record);
+
+        mdv_timer_wheel_arm(&m_timer_wheel, &entry, TEST_DELAY, 0);
+
+        EXPECT_EQ(TEST_DELAY - 3u,
+                  mdv_timer_wheel_provide_deadline(
+                          &m_timer_wheel, TEST_TIMER_INITIAL_TICK_COUNT + 3u))
+                << "Ticks elapsed since the wheel was processed must be " \
+                   "subtracted.";
+        EXPECT_EQ(0u, mdv_timer_wheel_provide_deadline(
+                          &m_timer_wheel,
+                          TEST_TIMER_INITIAL_TICK_COUNT + TEST_DELAY + 1u))
+                << "Deadline already passed must be due now.";
+
+        mdv_timer_wheel_cancel(&m_timer_wheel, &entry);
+
+        EXPECT_EQ(MDV_SW_TIMER_BASE_NO_DEADLINE,
+                  mdv_timer_wheel_provide_deadline(
+                          &m_timer_wheel, TEST_TIMER_INITIAL_TICK_COUNT))
+                << "Empty wheel must have no deadline.";
+}
+
+TEST_F(test_mdv_timer_wheel,
+       get_next_deadline__randomized_entries_match_earliest_expiration)
+{
+        std::vector<mdv_timer_wheel_entry_t> entries(TEST_ENTRY_COUNT);
+        std::vector<test_record> records(TEST_ENTRY_COUNT);
+        std::mt19937 random(54321);
+        uint32_t deadline;
+        uint32_t expected;
+        uint32_t now;
+
+        Init();
+
+        for (uint32_t i = 0; i < TEST_ENTRY_COUNT; i++) {
+                InitEntry(&entries[i], &records[i]);
+                mdv_timer_wheel_arm(&m_timer_wheel, &entries[i],
+                                    1u + (random() % 200000u),
+                                    (i % 4u) ? 0 : 1u + (random() % 50000u));
+        }
+
+        // Jump from a deadline to the next one, like the tickless timer base
+        for (uint32_t step = 0; step < TEST_ENTRY_COUNT; step++) {
+                now = mdv_timer_wheel_get_time(&m_timer_wheel);
+                expected = MDV_SW_TIMER_BASE_NO_DEADLINE;
+
+                for (uint32_t i = 0; i < TEST_ENTRY_COUNT; i++) {
+                        if (mdv_timer_wheel_is_armed(&entries[i]) &&
+                            ((entries[i].expires - now) < expected)) {
+                                expected = entries[i].expires - now;
+                        }
+                }
+
+                deadline = mdv_timer_wheel_get_next_deadline(&m_timer_wheel);
+
+                ASSERT_EQ(expected, deadline)
+                        << "Deadline must be the earliest expiration.";
+
+                if (deadline == MDV_SW_TIMER_BASE_NO_DEADLINE) {
+                        break;
+                }
+
+                // Cancel some entries to vary the occupancy
+                if (!(random() % 8u)) {
+                        mdv_timer_wheel_cancel(
+                                &m_timer_wheel,
+                                &entries[random() % TEST_ENTRY_COUNT]);
+                }
+
+                mdv_timer_wheel_advance(&m_timer_wheel, deadline);
+        }
+}
+
+} // namespace
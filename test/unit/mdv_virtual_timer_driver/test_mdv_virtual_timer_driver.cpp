@@ -0,0 +1,384 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "mdv_virtual_timer_driver.c"
+#include "mdv_timer_wheel.h"
+
+// Test value for timer width in bits
+#define TEST_TIMER_WIDTH_BITS 24u
+// Test mask (24-bit) for the timer counter
+#define TEST_TIMER_MASK 0x00ffffffu
+// Test value for timer tick duration (1 ms)
+#define TEST_TICK_DURATION_US 1000u
+// Test value for the period of the periodic events
+#define TEST_EVENT_PERIOD 10u
+// Test value for the compare value
+#define TEST_COMPARE 100u
+// Ticks in one simulated day
+#define TEST_TICKS_IN_ONE_DAY 86400000u
+
+using namespace testing;
+
+namespace{
+
+/*
+ * Record of raised events
+ */
+struct test_events {
+        uint32_t count;
+        uint32_t counter;
+        std::vector<bool> is_compare_pending;
+        uint32_t next_compare;
+};
+
+void test_event_handler(void *const user_data, uint32_t const counter)
+{
+        test_events *events = static_cast<test_events *>(user_data);
+
+        ++events->count;
+        events->counter = counter;
+        events->is_compare_pending.push_back(driver.is_compare_armed);
+
+        if (events->next_compare) {
+                mdv_virtual_timer_driver.set_compare(events->next_compare);
+                events->next_compare = 0;
+        }
+}
+
+/*
+ * Record of expired wheel entries
+ */
+struct test_expiration {
+        uint32_t id;
+        uint64_t tick_count64;
+};
+
+struct test_simulation {
+        mdv_sw_timer_base_t *sw_timer_base;
+        std::vector<test_expiration> expirations;
+};
+
+struct test_entry {
+        mdv_timer_wheel_entry_t entry;
+        test_simulation *simulation;
+        uint32_t id;
+};
+
+void test_callback(mdv_timer_wheel_entry_t *const entry, void *const user_data)
+{
+        test_entry *test = static_cast<test_entry *>(user_data);
+
+        (void)entry;
+
+        test->simulation->expirations.push_back(
+                {test->id, mdv_sw_timer_base_get_tick_count64(
+                        test->simulation->sw_timer_base)});
+}
+
+class test_mdv_virtual_timer_driver : public Test
+{
+        protected:
+
+        void SetUp() override {
+                m_config.timer_width_bits = TEST_TIMER_WIDTH_BITS;
+                m_config.event_period_ticks = 0;
+                m_events.count = 0;
+                m_events.counter = 0;
+                m_events.is_compare_pending.clear();
+                m_events.next_compare = 0;
+        }
+
+        void TearDown() override {
+                mdv_virtual_timer_driver.uninit();
+        }
+
+        void Init() {
+                ASSERT_EQ(MDV_RESULT_OK,
+                          mdv_virtual_timer_driver_configure(&m_config));
+                ASSERT_EQ(MDV_RESULT_OK,
+                          mdv_virtual_timer_driver.init(test_event_handler,
+                                                        &m_events));
+        }
+
+        // Simulate one day of a tickless timer base running a timer wheel
+        // with a periodic entry per second, a periodic entry per minute and a
+        // one-shot entry after one hour
+        void Simulate(test_simulation *const simulation) {
+                mdv_sw_timer_base_t sw_timer_base;
+                mdv_timer_wheel_t timer_wheel;
+                test_entry entries[3];
+                uint32_t const delays[3] = { 1000u, 60000u, 3600000u };
+                uint32_t const periods[3] = { 1000u, 60000u, 0 };
+
+                simulation->sw_timer_base = &sw_timer_base;
+                simulation->expirations.clear();
+
+                ASSERT_EQ(MDV_RESULT_OK,
+                          mdv_virtual_timer_driver_configure(&m_config));
+                mdv_sw_timer_base_init_tickless(&sw_timer_base,
+                                                TEST_TICK_DURATION_US,
+                                                TEST_TIMER_WIDTH_BITS,
+                                                &mdv_virtual_timer_driver);
+                mdv_timer_wheel_init(&timer_wheel, &sw_timer_base);
+                mdv_sw_timer_base_set_event_handler(
+                        &sw_timer_base, mdv_timer_wheel_handle_event,
+                        &timer_wheel);
+                mdv_sw_timer_base_set_deadline_provider(
+                        &sw_timer_base, mdv_timer_wheel_provide_deadline,
+                        &timer_wheel);
+
+                for (uint32_t i = 0; i < 3u; i++) {
+                        entries[i].simulation = simulation;
+                        entries[i].id = i;
+                        mdv_timer_wheel_entry_init(&entries[i].entry,
+                                                   test_callback, &entries[i]);
+                        mdv_timer_wheel_arm(&timer_wheel, &entries[i].entry,
+                                            delays[i], periods[i]);
+                }
+                mdv_sw_timer_base_update_deadline(&sw_timer_base);
+
+                mdv_virtual_timer_driver_advance(TEST_TICKS_IN_ONE_DAY);
+
+                mdv_sw_timer_base_uninit(&sw_timer_base);
+        }
+
+        mdv_virtual_timer_driver_config_t m_config;
+        test_events m_events;
+};
+
+TEST_F(test_mdv_virtual_timer_driver,
+       configure__invalid_function_parameters_cause_assertion_failure)
+{
+        EXPECT_DEATH(mdv_virtual_timer_driver_configure(0), "")
+                << "If null, config must cause an assertion failure.";
+
+        m_config.timer_width_bits = 0;
+        EXPECT_DEATH(mdv_virtual_timer_driver_configure(&m_config), "")
+                << "If zero, timer_width_bits must cause an assertion failure.";
+
+        m_config.timer_width_bits = 33u;
+        EXPECT_DEATH(mdv_virtual_timer_driver_configure(&m_config), "")
+                << "If over 32, timer_width_bits must cause an assertion " \
+                   "failure.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver, configure__fails_when_initialized)
+{
+        Init();
+
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver_configure(&m_config))
+                << "The driver can't be configured when initialized.";
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.init(0, 0))
+                << "The driver can't be initialized twice.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       functions_fail_when_not_initialized)
+{
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.uninit())
+                << "Uninit must fail when not initialized.";
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.start())
+                << "Start must fail when not initialized.";
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.stop())
+                << "Stop must fail when not initialized.";
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.reset())
+                << "Reset must fail when not initialized.";
+        EXPECT_EQ(MDV_VIRTUAL_TIMER_DRIVER_ERROR_STATE,
+                  mdv_virtual_timer_driver.set_compare(TEST_COMPARE))
+                << "Set compare must fail when not initialized.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       advance__counter_follows_virtual_clock_only)
+{
+        Init();
+
+        EXPECT_TRUE(mdv_virtual_timer_driver.is_running())
+                << "The timer must run after the initialization.";
+        EXPECT_EQ(0u, mdv_virtual_timer_driver.get_count())
+                << "The counter must start from zero.";
+
+        EXPECT_EQ(0u, mdv_virtual_timer_driver_advance(TEST_TIMER_MASK + 6u))
+                << "No events must be raised.";
+
+        EXPECT_EQ(5u, mdv_virtual_timer_driver.get_count())
+                << "The counter must be limited by the timer width.";
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + 6u,
+                  mdv_virtual_timer_driver_get_time())
+                << "The virtual time must advance by the given ticks.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver, stop__counter_frozen_while_stopped)
+{
+        Init();
+
+        mdv_virtual_timer_driver_advance(TEST_COMPARE);
+        mdv_virtual_timer_driver.stop();
+        mdv_virtual_timer_driver_advance(TEST_COMPARE);
+
+        EXPECT_FALSE(mdv_virtual_timer_driver.is_running())
+                << "The timer must be stopped.";
+        EXPECT_EQ(TEST_COMPARE, mdv_virtual_timer_driver.get_count())
+                << "The counter must not advance while stopped.";
+
+        mdv_virtual_timer_driver.start();
+        mdv_virtual_timer_driver_advance(1u);
+
+        EXPECT_EQ(TEST_COMPARE + 1u, mdv_virtual_timer_driver.get_count())
+                << "The counter must continue after starting.";
+        EXPECT_EQ(2u * TEST_COMPARE + 1u, mdv_virtual_timer_driver_get_time())
+                << "The virtual time must advance also while stopped.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver, reset__counter_restarted_from_zero)
+{
+        Init();
+
+        mdv_virtual_timer_driver_advance(TEST_COMPARE);
+        mdv_virtual_timer_driver.set_compare(TEST_COMPARE);
+
+        EXPECT_EQ(MDV_RESULT_OK, mdv_virtual_timer_driver.reset())
+                << "Reset must succeed.";
+        EXPECT_EQ(0u, mdv_virtual_timer_driver.get_count())
+                << "The counter must restart from zero.";
+        EXPECT_EQ(TEST_COMPARE,
+                  mdv_virtual_timer_driver_step(UINT64_MAX))
+                << "The compare value must be reached from the new origin.";
+        EXPECT_EQ(1u, m_events.count)
+                << "The compare event must be raised.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       step__jumps_to_compare_value_and_raises_event_once)
+{
+        Init();
+
+        EXPECT_EQ(MDV_RESULT_OK,
+                  mdv_virtual_timer_driver.set_compare(TEST_COMPARE))
+                << "Compare value must be programmed.";
+
+        EXPECT_EQ(TEST_COMPARE, mdv_virtual_timer_driver_step(UINT64_MAX))
+                << "The clock must jump to the compare value.";
+        EXPECT_EQ(1u, m_events.count)
+                << "The compare event must be raised.";
+        EXPECT_EQ(TEST_COMPARE, m_events.counter)
+                << "The event handler must receive the compare value.";
+
+        EXPECT_EQ(TEST_TIMER_MASK + 1u,
+                  mdv_virtual_timer_driver_step(TEST_TIMER_MASK + 1u))
+                << "Without events, the clock must advance by the maximum.";
+        EXPECT_EQ(1u, m_events.count)
+                << "The compare event must be raised only once.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       set_compare__current_value_reached_after_full_period)
+{
+        Init();
+
+        mdv_virtual_timer_driver.set_compare(0);
+
+        EXPECT_EQ((uint64_t)TEST_TIMER_MASK + 1u,
+                  mdv_virtual_timer_driver_step(UINT64_MAX))
+                << "The current counter value must be reached after a full " \
+                   "period.";
+        EXPECT_EQ(1u, m_events.count)
+                << "The compare event must be raised.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver, advance__periodic_events_raised)
+{
+        m_config.event_period_ticks = TEST_EVENT_PERIOD;
+        Init();
+
+        EXPECT_EQ(10u, mdv_virtual_timer_driver_advance(10u * TEST_EVENT_PERIOD))
+                << "One event must be raised per period, including the " \
+                   "last tick.";
+        EXPECT_EQ(10u * TEST_EVENT_PERIOD, m_events.counter)
+                << "The last event must be raised at the last tick.";
+        EXPECT_EQ(10u, mdv_virtual_timer_driver_get_event_count())
+                << "The raised events must be counted.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       step__events_at_same_tick_raised_in_fixed_order)
+{
+        m_config.event_period_ticks = TEST_COMPARE;
+        Init();
+
+        mdv_virtual_timer_driver.set_compare(TEST_COMPARE);
+
+        EXPECT_EQ(TEST_COMPARE, mdv_virtual_timer_driver_step(UINT64_MAX))
+                << "The clock must jump to the tick of both events.";
+        ASSERT_EQ(2u, m_events.count)
+                << "Both events must be raised in one step.";
+        EXPECT_TRUE(m_events.is_compare_pending[0])
+                << "The periodic event must be raised first.";
+        EXPECT_FALSE(m_events.is_compare_pending[1])
+                << "The compare event must be raised second.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       step__compare_programmed_by_event_handler_replaces_due_one)
+{
+        m_config.event_period_ticks = TEST_COMPARE;
+        Init();
+
+        mdv_virtual_timer_driver.set_compare(TEST_COMPARE);
+        m_events.next_compare = TEST_COMPARE + TEST_EVENT_PERIOD;
+
+        mdv_virtual_timer_driver_step(UINT64_MAX);
+
+        EXPECT_EQ(1u, m_events.count)
+                << "The replaced compare event must not be raised.";
+        EXPECT_EQ(TEST_EVENT_PERIOD, mdv_virtual_timer_driver_step(UINT64_MAX))
+                << "The clock must jump to the new compare value.";
+        EXPECT_EQ(2u, m_events.count)
+                << "The new compare event must be raised.";
+}
+
+TEST_F(test_mdv_virtual_timer_driver,
+       advance__tickless_timer_base_simulates_one_day_deterministically)
+{
+        test_simulation simulations[2];
+        uint32_t counts[3] = { 0, 0, 0 };
+
+        Simulate(&simulations[0]);
+
+        // One event per second covers the deadlines of all entries
+        EXPECT_EQ(86400u, mdv_virtual_timer_driver_get_event_count())
+                << "Events must be raised only at the deadlines.";
+        EXPECT_EQ((uint64_t)TEST_TICKS_IN_ONE_DAY,
+                  mdv_virtual_timer_driver_get_time())
+                << "The virtual clock must advance by one day.";
+
+        for (test_expiration const &expiration : simulations[0].expirations) {
+                ++counts[expiration.id];
+        }
+
+        EXPECT_EQ(86400u, counts[0]) << "Per second entry must expire.";
+        EXPECT_EQ(1440u, counts[1]) << "Per minute entry must expire.";
+        EXPECT_EQ(1u, counts[2]) << "One-shot entry must expire once.";
+
+        Simulate(&simulations[1]);
+
+        ASSERT_EQ(simulations[0].expirations.size(),
+                  simulations[1].expirations.size())
+                << "Repeated simulation must expire the same entries.";
+
+        for (size_t i = 0; i < simulations[0].expirations.size(); i++) {
+                ASSERT_EQ(simulations[0].expirations[i].id,
+                          simulations[1].expirations[i].id)
+                        << "Repeated simulation must keep the order.";
+                ASSERT_EQ(simulations[0].expirations[i].tick_count64,
+                          simulations[1].expirations[i].tick_count64)
+                        << "Repeated simulation must keep the times.";
+        }
+}
+
+} // namespace
\ No newline at end of file